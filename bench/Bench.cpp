@@ -0,0 +1,54 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Bench {
+
+namespace {
+
+std::vector<std::pair<const char*, Case>>& Cases() {
+  static std::vector<std::pair<const char*, Case>> cases;
+  return cases;
+}
+
+}  // namespace
+
+Registrar::Registrar(const char* name, Case fn) { Cases().emplace_back(name, fn); }
+
+void State::Run(const std::string& variant, std::size_t items, const std::function<void()>& fn,
+                int repetitions) {
+  using Clock = std::chrono::steady_clock;
+
+  double best = 1e300;
+  for (int i = 0; i < repetitions; ++i) {
+    const auto start = Clock::now();
+    fn();
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+
+  const double perItem = items ? best * 1e9 / static_cast<double>(items) : 0.0;
+  const double rate = best > 0.0 ? static_cast<double>(items) / best : 0.0;
+  std::printf("%-32s %-28s %12.1f ns/item %14.0f items/s\n", name_.c_str(), variant.c_str(),
+              perItem, rate);
+}
+
+}  // namespace Bench
+
+// Usage: Benchmarks [substring filter]
+int main(int argc, char** argv) {
+  const std::string_view filter = argc > 1 ? argv[1] : "";
+
+  for (const auto& [name, fn] : Bench::Cases()) {
+    if (!filter.empty() && std::string_view(name).find(filter) == std::string_view::npos) {
+      continue;
+    }
+    Bench::State state(name);
+    fn(state);
+  }
+  return 0;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <utility>
+
+// Tiny benchmark harness. Each case registers itself with BENCHMARK(name) and receives a
+// State; the body calls state.Run(items, fn) for every variant it wants to compare.
+namespace Bench {
+
+class State {
+ public:
+  explicit State(std::string name) : name_(std::move(name)) {}
+
+  // Times fn (best of several repetitions) and prints ns per item and items per second
+  void Run(const std::string& variant, std::size_t items, const std::function<void()>& fn,
+           int repetitions = 5);
+
+ private:
+  std::string name_;
+};
+
+using Case = void (*)(State&);
+
+struct Registrar {
+  Registrar(const char* name, Case fn);
+};
+
+// Keeps results observable so the optimiser cannot drop the measured work
+template <typename T>
+void DoNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}  // namespace Bench
+
+#define BENCHMARK(name)                                            \
+  static void name(Bench::State& state);                           \
+  static const Bench::Registrar name##_registrar(#name, &name);    \
+  static void name(Bench::State& state)
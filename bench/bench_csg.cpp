@@ -0,0 +1,24 @@
+#include <optional>
+
+#include "Bench.h"
+#include "Csg/Boolean.h"
+#include "Generators/Shapes.h"
+#include "Model/Model.h"
+
+BENCHMARK(CsgBoolean) {
+  // Two 100k face spheres overlapping by about a third of their diameter
+  Model model;
+  const MeshData sphere = Generators::UvSphere(Vec3{2, 2, 2}, 448, 224);
+  const VolumeId a = model.AppendMesh(sphere).volumes.front();
+  MeshData moved = sphere;
+  for (Vec3& p : moved.positions) p += Vec3{1.3f, 0.2f, 0.1f};
+  const VolumeId b = model.AppendMesh(moved).volumes.front();
+
+  for (uint8_t op = 0; op < Csg::kOperationCount; ++op) {
+    const auto operation = static_cast<Csg::Operation>(op);
+    state.Run(Csg::OperationName(operation), sphere.FaceCount() * 2, [&] {
+      const std::optional<MeshData> result = Csg::Combine(model, a, b, operation);
+      Bench::DoNotOptimize(result ? result->positions.data() : nullptr);
+    });
+  }
+}
@@ -0,0 +1,27 @@
+#include <vector>
+
+#include "Bench.h"
+#include "Generators/Shapes.h"
+#include "Model/Model.h"
+
+BENCHMARK(ExtrudeFaces) {
+  Model model;
+  const MeshIds ids = model.AppendMesh(Generators::Grid(Vec3{100, 0, 100}, 100, 100));
+  const std::size_t count = ids.faces.size();
+
+  // Each repetition extrudes and reverts so the model is identical every time
+  state.Run("region of 10k faces", count, [&] {
+    const ExtrudeRecord record = model.ExtrudeFaces(ids.faces, 1.0f);
+    Bench::DoNotOptimize(record.createdFaces.data());
+    model.RevertExtrude(record);
+  });
+
+  state.Run("face by face", count, [&] {
+    std::vector<ExtrudeRecord> records;
+    records.reserve(count);
+    for (FaceId face : ids.faces) {
+      records.push_back(model.ExtrudeFaces(std::span<const FaceId>(&face, 1), 1.0f));
+    }
+    for (auto it = records.rbegin(); it != records.rend(); ++it) model.RevertExtrude(*it);
+  });
+}
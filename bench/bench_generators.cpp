@@ -0,0 +1,55 @@
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include "Bench.h"
+#include "Core/MeshData.h"
+#include "Generators/Profiles.h"
+#include "Generators/Shapes.h"
+#include "Model/Model.h"
+
+namespace {
+
+// Circle of the given resolution in the xy plane, centred 2 from the y axis
+std::vector<Vec3> Profile(uint32_t resolution) {
+  std::vector<Vec3> points;
+  for (uint32_t i = 0; i < resolution; ++i) {
+    const float angle = 2.0f * std::numbers::pi_v<float> * static_cast<float>(i) /
+                        static_cast<float>(resolution);
+    points.push_back(Vec3{2.0f + std::cos(angle), std::sin(angle), 0.0f});
+  }
+  return points;
+}
+
+}  // namespace
+
+BENCHMARK(Lathe) {
+  const std::vector<Vec3> profile = Profile(64);
+  const std::size_t quads = 512 * profile.size();
+
+  state.Run("512 segments, generate", quads, [&] {
+    const MeshData mesh = Generators::Lathe(profile, Vec3{}, Up, 2.0f * std::numbers::pi_v<float>,
+                                            512);
+    Bench::DoNotOptimize(mesh.faceEdges.data());
+  });
+
+  // What one frame has to fit: generation plus insertion into a model
+  state.Run("512 segments, generate and append", quads, [&] {
+    Model model;
+    model.AppendMesh(Generators::Lathe(profile, Vec3{}, Up, 2.0f * std::numbers::pi_v<float>,
+                                       512));
+    Bench::DoNotOptimize(&model);
+  });
+}
+
+BENCHMARK(Shapes) {
+  state.Run("uv sphere 256 x 128", 256 * 128, [&] {
+    const MeshData mesh = Generators::UvSphere(Vec3{2, 2, 2}, 256, 128);
+    Bench::DoNotOptimize(mesh.faceEdges.data());
+  });
+
+  state.Run("ico sphere level 5", 20 * 1024, [&] {
+    const MeshData mesh = Generators::IcoSphere(Vec3{2, 2, 2}, 5);
+    Bench::DoNotOptimize(mesh.faceEdges.data());
+  });
+}
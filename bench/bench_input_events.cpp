@@ -0,0 +1,51 @@
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "App/Input.h"
+#include "Bench.h"
+
+BENCHMARK(InputEvents) {
+  // A frame's worth of fast mouse motion with a click in it
+  std::vector<InputEvent> frame(64);
+  for (std::size_t i = 0; i < frame.size(); ++i) {
+    frame[i].type = InputEvent::Type::Motion;
+    frame[i].x = static_cast<float>(i);
+    frame[i].y = static_cast<float>(i / 2);
+  }
+  frame[20].type = InputEvent::Type::KeyDown;
+  frame[20].key = KEYS::MOUSE_LEFT;
+  frame[40].type = InputEvent::Type::KeyUp;
+  frame[40].key = KEYS::MOUSE_LEFT;
+
+  auto queue = std::make_unique<InputEventQueue>();
+  Input input;
+  state.Run("push, pop and apply, one thread", frame.size(), [&] {
+    for (InputEvent event : frame) {
+      event.time = std::chrono::steady_clock::now();
+      queue->TryPush(event);
+    }
+    input.BeginFrame();
+    InputEvent event;
+    while (queue->TryPop(event)) input.Apply(event);
+    Bench::DoNotOptimize(&input);
+  });
+
+  // Producer on its own thread, as if callbacks came from an input thread
+  constexpr std::size_t kEvents = 1 << 16;
+  state.Run("handover between threads", kEvents, [&] {
+    std::thread producer([&] {
+      for (std::size_t i = 0; i < kEvents; ++i) {
+        while (!queue->TryPush(frame[i % frame.size()])) std::this_thread::yield();
+      }
+    });
+    std::size_t received = 0;
+    InputEvent event;
+    while (received < kEvents) {
+      if (queue->TryPop(event)) ++received;
+    }
+    producer.join();
+    Bench::DoNotOptimize(&received);
+  });
+}
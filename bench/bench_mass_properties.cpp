@@ -0,0 +1,27 @@
+#include <vector>
+
+#include "Analysis/MassProperties.h"
+#include "Bench.h"
+#include "Generators/Shapes.h"
+#include "Model/Model.h"
+
+BENCHMARK(MassPropertiesIntegration) {
+  // 1000 x 500 segment sphere: about a million triangles
+  Model model;
+  const MeshIds sphere = model.AppendMesh(Generators::UvSphere(Vec3{2, 2, 2}, 1000, 500));
+  const std::size_t triangles = 1000 * 500 * 2;
+
+  state.Run("1M triangle volume", triangles, [&] {
+    const Analysis::MassProperties result = Analysis::Compute(model, sphere.faces);
+    Bench::DoNotOptimize(&result);
+  });
+
+  std::vector<VolumeId> volumes;
+  for (int i = 0; i < 256; ++i) {
+    volumes.push_back(model.AppendMesh(Generators::Torus(Vec3{2, 1, 2}, 48, 16)).volumes[0]);
+  }
+  state.Run("256 volumes of 1.5k triangles", volumes.size(), [&] {
+    const auto results = Analysis::ComputeVolumes(model, volumes);
+    Bench::DoNotOptimize(results.data());
+  });
+}
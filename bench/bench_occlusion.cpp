@@ -0,0 +1,44 @@
+#include <random>
+#include <vector>
+
+#include "Bench.h"
+#include "Geometry/Aabb.h"
+#include "Occlusion/DepthBuffer.h"
+#include "Rendering/Camera.h"
+
+BENCHMARK(OcclusionDepthBuffer) {
+  Camera camera;
+  camera.SetAspectRatio(16.0f / 9.0f);
+  const Mat4 viewProjection = camera.GetViewProjectionMatrix();
+
+  // 32k random triangles a few units in front of the camera
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<float> spread(-3.0f, 3.0f);
+  std::uniform_real_distribution<float> size(-0.3f, 0.3f);
+  std::vector<Vec3> corners;
+  for (int t = 0; t < 32 * 1024; ++t) {
+    const Vec3 center{spread(rng), spread(rng), spread(rng) - 2.0f};
+    for (int k = 0; k < 3; ++k) corners.push_back(center + Vec3{size(rng), size(rng), size(rng)});
+  }
+
+  std::vector<Geometry::Aabb> boxes(16 * 1024);
+  for (auto& box : boxes) {
+    const Vec3 center{spread(rng), spread(rng), spread(rng) - 6.0f};
+    box.Expand(center - Vec3{0.2f});
+    box.Expand(center + Vec3{0.2f});
+  }
+
+  Occlusion::DepthBuffer depth;
+  depth.Resize(256, 144);
+  state.Run("rasterize 32k triangles at 256x144", corners.size() / 3, [&] {
+    depth.Clear(viewProjection);
+    depth.Rasterize(corners);
+    Bench::DoNotOptimize(&depth);
+  });
+
+  state.Run("test 16k boxes", boxes.size(), [&] {
+    std::size_t hidden = 0;
+    for (const auto& box : boxes) hidden += depth.IsOccluded(box) ? 1 : 0;
+    Bench::DoNotOptimize(&hidden);
+  });
+}
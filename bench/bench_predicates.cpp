@@ -0,0 +1,95 @@
+#include <array>
+#include <random>
+#include <vector>
+
+#include "Bench.h"
+#include "Geometry/Geometry.h"
+#include "Geometry/Predicates.h"
+#include "Utilities/Vec3.h"
+
+namespace {
+
+// The fixed epsilon coplanarity test the predicates replaced, kept as the baseline
+bool LegacyAreCoplanar(std::span<const Vec3> points) {
+  if (points.size() < 3) return true;
+
+  const Vec3& p0 = points[0];
+  Vec3 normal{};
+  bool foundPlane = false;
+  for (std::size_t i = 1; i + 1 < points.size(); ++i) {
+    normal = (points[i] - p0).Cross(points[i + 1] - p0);
+    if (!IsEqual(normal.LengthSquared(), 0.0f)) {
+      foundPlane = true;
+      break;
+    }
+  }
+  if (!foundPlane) return true;
+
+  for (std::size_t i = 1; i < points.size(); ++i) {
+    if (!IsEqual(normal.Dot(points[i] - p0), 0.0f)) return false;
+  }
+  return true;
+}
+
+std::vector<Vec3> RandomPoints(std::size_t count) {
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<float> coordinate(-10.0f, 10.0f);
+  std::vector<Vec3> points(count);
+  for (Vec3& p : points) p = Vec3{coordinate(rng), coordinate(rng), coordinate(rng)};
+  return points;
+}
+
+// Random planar quads with float rounding, as produced by transformed geometry
+std::vector<std::array<Vec3, 4>> RandomQuads(std::size_t count) {
+  const auto points = RandomPoints(count * 3);
+  std::vector<std::array<Vec3, 4>> quads(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const Vec3& o = points[i * 3];
+    const Vec3 u = points[i * 3 + 1] * 0.1f;
+    const Vec3 v = points[i * 3 + 2] * 0.1f;
+    quads[i] = {o, o + u, o + u + v, o + v};
+  }
+  return quads;
+}
+
+}  // namespace
+
+BENCHMARK(Orient3d) {
+  constexpr std::size_t kCount = 1 << 20;
+  const auto points = RandomPoints(kCount + 3);
+
+  state.Run("naive float", kCount, [&] {
+    int positive = 0;
+    for (std::size_t i = 0; i < kCount; ++i) {
+      const Vec3& a = points[i];
+      const float det = (points[i + 1] - a).Cross(points[i + 2] - a).Dot(points[i + 3] - a);
+      positive += det > 0.0f;
+    }
+    Bench::DoNotOptimize(positive);
+  });
+
+  state.Run("filtered exact", kCount, [&] {
+    int positive = 0;
+    for (std::size_t i = 0; i < kCount; ++i) {
+      positive += Geometry::Orient3d(points[i], points[i + 1], points[i + 2], points[i + 3]) > 0.0;
+    }
+    Bench::DoNotOptimize(positive);
+  });
+}
+
+BENCHMARK(AreCoplanar) {
+  constexpr std::size_t kCount = 1 << 18;
+  const auto quads = RandomQuads(kCount);
+
+  state.Run("legacy epsilon", kCount, [&] {
+    int coplanar = 0;
+    for (const auto& quad : quads) coplanar += LegacyAreCoplanar(quad);
+    Bench::DoNotOptimize(coplanar);
+  });
+
+  state.Run("predicates", kCount, [&] {
+    int coplanar = 0;
+    for (const auto& quad : quads) coplanar += Geometry::AreCoplanar(quad);
+    Bench::DoNotOptimize(coplanar);
+  });
+}
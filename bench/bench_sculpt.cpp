@@ -0,0 +1,37 @@
+#include <vector>
+
+#include "Bench.h"
+#include "Generators/Shapes.h"
+#include "Model/Model.h"
+#include "ModelView/ModelViewBuilder.h"
+#include "Sculpt/Stroke.h"
+
+BENCHMARK(SculptStroke) {
+  // 512 x 512 quads 1/64 apart; a 0.1 radius brush covers about 130 vertices
+  Model model;
+  model.AppendMesh(Generators::Grid(Vec3{8, 0, 8}, 512, 512));
+  model.ResetDirtyFlags();
+
+  ModelViewBuilder builder(model);
+  FaceView view;
+  builder.BuildFaceView(view);
+
+  Sculpt::Stroke stroke(model, {Sculpt::Brush::Inflate, 0.1f, 0.5f});
+  std::vector<ViewRange> ranges;
+  float x = -3.0f;
+
+  // What one input event costs: the dab, then patching the face view for upload
+  state.Run("inflate dab and view patch, 263k vertices", 1, [&] {
+    stroke.Dab(Vec3{x, 0, 0});
+    ranges.clear();
+    builder.PatchFaceView(view, model.ReshapedFaces(), ranges);
+    model.ResetDirtyFlags();
+    x = x < 3.0f ? x + 0.01f : -3.0f;
+    Bench::DoNotOptimize(ranges.data());
+  });
+
+  state.Run("stroke to undo delta", stroke.TouchedCount(), [&] {
+    const Sculpt::StrokeDelta delta = stroke.Finish();
+    Bench::DoNotOptimize(delta.bytes.data());
+  });
+}
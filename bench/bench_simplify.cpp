@@ -0,0 +1,23 @@
+#include <vector>
+
+#include "Bench.h"
+#include "Generators/Shapes.h"
+#include "Model/Model.h"
+#include "Simplify/Decimate.h"
+
+BENCHMARK(Decimation) {
+  // 1000 x 500 segment sphere: about a million triangles
+  Model model;
+  const MeshIds ids = model.AppendMesh(Generators::UvSphere(Vec3{2, 2, 2}, 1000, 500));
+  const std::size_t triangles = 1000 * 500 * 2;
+
+  state.Run("1M triangles to 100k", triangles, [&] {
+    const Simplify::Result result = Simplify::Decimate(model, ids.faces, {triangles / 10});
+    Bench::DoNotOptimize(result.mesh.positions.data());
+  });
+
+  state.Run("1M triangle LOD chain, 4 levels", triangles, [&] {
+    const Simplify::LodChain chain = Simplify::BuildLodChain(model, ids.faces, 4);
+    Bench::DoNotOptimize(chain.levels.data());
+  });
+}
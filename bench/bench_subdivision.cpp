@@ -0,0 +1,56 @@
+#include <array>
+#include <vector>
+
+#include "Bench.h"
+#include "Core/MeshData.h"
+#include "Model/Model.h"
+#include "Subdivision/CatmullClark.h"
+#include "Topology/EdgeTable.h"
+
+namespace {
+
+// side * side unit quads on a gently curved sheet
+MeshData Sheet(uint32_t side) {
+  MeshData mesh;
+  for (uint32_t y = 0; y <= side; ++y) {
+    for (uint32_t x = 0; x <= side; ++x) {
+      const float fx = static_cast<float>(x);
+      const float fy = static_cast<float>(y);
+      mesh.positions.push_back({fx, fy, 0.001f * (fx * fx + fy * fy)});
+    }
+  }
+
+  Topology::EdgeTable table(mesh.edges);
+  for (uint32_t y = 0; y < side; ++y) {
+    for (uint32_t x = 0; x < side; ++x) {
+      const uint32_t i = y * (side + 1) + x;
+      const std::array<uint32_t, 4> loop{i, i + 1, i + side + 2, i + side + 1};
+      Topology::AddFaceLoop(mesh, table, loop);
+    }
+  }
+  return mesh;
+}
+
+}  // namespace
+
+BENCHMARK(CatmullClark) {
+  Model model;
+  const MeshIds ids = model.AppendMesh(Sheet(316));  // ~100k faces
+  const std::size_t count = ids.faces.size();
+
+  state.Run("preview level 1", count, [&] {
+    FaceView view;
+    Subdivision::BuildPreview(model, ids.faces, 1, view);
+    Bench::DoNotOptimize(view.vertices.data());
+  });
+
+  state.Run("mesh level 1", count, [&] {
+    const auto result = Subdivision::CatmullClark(model, ids.faces, 1);
+    Bench::DoNotOptimize(result.mesh.positions.data());
+  });
+
+  state.Run("mesh level 2", count, [&] {
+    const auto result = Subdivision::CatmullClark(model, ids.faces, 2);
+    Bench::DoNotOptimize(result.mesh.positions.data());
+  });
+}
@@ -0,0 +1,137 @@
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include "Bench.h"
+#include "Core/Primitives.h"
+#include "Topology/Validation.h"
+#include "Utilities/SparseSet.h"
+
+namespace {
+
+// The hash map based checks validation used before it moved to scratch buffers,
+// kept as the per-call baseline
+template <typename EdgeContainer>
+bool LegacyIsValidFace(const Face& face, const EdgeContainer& edges) {
+  if (face.edges.size() < 3) return false;
+
+  std::unordered_map<VertexId, int> degree;
+  for (EdgeId eid : face.edges) {
+    const Edge& e = edges.Get(eid);
+    degree[e.a]++;
+    degree[e.b]++;
+  }
+  for (const auto& [_, count] : degree) {
+    if (count != 2) return false;
+  }
+  return Topology::ExtractVertices(face, edges).size() >= 3;
+}
+
+template <typename FaceContainer>
+bool LegacyIsValidVolume(const Volume& volume, const FaceContainer& faces) {
+  if (volume.faces.size() < 4) return false;
+
+  std::unordered_map<EdgeId, int> edgeUsage;
+  for (FaceId fid : volume.faces) {
+    for (EdgeId eid : faces.Get(fid).edges) edgeUsage[eid]++;
+  }
+  for (const auto& [_, count] : edgeUsage) {
+    if (count != 2) return false;
+  }
+  return true;
+}
+
+// Disjoint unit cubes: 12 edges, 6 quad faces and one volume each
+struct CubeField {
+  SparseSet<Edge> edges;
+  SparseSet<Face> faces;
+  std::vector<Face> faceCandidates;
+  std::vector<Volume> volumeCandidates;
+
+  explicit CubeField(std::size_t cubes) {
+    static constexpr std::array<std::array<uint32_t, 2>, 12> kEdges{{{0, 1},
+                                                                      {1, 2},
+                                                                      {2, 3},
+                                                                      {3, 0},
+                                                                      {4, 5},
+                                                                      {5, 6},
+                                                                      {6, 7},
+                                                                      {7, 4},
+                                                                      {0, 4},
+                                                                      {1, 5},
+                                                                      {2, 6},
+                                                                      {3, 7}}};
+    static constexpr std::array<std::array<uint32_t, 4>, 6> kFaces{{{0, 1, 2, 3},
+                                                                     {4, 5, 6, 7},
+                                                                     {0, 9, 4, 8},
+                                                                     {1, 10, 5, 9},
+                                                                     {2, 11, 6, 10},
+                                                                     {3, 8, 7, 11}}};
+
+    for (std::size_t c = 0; c < cubes; ++c) {
+      const auto vertexBase = static_cast<VertexId>(c * 8);
+      const auto edgeBase = static_cast<EdgeId>(c * 12);
+      for (const auto& e : kEdges) edges.Insert(Edge{vertexBase + e[0], vertexBase + e[1]});
+
+      Volume volume;
+      for (const auto& f : kFaces) {
+        Face face;
+        for (uint32_t e : f) face.edges.push_back(edgeBase + e);
+        faceCandidates.push_back(face);
+        volume.faces.push_back(faces.Insert(face));
+      }
+      volumeCandidates.push_back(std::move(volume));
+    }
+  }
+};
+
+}  // namespace
+
+BENCHMARK(ValidateFaces) {
+  const CubeField field(20000);
+  const std::size_t count = field.faceCandidates.size();
+
+  state.Run("legacy per call", count, [&] {
+    std::size_t valid = 0;
+    for (const Face& face : field.faceCandidates) valid += LegacyIsValidFace(face, field.edges);
+    Bench::DoNotOptimize(valid);
+  });
+
+  state.Run("scratch per call", count, [&] {
+    std::size_t valid = 0;
+    for (const Face& face : field.faceCandidates) valid += Topology::IsValidFace(face, field.edges);
+    Bench::DoNotOptimize(valid);
+  });
+
+  state.Run("batch", count, [&] {
+    const auto verdicts = Topology::CheckFaces(field.faceCandidates, field.edges);
+    Bench::DoNotOptimize(verdicts.data());
+  });
+}
+
+BENCHMARK(ValidateVolumes) {
+  const CubeField field(20000);
+  const std::size_t count = field.volumeCandidates.size();
+
+  state.Run("legacy per call (no winding)", count, [&] {
+    std::size_t valid = 0;
+    for (const Volume& volume : field.volumeCandidates) {
+      valid += LegacyIsValidVolume(volume, field.faces);
+    }
+    Bench::DoNotOptimize(valid);
+  });
+
+  state.Run("scratch per call", count, [&] {
+    std::size_t valid = 0;
+    for (const Volume& volume : field.volumeCandidates) {
+      valid += Topology::IsValidVolume(volume, field.faces, field.edges);
+    }
+    Bench::DoNotOptimize(valid);
+  });
+
+  state.Run("batch", count, [&] {
+    const auto verdicts =
+        Topology::CheckVolumes(field.volumeCandidates, field.faces, field.edges, false);
+    Bench::DoNotOptimize(verdicts.data());
+  });
+}
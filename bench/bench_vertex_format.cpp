@@ -0,0 +1,41 @@
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+#include "Generators/Shapes.h"
+#include "Model/Model.h"
+#include "ModelView/ModelViewBuilder.h"
+#include "Utilities/Vec3.h"
+
+BENCHMARK(QuantizedVertexFormat) {
+  // 2M triangles across a 100 unit sphere
+  Model model;
+  model.AppendMesh(Generators::UvSphere(Vec3{100, 100, 100}, 1024, 1024));
+  ModelViewBuilder builder(model);
+  FaceView faces;
+  builder.BuildFaceView(faces);
+  ModelViewBuilder::BuildChunks(faces);
+
+  QuantizedFaceView quantized;
+  ModelViewBuilder::BuildQuantized(faces, quantized);
+  const std::size_t vertices = faces.vertices.size();
+  const std::size_t floatBytes = vertices * (sizeof(Vec3) + sizeof(float));
+  const std::size_t quantizedBytes = quantized.Bytes() + quantized.chunkBoxes.size() * 4;
+  const std::string sizes = std::to_string(floatBytes >> 20) + " MB float, " +
+                            std::to_string(quantizedBytes >> 20) + " MB quantized, error " +
+                            std::to_string(quantized.maxError);
+
+  state.Run("quantize " + std::to_string(vertices) + " vertices, " + sizes, vertices, [&] {
+    ModelViewBuilder::BuildQuantized(faces, quantized);
+    Bench::DoNotOptimize(quantized.positions.data());
+  });
+
+  // What UpdateFaceIndices builds before the float upload
+  std::vector<float> ids;
+  state.Run("float ids for upload", vertices, [&] {
+    ids.clear();
+    ids.reserve(faces.primitiveIds.size());
+    for (uint32_t id : faces.primitiveIds) ids.push_back(static_cast<float>(id));
+    Bench::DoNotOptimize(ids.data());
+  });
+}
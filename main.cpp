@@ -1,5 +1,6 @@
 #include <iostream>
 #include <set>
+#include <vector>
 
 #include "App/Application.h"
 #include "App/Input.h"
@@ -55,15 +56,63 @@ void redo() {
   }
 }
 
+// Add a default sized primitive, by Generators::Shape index, from JavaScript
+void addShape(int shape) {
+  if (g_app && shape >= 0 && shape < Generators::kShapeCount) {
+    g_app->AddShape(Generators::DefaultParams(static_cast<Generators::Shape>(shape)));
+  }
+}
+
+// Revolve a face's loop by angle radians about the axis through origin from JavaScript
+void latheFace(int face, float ox, float oy, float oz, float ax, float ay, float az, float angle,
+               int segments) {
+  if (g_app && face >= 0 && segments > 0) {
+    g_app->LatheFace(static_cast<FaceId>(face), Vec3{ox, oy, oz}, Vec3{ax, ay, az}, angle,
+                     static_cast<uint32_t>(segments));
+  }
+}
+
+// Sweep a face's loop along a path given as a flat array of x, y, z from JavaScript
+void sweepFace(int face, const emscripten::val& coordinates) {
+  const std::vector<float> flat = emscripten::vecFromJSArray<float>(coordinates);
+  if (!g_app || face < 0 || flat.size() < 6) return;
+
+  std::vector<Vec3> path;
+  for (std::size_t i = 0; i + 2 < flat.size(); i += 3) {
+    path.push_back(Vec3{flat[i], flat[i + 1], flat[i + 2]});
+  }
+  g_app->SweepFace(static_cast<FaceId>(face), std::move(path));
+}
+
+// Loft between two faces with the same vertex count from JavaScript
+void loftFaces(int from, int to, int sections) {
+  if (g_app && from >= 0 && to >= 0 && sections > 0) {
+    g_app->LoftFaces(static_cast<FaceId>(from), static_cast<FaceId>(to),
+                     static_cast<uint32_t>(sections));
+  }
+}
+
+// Preview faces subdivided levels times (0 turns the preview off) from JavaScript
+void setSubdivisionPreview(int levels) {
+  if (g_app && levels >= 0) {
+    g_app->SetSubdivisionPreview(static_cast<uint32_t>(levels));
+  }
+}
+
 // Expose the functions to JavaScript using Embind
 EMSCRIPTEN_BINDINGS(my_module) {
   emscripten::function("debugButtonClick", &debug);
   emscripten::function("undo", &undo);
   emscripten::function("redo", &redo);
+  emscripten::function("addShape", &addShape);
+  emscripten::function("latheFace", &latheFace);
+  emscripten::function("sweepFace", &sweepFace);
+  emscripten::function("loftFaces", &loftFaces);
+  emscripten::function("setSubdivisionPreview", &setSubdivisionPreview);
 }
 #endif
 
-auto main() -> int {
+auto main(int argc, char** argv) -> int {
 #ifdef __EMSCRIPTEN__
   // For Emscripten, allocate on heap to ensure lifetime persists
   g_app = new Application();
@@ -92,6 +141,11 @@ auto main() -> int {
     return 1;
   }
 
+  // Any command line arguments are mesh files to import
+  for (int i = 1; i < argc; ++i) {
+    app.ImportMesh(argv[i]);
+  }
+
   std::cout << "application INITIALISED" << std::endl;
 
   int count = 0;
@@ -0,0 +1,224 @@
+#include "Analysis/MassProperties.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Geometry/Aabb.h"
+#include "Geometry/Triangulation.h"
+#include "Model/Model.h"
+#include "Utilities/JobSystem.h"
+#include "Utilities/Simd.h"
+
+namespace Analysis {
+
+namespace {
+
+constexpr std::size_t kFaceBatch = 2048;
+
+// Surface integrals of 1, x, y, z, x^2, y^2, z^2, xy, yz, zx (Eberly, "Polyhedral Mass
+// Properties"), then twice the area
+constexpr std::size_t kSumCount = 11;
+using Sums = std::array<double, kSumCount>;
+
+#ifdef CAD_SSE2
+// Two doubles with the arithmetic the integrand needs
+struct Lanes {
+  __m128d v;
+
+  static Lanes Load(const double* p) { return {_mm_loadu_pd(p)}; }
+  friend Lanes operator+(Lanes a, Lanes b) { return {_mm_add_pd(a.v, b.v)}; }
+  friend Lanes operator-(Lanes a, Lanes b) { return {_mm_sub_pd(a.v, b.v)}; }
+  friend Lanes operator*(Lanes a, Lanes b) { return {_mm_mul_pd(a.v, b.v)}; }
+  friend Lanes Sqrt(Lanes a) { return {_mm_sqrt_pd(a.v)}; }
+};
+#endif
+
+double Sqrt(double a) { return std::sqrt(a); }
+
+// Power sums of one coordinate over a triangle's corners
+template <typename T>
+struct Subexpressions {
+  T f1, f2, f3, g0, g1, g2;
+
+  Subexpressions(T w0, T w1, T w2) {
+    const T temp0 = w0 + w1;
+    f1 = temp0 + w2;
+    const T temp1 = w0 * w0;
+    const T temp2 = temp1 + w1 * temp0;
+    f2 = temp2 + w2 * f1;
+    f3 = w0 * temp1 + w1 * temp2 + w2 * f2;
+    g0 = f2 + w0 * (f1 + w0);
+    g1 = f2 + w1 * (f1 + w1);
+    g2 = f2 + w2 * (f1 + w2);
+  }
+};
+
+// Corners as separate coordinate arrays: x0, y0, z0, x1, ... z2
+template <typename T>
+void Integrate(const T (&p)[9], T (&sums)[kSumCount]) {
+  const T e1x = p[3] - p[0], e1y = p[4] - p[1], e1z = p[5] - p[2];
+  const T e2x = p[6] - p[0], e2y = p[7] - p[1], e2z = p[8] - p[2];
+  const T dx = e1y * e2z - e1z * e2y;
+  const T dy = e1z * e2x - e1x * e2z;
+  const T dz = e1x * e2y - e1y * e2x;
+
+  const Subexpressions<T> x(p[0], p[3], p[6]);
+  const Subexpressions<T> y(p[1], p[4], p[7]);
+  const Subexpressions<T> z(p[2], p[5], p[8]);
+
+  sums[0] = sums[0] + dx * x.f1;
+  sums[1] = sums[1] + dx * x.f2;
+  sums[2] = sums[2] + dy * y.f2;
+  sums[3] = sums[3] + dz * z.f2;
+  sums[4] = sums[4] + dx * x.f3;
+  sums[5] = sums[5] + dy * y.f3;
+  sums[6] = sums[6] + dz * z.f3;
+  sums[7] = sums[7] + dx * (p[1] * x.g0 + p[4] * x.g1 + p[7] * x.g2);
+  sums[8] = sums[8] + dy * (p[2] * y.g0 + p[5] * y.g1 + p[8] * y.g2);
+  sums[9] = sums[9] + dz * (p[0] * z.g0 + p[3] * z.g1 + p[6] * z.g2);
+  sums[10] = sums[10] + Sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// Triangles of a batch of faces, corners relative to the origin of the integration
+struct TriangleBatch {
+  std::vector<double> coords[9];
+
+  std::size_t Size() const { return coords[0].size(); }
+
+  void Clear() {
+    for (auto& c : coords) c.clear();
+  }
+};
+
+void Gather(const Model& model, std::span<const FaceId> faces, const Vec3& origin,
+            TriangleBatch& out) {
+  std::vector<Vec3> points;
+  std::vector<uint32_t> corners;
+  for (FaceId id : faces) {
+    if (!model.ContainsFace(id)) continue;
+    const auto loop = model.FaceLoop(id);
+    if (loop.size() < 3) continue;
+
+    points.clear();
+    for (VertexId vid : loop) points.push_back(model.GetVertex(vid).position);
+    corners.clear();
+    Geometry::TriangulatePolygon(points, model.FaceNormal(id), corners);
+    for (std::size_t c = 0; c < corners.size(); ++c) {
+      const Vec3& p = points[corners[c]];
+      const std::size_t k = 3 * (c % 3);
+      out.coords[k].push_back(static_cast<double>(p.x) - origin.x);
+      out.coords[k + 1].push_back(static_cast<double>(p.y) - origin.y);
+      out.coords[k + 2].push_back(static_cast<double>(p.z) - origin.z);
+    }
+  }
+}
+
+Sums Accumulate(const TriangleBatch& batch) {
+  const std::size_t count = batch.Size();
+  std::size_t i = 0;
+  Sums total{};
+
+#ifdef CAD_SSE2
+  Lanes sums[kSumCount];
+  for (auto& s : sums) s = {_mm_setzero_pd()};
+  for (; i + 2 <= count; i += 2) {
+    Lanes p[9];
+    for (int k = 0; k < 9; ++k) p[k] = Lanes::Load(batch.coords[k].data() + i);
+    Integrate(p, sums);
+  }
+  for (std::size_t s = 0; s < kSumCount; ++s) {
+    double lanes[2];
+    _mm_storeu_pd(lanes, sums[s].v);
+    total[s] = lanes[0] + lanes[1];
+  }
+#endif
+
+  double tail[kSumCount] = {};
+  for (; i < count; ++i) {
+    double p[9];
+    for (int k = 0; k < 9; ++k) p[k] = batch.coords[k][i];
+    Integrate(p, tail);
+  }
+  for (std::size_t s = 0; s < kSumCount; ++s) total[s] += tail[s];
+  return total;
+}
+
+MassProperties Finish(const Sums& sums, const Vec3& origin) {
+  MassProperties result;
+  result.area = sums[10] * 0.5;
+
+  const double volume = sums[0] / 6.0;
+  result.volume = volume;
+  if (!(std::abs(volume) > 0.0)) {
+    result.centroid = origin;
+    return result;
+  }
+
+  const double cx = sums[1] / 24.0 / volume;
+  const double cy = sums[2] / 24.0 / volume;
+  const double cz = sums[3] / 24.0 / volume;
+  const double xx = sums[4] / 60.0;
+  const double yy = sums[5] / 60.0;
+  const double zz = sums[6] / 60.0;
+  const double xy = sums[7] / 120.0;
+  const double yz = sums[8] / 120.0;
+  const double zx = sums[9] / 120.0;
+
+  // About the origin, then moved to the centroid (parallel axis theorem)
+  result.inertia[0] = yy + zz - volume * (cy * cy + cz * cz);
+  result.inertia[1] = zz + xx - volume * (cz * cz + cx * cx);
+  result.inertia[2] = xx + yy - volume * (cx * cx + cy * cy);
+  result.inertia[3] = -(xy - volume * cx * cy);
+  result.inertia[4] = -(yz - volume * cy * cz);
+  result.inertia[5] = -(zx - volume * cz * cx);
+  result.centroid = Vec3(static_cast<float>(cx + origin.x), static_cast<float>(cy + origin.y),
+                         static_cast<float>(cz + origin.z));
+  return result;
+}
+
+}  // namespace
+
+MassProperties Compute(const Model& model, std::span<const FaceId> faces) {
+  // Integrating about a point inside the bounds keeps the coordinates small, so the
+  // cubic terms do not lose the digits that matter to cancellation
+  Geometry::Aabb bounds;
+  for (FaceId id : faces) {
+    if (model.ContainsFace(id)) bounds.Expand(model.FaceBounds(id));
+  }
+  const Vec3 origin = bounds.IsEmpty() ? Vec3{} : bounds.Center();
+
+  // Fixed batches summed in order, so the result does not depend on scheduling
+  const std::size_t batchCount = (faces.size() + kFaceBatch - 1) / kFaceBatch;
+  std::vector<Sums> partial(batchCount);
+  Jobs::ParallelFor(batchCount, 1, [&](std::size_t begin, std::size_t end) {
+    TriangleBatch batch;
+    for (std::size_t b = begin; b < end; ++b) {
+      batch.Clear();
+      const std::size_t first = b * kFaceBatch;
+      Gather(model, faces.subspan(first, std::min(kFaceBatch, faces.size() - first)), origin,
+             batch);
+      partial[b] = Accumulate(batch);
+    }
+  });
+
+  Sums total{};
+  for (const Sums& sums : partial) {
+    for (std::size_t s = 0; s < kSumCount; ++s) total[s] += sums[s];
+  }
+  return Finish(total, origin);
+}
+
+std::vector<MassProperties> ComputeVolumes(const Model& model,
+                                           std::span<const VolumeId> volumes) {
+  std::vector<MassProperties> results(volumes.size());
+  Jobs::ParallelFor(volumes.size(), 1, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      if (model.ContainsVolume(volumes[i])) {
+        results[i] = Compute(model, model.GetVolume(volumes[i]).faces);
+      }
+    }
+  });
+  return results;
+}
+
+}  // namespace Analysis
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <span>
+#include <vector>
+
+#include "Core/Primitives.h"
+#include "Utilities/Vec3.h"
+
+class Model;
+
+// Volume, surface area, centroid and inertia of closed face sets. The divergence
+// theorem turns each volume integral into a sum over the triangulated faces, so a
+// volume costs one pass over its triangles; the per-triangle terms are accumulated in
+// double precision, two triangles at a time with SSE2 where available.
+namespace Analysis {
+
+struct MassProperties {
+  // Enclosed volume, positive when the faces are wound outward
+  double volume = 0.0;
+  double area = 0.0;
+  Vec3 centroid;
+
+  // Inertia tensor about the centroid for unit density (scale by the density for real
+  // material): xx, yy, zz, then xy, yz, xz. Off-diagonal entries are the negated
+  // products of inertia, so the tensor is symmetric [[xx xy xz] [xy yy yz] [xz yz zz]].
+  std::array<double, 6> inertia{};
+};
+
+// Integrate over the given faces, which should bound a solid; faces that are missing or
+// have no valid loop are skipped. Large face sets are split across the job pool.
+MassProperties Compute(const Model& model, std::span<const FaceId> faces);
+
+// One result per volume, computed in parallel; missing volumes give zeros
+std::vector<MassProperties> ComputeVolumes(const Model& model,
+                                           std::span<const VolumeId> volumes);
+
+}  // namespace Analysis
@@ -0,0 +1,60 @@
+#include "Analysis/MassPropertiesCache.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "Model/Model.h"
+
+namespace Analysis {
+
+void MassPropertiesCache::Update() {
+  if (entries_.empty()) return;
+  const VolumeChanges changes(model_);
+  if (!changes.Any()) return;
+
+  std::erase_if(entries_, [&](const auto& item) {
+    const auto& [volume, entry] = item;
+    return changes.Changed(volume, entry.stamp);
+  });
+}
+
+const MassProperties& MassPropertiesCache::Get(VolumeId volume) {
+  static const MassProperties kNone;
+  if (!model_.ContainsVolume(volume)) return kNone;
+
+  // Edits made since the last Update are still in the dirty flags; until the flags are
+  // reset a volume they touch is recomputed on every lookup
+  auto it = entries_.find(volume);
+  if (it != entries_.end() && VolumeChanges(model_).Changed(volume, it->second.stamp)) {
+    entries_.erase(it);
+    it = entries_.end();
+  }
+  if (it == entries_.end()) {
+    VolumeStamp stamp(model_, model_.GetVolume(volume).faces);
+    MassProperties properties = Compute(model_, stamp.Faces());
+    it = entries_.emplace(volume, Entry{std::move(stamp), properties}).first;
+  }
+  return it->second.properties;
+}
+
+void MassPropertiesCache::Prefetch(std::span<const VolumeId> volumes) {
+  const VolumeChanges changes(model_);
+  std::vector<VolumeId> missing;
+  for (VolumeId volume : volumes) {
+    if (!model_.ContainsVolume(volume)) continue;
+    const auto it = entries_.find(volume);
+    if (it == entries_.end() || changes.Changed(volume, it->second.stamp)) {
+      missing.push_back(volume);
+    }
+  }
+  std::sort(missing.begin(), missing.end());
+  missing.erase(std::unique(missing.begin(), missing.end()), missing.end());
+
+  const std::vector<MassProperties> properties = ComputeVolumes(model_, missing);
+  for (std::size_t i = 0; i < missing.size(); ++i) {
+    Entry entry{VolumeStamp(model_, model_.GetVolume(missing[i]).faces), properties[i]};
+    entries_.insert_or_assign(missing[i], std::move(entry));
+  }
+}
+
+}  // namespace Analysis
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <unordered_map>
+
+#include "Analysis/MassProperties.h"
+#include "Core/Primitives.h"
+#include "Model/VolumeChanges.h"
+
+class Model;
+
+namespace Analysis {
+
+// Mass properties per volume, kept until one of the volume's faces or vertices
+// changes. Update must see every frame's edits, so call it before the model's dirty
+// flags are reset. Lookups check the pending edits too, so they never return stale
+// values, and are free for unchanged volumes.
+class MassPropertiesCache {
+ public:
+  explicit MassPropertiesCache(const Model& model) : model_(model) {}
+
+  // Drop the entries of volumes whose face list, loops or vertex positions changed
+  void Update();
+
+  // Properties of a volume, computed now when not cached; zeros for missing volumes
+  const MassProperties& Get(VolumeId volume);
+
+  // Compute every uncached volume of the list in parallel
+  void Prefetch(std::span<const VolumeId> volumes);
+
+  std::size_t CachedCount() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    VolumeStamp stamp;  // the volume's faces when computed
+    MassProperties properties;
+  };
+
+  const Model& model_;
+  std::unordered_map<VolumeId, Entry> entries_;
+};
+
+}  // namespace Analysis
@@ -1,73 +1,198 @@
 #include "App/Application.h"
 
-#include <array>
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <iostream>
 
+#include "Export/MeshExporter.h"
+#include "Import/MeshImporter.h"
+#include "Model/ModelFile.h"
+#include "Utilities/JobSystem.h"
 #include "Utilities/Mat4.h"
 #include "Utilities/Vec3.h"
 
+namespace {
+
+constexpr const char* kSessionSnapshotPath = "cad_session.snapshot";
+constexpr const char* kSessionJournalPath = "cad_session.journal";
+
+// The volume still has the faces, loops and vertex positions it had in the snapshot
+bool SameVolume(const Model& model, const Model& snapshot, VolumeId volume) {
+  if (!model.ContainsVolume(volume)) return false;
+  const std::vector<FaceId>& faces = snapshot.GetVolume(volume).faces;
+  if (model.GetVolume(volume).faces != faces) return false;
+
+  for (FaceId face : faces) {
+    if (!model.ContainsFace(face)) return false;
+    const auto loop = model.FaceLoop(face);
+    const auto before = snapshot.FaceLoop(face);
+    if (!std::equal(loop.begin(), loop.end(), before.begin(), before.end())) return false;
+
+    for (VertexId v : loop) {
+      const Vec3& a = model.GetVertex(v).position;
+      const Vec3& b = snapshot.GetVertex(v).position;
+      if (a.x != b.x || a.y != b.y || a.z != b.z) return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 Application::Application()
     : commandStack_(model),
+      massProperties_(model),
       device(),
       renderer(device, model),
-      inputHandler(commandStack_, renderer.GetCamera()) {}
+      inputHandler(commandStack_, renderer.GetCamera(), model, renderer.GetPreviewOverlay()) {}
 
 Application::~Application() = default;
 
 bool Application::Start() {
-  // Create a simple cube - make it bigger
-  auto v0 = model.CreateVertex(Vec3{-1.0, -1.0, -1.0});
-  auto v1 = model.CreateVertex(Vec3{1.0, -1.0, -1.0});
-  auto v2 = model.CreateVertex(Vec3{1.0, 1.0, -1.0});
-  auto v3 = model.CreateVertex(Vec3{-1.0, 1.0, -1.0});
-  auto v4 = model.CreateVertex(Vec3{-1.0, -1.0, 1.0});
-  auto v5 = model.CreateVertex(Vec3{1.0, -1.0, 1.0});
-  auto v6 = model.CreateVertex(Vec3{1.0, 1.0, 1.0});
-  auto v7 = model.CreateVertex(Vec3{-1.0, 1.0, 1.0});
-
-  // Create edges for the cube
-  auto e0 = *model.CreateEdge(v0, v1);
-  auto e1 = *model.CreateEdge(v1, v2);
-  auto e2 = *model.CreateEdge(v2, v3);
-  auto e3 = *model.CreateEdge(v3, v0);
-  auto e4 = *model.CreateEdge(v4, v5);
-  auto e5 = *model.CreateEdge(v5, v6);
-  auto e6 = *model.CreateEdge(v6, v7);
-  auto e7 = *model.CreateEdge(v7, v4);
-  auto e8 = *model.CreateEdge(v0, v4);
-  auto e9 = *model.CreateEdge(v1, v5);
-  auto e10 = *model.CreateEdge(v2, v6);
-  auto e11 = *model.CreateEdge(v3, v7);
-
-  // Create faces
-  std::array<EdgeId, 4> bottomEdges = {e0, e1, e2, e3};
-  model.CreateFace(bottomEdges);
-
-  std::array<EdgeId, 4> topEdges = {e4, e5, e6, e7};
-  model.CreateFace(topEdges);
-
-  std::array<EdgeId, 4> frontEdges = {e0, e9, e4, e8};
-  model.CreateFace(frontEdges);
-
-  std::array<EdgeId, 4> rightEdges = {e1, e10, e5, e9};
-  model.CreateFace(rightEdges);
-
-  std::array<EdgeId, 4> backEdges = {e2, e11, e6, e10};
-  model.CreateFace(backEdges);
-
-  std::array<EdgeId, 4> leftEdges = {e3, e8, e7, e11};
-  model.CreateFace(leftEdges);
+  if (!RecoverSession()) CreateDefaultScene();
 
   ctx.viewportWidth = 800;
   ctx.viewportHeight = 600;
 
+  StartJournal();
+
+  return true;
+}
+
+void Application::CreateDefaultScene() {
+  // Not a command: the starting scene is not something to undo
+  model.AppendMesh(Generators::Box(Vec3{2, 2, 2}));
+}
+
+bool Application::ImportMesh(const std::string& path) {
+  Import::Result result = Import::ImportFile(path);
+  if (!result.Ok()) {
+    std::cerr << "Import failed: " << result.message << std::endl;
+    return false;
+  }
+
+  std::cout << "Imported " << path << ": " << result.mesh.positions.size() << " vertices, "
+            << result.mesh.FaceCount() << " faces, " << result.mesh.VolumeCount() << " volumes"
+            << std::endl;
+  commandStack_.Do<AppendMeshCommand>(std::move(result.mesh));
   return true;
 }
 
+void Application::AddShape(const Generators::ShapeParams& params) {
+  commandStack_.Do<GenerateShapeCommand>(params);
+}
+
+void Application::LatheFace(FaceId face, const Vec3& origin, const Vec3& axis, float angle,
+                            uint32_t segments) {
+  if (model.ContainsFace(face)) {
+    commandStack_.Do<LatheCommand>(face, origin, axis, angle, segments);
+  }
+}
+
+void Application::SweepFace(FaceId face, std::vector<Vec3> path) {
+  if (model.ContainsFace(face)) commandStack_.Do<SweepCommand>(face, std::move(path));
+}
+
+void Application::LoftFaces(FaceId from, FaceId to, uint32_t sections) {
+  if (model.ContainsFace(from) && model.ContainsFace(to)) {
+    commandStack_.Do<LoftCommand>(from, to, sections);
+  }
+}
+
+void Application::SetSubdivisionPreview(uint32_t levels) {
+  renderer.SetSubdivisionPreview(std::min(levels, kMaxSubdivisionPreview));
+}
+
+void Application::BeginSculptStroke(const Sculpt::BrushSettings& settings) {
+  EndSculptStroke();
+  stroke_.emplace(model, settings);
+}
+
+void Application::SculptDab(const Vec3& center, const Vec3& drag) {
+  if (stroke_) stroke_->Dab(center, drag);
+}
+
+void Application::EndSculptStroke() {
+  if (!stroke_) return;
+
+  Sculpt::StrokeDelta delta = stroke_->Finish();
+  stroke_.reset();
+  if (delta.vertexCount > 0) commandStack_.Do<SculptStrokeCommand>(std::move(delta), true);
+}
+
+bool Application::CombineVolumes(VolumeId a, VolumeId b, Csg::Operation operation) {
+  std::optional<MeshData> mesh = Csg::Combine(model, a, b, operation);
+  if (!mesh) {
+    std::cerr << "Boolean failed: volumes " << a << " and " << b
+              << " must be distinct, closed and consistently wound" << std::endl;
+    return false;
+  }
+
+  commandStack_.Do<BooleanCommand>(a, b, operation, std::move(mesh));
+  return true;
+}
+
+void Application::SimplifyVolume(VolumeId volume, const Simplify::Options& options) {
+  if (!model.ContainsVolume(volume)) return;
+
+  const uint64_t ticket = nextSimplifyTicket_++;
+  auto snapshot = model.Snapshot();
+  pendingSimplify_.push_back({ticket, volume, options, snapshot});
+
+  // Decimating a large volume takes seconds, so a worker reads the snapshot while
+  // editing carries on
+  Jobs::Submit([snapshot = std::move(snapshot), volume, options, ticket, inbox = simplifyInbox_] {
+    const std::vector<FaceId>& faces = snapshot->GetVolume(volume).faces;
+    MeshData mesh = Simplify::Decimate(*snapshot, faces, options).mesh;
+    std::lock_guard lock(inbox->mutex);
+    inbox->deliveries.emplace_back(ticket, std::move(mesh));
+  });
+}
+
+void Application::CollectSimplified() {
+  std::vector<std::pair<uint64_t, MeshData>> deliveries;
+  {
+    std::lock_guard lock(simplifyInbox_->mutex);
+    deliveries.swap(simplifyInbox_->deliveries);
+  }
+
+  for (auto& [ticket, mesh] : deliveries) {
+    const auto pending =
+        std::find_if(pendingSimplify_.begin(), pendingSimplify_.end(),
+                     [ticket](const PendingSimplify& p) { return p.ticket == ticket; });
+    if (pending == pendingSimplify_.end()) continue;
+
+    const PendingSimplify request = std::move(*pending);
+    pendingSimplify_.erase(pending);
+    if (mesh.Empty() || !SameVolume(model, *request.snapshot, request.volume)) {
+      std::cerr << "Simplify of volume " << request.volume
+                << " dropped: the volume changed while it ran" << std::endl;
+      continue;
+    }
+    commandStack_.Do<DecimateCommand>(request.volume, request.options, std::move(mesh));
+  }
+}
+
+void Application::ExportMesh(const std::string& path) const {
+  // Write from a snapshot so editing can continue while the file is produced
+  Jobs::Submit([snapshot = model.Snapshot(), path] {
+    Export::Result result = Export::ExportFile(*snapshot, path);
+    if (!result.Ok()) {
+      std::cerr << "Export failed: " << result.message << std::endl;
+      return;
+    }
+
+    std::cout << "Exported " << result.triangleCount << " triangles to " << path << std::endl;
+  });
+}
+
 void Application::Debug() {
   ctx.debug = !ctx.debug;
   renderer.MarkDirty();
+  std::cout << "Input to photon: " << inputLatency_.AverageMilliseconds() << " ms average, "
+            << inputLatency_.MaxMilliseconds() << " ms max over " << inputLatency_.Count()
+            << " frames" << std::endl;
 }
 
 bool Application::Run() {
@@ -77,15 +202,64 @@ bool Application::Run() {
   }
 
   device.CaptureFrameContext(ctx);
-  device.CaptureInput(input);
-  inputHandler.HandleInput(input);
+  inputHandler.HandleInput(device.GetInputEvents(), input);
+  CollectSimplified();
 
   renderer.ProcessPendingUpdates(ctx, input);
-  renderer.Render(ctx);
+  const bool presented = renderer.Render(ctx);
+  if (const auto firstEvent = input.FirstEventTime(); presented && firstEvent) {
+    inputLatency_.Add(std::chrono::steady_clock::now() - *firstEvent);
+  }
 
+  // Caches keyed on volumes see this frame's edits before the flags go
+  massProperties_.Update();
   model.ResetDirtyFlags();
 
   return true;
 }
 
-bool Application::Exit() { return true; }
\ No newline at end of file
+bool Application::Exit() {
+#ifndef __EMSCRIPTEN__
+  // A clean shutdown needs no recovery
+  commandStack_.SetJournal(nullptr);
+  journal_.Close();
+  std::remove(kSessionJournalPath);
+  std::remove(kSessionSnapshotPath);
+#endif
+  return true;
+}
+
+// -------------------------------------------------
+// Crash recovery
+// -------------------------------------------------
+
+bool Application::RecoverSession() {
+#ifdef __EMSCRIPTEN__
+  return false;
+#else
+  const auto generation = ModelFile::Load(model, kSessionSnapshotPath);
+  if (!generation) return false;
+  sessionGeneration_ = *generation;
+
+  const auto replay = CommandJournal::Replay(kSessionJournalPath, *generation, commandStack_);
+  std::cout << "Recovered previous session: replayed " << replay.records << " commands"
+            << (replay.truncatedTail ? " (journal tail was incomplete)" : "") << std::endl;
+
+  // Recovered work is folded into the next snapshot, so it can no longer be undone
+  commandStack_.Clear();
+  return true;
+#endif
+}
+
+void Application::StartJournal() {
+#ifndef __EMSCRIPTEN__
+  // Snapshot first: a journal only applies on top of the snapshot of its generation
+  ++sessionGeneration_;
+  if (!ModelFile::Save(model, kSessionSnapshotPath, sessionGeneration_) ||
+      !journal_.Open(kSessionJournalPath, sessionGeneration_)) {
+    std::cerr << "Failed to start session journal; crash recovery is disabled" << std::endl;
+    return;
+  }
+  commandStack_.SetJournal(&journal_);
+#endif
+}
\ No newline at end of file
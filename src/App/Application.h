@@ -1,12 +1,27 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Analysis/MassPropertiesCache.h"
+#include "App/Commands/CommandJournal.h"
 #include "App/Commands/CommandStack.h"
 #include "App/Input.h"
 #include "App/InputHandler.h"
+#include "App/InputLatency.h"
+#include "Csg/Boolean.h"
+#include "Generators/Shapes.h"
 #include "Model/Model.h"
 #include "Rendering/Devices/RenderDevice.h"
 #include "Rendering/FrameContext.h"
 #include "Rendering/Renderer.h"
+#include "Sculpt/Stroke.h"
+#include "Simplify/Decimate.h"
 
 class Application {
  public:
@@ -17,15 +32,85 @@ class Application {
   bool Run();
   bool Exit();
 
+  // Load a mesh file into the model as a single undoable command
+  bool ImportMesh(const std::string& path);
+
+  // Generate a procedural shape into the model as a single undoable command
+  void AddShape(const Generators::ShapeParams& params);
+
+  // Build a solid from a face's vertex loop as a single undoable command: revolved
+  // about an axis, swept along a path starting at the face, or lofted to a second face
+  // with the same vertex count. The faces themselves are left in place.
+  void LatheFace(FaceId face, const Vec3& origin, const Vec3& axis, float angle,
+                 uint32_t segments);
+  void SweepFace(FaceId face, std::vector<Vec3> path);
+  void LoftFaces(FaceId from, FaceId to, uint32_t sections);
+
+  // Draw faces as their Catmull-Clark limit approximation, levels deep (0 shows the
+  // cage). Clamped to kMaxSubdivisionPreview since each level quadruples the faces.
+  static constexpr uint32_t kMaxSubdivisionPreview = 4;
+  void SetSubdivisionPreview(uint32_t levels);
+
+  // Sculpt the model live; the whole stroke becomes one undoable command when it ends.
+  // drag is the cursor movement since the previous dab (used by the grab brush).
+  void BeginSculptStroke(const Sculpt::BrushSettings& settings);
+  void SculptDab(const Vec3& center, const Vec3& drag = Vec3{});
+  void EndSculptStroke();
+
+  // Replace two volumes with their union, difference or intersection as a single
+  // undoable command. Fails, leaving the undo stack alone, when Csg::Combine does.
+  bool CombineVolumes(VolumeId a, VolumeId b, Csg::Operation operation);
+
+  // Replace a volume with a decimated copy as a single undoable command. Decimation runs
+  // on a worker from a snapshot and the command is pushed by a later Run; editing the
+  // volume in the meantime drops the result.
+  void SimplifyVolume(VolumeId volume, const Simplify::Options& options);
+
+  // Volume, area, centroid and inertia of a volume, cached until it is edited
+  const Analysis::MassProperties& GetMassProperties(VolumeId volume) {
+    return massProperties_.Get(volume);
+  }
+
+  // Write the model's faces to an OBJ or STL file on a background thread
+  void ExportMesh(const std::string& path) const;
+
   CommandStack& GetCommandStack() { return commandStack_; }
   Input& GetInput() { return input; }
+  const InputLatency& GetInputLatency() const { return inputLatency_; }
 
  private:
+  void CreateDefaultScene();
+
+  // Restore the last snapshot plus its journal after an unclean shutdown
+  bool RecoverSession();
+  void StartJournal();
+
+  // Decimations running on workers, handed back to the main thread for their command
+  struct PendingSimplify {
+    uint64_t ticket = 0;
+    VolumeId volume = 0;
+    Simplify::Options options;
+    std::shared_ptr<const Model> snapshot;  // what the worker decimated
+  };
+  struct SimplifyInbox {
+    std::mutex mutex;
+    std::vector<std::pair<uint64_t, MeshData>> deliveries;
+  };
+  void CollectSimplified();
+
   Model model;
   CommandStack commandStack_;
+  CommandJournal journal_;
+  uint64_t sessionGeneration_ = 0;
+  Analysis::MassPropertiesCache massProperties_;
   RenderDevice device;
   Renderer renderer;
   FrameContext ctx;
   Input input;
   InputHandler inputHandler;
+  InputLatency inputLatency_;
+  std::optional<Sculpt::Stroke> stroke_;
+  std::vector<PendingSimplify> pendingSimplify_;
+  std::shared_ptr<SimplifyInbox> simplifyInbox_ = std::make_shared<SimplifyInbox>();
+  uint64_t nextSimplifyTicket_ = 1;
 };
\ No newline at end of file
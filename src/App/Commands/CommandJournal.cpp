@@ -0,0 +1,309 @@
+#include "CommandJournal.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include "CommandSerialization.h"
+#include "CommandStack.h"
+#include "Utilities/BinaryStream.h"
+#include "Utilities/MappedFile.h"
+
+namespace {
+
+constexpr char kMagic[4] = {'C', 'A', 'D', 'J'};
+constexpr uint32_t kVersion = 1;
+constexpr std::size_t kHeaderSize = sizeof(kMagic) + sizeof(uint32_t) + sizeof(uint64_t);
+
+// Each record: payload size, payload checksum, payload (op byte + command)
+constexpr std::size_t kRecordHeaderSize = 2 * sizeof(uint32_t);
+
+}  // namespace
+
+// -------------------------------------------------
+// Lifetime
+// -------------------------------------------------
+
+CommandJournal::CommandJournal(JournalOptions options) : options_(options) {}
+
+CommandJournal::~CommandJournal() { Close(); }
+
+bool CommandJournal::Open(const std::string& path, uint64_t generation) {
+  Close();
+
+  fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd_ < 0) return false;
+
+  std::vector<char> header;
+  BinaryWriter writer(header);
+  writer.Write(kMagic);
+  writer.Write(kVersion);
+  writer.Write(generation);
+
+  if (!WriteAll(header.data(), header.size()) || !Sync()) {
+    ::close(fd_);
+    fd_ = -1;
+    return false;
+  }
+
+  pending_.clear();
+  appendedSeq_ = writtenSeq_ = syncedSeq_ = 0;
+  flushRequested_ = stop_ = failed_ = false;
+
+#ifndef __EMSCRIPTEN__
+  writer_ = std::thread(&CommandJournal::WriterLoop, this);
+#endif
+  return true;
+}
+
+void CommandJournal::Close() {
+  if (fd_ < 0) return;
+
+  Flush();
+
+#ifndef __EMSCRIPTEN__
+  {
+    std::lock_guard lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  writer_.join();
+#endif
+
+  ::close(fd_);
+  fd_ = -1;
+}
+
+bool CommandJournal::Ok() const {
+  std::lock_guard lock(mutex_);
+  return !failed_;
+}
+
+// -------------------------------------------------
+// Recording
+// -------------------------------------------------
+
+void CommandJournal::RecordDo(const Command& command) { Append(Op::Do, &command); }
+
+void CommandJournal::RecordUndo() { Append(Op::Undo, nullptr); }
+
+void CommandJournal::RecordRedo() { Append(Op::Redo, nullptr); }
+
+void CommandJournal::RecordClear() { Append(Op::Clear, nullptr); }
+
+void CommandJournal::Append(Op op, const Command* command) {
+  if (fd_ < 0) return;
+
+  // Serialise up front: the command is moved into the undo stack right after this
+  std::vector<char> record(kRecordHeaderSize);
+  BinaryWriter writer(record);
+  writer.Write(op);
+  if (command) SerializeCommand(*command, record);
+
+  const std::string_view payload(record.data() + kRecordHeaderSize,
+                                 record.size() - kRecordHeaderSize);
+  const auto size = static_cast<uint32_t>(payload.size());
+  const uint32_t checksum = Checksum(payload);
+  std::memcpy(record.data(), &size, sizeof(size));
+  std::memcpy(record.data() + sizeof(size), &checksum, sizeof(checksum));
+
+  std::lock_guard lock(mutex_);
+  if (failed_) return;
+
+#ifdef __EMSCRIPTEN__
+  // No worker threads: write through
+  ++appendedSeq_;
+  if (!WriteAll(record.data(), record.size()) ||
+      (options_.fsync == FsyncPolicy::EveryCommit && !Sync())) {
+    failed_ = true;
+  }
+  writtenSeq_ = appendedSeq_;
+#else
+  pending_.insert(pending_.end(), record.begin(), record.end());
+  ++appendedSeq_;
+  wake_.notify_one();
+#endif
+}
+
+bool CommandJournal::Flush() {
+  if (fd_ < 0) return false;
+
+#ifdef __EMSCRIPTEN__
+  std::lock_guard lock(mutex_);
+  if (options_.fsync != FsyncPolicy::Never && !Sync()) failed_ = true;
+  return !failed_;
+#else
+  std::unique_lock lock(mutex_);
+  const uint64_t target = appendedSeq_;
+  flushRequested_ = true;
+  wake_.notify_one();
+
+  written_.wait(lock, [&] {
+    return failed_ || (writtenSeq_ >= target &&
+                       (options_.fsync == FsyncPolicy::Never || syncedSeq_ >= target));
+  });
+  return !failed_;
+#endif
+}
+
+// -------------------------------------------------
+// Writer thread
+// -------------------------------------------------
+
+void CommandJournal::WriterLoop() {
+  using Clock = std::chrono::steady_clock;
+
+  auto lastSync = Clock::now();
+  auto hasWork = [&] { return stop_ || flushRequested_ || !pending_.empty(); };
+
+  std::unique_lock lock(mutex_);
+  for (;;) {
+    if (!hasWork()) {
+      const bool syncDue = options_.fsync == FsyncPolicy::Periodic && syncedSeq_ < writtenSeq_;
+      if (syncDue) {
+        wake_.wait_until(lock, lastSync + options_.fsyncInterval, hasWork);
+      } else {
+        wake_.wait(lock, hasWork);
+      }
+    }
+    if (stop_ && pending_.empty()) break;
+
+    // Group commit: let closely spaced records join this write
+    if (!pending_.empty() && !flushRequested_ && !stop_ && options_.commitWindow.count() > 0) {
+      wake_.wait_for(lock, options_.commitWindow, [&] { return stop_ || flushRequested_; });
+    }
+
+    std::vector<char> batch;
+    batch.swap(pending_);
+    const uint64_t seq = appendedSeq_;
+    const uint64_t alreadySynced = syncedSeq_;
+    const bool urgent = flushRequested_ || stop_;
+    lock.unlock();
+
+    bool ok = batch.empty() || WriteAll(batch.data(), batch.size());
+
+    bool synced = false;
+    if (ok && options_.fsync != FsyncPolicy::Never && seq > alreadySynced) {
+      const auto now = Clock::now();
+      if (options_.fsync == FsyncPolicy::EveryCommit || urgent ||
+          now - lastSync >= options_.fsyncInterval) {
+        ok = Sync();
+        synced = true;
+        lastSync = now;
+      }
+    }
+
+    lock.lock();
+    writtenSeq_ = seq;
+    if (synced && ok) syncedSeq_ = seq;
+    if (!ok) failed_ = true;
+
+    const bool durable = options_.fsync == FsyncPolicy::Never || syncedSeq_ == writtenSeq_;
+    if (pending_.empty() && writtenSeq_ == appendedSeq_ && durable) flushRequested_ = false;
+    written_.notify_all();
+  }
+}
+
+bool CommandJournal::WriteAll(const char* data, std::size_t size) {
+  while (size > 0) {
+    const ssize_t written = ::write(fd_, data, size);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+  return true;
+}
+
+bool CommandJournal::Sync() {
+#if defined(__APPLE__)
+  // fsync on macOS does not flush the drive cache
+  return ::fcntl(fd_, F_FULLFSYNC) == 0 || ::fsync(fd_) == 0;
+#else
+  return ::fsync(fd_) == 0;
+#endif
+}
+
+// -------------------------------------------------
+// Replay
+// -------------------------------------------------
+
+CommandJournal::ReplayResult CommandJournal::Replay(const std::string& path, uint64_t generation,
+                                                    CommandStack& stack) {
+  ReplayResult result;
+
+  const MappedFile file(path);
+  if (!file.IsOpen() || file.Size() < kHeaderSize) return result;
+
+  BinaryReader header(file.View().substr(0, kHeaderSize));
+  char magic[4] = {};
+  uint32_t version = 0;
+  uint64_t fileGeneration = 0;
+  header.Read(magic);
+  header.Read(version);
+  header.Read(fileGeneration);
+  if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion ||
+      fileGeneration != generation) {
+    return result;
+  }
+  result.applied = true;
+
+  std::string_view records = file.View().substr(kHeaderSize);
+  while (!records.empty()) {
+    uint32_t size = 0;
+    uint32_t checksum = 0;
+    BinaryReader recordHeader(records);
+    if (!recordHeader.Read(size) || !recordHeader.Read(checksum) ||
+        records.size() - kRecordHeaderSize < size) {
+      result.truncatedTail = true;
+      break;
+    }
+
+    const std::string_view payload = records.substr(kRecordHeaderSize, size);
+    if (Checksum(payload) != checksum) {
+      result.truncatedTail = true;
+      break;
+    }
+    records.remove_prefix(kRecordHeaderSize + size);
+
+    BinaryReader in(payload);
+    Op op{};
+    if (!in.Read(op)) {
+      result.truncatedTail = true;
+      break;
+    }
+
+    switch (op) {
+      case Op::Do: {
+        auto command = DeserializeCommand(in);
+        if (!command) {
+          result.truncatedTail = true;
+          return result;
+        }
+        std::visit(
+            [&](auto&& cmd) { stack.Do<std::decay_t<decltype(cmd)>>(std::move(cmd)); },
+            std::move(*command));
+        break;
+      }
+      case Op::Undo:
+        stack.Undo();
+        break;
+      case Op::Redo:
+        stack.Redo();
+        break;
+      case Op::Clear:
+        stack.Clear();
+        break;
+      default:
+        result.truncatedTail = true;
+        return result;
+    }
+    ++result.records;
+  }
+
+  return result;
+}
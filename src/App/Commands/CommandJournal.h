@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Commands.h"
+
+class CommandStack;
+
+enum class FsyncPolicy {
+  Never,        // leave durability to the OS
+  EveryCommit,  // sync after each group commit
+  Periodic,     // sync at most once per fsyncInterval
+};
+
+struct JournalOptions {
+  FsyncPolicy fsync = FsyncPolicy::Periodic;
+  std::chrono::milliseconds fsyncInterval{250};
+
+  // Records arriving within this window of each other are written with one write
+  std::chrono::milliseconds commitWindow{5};
+};
+
+// Append-only log of everything CommandStack does (Do / Undo / Redo / Clear). Records
+// are serialised on the calling thread and written by a background thread, so the
+// frame never waits on disk. A journal is tied to the model snapshot generation it
+// was started from; replay only applies on top of that snapshot.
+class CommandJournal {
+ public:
+  explicit CommandJournal(JournalOptions options = {});
+  ~CommandJournal();
+
+  CommandJournal(const CommandJournal&) = delete;
+  CommandJournal& operator=(const CommandJournal&) = delete;
+
+  // Create (or truncate) the journal file and start the writer
+  bool Open(const std::string& path, uint64_t generation);
+  // Flush outstanding records and stop the writer
+  void Close();
+
+  bool IsOpen() const { return fd_ >= 0; }
+  bool Ok() const;
+
+  void RecordDo(const Command& command);
+  void RecordUndo();
+  void RecordRedo();
+  void RecordClear();
+
+  // Block until every record appended so far is written, and synced unless the
+  // policy is Never
+  bool Flush();
+
+  struct ReplayResult {
+    bool applied = false;       // header valid and generation matched
+    std::size_t records = 0;    // records replayed
+    bool truncatedTail = false;  // stopped at a torn or corrupt record
+  };
+
+  // Re-run a journal against the stack. The stack must not have a journal attached.
+  static ReplayResult Replay(const std::string& path, uint64_t generation, CommandStack& stack);
+
+ private:
+  enum class Op : uint8_t { Do, Undo, Redo, Clear };
+
+  void Append(Op op, const Command* command);
+  bool WriteAll(const char* data, std::size_t size);
+  bool Sync();
+  void WriterLoop();
+
+  JournalOptions options_;
+  int fd_ = -1;
+
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable written_;
+  std::vector<char> pending_;
+  uint64_t appendedSeq_ = 0;
+  uint64_t writtenSeq_ = 0;
+  uint64_t syncedSeq_ = 0;
+  bool flushRequested_ = false;
+  bool stop_ = false;
+  bool failed_ = false;
+  std::thread writer_;
+};
@@ -0,0 +1,217 @@
+#include "CommandSerialization.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Utilities/BinaryStream.h"
+
+namespace {
+
+// =================================================
+// Per command fields
+// =================================================
+
+void WriteFields(BinaryWriter& out, const CreateVertexCommand& cmd) { out.Write(cmd.position); }
+bool ReadFields(BinaryReader& in, CreateVertexCommand& cmd) { return in.Read(cmd.position); }
+
+void WriteFields(BinaryWriter& out, const RemoveVertexCommand& cmd) { out.Write(cmd.id); }
+bool ReadFields(BinaryReader& in, RemoveVertexCommand& cmd) { return in.Read(cmd.id); }
+
+void WriteFields(BinaryWriter& out, const CreateEdgeCommand& cmd) {
+  out.Write(cmd.a);
+  out.Write(cmd.b);
+}
+bool ReadFields(BinaryReader& in, CreateEdgeCommand& cmd) {
+  return in.Read(cmd.a) && in.Read(cmd.b);
+}
+
+void WriteFields(BinaryWriter& out, const RemoveEdgeCommand& cmd) { out.Write(cmd.id); }
+bool ReadFields(BinaryReader& in, RemoveEdgeCommand& cmd) { return in.Read(cmd.id); }
+
+void WriteFields(BinaryWriter& out, const CreateFaceCommand& cmd) { out.WriteArray(cmd.edges); }
+bool ReadFields(BinaryReader& in, CreateFaceCommand& cmd) { return in.ReadArray(cmd.edges); }
+
+void WriteFields(BinaryWriter& out, const RemoveFaceCommand& cmd) { out.Write(cmd.id); }
+bool ReadFields(BinaryReader& in, RemoveFaceCommand& cmd) { return in.Read(cmd.id); }
+
+void WriteFields(BinaryWriter& out, const ExtrudeFaceCommand& cmd) {
+  out.Write(cmd.faceId);
+  out.Write(cmd.delta);
+}
+bool ReadFields(BinaryReader& in, ExtrudeFaceCommand& cmd) {
+  return in.Read(cmd.faceId) && in.Read(cmd.delta);
+}
+
+void WriteFields(BinaryWriter& out, const CreateVolumeCommand& cmd) { out.WriteArray(cmd.faces); }
+bool ReadFields(BinaryReader& in, CreateVolumeCommand& cmd) { return in.ReadArray(cmd.faces); }
+
+void WriteFields(BinaryWriter& out, const RemoveVolumeCommand& cmd) { out.Write(cmd.id); }
+bool ReadFields(BinaryReader& in, RemoveVolumeCommand& cmd) { return in.Read(cmd.id); }
+
+void WriteFields(BinaryWriter& out, const AppendMeshCommand& cmd) {
+  const MeshData& mesh = cmd.mesh;
+  out.WriteArray(mesh.positions);
+  out.WriteArray(mesh.edges);
+  out.WriteArray(mesh.faceEdges);
+  out.WriteArray(mesh.faceOffsets);
+  out.WriteArray(mesh.volumeFaces);
+  out.WriteArray(mesh.volumeOffsets);
+}
+// Offsets start at 0, never decrease and end at the size of the array they split
+bool ValidOffsets(const std::vector<uint32_t>& offsets, std::size_t size) {
+  return !offsets.empty() && offsets.front() == 0 && offsets.back() == size &&
+         std::is_sorted(offsets.begin(), offsets.end());
+}
+
+bool AllBelow(const std::vector<uint32_t>& indices, std::size_t size) {
+  return std::all_of(indices.begin(), indices.end(), [&](uint32_t i) { return i < size; });
+}
+
+bool ReadFields(BinaryReader& in, AppendMeshCommand& cmd) {
+  MeshData& mesh = cmd.mesh;
+  if (!in.ReadArray(mesh.positions) || !in.ReadArray(mesh.edges) ||
+      !in.ReadArray(mesh.faceEdges) || !in.ReadArray(mesh.faceOffsets) ||
+      !in.ReadArray(mesh.volumeFaces) || !in.ReadArray(mesh.volumeOffsets)) {
+    return false;
+  }
+
+  // AppendMesh indexes with these unchecked
+  const std::size_t vertexCount = mesh.positions.size();
+  return ValidOffsets(mesh.faceOffsets, mesh.faceEdges.size()) &&
+         ValidOffsets(mesh.volumeOffsets, mesh.volumeFaces.size()) &&
+         std::all_of(mesh.edges.begin(), mesh.edges.end(),
+                     [&](const Edge& e) { return e.a < vertexCount && e.b < vertexCount; }) &&
+         AllBelow(mesh.faceEdges, mesh.edges.size()) &&
+         AllBelow(mesh.volumeFaces, mesh.FaceCount());
+}
+
+void WriteFields(BinaryWriter& out, const ExtrudeFacesCommand& cmd) {
+  out.WriteArray(cmd.faces);
+  out.Write(cmd.delta);
+}
+bool ReadFields(BinaryReader& in, ExtrudeFacesCommand& cmd) {
+  return in.ReadArray(cmd.faces) && in.Read(cmd.delta);
+}
+
+void WriteFields(BinaryWriter& out, const GenerateShapeCommand& cmd) {
+  const Generators::ShapeParams& params = cmd.params;
+  out.Write(static_cast<uint8_t>(params.shape));
+  out.Write(params.center);
+  out.Write(params.size);
+  out.Write(params.segments);
+  out.Write(params.rings);
+}
+bool ReadFields(BinaryReader& in, GenerateShapeCommand& cmd) {
+  Generators::ShapeParams& params = cmd.params;
+  uint8_t shape = 0;
+  if (!in.Read(shape) || shape >= Generators::kShapeCount) return false;
+  params.shape = static_cast<Generators::Shape>(shape);
+  return in.Read(params.center) && in.Read(params.size) && in.Read(params.segments) &&
+         in.Read(params.rings) && params.segments <= Generators::kMaxResolution &&
+         params.rings <= Generators::kMaxResolution;
+}
+
+void WriteFields(BinaryWriter& out, const LatheCommand& cmd) {
+  out.Write(cmd.face);
+  out.Write(cmd.origin);
+  out.Write(cmd.axis);
+  out.Write(cmd.angle);
+  out.Write(cmd.segments);
+}
+bool ReadFields(BinaryReader& in, LatheCommand& cmd) {
+  return in.Read(cmd.face) && in.Read(cmd.origin) && in.Read(cmd.axis) && in.Read(cmd.angle) &&
+         in.Read(cmd.segments) && cmd.segments <= Generators::kMaxResolution;
+}
+
+void WriteFields(BinaryWriter& out, const SweepCommand& cmd) {
+  out.Write(cmd.face);
+  out.WriteArray(cmd.path);
+}
+bool ReadFields(BinaryReader& in, SweepCommand& cmd) {
+  return in.Read(cmd.face) && in.ReadArray(cmd.path);
+}
+
+void WriteFields(BinaryWriter& out, const LoftCommand& cmd) {
+  out.Write(cmd.from);
+  out.Write(cmd.to);
+  out.Write(cmd.sections);
+}
+bool ReadFields(BinaryReader& in, LoftCommand& cmd) {
+  return in.Read(cmd.from) && in.Read(cmd.to) && in.Read(cmd.sections) &&
+         cmd.sections <= Generators::kMaxResolution;
+}
+
+void WriteFields(BinaryWriter& out, const SculptStrokeCommand& cmd) {
+  out.Write(cmd.delta.vertexCount);
+  out.WriteArray(cmd.delta.bytes);
+}
+bool ReadFields(BinaryReader& in, SculptStrokeCommand& cmd) {
+  return in.Read(cmd.delta.vertexCount) && in.ReadArray(cmd.delta.bytes);
+}
+
+void WriteFields(BinaryWriter& out, const BooleanCommand& cmd) {
+  out.Write(cmd.a);
+  out.Write(cmd.b);
+  out.Write(static_cast<uint8_t>(cmd.operation));
+}
+bool ReadFields(BinaryReader& in, BooleanCommand& cmd) {
+  uint8_t operation = 0;
+  if (!in.Read(cmd.a) || !in.Read(cmd.b) || !in.Read(operation)) return false;
+  if (operation >= Csg::kOperationCount) return false;
+  cmd.operation = static_cast<Csg::Operation>(operation);
+  return true;
+}
+
+void WriteFields(BinaryWriter& out, const DecimateCommand& cmd) {
+  out.Write(cmd.volume);
+  out.Write(static_cast<uint64_t>(cmd.options.targetTriangles));
+  out.Write(cmd.options.maxError);
+}
+bool ReadFields(BinaryReader& in, DecimateCommand& cmd) {
+  uint64_t targetTriangles = 0;
+  if (!in.Read(cmd.volume) || !in.Read(targetTriangles) || !in.Read(cmd.options.maxError)) {
+    return false;
+  }
+  cmd.options.targetTriangles = static_cast<std::size_t>(targetTriangles);
+  return true;
+}
+
+// =================================================
+// Variant dispatch
+// =================================================
+
+template <typename T>
+std::optional<Command> ReadCommand(BinaryReader& in) {
+  T cmd{};
+  if (!ReadFields(in, cmd)) return std::nullopt;
+  return Command{std::move(cmd)};
+}
+
+template <std::size_t... I>
+std::optional<Command> ReadAlternative(BinaryReader& in, std::size_t index,
+                                       std::index_sequence<I...>) {
+  std::optional<Command> result;
+  ((index == I ? (result = ReadCommand<std::variant_alternative_t<I, Command>>(in), true)
+               : false) ||
+   ...);
+  return result;
+}
+
+}  // namespace
+
+void SerializeCommand(const Command& command, std::vector<char>& out) {
+  static_assert(std::variant_size_v<Command> <= UINT8_MAX);
+
+  BinaryWriter writer(out);
+  writer.Write(static_cast<uint8_t>(command.index()));
+  std::visit([&](const auto& cmd) { WriteFields(writer, cmd); }, command);
+}
+
+std::optional<Command> DeserializeCommand(BinaryReader& in) {
+  uint8_t index = 0;
+  if (!in.Read(index) || index >= std::variant_size_v<Command>) return std::nullopt;
+
+  return ReadAlternative(in, index, std::make_index_sequence<std::variant_size_v<Command>>{});
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "Commands.h"
+
+class BinaryReader;
+
+// Compact binary encoding of a command's inputs (the fields set before Execute).
+// Results such as created ids are not stored; replaying the command against the same
+// model state reproduces them.
+void SerializeCommand(const Command& command, std::vector<char>& out);
+
+std::optional<Command> DeserializeCommand(BinaryReader& in);
@@ -32,6 +32,7 @@ bool CommandStack::Undo() {
   undoStack_.pop_back();
 
   std::visit(UndoVisitor{model_}, cmd);
+  if (journal_) journal_->RecordUndo();
   redoStack_.push_back(std::move(cmd));
   return true;
 }
@@ -43,6 +44,7 @@ bool CommandStack::Redo() {
   redoStack_.pop_back();
 
   std::visit(ExecuteVisitor{model_}, cmd);
+  if (journal_) journal_->RecordRedo();
   undoStack_.push_back(std::move(cmd));
   return true;
 }
@@ -54,4 +56,5 @@ bool CommandStack::Redo() {
 void CommandStack::Clear() {
   undoStack_.clear();
   redoStack_.clear();
+  if (journal_) journal_->RecordClear();
 }
@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <vector>
 
+#include "CommandJournal.h"
 #include "Commands.h"
 
 class Model;
@@ -28,8 +29,12 @@ class CommandStack {
   std::size_t UndoCount() const noexcept;
   std::size_t RedoCount() const noexcept;
 
+  // Mirror every Do / Undo / Redo / Clear into a journal (nullptr to detach)
+  void SetJournal(CommandJournal* journal) noexcept { journal_ = journal; }
+
  private:
   Model& model_;
+  CommandJournal* journal_ = nullptr;
 
   std::vector<Command> undoStack_;
   std::vector<Command> redoStack_;
@@ -42,6 +47,7 @@ bool CommandStack::Do(Args&&... args) {
 
   // Execute
   std::visit(ExecuteVisitor{model_}, cmd);
+  if (journal_) journal_->RecordDo(cmd);
 
   // Record
   redoStack_.clear();                    // Invalidate redo history
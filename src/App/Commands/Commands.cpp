@@ -1,7 +1,8 @@
 #include "Commands.h"
 
-#include <set>
+#include <ranges>
 
+#include "Generators/Profiles.h"
 #include "Model/Model.h"
 
 // =================================================
@@ -97,16 +98,8 @@ void ExtrudeFaceCommand::Execute(Model& model) {
 
   // Store original positions for undo
   if (affectedVertices.empty()) {
-    const Face& face = model.GetFace(faceId);
-    std::set<VertexId> uniqueVertices;
-
-    for (EdgeId edgeId : face.edges) {
-      const Edge& edge = model.GetEdge(edgeId);
-      uniqueVertices.insert(edge.a);
-      uniqueVertices.insert(edge.b);
-    }
-
-    affectedVertices.assign(uniqueVertices.begin(), uniqueVertices.end());
+    const auto loop = model.FaceLoop(faceId);
+    affectedVertices.assign(loop.begin(), loop.end());
     originalPositions.reserve(affectedVertices.size());
 
     for (VertexId vid : affectedVertices) {
@@ -119,12 +112,16 @@ void ExtrudeFaceCommand::Execute(Model& model) {
 }
 
 void ExtrudeFaceCommand::Undo(Model& model) {
-  // Restore original vertex positions
+  // Restore original vertex positions in one batch
+  std::vector<VertexId> ids;
+  std::vector<Vec3> positions;
   for (size_t i = 0; i < affectedVertices.size(); ++i) {
     if (model.ContainsVertex(affectedVertices[i])) {
-      model.SetVertexPosition(affectedVertices[i], originalPositions[i]);
+      ids.push_back(affectedVertices[i]);
+      positions.push_back(originalPositions[i]);
     }
   }
+  model.SetVertexPositions(ids, positions);
 }
 
 // =================================================
@@ -153,3 +150,159 @@ void RemoveVolumeCommand::Undo(Model& model) {
     removedVolume.reset();
   }
 }
+
+// =================================================
+// Bulk Commands
+// =================================================
+
+namespace {
+
+void RemoveAppended(Model& model, const MeshIds& ids) {
+  // Remove dependants before the elements they reference, each list newest first so the
+  // LIFO free lists hand a redo the same ids again
+  for (VolumeId id : std::views::reverse(ids.volumes)) model.RemoveVolume(id);
+  for (FaceId id : std::views::reverse(ids.faces)) model.RemoveFace(id);
+  for (EdgeId id : std::views::reverse(ids.edges)) model.RemoveEdge(id);
+  for (VertexId id : std::views::reverse(ids.vertices)) model.RemoveVertex(id);
+}
+
+// Positions around a face, empty if the face is gone
+std::vector<Vec3> LoopPositions(const Model& model, FaceId id) {
+  std::vector<Vec3> positions;
+  if (!model.ContainsFace(id)) return positions;
+
+  const auto loop = model.FaceLoop(id);
+  positions.reserve(loop.size());
+  for (VertexId v : loop) positions.push_back(model.GetVertex(v).position);
+  return positions;
+}
+
+std::optional<MeshIds> AppendIfAny(Model& model, const MeshData& mesh) {
+  if (mesh.Empty()) return std::nullopt;
+  return model.AppendMesh(mesh);
+}
+
+}  // namespace
+
+void AppendMeshCommand::Execute(Model& model) { createdIds = model.AppendMesh(mesh); }
+
+void AppendMeshCommand::Undo(Model& model) {
+  if (!createdIds) return;
+
+  RemoveAppended(model, *createdIds);
+  createdIds.reset();
+}
+
+void ExtrudeFacesCommand::Execute(Model& model) { record = model.ExtrudeFaces(faces, delta); }
+
+void ExtrudeFacesCommand::Undo(Model& model) {
+  if (!record) return;
+
+  model.RevertExtrude(*record);
+  record.reset();
+}
+
+void GenerateShapeCommand::Execute(Model& model) {
+  createdIds = model.AppendMesh(Generators::Generate(params));
+}
+
+void GenerateShapeCommand::Undo(Model& model) {
+  if (!createdIds) return;
+
+  RemoveAppended(model, *createdIds);
+  createdIds.reset();
+}
+
+void LatheCommand::Execute(Model& model) {
+  const std::vector<Vec3> profile = LoopPositions(model, face);
+  createdIds = AppendIfAny(model, Generators::Lathe(profile, origin, axis, angle, segments));
+}
+
+void LatheCommand::Undo(Model& model) {
+  if (!createdIds) return;
+
+  RemoveAppended(model, *createdIds);
+  createdIds.reset();
+}
+
+void SweepCommand::Execute(Model& model) {
+  const std::vector<Vec3> profile = LoopPositions(model, face);
+  createdIds = AppendIfAny(model, Generators::Sweep(profile, path));
+}
+
+void SweepCommand::Undo(Model& model) {
+  if (!createdIds) return;
+
+  RemoveAppended(model, *createdIds);
+  createdIds.reset();
+}
+
+void LoftCommand::Execute(Model& model) {
+  const std::vector<Vec3> first = LoopPositions(model, from);
+  const std::vector<Vec3> second = LoopPositions(model, to);
+  createdIds = AppendIfAny(model, Generators::Loft(first, second, sections));
+}
+
+void LoftCommand::Undo(Model& model) {
+  if (!createdIds) return;
+
+  RemoveAppended(model, *createdIds);
+  createdIds.reset();
+}
+
+// =================================================
+// Sculpt Commands
+// =================================================
+
+void SculptStrokeCommand::Execute(Model& model) {
+  if (!applied) applied = Sculpt::ApplyStrokeDelta(model, delta);
+}
+
+void SculptStrokeCommand::Undo(Model& model) {
+  if (applied && Sculpt::ApplyStrokeDelta(model, delta)) applied = false;
+}
+
+// =================================================
+// Boolean Commands
+// =================================================
+
+void BooleanCommand::Execute(Model& model) {
+  if (!mesh) mesh = Csg::Combine(model, a, b, operation);
+  if (!mesh) return;
+
+  createdIds = AppendIfAny(model, *mesh);
+  const VolumeId operands[] = {a, b};
+  removed = model.RemoveVolumes(operands);
+}
+
+void BooleanCommand::Undo(Model& model) {
+  if (createdIds) RemoveAppended(model, *createdIds);
+  if (removed) model.RestoreRemoved(*removed);
+  createdIds.reset();
+  removed.reset();
+}
+
+// =================================================
+// Simplify Commands
+// =================================================
+
+void DecimateCommand::Execute(Model& model) {
+  if (!model.ContainsVolume(volume)) return;
+
+  if (mesh.Empty()) {
+    const std::vector<FaceId> faces = model.GetVolume(volume).faces;
+    mesh = Simplify::Decimate(model, faces, options).mesh;
+  }
+  if (mesh.Empty()) return;
+
+  createdIds = AppendIfAny(model, mesh);
+  const VolumeId replaced[] = {volume};
+  removed = model.RemoveVolumes(replaced);
+}
+
+void DecimateCommand::Undo(Model& model) {
+  if (createdIds) RemoveAppended(model, *createdIds);
+  if (removed) model.RestoreRemoved(*removed);
+  createdIds.reset();
+  removed.reset();
+}
@@ -5,7 +5,12 @@
 #include <variant>
 #include <vector>
 
+#include "Core/MeshData.h"
 #include "Core/Primitives.h"
+#include "Csg/Boolean.h"
+#include "Generators/Shapes.h"
+#include "Sculpt/StrokeDelta.h"
+#include "Simplify/Decimate.h"
 #include "Utilities/Vec3.h"
 
 class Model;
@@ -102,13 +107,141 @@ struct RemoveVolumeCommand {
   void Undo(Model& model);
 };
 
+// =================================================
+// Bulk Commands
+// =================================================
+
+// Inserts a whole mesh (import, generators) as a single undo step
+struct AppendMeshCommand {
+  MeshData mesh;
+  std::optional<MeshIds> createdIds;
+
+  void Execute(Model& model);
+  void Undo(Model& model);
+};
+
+// Extrudes a region of faces with side walls (Model::ExtrudeFaces) as a single undo step
+struct ExtrudeFacesCommand {
+  std::vector<FaceId> faces;
+  float delta;
+  std::optional<ExtrudeRecord> record;
+
+  void Execute(Model& model);
+  void Undo(Model& model);
+};
+
+// Generates a procedural shape into the model as a single undo step. Only the
+// parameters are kept; the mesh is rebuilt whenever the command is executed.
+struct GenerateShapeCommand {
+  Generators::ShapeParams params;
+  std::optional<MeshIds> createdIds;
+
+  void Execute(Model& model);
+  void Undo(Model& model);
+};
+
+// Revolves a face's vertex loop into a new solid (Generators::Lathe); the face itself
+// is left in place
+struct LatheCommand {
+  FaceId face;
+  Vec3 origin;
+  Vec3 axis;
+  float angle;
+  uint32_t segments;
+  std::optional<MeshIds> createdIds;
+
+  void Execute(Model& model);
+  void Undo(Model& model);
+};
+
+// Sweeps a face's vertex loop along a polyline starting at the face (Generators::Sweep)
+struct SweepCommand {
+  FaceId face;
+  std::vector<Vec3> path;
+  std::optional<MeshIds> createdIds;
+
+  void Execute(Model& model);
+  void Undo(Model& model);
+};
+
+// Lofts a solid between two faces with the same vertex count (Generators::Loft)
+struct LoftCommand {
+  FaceId from;
+  FaceId to;
+  uint32_t sections;
+  std::optional<MeshIds> createdIds;
+
+  void Execute(Model& model);
+  void Undo(Model& model);
+};
+
+// =================================================
+// Sculpt Commands
+// =================================================
+
+// A finished brush stroke (Sculpt::Stroke) as one compressed undo step. Strokes are
+// painted live and recorded with applied already set, so only redo and journal replay
+// apply the delta on Execute.
+struct SculptStrokeCommand {
+  Sculpt::StrokeDelta delta;
+  bool applied = false;
+
+  void Execute(Model& model);
+  void Undo(Model& model);
+};
+
+// =================================================
+// Boolean Commands
+// =================================================
+
+// Replaces two volumes with their union, difference or intersection (Csg::Combine) as
+// one undo step. The operands' faces, edges and vertices go too unless something else
+// still uses them; undo brings them back under their old ids.
+struct BooleanCommand {
+  VolumeId a;
+  VolumeId b;
+  Csg::Operation operation;
+  // Combined solid, kept for redo. Left unset, the first Execute combines the operands
+  // (journal replay does); Application::CombineVolumes combines first, so a failed
+  // boolean never reaches the undo stack.
+  std::optional<MeshData> mesh;
+  std::optional<MeshIds> createdIds;
+  std::optional<RemovalRecord> removed;
+
+  void Execute(Model& model);
+  void Undo(Model& model);
+};
+
+// =================================================
+// Simplify Commands
+// =================================================
+
+// Replaces a volume with a decimated copy (Simplify::Decimate) as one undo step, the
+// same way BooleanCommand replaces its operands
+struct DecimateCommand {
+  VolumeId volume;
+  Simplify::Options options;
+  // Decimated copy of the volume, kept for redo. Left empty, the first Execute
+  // decimates on the calling thread (journal replay does); Application::SimplifyVolume
+  // fills it on a worker first.
+  MeshData mesh;
+  std::optional<MeshIds> createdIds;
+  std::optional<RemovalRecord> removed;
+
+  void Execute(Model& model);
+  void Undo(Model& model);
+};
+
 // =================================================
 // Command Variant
 // =================================================
 
 using Command = std::variant<CreateVertexCommand, RemoveVertexCommand, CreateEdgeCommand,
                              RemoveEdgeCommand, CreateFaceCommand, RemoveFaceCommand,
-                             ExtrudeFaceCommand, CreateVolumeCommand, RemoveVolumeCommand>;
+                             ExtrudeFaceCommand, CreateVolumeCommand, RemoveVolumeCommand,
+                             AppendMeshCommand, ExtrudeFacesCommand, GenerateShapeCommand,
+                             LatheCommand, SweepCommand, LoftCommand, SculptStrokeCommand,
+                             BooleanCommand, DecimateCommand>;
 
 // Helper visitors for Execute/Undo
 struct ExecuteVisitor {
@@ -1,8 +1,13 @@
 #pragma once
 
-#include <set>
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 
 #include "Core/Primitives.h"
+#include "Utilities/SpscQueue.h"
 
 enum class KEYS {
   UP,
@@ -21,11 +26,26 @@ enum class KEYS {
   MOUSE_MIDDLE,
   UNDO,
   REDO,
-  DEBUG
+  DEBUG,
+  COUNT  // number of keys, not a key
 };
 
 enum class INTERACTION_MODE { DEFAULT, FACE };
 
+// One change of input state, stamped when the platform reported it
+struct InputEvent {
+  enum class Type : uint8_t { KeyDown, KeyUp, Motion, Scroll };
+
+  Type type = Type::Motion;
+  KEYS key = KEYS::COUNT;  // KeyDown and KeyUp
+  float x = 0.0f;          // Motion: cursor position
+  float y = 0.0f;          // Scroll: wheel offset
+  std::chrono::steady_clock::time_point time;
+};
+
+// Platform callbacks push events as they arrive; InputHandler drains them once per frame
+using InputEventQueue = SpscQueue<InputEvent, 1024>;
+
 struct MouseState {
   float x = 0.0f;
   float y = 0.0f;
@@ -36,13 +56,15 @@ struct MouseState {
 
 class Input {
  public:
+  using KeySet = std::bitset<static_cast<std::size_t>(KEYS::COUNT)>;
+
   INTERACTION_MODE GetInteractionMode() const { return interactionMode_; }
   // only true on intital key pressed frame
-  bool IsPressed(KEYS key) const { return keysPressed_.contains(key); }
+  bool IsPressed(KEYS key) const { return keysPressed_.test(Bit(key)); }
   // only true on frame where key down is released
-  bool IsReleased(KEYS key) const { return keysReleased_.contains(key); }
+  bool IsReleased(KEYS key) const { return keysReleased_.test(Bit(key)); }
   // true whenever key is dowwn, pressed or held
-  bool IsDown(KEYS key) const { return keysDown_.contains(key); }
+  bool IsDown(KEYS key) const { return keysDown_.test(Bit(key)); }
 
   // combo, ctrl + key pressed
   bool IsCtrlPressed(KEYS key) const { return IsDown(KEYS::CTRL) && IsPressed(key); }
@@ -68,10 +90,50 @@ class Input {
 
   // ===== Update Functions =====
 
-  // Called each frame with current hardware state
-  void Update(const std::set<KEYS>& keysCurrentlyDown, const MouseState& mouseState) {
-    UpdateKeys(keysCurrentlyDown);
-    UpdateMouse(mouseState);
+  // Called at the start of each frame, before its events: presses, releases, mouse
+  // movement and scrolling only last one frame
+  void BeginFrame() {
+    keysPressed_.reset();
+    keysReleased_.reset();
+    mouse_.deltaX = 0.0f;
+    mouse_.deltaY = 0.0f;
+    mouse_.scrollDelta = 0.0f;
+    firstEventTime_.reset();
+  }
+
+  // Called with each event of the frame in order. Events within a frame coalesce:
+  // movement and scrolling add up, and a click shorter than a frame reads as pressed and
+  // released in the same frame rather than getting lost.
+  void Apply(const InputEvent& event) {
+    if (!firstEventTime_) firstEventTime_ = event.time;
+    switch (event.type) {
+      case InputEvent::Type::KeyDown:
+        if (!keysDown_.test(Bit(event.key))) keysPressed_.set(Bit(event.key));
+        keysDown_.set(Bit(event.key));
+        break;
+      case InputEvent::Type::KeyUp:
+        if (keysDown_.test(Bit(event.key))) keysReleased_.set(Bit(event.key));
+        keysDown_.reset(Bit(event.key));
+        break;
+      case InputEvent::Type::Motion:
+        // The first position only places the cursor
+        if (hasCursor_) {
+          mouse_.deltaX += event.x - mouse_.x;
+          mouse_.deltaY += event.y - mouse_.y;
+        }
+        mouse_.x = event.x;
+        mouse_.y = event.y;
+        hasCursor_ = true;
+        break;
+      case InputEvent::Type::Scroll:
+        mouse_.scrollDelta += event.y;
+        break;
+    }
+  }
+
+  // When the oldest event applied this frame happened, for input latency
+  std::optional<std::chrono::steady_clock::time_point> FirstEventTime() const {
+    return firstEventTime_;
   }
 
   void SetPendingPick(int x, int y) {
@@ -89,51 +151,19 @@ class Input {
 
   // Clear all input state (useful for focus loss, mode changes)
   void Clear() {
-    keysPressed_.clear();
-    keysDown_.clear();
-    keysReleased_.clear();
+    keysPressed_.reset();
+    keysDown_.reset();
+    keysReleased_.reset();
     mouse_ = MouseState{};
+    hasCursor_ = false;
   }
 
  private:
-  void UpdateKeys(const std::set<KEYS>& keysCurrentlyDown) {
-    // Clear per-frame states
-    keysPressed_.clear();
-    keysReleased_.clear();
-
-    // Determine pressed keys
-    for (KEYS key : keysCurrentlyDown) {
-      if (!keysDown_.contains(key)) {
-        keysPressed_.insert(key);
-      }
-    }
-
-    // Determine released keys
-    for (KEYS key : keysDown_) {
-      if (!keysCurrentlyDown.contains(key)) {
-        keysReleased_.insert(key);
-      }
-    }
-
-    keysDown_ = keysCurrentlyDown;
-  }
-
-  void UpdateMouse(const MouseState& newState) {
-    // Calculate deltas
-    mouse_.deltaX = newState.x - mouse_.x;
-    mouse_.deltaY = newState.y - mouse_.y;
-
-    // Update position
-    mouse_.x = newState.x;
-    mouse_.y = newState.y;
-
-    // Update scroll (usually accumulated externally)
-    mouse_.scrollDelta = newState.scrollDelta;
-  }
+  static std::size_t Bit(KEYS key) { return static_cast<std::size_t>(key); }
 
-  std::set<KEYS> keysPressed_;
-  std::set<KEYS> keysDown_;
-  std::set<KEYS> keysReleased_;
+  KeySet keysPressed_;
+  KeySet keysDown_;
+  KeySet keysReleased_;
   INTERACTION_MODE interactionMode_;
 
   int pendingPick_[2] = {-1, -1};
@@ -141,4 +171,6 @@ class Input {
   int32_t selectedVertexId_ = -1;
 
   MouseState mouse_;
+  bool hasCursor_ = false;
+  std::optional<std::chrono::steady_clock::time_point> firstEventTime_;
 };
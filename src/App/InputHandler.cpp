@@ -1,9 +1,23 @@
 #include "InputHandler.h"
 
+#include <vector>
+
 #include "Core/Primitives.h"
 #include "Input.h"
+#include "Rendering/PreviewOverlay.h"
+
+namespace {
+
+// Extrusion per pixel of vertical mouse movement
+constexpr float kExtrudePerPixel = 0.01f;
+
+}  // namespace
+
+void InputHandler::HandleInput(InputEventQueue& events, Input& input) {
+  input.BeginFrame();
+  InputEvent event;
+  while (events.TryPop(event)) input.Apply(event);
 
-void InputHandler::HandleInput(Input& input) {
   if ((input.IsDown(KEYS::UNDO) || input.IsCtrlDown(KEYS::Z)) && commandStack_.CanUndo()) {
     commandStack_.Undo();
   }
@@ -13,8 +27,10 @@ void InputHandler::HandleInput(Input& input) {
     commandStack_.Redo();
   }
 
+  HandleExtrudeDrag(input);
+
   // Orbit with left mouse button
-  if (input.IsDown(KEYS::MOUSE_LEFT) &&
+  if (!extruding_ && input.IsDown(KEYS::MOUSE_LEFT) &&
       (input.GetMouseDeltaX() != 0.0f || input.GetMouseDeltaY() != 0.0f)) {
     camera_.Orbit(input.GetMouseDeltaX(), input.GetMouseDeltaY());
   }
@@ -40,4 +56,42 @@ void InputHandler::HandleInput(Input& input) {
   if (input.IsPressed(KEYS::MOUSE_RIGHT)) {
     input.SetPendingPick(input.GetMouseX(), input.GetMouseY());
   }
+}
+
+void InputHandler::HandleExtrudeDrag(Input& input) {
+  if (!extruding_) {
+    if (!input.IsPressed(KEYS::MOUSE_LEFT) || !input.IsDown(KEYS::SHIFT) ||
+        input.GetSelectedFaceId() <= 0) {
+      return;
+    }
+    extruding_ = true;
+    extrudeFace_ = static_cast<FaceId>(input.GetSelectedFaceId() - 1);
+    extrudeDelta_ = 0.0f;
+    overlay_.Clear();
+    overlay_.AddExtrusion(model_, extrudeFace_, extrudeDelta_);
+    return;
+  }
+
+  if (input.IsPressed(KEYS::ESCAPE)) {
+    extruding_ = false;
+    overlay_.Clear();
+    return;
+  }
+
+  if (!input.IsDown(KEYS::MOUSE_LEFT)) {
+    extruding_ = false;
+    overlay_.Clear();
+    if (extrudeDelta_ != 0.0f) {
+      // Walls and all, as the preview showed it
+      commandStack_.Do<ExtrudeFacesCommand>(std::vector<FaceId>{extrudeFace_}, extrudeDelta_);
+    }
+    return;
+  }
+
+  // Mouse up pulls the face out
+  if (input.GetMouseDeltaY() != 0.0f) {
+    extrudeDelta_ -= input.GetMouseDeltaY() * kExtrudePerPixel;
+    overlay_.Clear();
+    overlay_.AddExtrusion(model_, extrudeFace_, extrudeDelta_);
+  }
 }
\ No newline at end of file
@@ -1,16 +1,30 @@
 #include "Commands/CommandStack.h"
+#include "Input.h"
 #include "Rendering/Camera.h"
 
-class Input;
+class Model;
+class PreviewOverlay;
 
 class InputHandler {
  public:
-  InputHandler(CommandStack& commandStack, Camera& camera)
-      : commandStack_(commandStack), camera_(camera) {}
+  InputHandler(CommandStack& commandStack, Camera& camera, const Model& model,
+               PreviewOverlay& overlay)
+      : commandStack_(commandStack), camera_(camera), model_(model), overlay_(overlay) {}
 
-  void HandleInput(Input& input);
+  // Apply the events queued since the last frame to input, coalesced, then act on them
+  void HandleInput(InputEventQueue& events, Input& input);
 
  private:
+  // Shift + left drag on the selected face pushes or pulls it. Only the overlay changes
+  // while dragging; the extrusion becomes one command on release, and Escape drops it.
+  void HandleExtrudeDrag(Input& input);
+
   CommandStack& commandStack_;
   Camera& camera_;
+  const Model& model_;
+  PreviewOverlay& overlay_;
+
+  bool extruding_ = false;
+  FaceId extrudeFace_ = 0;
+  float extrudeDelta_ = 0.0f;
 };
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+// Input to photon latency: for each presented frame that handled input, the time from
+// its oldest event until the frame was handed to the display (the buffer swap returned).
+// Scanout adds up to one refresh on top. Keeps the last kFrames samples.
+class InputLatency {
+ public:
+  static constexpr std::size_t kFrames = 240;
+
+  void Add(std::chrono::steady_clock::duration latency) {
+    samples_[next_] = std::chrono::duration<float, std::milli>(latency).count();
+    next_ = (next_ + 1) % kFrames;
+    count_ = std::min(count_ + 1, kFrames);
+  }
+
+  std::size_t Count() const { return count_; }
+
+  float AverageMilliseconds() const {
+    if (count_ == 0) return 0.0f;
+    float sum = 0.0f;
+    for (std::size_t i = 0; i < count_; ++i) sum += samples_[i];
+    return sum / static_cast<float>(count_);
+  }
+
+  float MaxMilliseconds() const {
+    return count_ == 0 ? 0.0f : *std::max_element(samples_.begin(), samples_.begin() + count_);
+  }
+
+ private:
+  std::array<float, kFrames> samples_{};
+  std::size_t next_ = 0;
+  std::size_t count_ = 0;
+};
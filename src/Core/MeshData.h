@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Core/Primitives.h"
+#include "Utilities/Vec3.h"
+
+// Flat, index based mesh description used to bulk insert geometry into a Model.
+// Edge endpoints index into positions, face loops index into edges and volumes index
+// into faces. Faces and volumes are stored as offset ranges into a single index array
+// so building large meshes needs no per-element allocation.
+struct MeshData {
+  std::vector<Vec3> positions;
+  std::vector<Edge> edges;
+
+  std::vector<uint32_t> faceEdges;       // loop ordered edge indices of every face
+  std::vector<uint32_t> faceOffsets{0};  // face i = faceEdges[faceOffsets[i], faceOffsets[i+1])
+
+  std::vector<uint32_t> volumeFaces;
+  std::vector<uint32_t> volumeOffsets{0};
+
+  std::size_t FaceCount() const { return faceOffsets.size() - 1; }
+  std::size_t VolumeCount() const { return volumeOffsets.size() - 1; }
+
+  std::span<const uint32_t> FaceEdges(std::size_t face) const {
+    return std::span<const uint32_t>(faceEdges).subspan(
+        faceOffsets[face], faceOffsets[face + 1] - faceOffsets[face]);
+  }
+
+  std::span<const uint32_t> VolumeFaces(std::size_t volume) const {
+    return std::span<const uint32_t>(volumeFaces)
+        .subspan(volumeOffsets[volume], volumeOffsets[volume + 1] - volumeOffsets[volume]);
+  }
+
+  uint32_t AddFace(std::span<const uint32_t> edgeIndices) {
+    faceEdges.insert(faceEdges.end(), edgeIndices.begin(), edgeIndices.end());
+    faceOffsets.push_back(static_cast<uint32_t>(faceEdges.size()));
+    return static_cast<uint32_t>(FaceCount() - 1);
+  }
+
+  uint32_t AddVolume(std::span<const uint32_t> faceIndices) {
+    volumeFaces.insert(volumeFaces.end(), faceIndices.begin(), faceIndices.end());
+    volumeOffsets.push_back(static_cast<uint32_t>(volumeFaces.size()));
+    return static_cast<uint32_t>(VolumeCount() - 1);
+  }
+
+  bool Empty() const { return positions.empty(); }
+
+  void Clear() {
+    positions.clear();
+    edges.clear();
+    faceEdges.clear();
+    faceOffsets.assign(1, 0);
+    volumeFaces.clear();
+    volumeOffsets.assign(1, 0);
+  }
+};
+
+// Ids assigned to the elements of a MeshData once it has been inserted into a Model,
+// in the same order as the MeshData arrays
+struct MeshIds {
+  std::vector<VertexId> vertices;
+  std::vector<EdgeId> edges;
+  std::vector<FaceId> faces;
+  std::vector<VolumeId> volumes;
+};
+
+// Everything Model::ExtrudeFaces changed, enough for RevertExtrude to restore the
+// model exactly
+struct ExtrudeRecord {
+  // A region face edge that was replaced by its extruded copy
+  struct EdgeSwap {
+    FaceId face;
+    uint32_t slot;
+    EdgeId original;
+  };
+
+  std::vector<FaceId> faces;  // the extruded region, sorted
+  std::vector<VertexId> createdVertices;
+  std::vector<EdgeId> createdEdges;
+  std::vector<FaceId> createdFaces;  // side walls
+  std::vector<VertexId> movedVertices;
+  std::vector<Vec3> originalPositions;
+  std::vector<std::pair<EdgeId, Edge>> rewiredEdges;
+  std::vector<EdgeSwap> swappedEdges;
+  std::vector<std::pair<VolumeId, uint32_t>> grownVolumes;  // original face counts
+};
+
+// Elements Model::RemoveVolumes deleted, in removal order, so RestoreRemoved can put
+// them back under their old ids
+struct RemovalRecord {
+  std::vector<VertexId> vertexIds;
+  std::vector<Vertex> vertices;
+  std::vector<EdgeId> edgeIds;
+  std::vector<Edge> edges;
+  std::vector<FaceId> faceIds;
+  std::vector<Face> faces;
+  std::vector<VolumeId> volumeIds;
+  std::vector<Volume> volumes;
+};
@@ -0,0 +1,1052 @@
+#include "Csg/Boolean.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "Csg/Perturbation.h"
+#include "Csg/Solid.h"
+#include "Geometry/Predicates.h"
+#include "Geometry/Triangulation.h"
+#include "Topology/EdgeTable.h"
+#include "Utilities/JobSystem.h"
+
+namespace Csg {
+namespace {
+
+constexpr uint32_t kNone = UINT32_MAX;
+
+// PerturbedOrient masks with the second operand (B) shifted
+constexpr unsigned kPlaneOfB = 0b0111;  // (b, b, b, a)
+constexpr unsigned kPlaneOfA = 0b1000;  // (a, a, a, b)
+constexpr unsigned kEdgeOfA = 0b1100;   // (a, a, b, b)
+constexpr unsigned kEdgeOfB = 0b0011;   // (b, b, a, a)
+
+// -------------------------------------------------
+// Intersection points
+// -------------------------------------------------
+// Every point of the intersection curves is where an edge of one solid crosses a
+// triangle of the other. Keys pack owner << 63 | edge << 32 | triangle, so all faces
+// around the edge agree on the point.
+uint64_t PointKey(uint32_t owner, uint32_t edge, uint32_t triangle) {
+  return static_cast<uint64_t>(owner) << 63 | static_cast<uint64_t>(edge) << 32 | triangle;
+}
+
+uint32_t KeyOwner(uint64_t key) { return static_cast<uint32_t>(key >> 63); }
+uint32_t KeyEdge(uint64_t key) { return static_cast<uint32_t>(key >> 32) & 0x7FFFFFFFu; }
+uint32_t KeyTriangle(uint64_t key) { return static_cast<uint32_t>(key); }
+
+uint64_t EdgeKey(uint32_t a, uint32_t b) {
+  const uint64_t lo = std::min(a, b);
+  const uint64_t hi = std::max(a, b);
+  return hi << 32 | lo;
+}
+
+// A triangle pair whose intersection is the segment between two points
+struct Cut {
+  uint32_t triangleA;
+  uint32_t triangleB;
+  std::array<uint64_t, 2> ends;
+};
+
+const Vec3& Corner(const Solid& solid, const Solid::Triangle& t, int k) {
+  return solid.positions[t.corners[k]];
+}
+
+// True when the line through p and q passes inside triangle t
+bool PassesInside(const Vec3& p, const Vec3& q, const Solid& solid, const Solid::Triangle& t,
+                  unsigned mask, const Perturbation& motion) {
+  const int ab = PerturbedOrient(p, q, Corner(solid, t, 0), Corner(solid, t, 1), mask, motion);
+  const int bc = PerturbedOrient(p, q, Corner(solid, t, 1), Corner(solid, t, 2), mask, motion);
+  const int ca = PerturbedOrient(p, q, Corner(solid, t, 2), Corner(solid, t, 0), mask, motion);
+  return ab != 0 && ab == bc && bc == ca;
+}
+
+// Number of edges of either triangle that cross the other: 0 when they miss, 2 for a
+// cut (stored in out), anything else only for inconsistent input
+int CutTriangles(const Solid& a, uint32_t ta, const Solid& b, uint32_t tb,
+                 const Perturbation& motion, Cut& out) {
+  const Solid::Triangle& triA = a.triangles[ta];
+  const Solid::Triangle& triB = b.triangles[tb];
+
+  // Zero area triangles have no plane (every side is 0), but their edges may still
+  // cross the other triangle
+  std::array<int, 3> sideA{};
+  for (int k = 0; k < 3; ++k) {
+    sideA[k] = PerturbedOrient(Corner(b, triB, 0), Corner(b, triB, 1), Corner(b, triB, 2),
+                               Corner(a, triA, k), kPlaneOfB, motion);
+  }
+  const bool flatB = sideA[0] == 0;
+  if (!flatB && sideA[0] == sideA[1] && sideA[1] == sideA[2]) return 0;
+
+  std::array<int, 3> sideB{};
+  for (int k = 0; k < 3; ++k) {
+    sideB[k] = PerturbedOrient(Corner(a, triA, 0), Corner(a, triA, 1), Corner(a, triA, 2),
+                               Corner(b, triB, k), kPlaneOfA, motion);
+  }
+  const bool flatA = sideB[0] == 0;
+  if (flatA && flatB) return 0;
+  if (!flatA && sideB[0] == sideB[1] && sideB[1] == sideB[2]) return 0;
+
+  int count = 0;
+  auto add = [&](uint64_t key) {
+    if (count < 2) out.ends[count] = key;
+    ++count;
+  };
+  for (int k = 0; k < 3 && !flatB; ++k) {
+    const int next = (k + 1) % 3;
+    if (sideA[k] != sideA[next] &&
+        PassesInside(Corner(a, triA, k), Corner(a, triA, next), b, triB, kEdgeOfA, motion)) {
+      add(PointKey(0, triA.edges[k], tb));
+    }
+  }
+  for (int k = 0; k < 3 && !flatA; ++k) {
+    const int next = (k + 1) % 3;
+    if (sideB[k] != sideB[next] &&
+        PassesInside(Corner(b, triB, k), Corner(b, triB, next), a, triA, kEdgeOfB, motion)) {
+      add(PointKey(1, triB.edges[k], ta));
+    }
+  }
+  out.triangleA = ta;
+  out.triangleB = tb;
+  return count;
+}
+
+// -------------------------------------------------
+// Pieces: vertex loops over the combined vertex numbering (A's vertices, then B's,
+// then the intersection points)
+// -------------------------------------------------
+struct Pieces {
+  std::vector<uint32_t> vertices;
+  std::vector<uint32_t> offsets{0};
+  std::vector<uint8_t> collapsed;  // from a region with no area once points are rounded
+
+  std::size_t Count() const { return offsets.size() - 1; }
+
+  std::span<const uint32_t> Loop(std::size_t piece) const {
+    return std::span<const uint32_t>(vertices).subspan(offsets[piece],
+                                                       offsets[piece + 1] - offsets[piece]);
+  }
+
+  void Add(std::span<const uint32_t> loop, bool flat = false) {
+    vertices.insert(vertices.end(), loop.begin(), loop.end());
+    offsets.push_back(static_cast<uint32_t>(vertices.size()));
+    collapsed.push_back(flat ? 1 : 0);
+  }
+
+  void Append(const Pieces& other) {
+    for (std::size_t i = 0; i < other.Count(); ++i) Add(other.Loop(i), other.collapsed[i]);
+  }
+};
+
+// Intersection segment lying in a face, between two point indices
+struct Segment {
+  uint32_t face;
+  uint32_t from;
+  uint32_t to;
+
+  bool operator<(const Segment& other) const {
+    return face != other.face ? face < other.face
+                              : from != other.from ? from < other.from : to < other.to;
+  }
+};
+
+// Everything the face splitter reads
+struct Context {
+  std::array<const Solid*, 2> solids;
+  std::array<uint32_t, 2> bases;  // combined number of each solid's vertex 0
+  uint32_t pointBase;
+  std::vector<uint64_t> pointKeys;
+  std::vector<double> pointParams;  // where along the owning edge, from edge.a
+  std::vector<Vec3> positions;      // combined numbering
+  Perturbation motion;              // of solids[1]
+};
+
+// -------------------------------------------------
+// Planar helpers in a face's projection plane
+// -------------------------------------------------
+struct Projection {
+  int u;
+  int v;
+  double sign;  // makes areas positive for loops wound counter clockwise about the normal
+
+  explicit Projection(const Vec3& normal) {
+    const int axis = Geometry::DominantAxis(normal);
+    u = (axis + 1) % 3;
+    v = (axis + 2) % 3;
+    const float along = axis == 0 ? normal.x : axis == 1 ? normal.y : normal.z;
+    sign = along >= 0.0f ? 1.0f : -1.0f;
+  }
+
+  static double Component(const Vec3& p, int axis) {
+    return axis == 0 ? p.x : axis == 1 ? p.y : p.z;
+  }
+
+  double U(const Vec3& p) const { return Component(p, u); }
+  double V(const Vec3& p) const { return Component(p, v); }
+
+  double Area(std::span<const uint32_t> loop, const std::vector<Vec3>& positions) const {
+    double area = 0.0;
+    for (std::size_t i = 0; i < loop.size(); ++i) {
+      const Vec3& p = positions[loop[i]];
+      const Vec3& q = positions[loop[(i + 1) % loop.size()]];
+      area += U(p) * V(q) - U(q) * V(p);
+    }
+    return 0.5 * area * sign;
+  }
+
+  bool Inside(const Vec3& point, std::span<const uint32_t> loop,
+              const std::vector<Vec3>& positions) const {
+    const double x = U(point);
+    const double y = V(point);
+    bool inside = false;
+    for (std::size_t i = 0, j = loop.size() - 1; i < loop.size(); j = i++) {
+      const double xi = U(positions[loop[i]]);
+      const double yi = V(positions[loop[i]]);
+      const double xj = U(positions[loop[j]]);
+      const double yj = V(positions[loop[j]]);
+      if ((yi > y) != (yj > y) && x < (xj - xi) * (y - yi) / (yj - yi) + xi) inside = !inside;
+    }
+    return inside;
+  }
+
+  // Proper crossing of segments pq and rs
+  bool Crosses(const Vec3& p, const Vec3& q, const Vec3& r, const Vec3& s) const {
+    auto turn = [&](const Vec3& a, const Vec3& b, const Vec3& c) {
+      const double value = (U(b) - U(a)) * (V(c) - V(a)) - (V(b) - V(a)) * (U(c) - U(a));
+      return (value > 0.0) - (value < 0.0);
+    };
+    const int d1 = turn(r, s, p);
+    const int d2 = turn(r, s, q);
+    const int d3 = turn(p, q, r);
+    const int d4 = turn(p, q, s);
+    return d1 * d2 < 0 && d3 * d4 < 0;
+  }
+};
+
+// Splits region at the chord between two of its vertices; the chord runs
+// chain.front() -> chain.back() through the interior
+bool SplitRegion(std::vector<std::vector<uint32_t>>& regions, std::span<const uint32_t> chain) {
+  for (std::size_t r = 0; r < regions.size(); ++r) {
+    const std::vector<uint32_t>& region = regions[r];
+    const auto x = std::find(region.begin(), region.end(), chain.front());
+    const auto y = std::find(region.begin(), region.end(), chain.back());
+    if (x == region.end() || y == region.end()) continue;
+
+    const std::size_t size = region.size();
+    const auto ix = static_cast<std::size_t>(x - region.begin());
+    const auto iy = static_cast<std::size_t>(y - region.begin());
+
+    // X -> Y along the region and back along the chord, then Y -> X and forward
+    std::vector<uint32_t> first;
+    std::vector<uint32_t> second;
+    for (std::size_t i = ix;; i = (i + 1) % size) {
+      first.push_back(region[i]);
+      if (i == iy) break;
+    }
+    for (std::size_t k = chain.size() - 1; k-- > 1;) first.push_back(chain[k]);
+    for (std::size_t i = iy;; i = (i + 1) % size) {
+      second.push_back(region[i]);
+      if (i == ix) break;
+    }
+    for (std::size_t k = 1; k + 1 < chain.size(); ++k) second.push_back(chain[k]);
+
+    regions[r] = std::move(first);
+    regions.push_back(std::move(second));
+    return true;
+  }
+  return false;
+}
+
+// Merges the holes into region through bridge edges and triangulates the result
+bool EmitWithHoles(const Context& ctx, const Projection& plane, const Vec3& normal,
+                   std::vector<uint32_t> merged, std::vector<std::vector<uint32_t>> holes,
+                   Pieces& out) {
+  const auto& positions = ctx.positions;
+
+  // Rightmost holes first, each bridged from its rightmost vertex
+  auto rightmost = [&](const std::vector<uint32_t>& hole) {
+    std::size_t best = 0;
+    for (std::size_t i = 1; i < hole.size(); ++i) {
+      if (plane.U(positions[hole[i]]) > plane.U(positions[hole[best]])) best = i;
+    }
+    return best;
+  };
+  std::sort(holes.begin(), holes.end(), [&](const auto& h0, const auto& h1) {
+    return plane.U(positions[h0[rightmost(h0)]]) > plane.U(positions[h1[rightmost(h1)]]);
+  });
+
+  auto blocked = [&](uint32_t m, uint32_t p, std::span<const uint32_t> loop) {
+    for (std::size_t i = 0; i < loop.size(); ++i) {
+      const uint32_t r = loop[i];
+      const uint32_t s = loop[(i + 1) % loop.size()];
+      if (r == m || r == p || s == m || s == p) continue;
+      if (plane.Crosses(positions[m], positions[p], positions[r], positions[s])) return true;
+    }
+    return false;
+  };
+
+  for (std::size_t h = 0; h < holes.size(); ++h) {
+    const std::vector<uint32_t>& hole = holes[h];
+    const std::size_t im = rightmost(hole);
+    const uint32_t m = hole[im];
+
+    // Nearest outer vertex the bridge can reach without crossing anything
+    std::size_t bridge = kNone;
+    double nearest = INFINITY;
+    for (std::size_t i = 0; i < merged.size(); ++i) {
+      const double d = (positions[merged[i]] - positions[m]).LengthSquared();
+      if (d >= nearest) continue;
+      bool clear = !blocked(m, merged[i], merged);
+      for (std::size_t other = h; clear && other < holes.size(); ++other) {
+        clear = !blocked(m, merged[i], holes[other]);
+      }
+      if (!clear) continue;
+      nearest = d;
+      bridge = i;
+    }
+    if (bridge == kNone) return false;
+
+    std::vector<uint32_t> splice;
+    splice.reserve(hole.size() + 2);
+    for (std::size_t k = 0; k <= hole.size(); ++k) splice.push_back(hole[(im + k) % hole.size()]);
+    splice.push_back(merged[bridge]);
+    merged.insert(merged.begin() + static_cast<std::ptrdiff_t>(bridge) + 1, splice.begin(),
+                  splice.end());
+  }
+
+  std::vector<Vec3> points;
+  points.reserve(merged.size());
+  for (uint32_t v : merged) points.push_back(positions[v]);
+  std::vector<uint32_t> corners;
+  Geometry::TriangulatePolygon(points, normal, corners);
+
+  for (std::size_t i = 0; i + 2 < corners.size(); i += 3) {
+    const std::array<uint32_t, 3> triangle{merged[corners[i]], merged[corners[i + 1]],
+                                           merged[corners[i + 2]]};
+    if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[2] == triangle[0]) {
+      continue;
+    }
+    out.Add(triangle);
+  }
+  return true;
+}
+
+// Splits one face of solid s along the segments lying in it. False when the segments
+// do not form chords between loop edges and closed loops inside the face.
+bool SplitFace(const Context& ctx, uint32_t s, uint32_t face, std::span<const Segment> segments,
+               Pieces& out) {
+  const Solid& solid = *ctx.solids[s];
+  const auto loop = solid.Loop(face);
+  const std::size_t n = loop.size();
+  const uint32_t base = ctx.bases[s];
+
+  // Points in the face and their neighbours along the curves
+  std::vector<uint32_t> points;
+  points.reserve(segments.size() * 2);
+  for (const Segment& segment : segments) {
+    points.push_back(segment.from);
+    points.push_back(segment.to);
+  }
+  std::sort(points.begin(), points.end());
+  points.erase(std::unique(points.begin(), points.end()), points.end());
+  auto local = [&](uint32_t point) {
+    return static_cast<uint32_t>(std::lower_bound(points.begin(), points.end(), point) -
+                                 points.begin());
+  };
+
+  std::vector<std::array<uint32_t, 2>> links(points.size(), {kNone, kNone});
+  std::vector<uint8_t> degree(points.size(), 0);
+  for (const Segment& segment : segments) {
+    const uint32_t i = local(segment.from);
+    const uint32_t j = local(segment.to);
+    if (degree[i] == 2 || degree[j] == 2) return false;
+    links[i][degree[i]++] = j;
+    links[j][degree[j]++] = i;
+  }
+
+  // Points on the face's own loop edges, ordered along the loop
+  struct BoundaryPoint {
+    uint32_t loopEdge;
+    double param;
+    uint32_t local;
+
+    bool operator<(const BoundaryPoint& other) const {
+      return loopEdge != other.loopEdge ? loopEdge < other.loopEdge : param < other.param;
+    }
+  };
+  std::vector<BoundaryPoint> boundary;
+  std::vector<uint8_t> onBoundary(points.size(), 0);
+  for (uint32_t l = 0; l < points.size(); ++l) {
+    const uint64_t key = ctx.pointKeys[points[l]];
+    if (KeyOwner(key) != s) continue;
+
+    // On a triangulation diagonal the point is inside the face
+    const Edge& edge = solid.edges[KeyEdge(key)];
+    const auto ia = static_cast<std::size_t>(std::find(loop.begin(), loop.end(), edge.a) -
+                                             loop.begin());
+    const auto ib = static_cast<std::size_t>(std::find(loop.begin(), loop.end(), edge.b) -
+                                             loop.begin());
+    if (ia == n || ib == n) continue;
+    const double t = ctx.pointParams[points[l]];
+    if ((ia + 1) % n == ib) {
+      boundary.push_back({static_cast<uint32_t>(ia), t, l});
+    } else if ((ib + 1) % n == ia) {
+      boundary.push_back({static_cast<uint32_t>(ib), 1.0 - t, l});
+    } else {
+      continue;
+    }
+    onBoundary[l] = 1;
+  }
+  for (uint32_t l = 0; l < points.size(); ++l) {
+    if (degree[l] != (onBoundary[l] ? 1 : 2)) return false;
+  }
+  std::sort(boundary.begin(), boundary.end());
+
+  // The loop with its boundary points, then cut by every chord
+  std::vector<std::vector<uint32_t>> regions(1);
+  for (std::size_t i = 0, b = 0; i < n; ++i) {
+    regions[0].push_back(base + loop[i]);
+    for (; b < boundary.size() && boundary[b].loopEdge == i; ++b) {
+      regions[0].push_back(ctx.pointBase + points[boundary[b].local]);
+    }
+  }
+
+  std::vector<uint8_t> visited(points.size(), 0);
+  std::vector<uint32_t> chain;
+  auto walk = [&](uint32_t start) {
+    chain.clear();
+    uint32_t previous = kNone;
+    uint32_t current = start;
+    while (true) {
+      visited[current] = 1;
+      chain.push_back(ctx.pointBase + points[current]);
+      if (current != start && onBoundary[current]) return true;
+      const uint32_t next = links[current][0] != previous ? links[current][0] : links[current][1];
+      if (next == kNone) return false;
+      if (next == start) return !onBoundary[start];
+      if (visited[next]) return false;
+      previous = current;
+      current = next;
+    }
+  };
+
+  for (const BoundaryPoint& start : boundary) {
+    if (visited[start.local]) continue;
+    if (!walk(start.local) || !SplitRegion(regions, chain)) return false;
+  }
+
+  std::vector<std::vector<uint32_t>> loops;
+  for (uint32_t l = 0; l < points.size(); ++l) {
+    if (visited[l]) continue;
+    if (!walk(l)) return false;
+    loops.push_back(chain);
+  }
+
+  const Vec3& normal = solid.normals[face];
+  const Projection plane(normal);
+  std::vector<double> areas;
+  for (const auto& region : regions) areas.push_back(plane.Area(region, ctx.positions));
+  std::vector<std::vector<std::vector<uint32_t>>> holes(regions.size());
+
+  // Closed loops become holes in the smallest region around them and regions of their
+  // own. Larger loops go first so a nested loop finds the loop it sits in.
+  std::vector<double> loopAreas;
+  for (auto& l : loops) {
+    double area = plane.Area(l, ctx.positions);
+    if (area < 0.0) {
+      std::reverse(l.begin(), l.end());
+      area = -area;
+    }
+    loopAreas.push_back(area);
+  }
+  std::vector<std::size_t> order(loops.size());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::sort(order.begin(), order.end(),
+            [&](std::size_t i, std::size_t j) { return loopAreas[i] > loopAreas[j]; });
+
+  for (std::size_t i : order) {
+    std::size_t container = kNone;
+    for (std::size_t k = 0; k < loops[i].size() && container == kNone; ++k) {
+      const Vec3& probe = ctx.positions[loops[i][k]];
+      for (std::size_t r = 0; r < regions.size(); ++r) {
+        if (container != kNone && std::abs(areas[r]) >= std::abs(areas[container])) continue;
+        if (plane.Inside(probe, regions[r], ctx.positions)) container = r;
+      }
+    }
+
+    // A loop rounded onto the outline of its region (a flush contact) has no point
+    // strictly inside anything; take the smallest region big enough to hold it
+    for (std::size_t r = 0; r < regions.size() && container == kNone; ++r) {
+      if (std::abs(areas[r]) < loopAreas[i]) continue;
+      if (container == kNone || std::abs(areas[r]) < std::abs(areas[container])) container = r;
+    }
+    if (container == kNone) return false;
+
+    holes[container].emplace_back(loops[i].rbegin(), loops[i].rend());
+    regions.push_back(loops[i]);
+    areas.push_back(loopAreas[i]);
+    holes.emplace_back();
+  }
+
+  // Flush contacts cut regions an infinitesimal wide; their points round onto each other
+  // and the region is left with no area at all
+  for (std::size_t r = 0; r < regions.size(); ++r) {
+    double area = std::abs(areas[r]);
+    double total = area;
+    for (const auto& hole : holes[r]) {
+      const double holeArea = std::abs(plane.Area(hole, ctx.positions));
+      area -= holeArea;
+      total += holeArea;
+    }
+    const bool flat = std::abs(area) <= 1e-12 * total;
+
+    if (flat) {
+      // Never output, so there is nothing to triangulate; it only has to join its
+      // neighbours for classification. Holes hang off the first vertex.
+      std::vector<uint32_t> joined(regions[r]);
+      for (const auto& hole : holes[r]) {
+        joined.push_back(regions[r].front());
+        joined.insert(joined.end(), hole.begin(), hole.end());
+        joined.push_back(hole.front());
+      }
+      out.Add(joined, true);
+    } else if (holes[r].empty()) {
+      out.Add(regions[r]);
+    } else if (!EmitWithHoles(ctx, plane, normal, regions[r], holes[r], out)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// -------------------------------------------------
+// Classification
+// -------------------------------------------------
+// Union-find over pieces, tracking whether each piece is on the other side of the other
+// solid from its root
+class SideSets {
+ public:
+  explicit SideSets(std::size_t count) : parent_(count), parity_(count, 0) {
+    std::iota(parent_.begin(), parent_.end(), 0u);
+  }
+
+  uint32_t Find(uint32_t piece, uint8_t& parity) {
+    uint32_t root = piece;
+    parity = 0;
+    while (parent_[root] != root) {
+      parity ^= parity_[root];
+      root = parent_[root];
+    }
+
+    // Compress, keeping each parity relative to the root
+    uint8_t remaining = parity;
+    while (parent_[piece] != root && parent_[piece] != piece) {
+      const uint32_t next = parent_[piece];
+      const uint8_t step = parity_[piece];
+      parent_[piece] = root;
+      parity_[piece] = remaining;
+      remaining ^= step;
+      piece = next;
+    }
+    return root;
+  }
+
+  // False when the pieces are already related the other way
+  bool Join(uint32_t a, uint32_t b, uint8_t opposite) {
+    uint8_t pa = 0;
+    uint8_t pb = 0;
+    const uint32_t ra = Find(a, pa);
+    const uint32_t rb = Find(b, pb);
+    if (ra == rb) return (pa ^ pb) == opposite;
+    parent_[rb] = ra;
+    parity_[rb] = pa ^ pb ^ opposite;
+    return true;
+  }
+
+ private:
+  std::vector<uint32_t> parent_;
+  std::vector<uint8_t> parity_;
+};
+
+// Pieces on either side of an intersection curve lie on opposite sides of the other
+// solid, pieces sharing any other edge on the same side. One exact point test per
+// connected shell settles the rest.
+bool Classify(const Context& ctx, uint32_t s, const Pieces& pieces,
+              std::span<const uint64_t> curveEdges, std::vector<uint8_t>& inside) {
+  const auto count = static_cast<uint32_t>(pieces.Count());
+  SideSets sets(count);
+
+  std::vector<Edge> edges;
+  std::vector<uint32_t> firstUse;
+  Topology::EdgeTable table(edges);
+  table.Reserve(pieces.vertices.size() / 2 + 16);
+  firstUse.reserve(pieces.vertices.size() / 2 + 16);
+  for (uint32_t p = 0; p < count; ++p) {
+    const auto loop = pieces.Loop(p);
+    for (std::size_t i = 0; i < loop.size(); ++i) {
+      const uint32_t a = loop[i];
+      const uint32_t b = loop[(i + 1) % loop.size()];
+      const uint32_t edge = table.FindOrAdd(a, b);
+      if (edge == firstUse.size()) {
+        firstUse.push_back(p);
+        continue;
+      }
+      const bool curve = a >= ctx.pointBase && b >= ctx.pointBase &&
+                         std::binary_search(curveEdges.begin(), curveEdges.end(), EdgeKey(a, b));
+      if (!sets.Join(firstUse[edge], p, curve ? 1 : 0)) return false;
+    }
+  }
+
+  const Solid& other = *ctx.solids[1 - s];
+  const bool shifted = ctx.solids[s]->shifted;
+  std::vector<int8_t> rootInside(count, -1);
+  for (uint32_t p = 0; p < count; ++p) {
+    uint8_t parity = 0;
+    const uint32_t root = sets.Find(p, parity);
+    if (rootInside[root] >= 0) continue;
+
+    // Original vertices of the piece lie off the other solid, exactly
+    for (uint32_t v : pieces.Loop(p)) {
+      if (v >= ctx.pointBase) continue;
+      rootInside[root] =
+          static_cast<int8_t>(Contains(other, ctx.positions[v], shifted, ctx.motion) ^ parity);
+      break;
+    }
+  }
+
+  inside.resize(count);
+  for (uint32_t p = 0; p < count; ++p) {
+    uint8_t parity = 0;
+    const uint32_t root = sets.Find(p, parity);
+    if (rootInside[root] < 0) return false;
+    inside[p] = static_cast<uint8_t>(rootInside[root] ^ parity);
+  }
+  return true;
+}
+
+// -------------------------------------------------
+// Output
+// -------------------------------------------------
+// Drops repeated vertices and back and forth spikes left by welding; an empty loop has
+// collapsed completely
+void CleanLoop(std::vector<uint32_t>& loop) {
+  std::vector<uint32_t> out;
+  out.reserve(loop.size());
+  for (uint32_t v : loop) {
+    if (!out.empty() && out.back() == v) continue;
+    if (out.size() >= 2 && out[out.size() - 2] == v) {
+      out.pop_back();
+      continue;
+    }
+    out.push_back(v);
+  }
+  while (out.size() >= 2) {
+    const std::size_t size = out.size();
+    if (out.front() == out.back()) {
+      out.pop_back();
+    } else if (size >= 3 && out[size - 2] == out.front()) {
+      out.resize(size - 2);
+    } else if (size >= 3 && out.back() == out[1]) {
+      out.erase(out.begin(), out.begin() + 2);
+    } else {
+      break;
+    }
+  }
+  if (out.size() < 3) out.clear();
+  loop = std::move(out);
+}
+
+// The loop rotated to start at its smallest vertex, optionally walked backwards
+std::vector<uint32_t> Canonical(std::span<const uint32_t> loop, bool reversed) {
+  const std::size_t n = loop.size();
+  const auto start =
+      static_cast<std::size_t>(std::min_element(loop.begin(), loop.end()) - loop.begin());
+  std::vector<uint32_t> result(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    result[i] = reversed ? loop[(start + n - i) % n] : loop[(start + i) % n];
+  }
+  return result;
+}
+
+// Removes pairs of faces over the same vertices wound opposite ways, the two sides of a
+// flush contact that welding closed
+void CancelOpposedFaces(Pieces& faces) {
+  const std::size_t count = faces.Count();
+  // Summing mixed ids makes the hash independent of where the loop starts and which way
+  // it runs
+  std::vector<std::pair<uint64_t, uint32_t>> hashes(count);
+  for (uint32_t f = 0; f < count; ++f) {
+    uint64_t hash = 0;
+    for (uint32_t v : faces.Loop(f)) {
+      uint64_t mixed = (v + 0x9E3779B97F4A7C15ull) * 0xBF58476D1CE4E5B9ull;
+      hash += mixed ^ (mixed >> 31);
+    }
+    hashes[f] = {hash, f};
+  }
+  std::sort(hashes.begin(), hashes.end());
+
+  std::vector<uint8_t> removed(count, 0);
+  bool any = false;
+  for (std::size_t i = 0; i < count;) {
+    std::size_t j = i + 1;
+    while (j < count && hashes[j].first == hashes[i].first) ++j;
+    for (std::size_t x = i; x < j; ++x) {
+      const uint32_t f = hashes[x].second;
+      for (std::size_t y = x + 1; y < j && !removed[f]; ++y) {
+        const uint32_t g = hashes[y].second;
+        if (removed[g] || faces.Loop(f).size() != faces.Loop(g).size()) continue;
+        if (Canonical(faces.Loop(f), false) == Canonical(faces.Loop(g), true)) {
+          removed[f] = removed[g] = 1;
+          any = true;
+        }
+      }
+    }
+    i = j;
+  }
+  if (!any) return;
+
+  Pieces kept;
+  for (std::size_t f = 0; f < count; ++f) {
+    if (!removed[f]) kept.Add(faces.Loop(f));
+  }
+  faces = std::move(kept);
+}
+
+// Dropping collapsed regions leaves their neighbours meeting along one line, one side
+// with extra points on it. Splits every unmatched edge at the unmatched vertices lying
+// exactly on it so the two sides pair up again.
+void SplitTJunctions(Pieces& faces, const std::vector<Vec3>& positions) {
+  std::vector<uint64_t> directed;
+  directed.reserve(faces.vertices.size());
+  for (std::size_t f = 0; f < faces.Count(); ++f) {
+    const auto loop = faces.Loop(f);
+    for (std::size_t i = 0; i < loop.size(); ++i) {
+      directed.push_back(static_cast<uint64_t>(loop[i]) << 32 | loop[(i + 1) % loop.size()]);
+    }
+  }
+  std::sort(directed.begin(), directed.end());
+  auto paired = [&](uint32_t a, uint32_t b) {
+    return std::binary_search(directed.begin(), directed.end(),
+                              static_cast<uint64_t>(b) << 32 | a);
+  };
+
+  std::vector<uint32_t> open;
+  for (uint64_t edge : directed) {
+    const auto a = static_cast<uint32_t>(edge >> 32);
+    const auto b = static_cast<uint32_t>(edge);
+    if (paired(a, b)) continue;
+    open.push_back(a);
+    open.push_back(b);
+  }
+  if (open.empty()) return;
+  std::sort(open.begin(), open.end());
+  open.erase(std::unique(open.begin(), open.end()), open.end());
+
+  Pieces split;
+  std::vector<uint32_t> loop;
+  std::vector<std::pair<double, uint32_t>> between;
+  for (std::size_t f = 0; f < faces.Count(); ++f) {
+    const auto face = faces.Loop(f);
+    loop.clear();
+    for (std::size_t i = 0; i < face.size(); ++i) {
+      const uint32_t a = face[i];
+      const uint32_t b = face[(i + 1) % face.size()];
+      loop.push_back(a);
+      if (paired(a, b)) continue;
+
+      const Vec3& p = positions[a];
+      const Vec3& q = positions[b];
+      const double dx = static_cast<double>(q.x) - p.x;
+      const double dy = static_cast<double>(q.y) - p.y;
+      const double dz = static_cast<double>(q.z) - p.z;
+      const double length = dx * dx + dy * dy + dz * dz;
+      between.clear();
+      for (uint32_t w : open) {
+        if (w == a || w == b) continue;
+        const Vec3& r = positions[w];
+        if (Geometry::Orient2dAlong(p, q, r, 0) != 0.0 ||
+            Geometry::Orient2dAlong(p, q, r, 1) != 0.0 ||
+            Geometry::Orient2dAlong(p, q, r, 2) != 0.0) {
+          continue;
+        }
+        const double t = ((r.x - p.x) * dx + (r.y - p.y) * dy + (r.z - p.z) * dz) / length;
+        if (t > 0.0 && t < 1.0) between.emplace_back(t, w);
+      }
+      std::sort(between.begin(), between.end());
+      for (const auto& [t, w] : between) loop.push_back(w);
+    }
+    split.Add(loop);
+  }
+  faces = std::move(split);
+}
+
+}  // namespace
+
+const char* OperationName(Operation operation) {
+  switch (operation) {
+    case Operation::Union: return "Union";
+    case Operation::Difference: return "Difference";
+    case Operation::Intersection: return "Intersection";
+  }
+  return "Unknown";
+}
+
+std::optional<MeshData> Combine(const Model& model, VolumeId a, VolumeId b, Operation operation) {
+  if (a == b) return std::nullopt;
+  std::array<std::optional<Solid>, 2> extracted;
+  Jobs::ParallelFor(2, 1, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t s = begin; s < end; ++s) {
+      extracted[s] = ExtractSolid(model, s == 0 ? a : b, s == 1);
+    }
+  });
+  std::optional<Solid>& solidA = extracted[0];
+  std::optional<Solid>& solidB = extracted[1];
+  if (!solidA || !solidB) return std::nullopt;
+  if (solidA->edges.size() > 0x7FFFFFFFu || solidB->edges.size() > 0x7FFFFFFFu) {
+    return std::nullopt;
+  }
+  const Solid& sa = *solidA;
+  const Solid& sb = *solidB;
+
+  // B grows into flush neighbours for union and difference, so shared faces become an
+  // overlap; it shrinks away from them for intersection
+  const Perturbation motion{sb.bvh.Bounds().Center(),
+                            operation == Operation::Intersection ? -1.0f : 1.0f};
+
+  // -------------------------------------------------
+  // Cut every overlapping triangle pair
+  // -------------------------------------------------
+  std::vector<Cut> cuts;
+  std::mutex cutsMutex;
+  std::atomic<bool> ok{true};
+  Jobs::ParallelFor(sa.triangles.size(), 512, [&](std::size_t begin, std::size_t end) {
+    std::vector<Cut> found;
+    Cut cut{};
+    for (std::size_t ta = begin; ta < end; ++ta) {
+      Geometry::Aabb box;
+      for (uint32_t v : sa.triangles[ta].corners) box.Expand(sa.positions[v]);
+      sb.bvh.Query(box, [&](uint32_t tb) {
+        const int ends = CutTriangles(sa, static_cast<uint32_t>(ta), sb, tb, motion, cut);
+        if (ends == 2) {
+          found.push_back(cut);
+        } else if (ends != 0) {
+          ok = false;
+        }
+      });
+    }
+    if (found.empty()) return;
+    std::lock_guard lock(cutsMutex);
+    cuts.insert(cuts.end(), found.begin(), found.end());
+  });
+  if (!ok) return std::nullopt;
+  std::sort(cuts.begin(), cuts.end(), [](const Cut& x, const Cut& y) {
+    return x.triangleA != y.triangleA ? x.triangleA < y.triangleA : x.triangleB < y.triangleB;
+  });
+
+  // -------------------------------------------------
+  // Intersection points, numbered after both solids' vertices
+  // -------------------------------------------------
+  Context ctx;
+  ctx.solids = {&sa, &sb};
+  ctx.motion = motion;
+  ctx.bases = {0, static_cast<uint32_t>(sa.positions.size())};
+  ctx.pointBase = static_cast<uint32_t>(sa.positions.size() + sb.positions.size());
+
+  for (const Cut& cut : cuts) {
+    ctx.pointKeys.insert(ctx.pointKeys.end(), cut.ends.begin(), cut.ends.end());
+  }
+  std::sort(ctx.pointKeys.begin(), ctx.pointKeys.end());
+  ctx.pointKeys.erase(std::unique(ctx.pointKeys.begin(), ctx.pointKeys.end()),
+                      ctx.pointKeys.end());
+
+  const std::size_t pointCount = ctx.pointKeys.size();
+  ctx.positions.resize(ctx.pointBase + pointCount);
+  ctx.pointParams.resize(pointCount);
+  std::copy(sa.positions.begin(), sa.positions.end(), ctx.positions.begin());
+  std::copy(sb.positions.begin(), sb.positions.end(), ctx.positions.begin() + ctx.bases[1]);
+  Jobs::ParallelFor(pointCount, 1024, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      const uint64_t key = ctx.pointKeys[i];
+      const Solid& owner = *ctx.solids[KeyOwner(key)];
+      const Solid& other = *ctx.solids[1 - KeyOwner(key)];
+      const Edge& edge = owner.edges[KeyEdge(key)];
+      const Solid::Triangle& t = other.triangles[KeyTriangle(key)];
+      const Vec3& p = owner.positions[edge.a];
+      const Vec3& q = owner.positions[edge.b];
+
+      const double dp = Geometry::Orient3d(Corner(other, t, 0), Corner(other, t, 1),
+                                           Corner(other, t, 2), p);
+      const double dq = Geometry::Orient3d(Corner(other, t, 0), Corner(other, t, 1),
+                                           Corner(other, t, 2), q);
+      const double param = dp != dq ? std::clamp(dp / (dp - dq), 0.0, 1.0) : 0.5;
+      ctx.pointParams[i] = param;
+      ctx.positions[ctx.pointBase + i] =
+          Vec3(static_cast<float>(p.x + (static_cast<double>(q.x) - p.x) * param),
+               static_cast<float>(p.y + (static_cast<double>(q.y) - p.y) * param),
+               static_cast<float>(p.z + (static_cast<double>(q.z) - p.z) * param));
+    }
+  });
+
+  auto pointIndex = [&](uint64_t key) {
+    return static_cast<uint32_t>(
+        std::lower_bound(ctx.pointKeys.begin(), ctx.pointKeys.end(), key) - ctx.pointKeys.begin());
+  };
+  std::array<std::vector<Segment>, 2> segments;
+  std::vector<uint64_t> curveEdges;
+  curveEdges.reserve(cuts.size());
+  for (const Cut& cut : cuts) {
+    const uint32_t from = pointIndex(cut.ends[0]);
+    const uint32_t to = pointIndex(cut.ends[1]);
+    segments[0].push_back({sa.triangles[cut.triangleA].face, from, to});
+    segments[1].push_back({sb.triangles[cut.triangleB].face, from, to});
+    curveEdges.push_back(EdgeKey(ctx.pointBase + from, ctx.pointBase + to));
+  }
+  std::sort(curveEdges.begin(), curveEdges.end());
+
+  // -------------------------------------------------
+  // Split the cut faces, then classify every piece
+  // -------------------------------------------------
+  std::array<Pieces, 2> pieces;
+  std::array<std::vector<uint8_t>, 2> inside;
+  for (uint32_t s = 0; s < 2; ++s) {
+    const Solid& solid = *ctx.solids[s];
+    std::vector<Segment>& list = segments[s];
+    std::sort(list.begin(), list.end());
+
+    std::vector<std::size_t> starts;
+    for (std::size_t i = 0; i < list.size(); ++i) {
+      if (i == 0 || list[i].face != list[i - 1].face) starts.push_back(i);
+    }
+    starts.push_back(list.size());
+
+    const std::size_t cutFaces = starts.size() - 1;
+    std::vector<Pieces> split(cutFaces);
+    Jobs::ParallelFor(cutFaces, 16, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        const std::span<const Segment> faceSegments(list.data() + starts[i],
+                                                    starts[i + 1] - starts[i]);
+        if (!SplitFace(ctx, s, faceSegments.front().face, faceSegments, split[i])) ok = false;
+      }
+    });
+    if (!ok) return std::nullopt;
+
+    Pieces& out = pieces[s];
+    out.vertices.reserve(solid.loops.size() + solid.loops.size() / 8);
+    out.offsets.reserve(solid.FaceCount() + 1);
+    std::vector<uint32_t> loop;
+    for (uint32_t f = 0, next = 0; f < solid.FaceCount(); ++f) {
+      if (next < cutFaces && list[starts[next]].face == f) {
+        out.Append(split[next++]);
+        continue;
+      }
+      loop.clear();
+      for (uint32_t v : solid.Loop(f)) loop.push_back(ctx.bases[s] + v);
+      out.Add(loop);
+    }
+
+    if (!Classify(ctx, s, out, curveEdges, inside[s])) return std::nullopt;
+  }
+
+  // -------------------------------------------------
+  // Keep the pieces the operation selects
+  // -------------------------------------------------
+  auto keep = [&](uint32_t s, bool in) {
+    switch (operation) {
+      case Operation::Union: return !in;
+      case Operation::Intersection: return in;
+      case Operation::Difference: return s == 0 ? !in : in;
+    }
+    return false;
+  };
+
+  // Flush contacts leave points on top of vertices; weld every position to the
+  // lowest numbered vertex sharing it exactly
+  std::vector<uint8_t> used(ctx.positions.size(), 0);
+  for (uint32_t s = 0; s < 2; ++s) {
+    for (uint32_t p = 0; p < pieces[s].Count(); ++p) {
+      if (!keep(s, inside[s][p]) || pieces[s].collapsed[p]) continue;
+      for (uint32_t v : pieces[s].Loop(p)) used[v] = 1;
+    }
+  }
+
+  // Sorted by value rather than through the index, which keeps the sort in cache
+  struct Located {
+    float x;
+    float y;
+    float z;
+    uint32_t vertex;
+  };
+  std::vector<Located> byPosition;
+  for (uint32_t v = 0; v < used.size(); ++v) {
+    const Vec3& p = ctx.positions[v];
+    if (used[v]) byPosition.push_back({p.x, p.y, p.z, v});
+  }
+  std::sort(byPosition.begin(), byPosition.end(), [](const Located& p, const Located& q) {
+    if (p.x != q.x) return p.x < q.x;
+    if (p.y != q.y) return p.y < q.y;
+    if (p.z != q.z) return p.z < q.z;
+    return p.vertex < q.vertex;
+  });
+  std::vector<uint32_t> remap(ctx.positions.size(), kNone);
+  for (std::size_t i = 0; i < byPosition.size(); ++i) {
+    const Located& p = byPosition[i];
+    const bool same = i > 0 && p.x == byPosition[i - 1].x && p.y == byPosition[i - 1].y &&
+                      p.z == byPosition[i - 1].z;
+    remap[p.vertex] = same ? remap[byPosition[i - 1].vertex] : p.vertex;
+  }
+
+  Pieces faces;
+  std::vector<uint32_t> loop;
+  bool dropped = false;
+  for (uint32_t s = 0; s < 2; ++s) {
+    const bool flip = operation == Operation::Difference && s == 1;
+    for (uint32_t p = 0; p < pieces[s].Count(); ++p) {
+      if (!keep(s, inside[s][p])) continue;
+      if (pieces[s].collapsed[p]) {
+        dropped = true;
+        continue;
+      }
+      loop.clear();
+      for (uint32_t v : pieces[s].Loop(p)) loop.push_back(remap[v]);
+      if (flip) std::reverse(loop.begin(), loop.end());
+      CleanLoop(loop);
+      if (!loop.empty()) faces.Add(loop);
+    }
+  }
+  CancelOpposedFaces(faces);
+  if (dropped) SplitTJunctions(faces, ctx.positions);
+
+  // -------------------------------------------------
+  // Rebuild as mesh data with one volume
+  // -------------------------------------------------
+  MeshData mesh;
+  if (faces.Count() == 0) return mesh;
+
+  std::vector<uint32_t> compact(ctx.positions.size(), kNone);
+  for (uint32_t& v : faces.vertices) {
+    if (compact[v] == kNone) {
+      compact[v] = static_cast<uint32_t>(mesh.positions.size());
+      mesh.positions.push_back(ctx.positions[v]);
+    }
+    v = compact[v];
+  }
+
+  Topology::EdgeTable table(mesh.edges);
+  table.Reserve(faces.vertices.size() / 2 + 16);
+  mesh.faceEdges.reserve(faces.vertices.size());
+  mesh.faceOffsets.reserve(faces.Count() + 1);
+  for (std::size_t f = 0; f < faces.Count(); ++f) Topology::AddFaceLoop(mesh, table, faces.Loop(f));
+
+  std::vector<uint32_t> volumeFaces(mesh.FaceCount());
+  std::iota(volumeFaces.begin(), volumeFaces.end(), 0u);
+  mesh.AddVolume(volumeFaces);
+  return mesh;
+}
+
+}  // namespace Csg
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "Core/MeshData.h"
+#include "Core/Primitives.h"
+
+class Model;
+
+// Boolean operations between closed volumes (constructive solid geometry). Both
+// operands are triangulated, intersecting triangle pairs are found through a BVH and
+// cut in parallel with exact predicates, faces are split along the intersection
+// curves and every piece is classified inside or outside the other solid. The kept
+// pieces are rebuilt as standalone mesh data with one volume.
+//
+// Touching and coplanar faces are resolved by simulation of simplicity: the second
+// operand counts as grown (union, difference) or shrunk (intersection) by an
+// infinitesimal, so no configuration is degenerate and flush faces overlap or come
+// apart the way the operation wants. The infinitesimal regions this leaves are
+// dropped once intersection points are rounded and welded, and pairs of coincident
+// opposite faces cancel.
+namespace Csg {
+
+enum class Operation : uint8_t { Union, Difference, Intersection };
+
+inline constexpr uint8_t kOperationCount = 3;
+
+const char* OperationName(Operation operation);
+
+// The combined solid; empty mesh data when nothing is left (e.g. the intersection of
+// disjoint solids). nullopt when an operand is missing, not a closed consistently wound
+// shell, or the cut does not close up (self intersecting or broken input).
+std::optional<MeshData> Combine(const Model& model, VolumeId a, VolumeId b, Operation operation);
+
+}  // namespace Csg
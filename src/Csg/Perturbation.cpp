@@ -0,0 +1,96 @@
+#include "Csg/Perturbation.h"
+
+#include <array>
+#include <bit>
+
+#include "Geometry/Predicates.h"
+
+namespace Csg {
+namespace {
+
+int Sign(double v) { return (v > 0.0) - (v < 0.0); }
+
+// Sign of (1, e, e^2) . (x, y, z) as e -> 0
+int LexicographicSign(double x, double y, double z) {
+  if (x != 0.0) return Sign(x);
+  if (y != 0.0) return Sign(y);
+  return Sign(z);
+}
+
+}  // namespace
+
+int PerturbedOrient(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d, unsigned shifted,
+                    const Perturbation& motion) {
+  const int exact = Sign(Geometry::Orient3d(a, b, c, d));
+  if (exact != 0) return exact;
+
+  const int moved = std::popcount(shifted & 0b1111u);
+  if (moved == 0 || moved == 4) return 0;
+
+  // First order: the scaling. In homogeneous form each moved row becomes
+  // (1 + g eps) p_i - g eps center, so the term is -g times the sum of the orientations
+  // with one moved p_i replaced by center. Replacing each of the four points in turn
+  // sums to the (zero) orientation itself, so the fixed points give the same sum with
+  // the opposite sign; use whichever set is smaller.
+  const std::array<const Vec3*, 4> points{&a, &b, &c, &d};
+  const bool useFixed = moved > 2;
+  std::array<std::array<const Vec3*, 4>, 2> replaced{};
+  int terms = 0;
+  for (int i = 0; i < 4; ++i) {
+    if (static_cast<bool>(shifted & (1u << i)) == useFixed) continue;
+    replaced[terms] = points;
+    replaced[terms][i] = &motion.center;
+    ++terms;
+  }
+  const auto orient = [](const std::array<const Vec3*, 4>& q) {
+    return Geometry::Orient3d(*q[0], *q[1], *q[2], *q[3]);
+  };
+  const double sum = terms == 1 ? orient(replaced[0])
+                                : Geometry::Orient3dSum(*replaced[0][0], *replaced[0][1],
+                                                        *replaced[0][2], *replaced[0][3],
+                                                        *replaced[1][0], *replaced[1][1],
+                                                        *replaced[1][2], *replaced[1][3]);
+  const int scaled = Sign(sum) * (useFixed ? 1 : -1) * (motion.growth > 0.0f ? 1 : -1);
+  if (scaled != 0) return scaled;
+
+  // Second order: the translation. Move the shifted points last; every swap of
+  // neighbours flips the determinant.
+  std::array<const Vec3*, 4> p{};
+  int count = 0;
+  int swaps = 0;
+  for (int i = 0; i < 4; ++i) {
+    if (!(shifted & (1u << i))) {
+      swaps += std::popcount(shifted & ((1u << i) - 1));
+      p[count++] = points[i];
+    }
+  }
+  const int unshifted = count;
+  for (int i = 0; i < 4; ++i) {
+    if (shifted & (1u << i)) p[count++] = points[i];
+  }
+  const int parity = swaps % 2 == 0 ? 1 : -1;
+
+  // With u = p1 - p0, v = p2 - p0, w = p3 - p0 and shift s, the term is s . n below
+  const Vec3& p0 = *p[0];
+  const Vec3& p1 = *p[1];
+  const Vec3& p2 = *p[2];
+  const Vec3& p3 = *p[3];
+  switch (unshifted) {
+    case 3:  // only w moves: n = u x v
+      return parity * LexicographicSign(Geometry::Orient2dAlong(p0, p1, p2, 0),
+                                        Geometry::Orient2dAlong(p0, p1, p2, 1),
+                                        Geometry::Orient2dAlong(p0, p1, p2, 2));
+    case 2:  // v and w move: n = u x (v - w)
+      return parity * LexicographicSign(Geometry::CrossAlong(p0, p1, p3, p2, 0),
+                                        Geometry::CrossAlong(p0, p1, p3, p2, 1),
+                                        Geometry::CrossAlong(p0, p1, p3, p2, 2));
+    case 1:  // u, v and w move: n = (p2 - p1) x (p3 - p1)
+      return parity * LexicographicSign(Geometry::Orient2dAlong(p1, p2, p3, 0),
+                                        Geometry::Orient2dAlong(p1, p2, p3, 1),
+                                        Geometry::Orient2dAlong(p1, p2, p3, 2));
+    default:
+      return 0;
+  }
+}
+
+}  // namespace Csg
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Utilities/Vec3.h"
+
+namespace Csg {
+
+// The symbolic motion of the second operand of a boolean: scaled about center by
+// 1 + growth * eps, then translated by eps^2 along (1, e, e^2) with e vanishing too.
+// Growing or shrinking settles flush faces the way the operation wants them (they end
+// up overlapping or apart, never as a zero thickness layer); the translation breaks
+// whatever ties the scaling leaves.
+struct Perturbation {
+  Vec3 center;
+  float growth = 1.0f;  // +1 grows, -1 shrinks
+};
+
+// Orient3d under simulation of simplicity. Arguments whose bit is set in shifted (bit 0
+// for a, bit 3 for d) count as moved by motion, so points of the two operands of a
+// boolean are never coplanar. Returns the sign, +1 or -1; 0 only when all or none of the
+// points are shifted, or the answer does not depend on the motion (a degenerate
+// triangle, or parallel segments).
+int PerturbedOrient(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d, unsigned shifted,
+                    const Perturbation& motion);
+
+}  // namespace Csg
@@ -0,0 +1,204 @@
+#include "Csg/Solid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+#include "Csg/Perturbation.h"
+#include "Geometry/Geometry.h"
+#include "Geometry/Triangulation.h"
+#include "Model/Model.h"
+#include "Topology/EdgeTable.h"
+#include "Topology/Validation.h"
+#include "Utilities/JobSystem.h"
+
+namespace Csg {
+namespace {
+
+constexpr uint32_t kNone = UINT32_MAX;
+constexpr std::size_t kBatch = 256;
+
+// Ray directions with no simple relation to the axes, tried in turn until one passes
+// no triangle edge exactly
+constexpr Vec3 kRayDirections[] = {
+    {0.5773503f, 0.7142857f, 0.3952847f},
+    {-0.2672612f, 0.5345225f, 0.8017837f},
+    {0.8164966f, -0.4082483f, 0.4082483f},
+};
+
+// Conservative segment against box test (slab method), padded so rounding can only
+// admit extra boxes, never reject one the segment touches
+bool SegmentOverlaps(const Vec3& from, const Vec3& to, const Geometry::Aabb& box) {
+  const double origin[3] = {from.x, from.y, from.z};
+  const double delta[3] = {static_cast<double>(to.x) - from.x, static_cast<double>(to.y) - from.y,
+                           static_cast<double>(to.z) - from.z};
+  const double lo[3] = {box.min.x, box.min.y, box.min.z};
+  const double hi[3] = {box.max.x, box.max.y, box.max.z};
+
+  double enter = 0.0;
+  double exit = 1.0;
+  for (int axis = 0; axis < 3; ++axis) {
+    const double pad = 1e-6 * (std::abs(lo[axis]) + std::abs(hi[axis])) + 1e-30;
+    const double min = lo[axis] - pad;
+    const double max = hi[axis] + pad;
+    if (delta[axis] == 0.0) {
+      if (origin[axis] < min || origin[axis] > max) return false;
+      continue;
+    }
+    double t0 = (min - origin[axis]) / delta[axis];
+    double t1 = (max - origin[axis]) / delta[axis];
+    if (t0 > t1) std::swap(t0, t1);
+    enter = std::max(enter, t0);
+    exit = std::min(exit, t1);
+    if (enter > exit) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+// -------------------------------------------------
+// Extraction
+// -------------------------------------------------
+std::optional<Solid> ExtractSolid(const Model& model, VolumeId id, bool shifted) {
+  if (!model.ContainsVolume(id)) return std::nullopt;
+  const Volume& volume = model.GetVolume(id);
+  const auto verdict = model.ValidateVolumes(std::span<const Volume>(&volume, 1), true);
+  if (verdict.front() != Topology::Defect::None) return std::nullopt;
+
+  Solid solid;
+  solid.shifted = shifted;
+
+  // Model vertices are renumbered densely in first use order
+  std::vector<uint32_t> compact(model.Vertices().size(), kNone);
+  solid.loopOffsets.reserve(volume.faces.size() + 1);
+  for (FaceId fid : volume.faces) {
+    const auto loop = model.FaceLoop(fid);
+    if (loop.size() < 3) return std::nullopt;
+    for (VertexId vid : loop) {
+      uint32_t& index = compact[model.VertexIdToIndex(vid)];
+      if (index == kNone) {
+        index = static_cast<uint32_t>(solid.positions.size());
+        solid.positions.push_back(model.GetVertex(vid).position);
+      }
+      solid.loops.push_back(index);
+    }
+    solid.loopOffsets.push_back(static_cast<uint32_t>(solid.loops.size()));
+  }
+
+  // An n-gon always gives n - 2 triangles, so every face knows its slots up front
+  const std::size_t faceCount = solid.FaceCount();
+  std::vector<uint32_t> firstTriangle(faceCount + 1, 0);
+  for (std::size_t f = 0; f < faceCount; ++f) {
+    firstTriangle[f + 1] = firstTriangle[f] + static_cast<uint32_t>(solid.Loop(f).size()) - 2;
+  }
+  solid.triangles.resize(firstTriangle.back());
+  solid.normals.resize(faceCount);
+
+  std::atomic<bool> ok{true};
+  Jobs::ParallelFor(faceCount, kBatch, [&](std::size_t begin, std::size_t end) {
+    std::vector<Vec3> points;
+    std::vector<uint32_t> corners;
+    for (std::size_t f = begin; f < end; ++f) {
+      const auto loop = solid.Loop(f);
+      points.clear();
+      for (uint32_t v : loop) points.push_back(solid.positions[v]);
+      solid.normals[f] = Geometry::PolygonNormal(points);
+
+      corners.clear();
+      Geometry::TriangulatePolygon(points, solid.normals[f], corners);
+      if (corners.size() != 3 * (loop.size() - 2)) {
+        ok = false;
+        continue;
+      }
+      for (std::size_t t = 0; t < loop.size() - 2; ++t) {
+        Solid::Triangle& triangle = solid.triangles[firstTriangle[f] + t];
+        for (int k = 0; k < 3; ++k) triangle.corners[k] = loop[corners[3 * t + k]];
+        triangle.face = static_cast<uint32_t>(f);
+      }
+    }
+  });
+  if (!ok) return std::nullopt;
+
+  // Consistent winding still allows a shell turned inside out
+  double volume6 = 0.0;
+  for (const Solid::Triangle& t : solid.triangles) {
+    const Vec3& a = solid.positions[t.corners[0]];
+    const Vec3& b = solid.positions[t.corners[1]];
+    const Vec3& c = solid.positions[t.corners[2]];
+    volume6 += static_cast<double>(a.Dot(b.Cross(c)));
+  }
+  if (volume6 < 0.0) {
+    for (std::size_t f = 0; f < faceCount; ++f) {
+      std::reverse(solid.loops.begin() + solid.loopOffsets[f],
+                   solid.loops.begin() + solid.loopOffsets[f + 1]);
+      solid.normals[f] = solid.normals[f] * -1.0f;
+    }
+    for (Solid::Triangle& t : solid.triangles) std::swap(t.corners[1], t.corners[2]);
+  }
+
+  Topology::EdgeTable table(solid.edges);
+  table.Reserve(solid.triangles.size() * 3 / 2 + 3);
+  for (Solid::Triangle& t : solid.triangles) {
+    for (int k = 0; k < 3; ++k) t.edges[k] = table.FindOrAdd(t.corners[k], t.corners[(k + 1) % 3]);
+  }
+
+  std::vector<Geometry::Aabb> boxes(solid.triangles.size());
+  Jobs::ParallelFor(boxes.size(), 4096, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      for (uint32_t v : solid.triangles[i].corners) boxes[i].Expand(solid.positions[v]);
+    }
+  });
+  solid.bvh.Build(boxes);
+
+  return solid;
+}
+
+// -------------------------------------------------
+// Point containment
+// -------------------------------------------------
+bool Contains(const Solid& solid, const Vec3& point, bool pointShifted,
+              const Perturbation& motion) {
+  if (solid.bvh.Empty()) return false;
+
+  // Bits for (a, b, c, point) and (point, end, a, b); the ray moves with its point
+  const unsigned planeMask = pointShifted ? 0b1000u : 0b0111u;
+  const unsigned edgeMask = pointShifted ? 0b0011u : 0b1100u;
+
+  const Geometry::Aabb& bounds = solid.bvh.Bounds();
+  const float reach = bounds.Extent().Length() + (point - bounds.Center()).Length() + 1.0f;
+
+  for (const Vec3& direction : kRayDirections) {
+    const Vec3 end = point + direction * reach;
+    int crossings = 0;
+    bool ambiguous = false;
+
+    solid.bvh.Traverse(
+        [&](const Geometry::Aabb& box) { return !ambiguous && SegmentOverlaps(point, end, box); },
+        [&](uint32_t index) {
+          const Solid::Triangle& t = solid.triangles[index];
+          const Vec3& a = solid.positions[t.corners[0]];
+          const Vec3& b = solid.positions[t.corners[1]];
+          const Vec3& c = solid.positions[t.corners[2]];
+
+          // A zero area triangle (collinear loop corners) can not be crossed
+          const int from = PerturbedOrient(a, b, c, point, planeMask, motion);
+          const int to = PerturbedOrient(a, b, c, end, planeMask, motion);
+          if (from == 0 || from == to) return;
+
+          const int ab = PerturbedOrient(point, end, a, b, edgeMask, motion);
+          const int bc = PerturbedOrient(point, end, b, c, edgeMask, motion);
+          const int ca = PerturbedOrient(point, end, c, a, edgeMask, motion);
+          if (ab == 0 || bc == 0 || ca == 0) {
+            ambiguous = true;
+            return;
+          }
+          if (ab == bc && bc == ca) ++crossings;
+        });
+
+    if (!ambiguous) return crossings % 2 == 1;
+  }
+  return false;
+}
+
+}  // namespace Csg
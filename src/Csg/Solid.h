@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Core/Primitives.h"
+#include "Csg/Perturbation.h"
+#include "Geometry/Bvh.h"
+#include "Utilities/Vec3.h"
+
+class Model;
+
+namespace Csg {
+
+// A volume prepared for cutting: vertices renumbered densely, every face's vertex loop
+// wound outward, and the faces triangulated with undirected edges shared between
+// triangles (loop edges and diagonals alike). The BVH holds the triangle bounds.
+struct Solid {
+  struct Triangle {
+    uint32_t corners[3];  // vertex indices, wound outward
+    uint32_t edges[3];    // edges[i] joins corners[i] and corners[(i + 1) % 3]
+    uint32_t face;
+  };
+
+  std::vector<Vec3> positions;
+  std::vector<uint32_t> loops;           // face f = loops[loopOffsets[f], loopOffsets[f + 1])
+  std::vector<uint32_t> loopOffsets{0};
+  std::vector<Vec3> normals;             // outward, per face
+  std::vector<Triangle> triangles;
+  std::vector<Edge> edges;
+  Geometry::Bvh bvh;
+  bool shifted = false;  // the operand moved by the symbolic perturbation
+
+  std::size_t FaceCount() const { return loopOffsets.size() - 1; }
+
+  std::span<const uint32_t> Loop(std::size_t face) const {
+    return std::span<const uint32_t>(loops).subspan(loopOffsets[face],
+                                                    loopOffsets[face + 1] - loopOffsets[face]);
+  }
+};
+
+// nullopt when the volume is missing, not closed or not consistently wound. Inside out
+// shells are flipped so every solid encloses positive volume.
+std::optional<Solid> ExtractSolid(const Model& model, VolumeId id, bool shifted);
+
+// Exact inside test by the parity of ray crossings. pointShifted tells whether point
+// belongs to the operand moved by motion; the two operands never touch, so the answer is
+// always strictly inside or outside.
+bool Contains(const Solid& solid, const Vec3& point, bool pointShifted,
+              const Perturbation& motion);
+
+}  // namespace Csg
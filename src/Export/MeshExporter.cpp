@@ -0,0 +1,274 @@
+#include "MeshExporter.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <vector>
+
+#include "Model/Model.h"
+#include "ModelView/ModelViewBuilder.h"
+#include "Utilities/BufferedWriter.h"
+#include "Utilities/JobSystem.h"
+
+namespace Export {
+
+namespace {
+
+constexpr std::size_t kVerticesPerChunk = 64 * 1024;
+constexpr std::size_t kStlHeaderSize = 80;
+constexpr std::size_t kStlTriangleSize = 50;
+
+// -------------------------------------------------
+// Chunk streaming
+// -------------------------------------------------
+
+// Format chunks [0, chunkCount) in parallel batches of one chunk per thread and write
+// each batch in order. Only one batch of text is alive at a time.
+template <typename FormatChunk>
+Status StreamChunks(std::size_t chunkCount, BufferedWriter& writer, const Options& options,
+                  float progressBegin, float progressEnd, FormatChunk&& formatChunk) {
+  const std::size_t batchSize = Jobs::Concurrency();
+  std::vector<std::string> texts(batchSize);
+
+  for (std::size_t first = 0; first < chunkCount; first += batchSize) {
+    if (options.cancel && options.cancel->load(std::memory_order_relaxed)) {
+      return Status::Cancelled;
+    }
+
+    const std::size_t count = std::min(batchSize, chunkCount - first);
+    Jobs::ParallelFor(count, 1, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        texts[i].clear();
+        formatChunk(first + i, texts[i]);
+      }
+    });
+
+    for (std::size_t i = 0; i < count; ++i) writer.Write(texts[i]);
+    if (!writer.Ok()) return Status::FileError;
+
+    if (options.progress) {
+      const float t = static_cast<float>(first + count) / chunkCount;
+      options.progress(progressBegin + (progressEnd - progressBegin) * t);
+    }
+  }
+  return Status::Ok;
+}
+
+std::size_t ChunkCount(std::size_t items, std::size_t perChunk) {
+  return (items + perChunk - 1) / perChunk;
+}
+
+// -------------------------------------------------
+// OBJ
+// -------------------------------------------------
+
+// Shortest round-trip representation; far cheaper than printf-style formatting
+char* AppendFloat(char* p, char* end, float value) {
+  return std::to_chars(p, end, value).ptr;
+}
+
+char* AppendUInt(char* p, char* end, std::size_t value) {
+  return std::to_chars(p, end, value).ptr;
+}
+
+void FormatObjVertices(const Model& model, std::size_t chunk, std::string& out) {
+  const auto& vertices = model.Vertices();
+  const std::size_t begin = chunk * kVerticesPerChunk;
+  const std::size_t end = std::min(vertices.size(), begin + kVerticesPerChunk);
+
+  char line[128];
+  char* lineEnd = line + sizeof(line);
+  out.reserve((end - begin) * 32);
+  for (std::size_t i = begin; i < end; ++i) {
+    const Vec3& p = vertices[i].position;
+    char* cursor = line;
+    *cursor++ = 'v';
+    *cursor++ = ' ';
+    cursor = AppendFloat(cursor, lineEnd, p.x);
+    *cursor++ = ' ';
+    cursor = AppendFloat(cursor, lineEnd, p.y);
+    *cursor++ = ' ';
+    cursor = AppendFloat(cursor, lineEnd, p.z);
+    *cursor++ = '\n';
+    out.append(line, cursor);
+  }
+}
+
+void FormatObjFaces(const TriangleChunk& triangles, std::string& out) {
+  char line[128];
+  char* lineEnd = line + sizeof(line);
+  out.reserve(triangles.TriangleCount() * 24);
+  for (std::size_t t = 0; t < triangles.TriangleCount(); ++t) {
+    char* cursor = line;
+    *cursor++ = 'f';
+    for (int k = 0; k < 3; ++k) {
+      *cursor++ = ' ';
+      // OBJ indices are 1-based
+      cursor = AppendUInt(cursor, lineEnd, triangles.vertexIndices[t * 3 + k] + std::size_t{1});
+    }
+    *cursor++ = '\n';
+    out.append(line, cursor);
+  }
+}
+
+Result WriteObj(const Model& model, BufferedWriter& writer, const Options& options) {
+  Result result;
+  const ModelViewBuilder builder(model);
+
+  writer.Write("# Exported by CAD\n");
+
+  const std::size_t vertexChunks = ChunkCount(model.Vertices().size(), kVerticesPerChunk);
+  result.status = StreamChunks(vertexChunks, writer, options, 0.0f, 0.3f,
+                               [&](std::size_t chunk, std::string& out) {
+                                 FormatObjVertices(model, chunk, out);
+                               });
+  if (!result.Ok()) return result;
+
+  const std::size_t faceChunks = ChunkCount(model.Faces().size(), options.facesPerChunk);
+  std::vector<std::size_t> triangleCounts(faceChunks, 0);
+  result.status = StreamChunks(faceChunks, writer, options, 0.3f, 1.0f,
+                               [&](std::size_t chunk, std::string& out) {
+                                 TriangleChunk triangles;
+                                 builder.BuildFaceTriangles(chunk * options.facesPerChunk,
+                                                            options.facesPerChunk, triangles);
+                                 triangleCounts[chunk] = triangles.TriangleCount();
+                                 FormatObjFaces(triangles, out);
+                               });
+  if (!result.Ok()) return result;
+
+  for (std::size_t count : triangleCounts) result.triangleCount += count;
+  return result;
+}
+
+// -------------------------------------------------
+// STL (binary)
+// -------------------------------------------------
+
+void FormatStlTriangles(const Model& model, const TriangleChunk& triangles, std::string& out) {
+  const auto& vertices = model.Vertices();
+
+  out.resize(triangles.TriangleCount() * kStlTriangleSize);
+  char* record = out.data();
+  for (std::size_t t = 0; t < triangles.TriangleCount(); ++t) {
+    const Vec3& a = vertices[triangles.vertexIndices[t * 3 + 0]].position;
+    const Vec3& b = vertices[triangles.vertexIndices[t * 3 + 1]].position;
+    const Vec3& c = vertices[triangles.vertexIndices[t * 3 + 2]].position;
+
+    Vec3 normal = (b - a).Cross(c - a);
+    const float length = normal.Length();
+    if (length > 0.0f) normal = normal / length;
+
+    const float values[12] = {normal.x, normal.y, normal.z, a.x, a.y, a.z,
+                              b.x,      b.y,      b.z,      c.x, c.y, c.z};
+    std::memcpy(record, values, sizeof(values));
+    std::memset(record + sizeof(values), 0, 2);  // attribute byte count
+    record += kStlTriangleSize;
+  }
+}
+
+Result WriteStl(const Model& model, BufferedWriter& writer, const Options& options) {
+  Result result;
+  const ModelViewBuilder builder(model);
+
+  // Every loop of n corners triangulates into n - 2 triangles, so the count is known
+  // before anything is written
+  std::size_t triangleBound = 0;
+  for (uint32_t i = 0; i < model.Faces().size(); ++i) {
+    const std::size_t corners = model.FaceLoop(model.FaceIndexToId(i)).size();
+    if (corners >= 3) triangleBound += corners - 2;
+  }
+  if (triangleBound > UINT32_MAX) {
+    result.status = Status::TooLarge;
+    result.message = "Binary STL holds at most 4294967295 triangles";
+    return result;
+  }
+
+  char header[kStlHeaderSize] = {};
+  std::memcpy(header, "Exported by CAD", 15);
+  writer.Write(header, sizeof(header));
+
+  // Placeholder, patched once the triangle count is known
+  const std::size_t countOffset = writer.Position();
+  writer.WriteValue(uint32_t{0});
+
+  const std::size_t faceChunks = ChunkCount(model.Faces().size(), options.facesPerChunk);
+  std::vector<std::size_t> triangleCounts(faceChunks, 0);
+  result.status = StreamChunks(faceChunks, writer, options, 0.0f, 1.0f,
+                               [&](std::size_t chunk, std::string& out) {
+                                 TriangleChunk triangles;
+                                 builder.BuildFaceTriangles(chunk * options.facesPerChunk,
+                                                            options.facesPerChunk, triangles);
+                                 triangleCounts[chunk] = triangles.TriangleCount();
+                                 FormatStlTriangles(model, triangles, out);
+                               });
+  if (!result.Ok()) return result;
+
+  for (std::size_t count : triangleCounts) result.triangleCount += count;
+  if (result.triangleCount > UINT32_MAX) {
+    result.status = Status::TooLarge;
+    result.message = "Binary STL holds at most 4294967295 triangles";
+    return result;
+  }
+  const auto count = static_cast<uint32_t>(result.triangleCount);
+  writer.WriteAt(countOffset, &count, sizeof(count));
+  return result;
+}
+
+Format FormatFromExtension(const std::string& path) {
+  const std::size_t dot = path.find_last_of('.');
+  if (dot == std::string::npos) return Format::Auto;
+
+  std::string extension = path.substr(dot + 1);
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+  if (extension == "obj") return Format::Obj;
+  if (extension == "stl") return Format::Stl;
+  return Format::Auto;
+}
+
+}  // namespace
+
+Result ExportFile(const Model& model, const std::string& path, const Options& options) {
+  Result result;
+
+  const Format format = options.format != Format::Auto ? options.format : FormatFromExtension(path);
+  if (format == Format::Auto) {
+    result.status = Status::UnsupportedFormat;
+    result.message = "Unsupported export format: " + path;
+    return result;
+  }
+
+  Options chunkOptions = options;
+  chunkOptions.facesPerChunk = std::max<std::size_t>(1, options.facesPerChunk);
+
+  BufferedWriter writer;
+  if (!writer.Open(path)) {
+    result.status = Status::FileError;
+    result.message = "Failed to open export file: " + path;
+    return result;
+  }
+
+  result = format == Format::Obj ? WriteObj(model, writer, chunkOptions)
+                                 : WriteStl(model, writer, chunkOptions);
+
+  if (!writer.Close() && result.Ok()) result.status = Status::FileError;
+  if (result.status == Status::FileError) {
+    result.message = "Failed to write export file: " + path;
+  } else if (result.status == Status::Cancelled) {
+    result.message = "Export cancelled";
+  }
+
+  // A partial file would look like a complete export. Devices such as /dev/null stay.
+  if (!result.Ok()) {
+    std::error_code error;
+    if (std::filesystem::is_regular_file(path, error)) std::filesystem::remove(path, error);
+  }
+  return result;
+}
+
+}  // namespace Export
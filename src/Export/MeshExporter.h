@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+class Model;
+
+// Streaming mesh exporters. Faces are triangulated in fixed size chunks through
+// ModelViewBuilder, formatted in parallel and written in order through a large
+// sequential buffer, so memory stays bounded by the chunk size, not the model size.
+namespace Export {
+
+enum class Format { Auto, Obj, Stl };
+
+enum class Status { Ok, Cancelled, FileError, UnsupportedFormat, TooLarge };
+
+struct Options {
+  Format format = Format::Auto;
+
+  // Faces triangulated and formatted per job
+  std::size_t facesPerChunk = 16 * 1024;
+
+  // Monotonic progress in [0, 1], called on the exporting thread
+  std::function<void(float)> progress;
+
+  // Polled between chunk batches; set to abort early
+  const std::atomic<bool>* cancel = nullptr;
+};
+
+struct Result {
+  Status status = Status::Ok;
+  std::string message;
+  std::size_t triangleCount = 0;
+
+  bool Ok() const { return status == Status::Ok; }
+};
+
+// Write all faces of the model; Format::Auto picks the format from the extension.
+// OBJ is written as ASCII, STL as binary; STL counts triangles in 32 bits, so larger
+// models are rejected with Status::TooLarge. A cancelled or failed export removes the
+// partial file.
+Result ExportFile(const Model& model, const std::string& path, const Options& options = {});
+
+}  // namespace Export
@@ -0,0 +1,127 @@
+#include "Generators/Lattice.h"
+
+#include <array>
+#include <cassert>
+#include <numeric>
+#include <vector>
+
+#include "Utilities/JobSystem.h"
+
+namespace Generators {
+
+Lattice AddLattice(MeshData& mesh, uint32_t firstVertex, uint32_t rows, uint32_t columns,
+                   bool closedRings, bool closedRows, bool flip) {
+  assert(rows >= 1 && columns >= (closedRings ? 3u : 2u));
+  assert(firstVertex + rows * columns <= mesh.positions.size());
+
+  Lattice lattice;
+  lattice.firstVertex = firstVertex;
+  lattice.rows = rows;
+  lattice.columns = columns;
+  lattice.closedRings = closedRings;
+  lattice.closedRows = closedRows && rows > 2;
+  lattice.firstRingEdge = static_cast<uint32_t>(mesh.edges.size());
+  lattice.firstRungEdge = lattice.firstRingEdge + rows * lattice.RingEdgesPerRow();
+  lattice.firstFace = static_cast<uint32_t>(mesh.FaceCount());
+
+  const uint32_t ringsPerRow = lattice.RingEdgesPerRow();
+  const uint32_t quadRows = lattice.QuadRows();
+  const uint32_t rungCount = quadRows * columns;
+  const uint32_t quadCount = quadRows * ringsPerRow;
+
+  // Every element has a closed form index, so rows are written independently
+  mesh.edges.resize(lattice.firstRungEdge + rungCount);
+  const std::size_t firstFaceEdge = mesh.faceEdges.size();
+  mesh.faceEdges.resize(firstFaceEdge + 4 * std::size_t{quadCount});
+  mesh.faceOffsets.resize(mesh.faceOffsets.size() + quadCount);
+
+  Jobs::ParallelFor(rows, 16, [&](std::size_t begin, std::size_t end) {
+    for (auto r = static_cast<uint32_t>(begin); r < end; ++r) {
+      const uint32_t next = (r + 1) % rows;
+
+      for (uint32_t c = 0; c < ringsPerRow; ++c) {
+        mesh.edges[lattice.RingEdge(r, c)] =
+            Edge{lattice.Vertex(r, c), lattice.Vertex(r, (c + 1) % columns)};
+      }
+      if (r >= quadRows) continue;
+
+      for (uint32_t c = 0; c < columns; ++c) {
+        mesh.edges[lattice.RungEdge(r, c)] = Edge{lattice.Vertex(r, c), lattice.Vertex(next, c)};
+      }
+
+      for (uint32_t c = 0; c < ringsPerRow; ++c) {
+        const uint32_t quad = r * ringsPerRow + c;
+        uint32_t* loop = mesh.faceEdges.data() + firstFaceEdge + 4 * std::size_t{quad};
+        const uint32_t bottom = lattice.RingEdge(r, c);
+        const uint32_t right = lattice.RungEdge(r, (c + 1) % columns);
+        const uint32_t top = lattice.RingEdge(next, c);
+        const uint32_t left = lattice.RungEdge(r, c);
+        if (flip) {
+          loop[0] = left;
+          loop[1] = top;
+          loop[2] = right;
+          loop[3] = bottom;
+        } else {
+          loop[0] = bottom;
+          loop[1] = right;
+          loop[2] = top;
+          loop[3] = left;
+        }
+        mesh.faceOffsets[lattice.firstFace + quad + 1] =
+            static_cast<uint32_t>(firstFaceEdge + 4 * std::size_t{quad + 1});
+      }
+    }
+  });
+
+  return lattice;
+}
+
+uint32_t AddRowCap(MeshData& mesh, const Lattice& lattice, uint32_t row, bool reversed) {
+  assert(lattice.closedRings && row < lattice.rows);
+
+  for (uint32_t i = 0; i < lattice.columns; ++i) {
+    const uint32_t c = reversed ? lattice.columns - 1 - i : i;
+    mesh.faceEdges.push_back(lattice.RingEdge(row, c));
+  }
+  mesh.faceOffsets.push_back(static_cast<uint32_t>(mesh.faceEdges.size()));
+  return static_cast<uint32_t>(mesh.FaceCount() - 1);
+}
+
+void AddRowFan(MeshData& mesh, const Lattice& lattice, uint32_t row, uint32_t apex,
+               bool reversed) {
+  assert(lattice.closedRings && row < lattice.rows);
+
+  const auto firstSpoke = static_cast<uint32_t>(mesh.edges.size());
+  for (uint32_t c = 0; c < lattice.columns; ++c) {
+    mesh.edges.push_back(Edge{apex, lattice.Vertex(row, c)});
+  }
+
+  for (uint32_t c = 0; c < lattice.columns; ++c) {
+    const uint32_t ring = lattice.RingEdge(row, c);
+    const uint32_t from = firstSpoke + c;
+    const uint32_t to = firstSpoke + (c + 1) % lattice.columns;
+    if (reversed) {
+      mesh.AddFace(std::array<uint32_t, 3>{from, to, ring});
+    } else {
+      mesh.AddFace(std::array<uint32_t, 3>{ring, to, from});
+    }
+  }
+}
+
+Lattice AddTube(MeshData& mesh, uint32_t firstVertex, uint32_t rows, uint32_t columns,
+                bool closedRows, bool flip) {
+  const Lattice lattice = AddLattice(mesh, firstVertex, rows, columns, true, closedRows, flip);
+
+  // Quads cross the first ring forwards unless flipped, so its cap runs the other way
+  if (!lattice.closedRows) {
+    AddRowCap(mesh, lattice, 0, !flip);
+    AddRowCap(mesh, lattice, rows - 1, flip);
+  }
+
+  std::vector<uint32_t> faces(mesh.FaceCount() - lattice.firstFace);
+  std::iota(faces.begin(), faces.end(), lattice.firstFace);
+  mesh.AddVolume(faces);
+  return lattice;
+}
+
+}  // namespace Generators
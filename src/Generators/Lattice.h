@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Core/MeshData.h"
+
+namespace Generators {
+
+// Quad topology over a rows x columns block of vertices, vertex (r, c) at
+// firstVertex + r * columns + c. Rings run along a row, rungs join a vertex to the
+// same column of the next row. Closed rings wrap the last column back to the first;
+// closed rows wrap the last row back to the first.
+struct Lattice {
+  uint32_t firstVertex = 0;
+  uint32_t rows = 0;
+  uint32_t columns = 0;
+  bool closedRings = false;
+  bool closedRows = false;
+  uint32_t firstRingEdge = 0;
+  uint32_t firstRungEdge = 0;
+  uint32_t firstFace = 0;
+
+  uint32_t RingEdgesPerRow() const { return closedRings ? columns : columns - 1; }
+  uint32_t QuadRows() const { return closedRows ? rows : rows - 1; }
+
+  uint32_t Vertex(uint32_t row, uint32_t column) const {
+    return firstVertex + row * columns + column;
+  }
+
+  // Edge from (row, column) to (row, column + 1)
+  uint32_t RingEdge(uint32_t row, uint32_t column) const {
+    return firstRingEdge + row * RingEdgesPerRow() + column;
+  }
+
+  // Edge from (row, column) to (row + 1, column)
+  uint32_t RungEdge(uint32_t row, uint32_t column) const {
+    return firstRungEdge + row * columns + column;
+  }
+};
+
+// Append the lattice edges and quads to mesh, writing every element by index in
+// parallel. Quads run (r, c) -> (r, c + 1) -> (r + 1, c + 1) -> (r + 1, c), so they face
+// along (column direction) x (row direction); flip reverses them. The positions must
+// already be in mesh.
+Lattice AddLattice(MeshData& mesh, uint32_t firstVertex, uint32_t rows, uint32_t columns,
+                   bool closedRings, bool closedRows, bool flip = false);
+
+// Close a row of a lattice with closed rings. A cap is one polygon over the ring edges;
+// a fan joins the ring to apex with triangles. Both run along the ring in column order,
+// or against it when reversed.
+uint32_t AddRowCap(MeshData& mesh, const Lattice& lattice, uint32_t row, bool reversed);
+void AddRowFan(MeshData& mesh, const Lattice& lattice, uint32_t row, uint32_t apex,
+               bool reversed);
+
+// Closed solid over rows rings of a closed profile: the lattice, caps on the first and
+// last ring unless the rows wrap, and a volume over all of them. flip as for AddLattice.
+Lattice AddTube(MeshData& mesh, uint32_t firstVertex, uint32_t rows, uint32_t columns,
+                bool closedRows, bool flip);
+
+}  // namespace Generators
@@ -0,0 +1,274 @@
+#include "Generators/Profiles.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+#include <vector>
+
+#include "Generators/Lattice.h"
+#include "Generators/Shapes.h"
+#include "Geometry/Geometry.h"
+#include "Topology/EdgeTable.h"
+#include "Utilities/JobSystem.h"
+
+namespace Generators {
+namespace {
+
+constexpr float kTau = 2.0f * std::numbers::pi_v<float>;
+constexpr uint32_t kGone = UINT32_MAX;
+
+// Rotation of v about the unit axis (Rodrigues)
+Vec3 Rotate(const Vec3& v, const Vec3& axis, float cosAngle, float sinAngle) {
+  return v * cosAngle + axis.Cross(v) * sinAngle + axis * (axis.Dot(v) * (1.0f - cosAngle));
+}
+
+Vec3 Centroid(std::span<const Vec3> points) {
+  Vec3 sum{};
+  for (const Vec3& p : points) sum += p;
+  return sum / static_cast<float>(points.size());
+}
+
+// Lattice quads face along (profile direction) x travel, so they face inward when the
+// profile turns clockwise about the direction it travels in
+bool TurnsAgainst(std::span<const Vec3> profile, const Vec3& travel) {
+  return Geometry::PolygonNormal(profile).Dot(travel) < 0.0f;
+}
+
+// Lay out rows rings of columns vertices, each ring written independently
+template <typename RingFn>
+void FillRings(MeshData& mesh, uint32_t rows, uint32_t columns, RingFn&& ring) {
+  mesh.positions.resize(std::size_t{rows} * columns);
+  Jobs::ParallelFor(rows, 4, [&](std::size_t begin, std::size_t end) {
+    for (auto r = static_cast<uint32_t>(begin); r < end; ++r) {
+      ring(r, mesh.positions.data() + std::size_t{r} * columns);
+    }
+  });
+}
+
+// Merge every vertex v into remap[v] (remap[v] <= v). Edges between merged vertices
+// vanish, edges that now join the same pair become one, and faces or volumes left with
+// too few elements are dropped.
+void Weld(MeshData& mesh, std::span<const uint32_t> remap) {
+  MeshData welded;
+  std::vector<uint32_t> vertexIndex(mesh.positions.size());
+  for (uint32_t v = 0; v < mesh.positions.size(); ++v) {
+    if (remap[v] == v) {
+      vertexIndex[v] = static_cast<uint32_t>(welded.positions.size());
+      welded.positions.push_back(mesh.positions[v]);
+    } else {
+      vertexIndex[v] = vertexIndex[remap[v]];
+    }
+  }
+
+  std::vector<uint32_t> edgeIndex(mesh.edges.size());
+  {
+    Topology::EdgeTable table(welded.edges);
+    table.Reserve(mesh.edges.size());
+    for (std::size_t e = 0; e < mesh.edges.size(); ++e) {
+      const uint32_t a = vertexIndex[mesh.edges[e].a];
+      const uint32_t b = vertexIndex[mesh.edges[e].b];
+      edgeIndex[e] = a == b ? kGone : table.FindOrAdd(a, b);
+    }
+  }
+
+  // A quad between two merged rungs folds onto one edge and disappears
+  std::vector<uint32_t> faceIndex(mesh.FaceCount(), kGone);
+  for (std::size_t f = 0; f < mesh.FaceCount(); ++f) {
+    const std::size_t start = welded.faceEdges.size();
+    for (uint32_t e : mesh.FaceEdges(f)) {
+      const uint32_t kept = edgeIndex[e];
+      if (kept == kGone) continue;
+      if (welded.faceEdges.size() > start && welded.faceEdges.back() == kept) continue;
+      welded.faceEdges.push_back(kept);
+    }
+    auto& loop = welded.faceEdges;
+    while (loop.size() > start + 1 && loop.back() == loop[start]) loop.pop_back();
+
+    if (loop.size() - start < 3) {
+      loop.resize(start);
+      continue;
+    }
+    welded.faceOffsets.push_back(static_cast<uint32_t>(loop.size()));
+    faceIndex[f] = static_cast<uint32_t>(welded.FaceCount() - 1);
+  }
+
+  // Drop the edges only the vanished faces used, such as a profile edge on the axis
+  std::vector<uint32_t> used(welded.edges.size(), kGone);
+  std::vector<Edge> edges;
+  for (uint32_t& e : welded.faceEdges) {
+    if (used[e] == kGone) {
+      used[e] = static_cast<uint32_t>(edges.size());
+      edges.push_back(welded.edges[e]);
+    }
+    e = used[e];
+  }
+  welded.edges = std::move(edges);
+
+  for (std::size_t v = 0; v < mesh.VolumeCount(); ++v) {
+    const std::size_t start = welded.volumeFaces.size();
+    for (uint32_t f : mesh.VolumeFaces(v)) {
+      if (faceIndex[f] != kGone) welded.volumeFaces.push_back(faceIndex[f]);
+    }
+    if (welded.volumeFaces.size() - start < 4) {
+      welded.volumeFaces.resize(start);
+      continue;
+    }
+    welded.volumeOffsets.push_back(static_cast<uint32_t>(welded.volumeFaces.size()));
+  }
+
+  mesh = std::move(welded);
+}
+
+}  // namespace
+
+// -------------------------------------------------
+// Lathe
+// -------------------------------------------------
+MeshData Lathe(std::span<const Vec3> profile, const Vec3& origin, const Vec3& axis, float angle,
+               uint32_t segments) {
+  MeshData mesh;
+  const auto columns = static_cast<uint32_t>(profile.size());
+  if (columns < 3 || axis.LengthSquared() <= 0.0f || angle == 0.0f) return mesh;
+
+  const Vec3 k = axis * (1.0f / axis.Length());
+  const bool full = std::abs(angle) >= kTau - 1e-4f;
+  segments = std::clamp(segments, full ? 3u : 1u, kMaxResolution);
+  const float step = (full ? std::copysign(kTau, angle) : angle) / static_cast<float>(segments);
+  const uint32_t rows = full ? segments : segments + 1;
+
+  FillRings(mesh, rows, columns, [&](uint32_t r, Vec3* ring) {
+    const float turn = step * static_cast<float>(r);
+    const float c = std::cos(turn);
+    const float s = std::sin(turn);
+    for (uint32_t i = 0; i < columns; ++i) ring[i] = origin + Rotate(profile[i] - origin, k, c, s);
+  });
+
+  // The profile centroid moves along k x offset when step is positive
+  const Vec3 travel = k.Cross(Centroid(profile) - origin) * step;
+  AddTube(mesh, 0, rows, columns, full, TurnsAgainst(profile, travel));
+
+  // Vertices on the axis stay put, so every ring shares the first ring's copy
+  float reach = 0.0f;
+  for (const Vec3& p : profile) reach = std::max(reach, (p - origin).Length());
+  const float tolerance = 1e-5f * std::max(reach, 1.0f);
+
+  std::vector<uint32_t> remap(mesh.positions.size());
+  std::iota(remap.begin(), remap.end(), 0u);
+  bool touchesAxis = false;
+  for (uint32_t i = 0; i < columns; ++i) {
+    const Vec3 offset = profile[i] - origin;
+    if ((offset - k * k.Dot(offset)).LengthSquared() > tolerance * tolerance) continue;
+    for (uint32_t r = 1; r < rows; ++r) remap[r * columns + i] = i;
+    touchesAxis = true;
+  }
+  if (touchesAxis) {
+    Weld(mesh, remap);
+    if (mesh.VolumeCount() == 0) mesh.Clear();
+  }
+  return mesh;
+}
+
+// -------------------------------------------------
+// Sweep
+// -------------------------------------------------
+MeshData Sweep(std::span<const Vec3> profile, std::span<const Vec3> path) {
+  MeshData mesh;
+  const auto columns = static_cast<uint32_t>(profile.size());
+  if (columns < 3) return mesh;
+
+  // Repeated path points would leave zero length segments without a direction
+  std::vector<Vec3> points;
+  std::vector<Vec3> directions;
+  for (const Vec3& p : path) {
+    if (!points.empty()) {
+      const Vec3 d = p - points.back();
+      const float length = d.Length();
+      if (length <= 1e-6f) continue;
+      directions.push_back(d * (1.0f / length));
+    }
+    points.push_back(p);
+  }
+  if (points.size() < 2) return mesh;
+  const auto rows = static_cast<uint32_t>(points.size());
+
+  // Each ring turns from the previous ring's tangent, so frames accumulate in order;
+  // a frame holds the images of the world axes
+  std::vector<std::array<Vec3, 3>> frames(rows);
+  frames[0] = {Right, Up, Forward};
+  Vec3 previous = directions[0];
+  for (uint32_t r = 1; r < rows; ++r) {
+    Vec3 tangent = directions[r - 1];
+    if (r + 1 < rows) {
+      const Vec3 bisector = directions[r - 1] + directions[r];
+      const float length = bisector.Length();
+      if (length > 1e-6f) tangent = bisector * (1.0f / length);
+    }
+
+    const Vec3 turn = previous.Cross(tangent);
+    const float s = turn.Length();
+    frames[r] = frames[r - 1];
+    if (s > 1e-7f) {
+      const Vec3 k = turn * (1.0f / s);
+      const float c = previous.Dot(tangent);
+      for (Vec3& basis : frames[r]) basis = Rotate(basis, k, c, s);
+    }
+    previous = tangent;
+  }
+
+  FillRings(mesh, rows, columns, [&](uint32_t r, Vec3* ring) {
+    const auto& [x, y, z] = frames[r];
+    for (uint32_t i = 0; i < columns; ++i) {
+      const Vec3 local = profile[i] - points[0];
+      ring[i] = points[r] + x * local.x + y * local.y + z * local.z;
+    }
+  });
+
+  AddTube(mesh, 0, rows, columns, false, TurnsAgainst(profile, directions[0]));
+  return mesh;
+}
+
+// -------------------------------------------------
+// Loft
+// -------------------------------------------------
+MeshData Loft(std::span<const Vec3> from, std::span<const Vec3> to, uint32_t sections) {
+  MeshData mesh;
+  const auto columns = static_cast<uint32_t>(from.size());
+  if (columns < 3 || to.size() != from.size()) return mesh;
+  sections = std::clamp(sections, 1u, kMaxResolution);
+
+  const Vec3 fromCenter = Centroid(from);
+  const Vec3 toCenter = Centroid(to);
+  const Vec3 travel = toCenter - fromCenter;
+
+  // Run to the same way round as from, seen along the direction of travel
+  const bool reversed = TurnsAgainst(from, travel) != TurnsAgainst(to, travel);
+  auto target = [&](uint32_t start, uint32_t i) {
+    return reversed ? to[(start + columns - i) % columns] : to[(start + i) % columns];
+  };
+
+  // Pick the starting vertex that keeps the rungs shortest relative to the centroids
+  std::vector<float> cost(columns);
+  Jobs::ParallelFor(columns, 64, [&](std::size_t begin, std::size_t end) {
+    for (auto start = static_cast<uint32_t>(begin); start < end; ++start) {
+      float sum = 0.0f;
+      for (uint32_t i = 0; i < columns; ++i) {
+        sum += ((from[i] - fromCenter) - (target(start, i) - toCenter)).LengthSquared();
+      }
+      cost[start] = sum;
+    }
+  });
+  const auto start =
+      static_cast<uint32_t>(std::min_element(cost.begin(), cost.end()) - cost.begin());
+
+  FillRings(mesh, sections + 1, columns, [&](uint32_t r, Vec3* ring) {
+    const float t = static_cast<float>(r) / static_cast<float>(sections);
+    for (uint32_t i = 0; i < columns; ++i) ring[i] = from[i] + (target(start, i) - from[i]) * t;
+  });
+
+  AddTube(mesh, 0, sections + 1, columns, false, TurnsAgainst(from, travel));
+  return mesh;
+}
+
+}  // namespace Generators
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "Core/MeshData.h"
+#include "Utilities/Vec3.h"
+
+// Solids built by moving a closed profile loop (usually a face's vertex loop) through
+// space. Each ring of the profile becomes one lattice row, so rows are positioned in
+// parallel and the topology is written by index; open ends are capped with copies of
+// the profile and every result is a closed, outward wound volume ready for
+// Model::AppendMesh.
+namespace Generators {
+
+// Revolve the profile by angle radians about the axis through origin, in segments
+// steps (at most kMaxResolution). A full turn closes on itself instead of being capped.
+// Profile vertices on the axis are shared by every ring, turning their quads into
+// triangles.
+MeshData Lathe(std::span<const Vec3> profile, const Vec3& origin, const Vec3& axis, float angle,
+               uint32_t segments);
+
+// Carry the profile along the polyline, which starts where the profile is. At every
+// corner the profile turns by the minimal rotation onto the averaged path direction, so
+// it does not twist about the path.
+MeshData Sweep(std::span<const Vec3> profile, std::span<const Vec3> path);
+
+// Join two loops with the same vertex count through sections - 1 interpolated rings,
+// sections being clamped to kMaxResolution. to is re-ordered to run the same way round
+// as from, starting at the vertex that best matches from's first one.
+MeshData Loft(std::span<const Vec3> from, std::span<const Vec3> to, uint32_t sections = 1);
+
+}  // namespace Generators
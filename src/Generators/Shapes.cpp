@@ -0,0 +1,337 @@
+#include "Generators/Shapes.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "Generators/Lattice.h"
+#include "Geometry/Geometry.h"
+#include "Topology/EdgeTable.h"
+
+namespace Generators {
+namespace {
+
+constexpr float kTau = 2.0f * std::numbers::pi_v<float>;
+
+Vec3 Scale(const Vec3& v, const Vec3& s) { return {v.x * s.x, v.y * s.y, v.z * s.z}; }
+
+// Angle around +y, counter clockwise seen from above, as (cos, -sin) in the xz plane
+Vec3 RingDirection(uint32_t segment, uint32_t segments) {
+  const float angle = kTau * static_cast<float>(segment) / static_cast<float>(segments);
+  return {std::cos(angle), 0.0f, -std::sin(angle)};
+}
+
+// Closes the mesh with one volume over every face emitted so far
+void AddSolid(MeshData& mesh) {
+  std::vector<uint32_t> faces(mesh.FaceCount());
+  std::iota(faces.begin(), faces.end(), 0u);
+  mesh.AddVolume(faces);
+}
+
+// Extrude a closed planar profile by offset, wound outward whichever way it turns
+void AddPrism(MeshData& mesh, std::span<const Vec3> profile, const Vec3& offset) {
+  const auto first = static_cast<uint32_t>(mesh.positions.size());
+  mesh.positions.insert(mesh.positions.end(), profile.begin(), profile.end());
+  for (const Vec3& p : profile) mesh.positions.push_back(p + offset);
+
+  // Band quads face along edge x offset, outward when the profile turns about offset
+  const bool flip = Geometry::PolygonNormal(profile).Dot(offset) < 0.0f;
+  AddTube(mesh, first, 2, static_cast<uint32_t>(profile.size()), false, flip);
+}
+
+}  // namespace
+
+const char* ShapeName(Shape shape) {
+  switch (shape) {
+    case Shape::Box: return "box";
+    case Shape::Cylinder: return "cylinder";
+    case Shape::UvSphere: return "uv sphere";
+    case Shape::IcoSphere: return "ico sphere";
+    case Shape::Torus: return "torus";
+    case Shape::Grid: return "grid";
+    case Shape::Stairs: return "stairs";
+  }
+  return "unknown";
+}
+
+ShapeParams DefaultParams(Shape shape) {
+  ShapeParams params;
+  params.shape = shape;
+  switch (shape) {
+    case Shape::Box: params.segments = 1; break;
+    case Shape::Cylinder: params.segments = 32; params.rings = 1; break;
+    case Shape::UvSphere: params.segments = 32; params.rings = 16; break;
+    case Shape::IcoSphere: params.rings = 2; break;
+    case Shape::Torus: params.segments = 48; params.rings = 16; break;
+    case Shape::Grid: params.segments = 10; params.rings = 10; break;
+    case Shape::Stairs: params.segments = 8; break;
+  }
+  return params;
+}
+
+// -------------------------------------------------
+// Box
+// -------------------------------------------------
+MeshData Box(const Vec3& size, uint32_t divisions) {
+  const uint32_t n = std::clamp(divisions, 1u, kMaxBoxDivisions);
+  const uint32_t side = n + 1;
+
+  MeshData mesh;
+  mesh.positions.reserve(6 * n * n + 2);
+
+  // Surface points of the side^3 grid, numbered when first reached so the six sides
+  // share their border vertices
+  std::vector<uint32_t> index(std::size_t{side} * side * side, UINT32_MAX);
+  auto vertex = [&](const std::array<uint32_t, 3>& g) {
+    uint32_t& slot = index[(std::size_t{g[2]} * side + g[1]) * side + g[0]];
+    if (slot == UINT32_MAX) {
+      slot = static_cast<uint32_t>(mesh.positions.size());
+      const Vec3 unit{static_cast<float>(g[0]), static_cast<float>(g[1]),
+                      static_cast<float>(g[2])};
+      mesh.positions.push_back(Scale(unit / static_cast<float>(n) - Vec3(0.5f), size));
+    }
+    return slot;
+  };
+
+  Topology::EdgeTable table(mesh.edges);
+  table.Reserve(12 * n * n);
+  mesh.faceEdges.reserve(24 * n * n);
+  mesh.faceOffsets.reserve(6 * n * n + 1);
+
+  for (uint32_t axis = 0; axis < 3; ++axis) {
+    for (const bool positive : {false, true}) {
+      // u x v points out of the side
+      const uint32_t u = positive ? (axis + 1) % 3 : (axis + 2) % 3;
+      const uint32_t v = positive ? (axis + 2) % 3 : (axis + 1) % 3;
+
+      for (uint32_t j = 0; j < n; ++j) {
+        for (uint32_t i = 0; i < n; ++i) {
+          std::array<uint32_t, 3> g{};
+          g[axis] = positive ? n : 0;
+          std::array<uint32_t, 4> loop{};
+          for (uint32_t k = 0; k < 4; ++k) {
+            g[u] = i + (k == 1 || k == 2 ? 1 : 0);
+            g[v] = j + (k >= 2 ? 1 : 0);
+            loop[k] = vertex(g);
+          }
+          Topology::AddFaceLoop(mesh, table, loop);
+        }
+      }
+    }
+  }
+
+  AddSolid(mesh);
+  return mesh;
+}
+
+// -------------------------------------------------
+// Cylinder
+// -------------------------------------------------
+MeshData Cylinder(const Vec3& size, uint32_t segments, uint32_t rings) {
+  segments = std::clamp(segments, 3u, kMaxResolution);
+  rings = std::clamp(rings, 1u, kMaxResolution);
+
+  MeshData mesh;
+  mesh.positions.reserve(std::size_t{rings + 1} * segments);
+  const Vec3 radius{size.x * 0.5f, 1.0f, size.z * 0.5f};
+  for (uint32_t r = 0; r <= rings; ++r) {
+    const float y = size.y * (static_cast<float>(r) / static_cast<float>(rings) - 0.5f);
+    for (uint32_t c = 0; c < segments; ++c) {
+      mesh.positions.push_back(Scale(RingDirection(c, segments), radius) + Vec3{0.0f, y, 0.0f});
+    }
+  }
+
+  AddTube(mesh, 0, rings + 1, segments, false, false);
+  return mesh;
+}
+
+// -------------------------------------------------
+// Spheres
+// -------------------------------------------------
+MeshData UvSphere(const Vec3& size, uint32_t segments, uint32_t rings) {
+  segments = std::clamp(segments, 3u, kMaxResolution);
+  rings = std::clamp(rings, 2u, kMaxResolution);
+
+  // Latitude rings bottom to top, then the two poles
+  MeshData mesh;
+  mesh.positions.reserve(std::size_t{rings - 1} * segments + 2);
+  const Vec3 radius = size * 0.5f;
+  for (uint32_t r = 1; r < rings; ++r) {
+    const float latitude =
+        std::numbers::pi_v<float> * (static_cast<float>(r) / static_cast<float>(rings) - 0.5f);
+    for (uint32_t c = 0; c < segments; ++c) {
+      const Vec3 unit = RingDirection(c, segments) * std::cos(latitude) + Up * std::sin(latitude);
+      mesh.positions.push_back(Scale(unit, radius));
+    }
+  }
+  const auto south = static_cast<uint32_t>(mesh.positions.size());
+  mesh.positions.push_back(Vec3{0.0f, -radius.y, 0.0f});
+  mesh.positions.push_back(Vec3{0.0f, radius.y, 0.0f});
+
+  const Lattice bands = AddLattice(mesh, 0, rings - 1, segments, true, false);
+  AddRowFan(mesh, bands, 0, south, true);
+  AddRowFan(mesh, bands, rings - 2, south + 1, false);
+  AddSolid(mesh);
+  return mesh;
+}
+
+MeshData IcoSphere(const Vec3& size, uint32_t subdivisions) {
+  subdivisions = std::min(subdivisions, kMaxIcoSubdivisions);
+
+  const float t = std::numbers::phi_v<float>;
+  std::vector<Vec3> points{{-1, t, 0}, {1, t, 0}, {-1, -t, 0}, {1, -t, 0},
+                           {0, -1, t}, {0, 1, t}, {0, -1, -t}, {0, 1, -t},
+                           {t, 0, -1}, {t, 0, 1}, {-t, 0, -1}, {-t, 0, 1}};
+  std::vector<std::array<uint32_t, 3>> triangles{
+      {0, 11, 5}, {0, 5, 1},  {0, 1, 7},   {0, 7, 10}, {0, 10, 11},
+      {1, 5, 9},  {5, 11, 4}, {11, 10, 2}, {10, 7, 6}, {7, 1, 8},
+      {3, 9, 4},  {3, 4, 2},  {3, 2, 6},   {3, 6, 8},  {3, 8, 9},
+      {4, 9, 5},  {2, 4, 11}, {6, 2, 10},  {8, 6, 7},  {9, 8, 1}};
+
+  // Split every triangle in four; the edge table numbers each edge once so both
+  // triangles on an edge pick up the same midpoint
+  std::vector<Edge> edges;
+  std::vector<std::array<uint32_t, 3>> split;
+  for (uint32_t level = 0; level < subdivisions; ++level) {
+    edges.clear();
+    Topology::EdgeTable table(edges);
+    table.Reserve(triangles.size() * 3 / 2);
+
+    std::vector<uint32_t> midpoints;
+    auto midpoint = [&](uint32_t a, uint32_t b) {
+      const uint32_t edge = table.FindOrAdd(a, b);
+      if (edge == midpoints.size()) {
+        midpoints.push_back(static_cast<uint32_t>(points.size()));
+        points.push_back((points[a] + points[b]) * 0.5f);
+      }
+      return midpoints[edge];
+    };
+
+    split.clear();
+    split.reserve(triangles.size() * 4);
+    for (const auto& [a, b, c] : triangles) {
+      const uint32_t ab = midpoint(a, b);
+      const uint32_t bc = midpoint(b, c);
+      const uint32_t ca = midpoint(c, a);
+      split.push_back({a, ab, ca});
+      split.push_back({b, bc, ab});
+      split.push_back({c, ca, bc});
+      split.push_back({ab, bc, ca});
+    }
+    triangles.swap(split);
+  }
+
+  MeshData mesh;
+  const Vec3 radius = size * 0.5f;
+  mesh.positions.reserve(points.size());
+  for (const Vec3& p : points) mesh.positions.push_back(Scale(p.Normalized(), radius));
+
+  Topology::EdgeTable table(mesh.edges);
+  table.Reserve(triangles.size() * 3 / 2);
+  mesh.faceEdges.reserve(triangles.size() * 3);
+  mesh.faceOffsets.reserve(triangles.size() + 1);
+  for (const auto& triangle : triangles) Topology::AddFaceLoop(mesh, table, triangle);
+
+  AddSolid(mesh);
+  return mesh;
+}
+
+// -------------------------------------------------
+// Torus
+// -------------------------------------------------
+MeshData Torus(const Vec3& size, uint32_t segments, uint32_t sides) {
+  segments = std::clamp(segments, 3u, kMaxResolution);
+  sides = std::clamp(sides, 3u, kMaxResolution);
+
+  // The tube may be at most half the ring radius so the hole stays open
+  const float tube = std::min(size.y, std::min(size.x, size.z) * 0.5f) * 0.5f;
+  const Vec3 ring{size.x * 0.5f - tube, 0.0f, size.z * 0.5f - tube};
+
+  // Rows walk around the tube starting at the outer equator, columns around y
+  MeshData mesh;
+  mesh.positions.reserve(std::size_t{sides} * segments);
+  for (uint32_t r = 0; r < sides; ++r) {
+    const float angle = kTau * static_cast<float>(r) / static_cast<float>(sides);
+    for (uint32_t c = 0; c < segments; ++c) {
+      const Vec3 direction = RingDirection(c, segments);
+      mesh.positions.push_back(Scale(direction, ring) + direction * (tube * std::cos(angle)) +
+                               Up * (tube * std::sin(angle)));
+    }
+  }
+
+  AddTube(mesh, 0, sides, segments, true, false);
+  return mesh;
+}
+
+// -------------------------------------------------
+// Grid
+// -------------------------------------------------
+MeshData Grid(const Vec3& size, uint32_t columns, uint32_t rows) {
+  columns = std::clamp(columns, 1u, kMaxResolution);
+  rows = std::clamp(rows, 1u, kMaxResolution);
+
+  // Rows advance towards -z so the quads face +y
+  MeshData mesh;
+  mesh.positions.reserve(std::size_t{rows + 1} * (columns + 1));
+  for (uint32_t r = 0; r <= rows; ++r) {
+    const float z = size.z * (0.5f - static_cast<float>(r) / static_cast<float>(rows));
+    for (uint32_t c = 0; c <= columns; ++c) {
+      const float x = size.x * (static_cast<float>(c) / static_cast<float>(columns) - 0.5f);
+      mesh.positions.push_back(Vec3{x, 0.0f, z});
+    }
+  }
+
+  AddLattice(mesh, 0, rows + 1, columns + 1, false, false);
+  return mesh;
+}
+
+// -------------------------------------------------
+// Stairs
+// -------------------------------------------------
+MeshData Stairs(const Vec3& size, uint32_t steps) {
+  steps = std::clamp(steps, 1u, kMaxResolution);
+
+  // Side profile in the yz plane: floor, back wall, then each tread and riser down to
+  // the front
+  const Vec3 min = size * -0.5f;
+  const float rise = size.y / static_cast<float>(steps);
+  const float run = size.z / static_cast<float>(steps);
+  std::vector<Vec3> profile;
+  profile.reserve(2 * std::size_t{steps} + 2);
+  profile.push_back(min);
+  profile.push_back(Vec3{min.x, min.y, -min.z});
+  for (uint32_t s = steps; s >= 1; --s) {
+    const float y = min.y + rise * static_cast<float>(s);
+    profile.push_back(Vec3{min.x, y, min.z + run * static_cast<float>(s)});
+    profile.push_back(Vec3{min.x, y, min.z + run * static_cast<float>(s - 1)});
+  }
+
+  MeshData mesh;
+  AddPrism(mesh, profile, Vec3{size.x, 0.0f, 0.0f});
+  return mesh;
+}
+
+// -------------------------------------------------
+// Dispatch
+// -------------------------------------------------
+MeshData Generate(const ShapeParams& params) {
+  MeshData mesh;
+  switch (params.shape) {
+    case Shape::Box: mesh = Box(params.size, params.segments); break;
+    case Shape::Cylinder: mesh = Cylinder(params.size, params.segments, params.rings); break;
+    case Shape::UvSphere: mesh = UvSphere(params.size, params.segments, params.rings); break;
+    case Shape::IcoSphere: mesh = IcoSphere(params.size, params.rings); break;
+    case Shape::Torus: mesh = Torus(params.size, params.segments, params.rings); break;
+    case Shape::Grid: mesh = Grid(params.size, params.segments, params.rings); break;
+    case Shape::Stairs: mesh = Stairs(params.size, params.segments); break;
+  }
+
+  for (Vec3& p : mesh.positions) p += params.center;
+  return mesh;
+}
+
+}  // namespace Generators
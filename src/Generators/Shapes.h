@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Core/MeshData.h"
+#include "Utilities/Vec3.h"
+
+// Procedural primitives emitted as MeshData with their topology known up front: edges
+// are shared between neighbouring faces, faces are wound outward and closed shapes
+// come with a volume, so the result goes straight into Model::AppendMesh. Every shape
+// fills the axis aligned box of the given size centred on the origin, with +y up.
+namespace Generators {
+
+enum class Shape : uint8_t { Box, Cylinder, UvSphere, IcoSphere, Torus, Grid, Stairs };
+
+inline constexpr uint8_t kShapeCount = 7;
+
+// Upper bounds on the resolution arguments below, keeping every shape to a few hundred
+// thousand faces and its indices well inside uint32_t
+inline constexpr uint32_t kMaxResolution = 512;      // segments, rings, sides, steps...
+inline constexpr uint32_t kMaxBoxDivisions = 64;
+inline constexpr uint32_t kMaxIcoSubdivisions = 7;
+
+const char* ShapeName(Shape shape);
+
+// Everything needed to regenerate a shape. segments is the first resolution argument of
+// the generator below and rings the second (box divisions and stair steps are segments,
+// ico sphere subdivisions are rings).
+struct ShapeParams {
+  Shape shape = Shape::Box;
+  Vec3 center{};
+  Vec3 size{2, 2, 2};
+  uint32_t segments = 1;
+  uint32_t rings = 1;
+};
+
+// The resolutions the generators below default to
+ShapeParams DefaultParams(Shape shape);
+
+// divisions quads along every edge of the box
+MeshData Box(const Vec3& size, uint32_t divisions = 1);
+
+// segments around the y axis, rings bands from bottom to top, capped at both ends
+MeshData Cylinder(const Vec3& size, uint32_t segments = 32, uint32_t rings = 1);
+
+// segments around the y axis, rings latitude bands from pole to pole
+MeshData UvSphere(const Vec3& size, uint32_t segments = 32, uint32_t rings = 16);
+
+// Icosahedron with every triangle split in four subdivisions times
+MeshData IcoSphere(const Vec3& size, uint32_t subdivisions = 2);
+
+// segments around the y axis, sides around the tube; size.y is the tube diameter
+MeshData Torus(const Vec3& size, uint32_t segments = 48, uint32_t sides = 16);
+
+// Open plane at y = 0 facing +y, columns along x and rows along z
+MeshData Grid(const Vec3& size, uint32_t columns = 10, uint32_t rows = 10);
+
+// Solid flight climbing from -z to +z, size.x wide
+MeshData Stairs(const Vec3& size, uint32_t steps = 8);
+
+// Dispatch on params.shape and move the result to params.center. Every generator clamps
+// its resolution to what the shape needs to stay closed and non-degenerate, and to the
+// maxima above.
+MeshData Generate(const ShapeParams& params);
+
+}  // namespace Generators
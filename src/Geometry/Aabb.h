@@ -0,0 +1,42 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include "Utilities/Vec3.h"
+
+namespace Geometry {
+
+// Axis aligned bounding box; default constructed boxes are empty
+struct Aabb {
+  Vec3 min{std::numeric_limits<float>::max()};
+  Vec3 max{std::numeric_limits<float>::lowest()};
+
+  bool IsEmpty() const { return min.x > max.x || min.y > max.y || min.z > max.z; }
+
+  void Expand(const Vec3& p) {
+    min = Vec3(std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z));
+    max = Vec3(std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z));
+  }
+
+  void Expand(const Aabb& other) {
+    if (other.IsEmpty()) return;
+    Expand(other.min);
+    Expand(other.max);
+  }
+
+  Vec3 Center() const { return (min + max) * 0.5f; }
+  Vec3 Extent() const { return max - min; }
+
+  bool Contains(const Vec3& p) const {
+    return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y && p.z >= min.z &&
+           p.z <= max.z;
+  }
+
+  bool Overlaps(const Aabb& other) const {
+    return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y &&
+           max.y >= other.min.y && min.z <= other.max.z && max.z >= other.min.z;
+  }
+};
+
+}  // namespace Geometry
@@ -0,0 +1,91 @@
+#include "Geometry/Bvh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace Geometry {
+
+void Bvh::Build(std::span<const Aabb> boxes) {
+  nodes_.clear();
+  boxes_.assign(boxes.begin(), boxes.end());
+  items_.clear();
+  if (boxes.empty()) return;
+
+  // Centroids travel with their box index so the splits work on contiguous memory
+  struct Item {
+    float center[3];
+    uint32_t index;
+  };
+  std::vector<Item> order(boxes.size());
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    const Vec3 center = boxes[i].Center();
+    order[i] = {{center.x, center.y, center.z}, static_cast<uint32_t>(i)};
+  }
+
+  // Median splits halve every range, so the tree has about 2n / kLeafSize nodes
+  nodes_.reserve(2 * boxes.size() / kLeafSize + 2);
+  nodes_.emplace_back();
+
+  struct Range {
+    uint32_t node;
+    uint32_t begin;
+    uint32_t end;
+  };
+  std::vector<Range> work{{0, 0, static_cast<uint32_t>(boxes.size())}};
+  while (!work.empty()) {
+    const Range range = work.back();
+    work.pop_back();
+
+    const uint32_t count = range.end - range.begin;
+    if (count <= kLeafSize) {
+      nodes_[range.node].first = range.begin;
+      nodes_[range.node].count = count;
+      continue;
+    }
+
+    float lo[3] = {INFINITY, INFINITY, INFINITY};
+    float hi[3] = {-INFINITY, -INFINITY, -INFINITY};
+    for (uint32_t i = range.begin; i < range.end; ++i) {
+      for (int k = 0; k < 3; ++k) {
+        lo[k] = std::min(lo[k], order[i].center[k]);
+        hi[k] = std::max(hi[k], order[i].center[k]);
+      }
+    }
+    const float extent[3] = {hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]};
+    const int axis = extent[0] >= extent[1] && extent[0] >= extent[2] ? 0
+                     : extent[1] >= extent[2]                         ? 1
+                                                                      : 2;
+    const uint32_t middle = range.begin + count / 2;
+    std::nth_element(order.begin() + range.begin, order.begin() + middle,
+                     order.begin() + range.end, [axis](const Item& a, const Item& b) {
+                       return a.center[axis] < b.center[axis];
+                     });
+
+    const auto left = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+    nodes_.emplace_back();
+    nodes_[range.node].first = left;
+    nodes_[range.node].count = 0;
+    work.push_back({left, range.begin, middle});
+    work.push_back({left + 1, middle, range.end});
+  }
+
+  items_.resize(order.size());
+  for (std::size_t i = 0; i < order.size(); ++i) items_[i] = order[i].index;
+
+  // Bounds bottom up; children always come after their parent
+  for (std::size_t n = nodes_.size(); n-- > 0;) {
+    Node& node = nodes_[n];
+    if (node.count > 0) {
+      for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+        node.bounds.Expand(boxes_[items_[i]]);
+      }
+    } else {
+      node.bounds.Expand(nodes_[node.first].bounds);
+      node.bounds.Expand(nodes_[node.first + 1].bounds);
+    }
+  }
+}
+
+}  // namespace Geometry
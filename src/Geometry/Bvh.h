@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Geometry/Aabb.h"
+
+namespace Geometry {
+
+// Bounding volume hierarchy over a fixed set of boxes, built top down by splitting at
+// the median centroid along the longest axis. Nodes live in one flat array with both
+// children of a node stored next to each other, and leaves hold a few box indices.
+class Bvh {
+ public:
+  void Build(std::span<const Aabb> boxes);
+
+  bool Empty() const { return nodes_.empty(); }
+  const Aabb& Bounds() const { return nodes_.front().bounds; }
+
+  // Descends into every node whose bounds enter(bounds) accepts and calls
+  // leaf(boxIndex) for each box in the accepted leaves
+  template <typename EnterFn, typename LeafFn>
+  void Traverse(EnterFn&& enter, LeafFn&& leaf) const {
+    if (nodes_.empty()) return;
+
+    uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+      const Node& node = nodes_[stack[--top]];
+      if (!enter(node.bounds)) continue;
+      if (node.count > 0) {
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) leaf(items_[i]);
+      } else {
+        stack[top++] = node.first;
+        stack[top++] = node.first + 1;
+      }
+    }
+  }
+
+  // Calls visit(boxIndex) for every box whose bounds overlap query
+  template <typename VisitFn>
+  void Query(const Aabb& query, VisitFn&& visit) const {
+    Traverse([&](const Aabb& bounds) { return bounds.Overlaps(query); },
+             [&](uint32_t index) {
+               if (boxes_[index].Overlaps(query)) visit(index);
+             });
+  }
+
+ private:
+  static constexpr uint32_t kLeafSize = 4;
+
+  // Leaf when count > 0 (items_[first, first + count)), otherwise the children are
+  // nodes_[first] and nodes_[first + 1]
+  struct Node {
+    Aabb bounds;
+    uint32_t first = 0;
+    uint32_t count = 0;
+  };
+
+  std::vector<Node> nodes_;
+  std::vector<uint32_t> items_;
+  std::vector<Aabb> boxes_;
+};
+
+}  // namespace Geometry
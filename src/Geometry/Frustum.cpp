@@ -0,0 +1,105 @@
+#include "Geometry/Frustum.h"
+
+#include <cmath>
+
+#include "Utilities/JobSystem.h"
+#include "Utilities/Mat4.h"
+#include "Utilities/Simd.h"
+
+namespace Geometry {
+
+namespace {
+
+// Boxes per job; culling a box is a few dozen flops, so only big sets are split
+constexpr std::size_t kCullBatch = 4096;
+
+void CullRange(const Frustum& frustum, std::span<const Aabb> boxes, uint8_t* outVisible) {
+  const std::size_t count = boxes.size();
+  std::size_t i = 0;
+
+#ifdef CAD_SSE
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 zero = _mm_setzero_ps();
+  for (; i + 4 <= count; i += 4) {
+    // Four boxes as centers and half extents, one lane each
+    const Aabb* b = boxes.data() + i;
+    const __m128 minX = _mm_setr_ps(b[0].min.x, b[1].min.x, b[2].min.x, b[3].min.x);
+    const __m128 minY = _mm_setr_ps(b[0].min.y, b[1].min.y, b[2].min.y, b[3].min.y);
+    const __m128 minZ = _mm_setr_ps(b[0].min.z, b[1].min.z, b[2].min.z, b[3].min.z);
+    const __m128 maxX = _mm_setr_ps(b[0].max.x, b[1].max.x, b[2].max.x, b[3].max.x);
+    const __m128 maxY = _mm_setr_ps(b[0].max.y, b[1].max.y, b[2].max.y, b[3].max.y);
+    const __m128 maxZ = _mm_setr_ps(b[0].max.z, b[1].max.z, b[2].max.z, b[3].max.z);
+    const __m128 cx = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+    const __m128 cy = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+    const __m128 cz = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+    const __m128 ex = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+    const __m128 ey = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+    const __m128 ez = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+
+    __m128 inside = _mm_cmpeq_ps(zero, zero);
+    for (const Frustum::Plane& plane : frustum.planes) {
+      // Signed distance of the box corner furthest along the plane normal
+      const __m128 center = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(plane.normal.x)),
+                     _mm_mul_ps(cy, _mm_set1_ps(plane.normal.y))),
+          _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(plane.normal.z)), _mm_set1_ps(plane.d)));
+      const __m128 reach = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(std::abs(plane.normal.x))),
+                     _mm_mul_ps(ey, _mm_set1_ps(std::abs(plane.normal.y)))),
+          _mm_mul_ps(ez, _mm_set1_ps(std::abs(plane.normal.z))));
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(center, reach), zero));
+    }
+
+    const int mask = _mm_movemask_ps(inside);
+    for (int lane = 0; lane < 4; ++lane) outVisible[i + lane] = (mask >> lane) & 1;
+  }
+#endif
+
+  for (; i < count; ++i) outVisible[i] = frustum.Intersects(boxes[i]) ? 1 : 0;
+}
+
+}  // namespace
+
+Frustum Frustum::FromViewProjection(const Mat4& viewProjection) {
+  // Gribb and Hartmann: each plane is the last row of the matrix plus or minus another
+  float rows[4][4];
+  for (int r = 0; r < 4; ++r) {
+    for (int c = 0; c < 4; ++c) rows[r][c] = viewProjection.At(r, c);
+  }
+
+  Frustum frustum;
+  for (int p = 0; p < 6; ++p) {
+    const float sign = (p % 2 == 0) ? 1.0f : -1.0f;
+    const float* other = rows[p / 2];
+    const Vec3 normal{rows[3][0] + sign * other[0], rows[3][1] + sign * other[1],
+                      rows[3][2] + sign * other[2]};
+    const float d = rows[3][3] + sign * other[3];
+
+    // Normalized so that distances are comparable across planes
+    const float length = normal.Length();
+    const float scale = length > 0.0f ? 1.0f / length : 0.0f;
+    frustum.planes[p] = {normal * scale, d * scale};
+  }
+  return frustum;
+}
+
+bool Frustum::Intersects(const Aabb& box) const {
+  if (box.IsEmpty()) return false;
+  const Vec3 center = box.Center();
+  const Vec3 extent = box.Extent() * 0.5f;
+  for (const Plane& plane : planes) {
+    const float reach = extent.x * std::abs(plane.normal.x) +
+                        extent.y * std::abs(plane.normal.y) +
+                        extent.z * std::abs(plane.normal.z);
+    if (plane.normal.Dot(center) + plane.d + reach < 0.0f) return false;
+  }
+  return true;
+}
+
+void Frustum::Cull(std::span<const Aabb> boxes, std::span<uint8_t> outVisible) const {
+  Jobs::ParallelFor(boxes.size(), kCullBatch, [&](std::size_t begin, std::size_t end) {
+    CullRange(*this, boxes.subspan(begin, end - begin), outVisible.data() + begin);
+  });
+}
+
+}  // namespace Geometry
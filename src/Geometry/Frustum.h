@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "Geometry/Aabb.h"
+
+class Mat4;
+
+namespace Geometry {
+
+// The six clip planes of a view projection, pointing inward: a point p is inside a
+// plane (n, d) when n.p + d >= 0. Boxes are tested conservatively, so a box may be
+// kept although it misses the view (near the frustum's corners) but never dropped
+// while any part of it is visible.
+struct Frustum {
+  struct Plane {
+    Vec3 normal;
+    float d = 0.0f;
+  };
+
+  // Left, right, bottom, top, near, far
+  std::array<Plane, 6> planes;
+
+  // Planes of an OpenGL style projection (clip z in [-w, w]), in the space the matrix
+  // maps from: world space for Camera::GetViewProjectionMatrix
+  static Frustum FromViewProjection(const Mat4& viewProjection);
+
+  // Empty boxes are never visible
+  bool Intersects(const Aabb& box) const;
+
+  // One flag per box, 1 when it may be visible. Four boxes per step with SSE, and
+  // large sets are split across the job pool.
+  void Cull(std::span<const Aabb> boxes, std::span<uint8_t> outVisible) const;
+};
+
+}  // namespace Geometry
@@ -1,64 +1,158 @@
 #include "Geometry.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <vector>
 
+#include "Geometry/Predicates.h"
 #include "Utilities/Vec3.h"
 
 namespace Geometry {
 
-bool AreColinear(std::span<const Vec3> points) {
+namespace {
+
+struct Dvec {
+  double x, y, z;
+
+  Dvec(const Vec3& to, const Vec3& from)
+      : x(static_cast<double>(to.x) - from.x),
+        y(static_cast<double>(to.y) - from.y),
+        z(static_cast<double>(to.z) - from.z) {}
+  Dvec(double x, double y, double z) : x(x), y(y), z(z) {}
+
+  Dvec Cross(const Dvec& o) const {
+    return {y * o.z - z * o.y, z * o.x - x * o.z, x * o.y - y * o.x};
+  }
+  double Dot(const Dvec& o) const { return x * o.x + y * o.y + z * o.z; }
+};
+
+struct Frame {
+  std::size_t farthest = 0;  // index of the point farthest from points[0]
+  double tolerance = 0.0;    // distance below which a point counts as on the line / plane
+};
+
+// One pass for the reference chord and the scale of the set
+Frame Measure(std::span<const Vec3> points, float relativeTolerance) {
+  const float origin[3] = {points[0].x, points[0].y, points[0].z};
+  Frame frame;
+  float farthest = 0.0f;
+  float min[3] = {origin[0], origin[1], origin[2]};
+  float max[3] = {origin[0], origin[1], origin[2]};
+  float magnitude = 0.0f;
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const float p[3] = {points[i].x, points[i].y, points[i].z};
+    float distance = 0.0f;
+    for (int k = 0; k < 3; ++k) {
+      const float d = p[k] - origin[k];
+      distance += d * d;
+      min[k] = std::min(min[k], p[k]);
+      max[k] = std::max(max[k], p[k]);
+      magnitude = std::max(magnitude, std::abs(p[k]));
+    }
+    if (distance > farthest) {
+      farthest = distance;
+      frame.farthest = i;
+    }
+  }
+
+  if (relativeTolerance > 0.0f) {
+    const Dvec diagonal(max[0] - min[0], max[1] - min[1], max[2] - min[2]);
+    const double extent = std::sqrt(diagonal.Dot(diagonal));
+    frame.tolerance =
+        relativeTolerance * extent + 8.0 * std::numeric_limits<float>::epsilon() * magnitude;
+  }
+  return frame;
+}
+
+}  // namespace
+
+bool AreColinear(std::span<const Vec3> points, float relativeTolerance) {
   if (points.size() < 2) return false;
 
   if (points.size() == 2) return true;
 
-  const Vec3& p0 = points[0];
-  const Vec3 direction = points[1] - p0;
+  // Measure against the longest chord from the first point for a well conditioned line
+  const Frame frame = Measure(points, relativeTolerance);
+  const Vec3& a = points[0];
+  const Vec3& b = points[frame.farthest];
 
   // All points identical
-  if (direction.LengthSquared() == 0.0f) {
-    for (std::size_t i = 2; i < points.size(); ++i) {
-      if ((points[i] - p0).LengthSquared() != 0.0f) return false;
-    }
-    return true;
-  }
+  if (frame.farthest == 0) return true;
 
-  for (std::size_t i = 2; i < points.size(); ++i) {
-    const Vec3 v = points[i] - p0;
+  const Dvec chord(b, a);
+  const double limit = frame.tolerance * frame.tolerance * chord.Dot(chord);
 
-    // v must be parallel to direction
-    if (!IsEqual(direction.Cross(v).LengthSquared(), 0.0f)) return false;
+  for (const Vec3& p : points) {
+    if (frame.tolerance == 0.0) {
+      if (!AreCollinear(a, b, p)) return false;
+    } else {
+      const Dvec cross = chord.Cross(Dvec(p, a));
+      if (cross.Dot(cross) > limit) return false;
+    }
   }
 
   return true;
 }
 
-bool AreCoplanar(std::span<const Vec3> points) {
-  if (points.size() < 3) return true;
+bool AreCoplanar(std::span<const Vec3> points, float relativeTolerance) {
+  if (points.size() < 4) return true;
 
-  const Vec3& p0 = points[0];
-
-  // Find first non-collinear triplet
-  Vec3 normal{};
-  bool foundPlane = false;
+  // Reference plane from the first point, the point farthest from it and the point
+  // spanning the largest triangle with those two
+  const Frame frame = Measure(points, relativeTolerance);
+  const Vec3& a = points[0];
+  const Vec3& b = points[frame.farthest];
+  const Dvec chord(b, a);
 
-  for (std::size_t i = 1; i + 1 < points.size(); ++i) {
-    normal = (points[i] - p0).Cross(points[i + 1] - p0);
-    if (!IsEqual(normal.LengthSquared(), 0.0f)) {
-      foundPlane = true;
-      break;
+  std::size_t best = 0;
+  Dvec normal(0.0, 0.0, 0.0);
+  double bestArea = 0.0;
+  for (std::size_t i = 1; i < points.size(); ++i) {
+    const Dvec cross = chord.Cross(Dvec(points[i], a));
+    const double area = cross.Dot(cross);
+    if (area > bestArea) {
+      bestArea = area;
+      normal = cross;
+      best = i;
     }
   }
 
   // All points collinear → coplanar
-  if (!foundPlane) return true;
+  if (bestArea == 0.0) return true;
+
+  // normal . (p - a) is |normal| times the signed distance of p from the plane. Exact
+  // signs (Orient3d) only matter for a zero tolerance; otherwise the double precision
+  // distance is far more accurate than the tolerance it is compared against.
+  if (frame.tolerance == 0.0) {
+    for (const Vec3& p : points) {
+      if (Orient3d(a, b, points[best], p) != 0.0) return false;
+    }
+    return true;
+  }
 
-  for (std::size_t i = 1; i < points.size(); ++i) {
-    const Vec3 v = points[i] - p0;
-    if (!IsEqual(normal.Dot(v), 0.0f)) return false;
+  const double limit = frame.tolerance * std::sqrt(bestArea);
+  for (const Vec3& p : points) {
+    if (std::abs(normal.Dot(Dvec(p, a))) > limit) return false;
   }
 
   return true;
 }
 
+Vec3 PolygonNormal(std::span<const Vec3> points) {
+  Vec3 normal{};
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const Vec3& current = points[i];
+    const Vec3& next = points[(i + 1) % points.size()];
+    normal.x += (current.y - next.y) * (current.z + next.z);
+    normal.y += (current.z - next.z) * (current.x + next.x);
+    normal.z += (current.x - next.x) * (current.y + next.y);
+  }
+
+  // Small faces have tiny Newell vectors, below Vec3's division guard
+  const float length = normal.Length();
+  return length > 0.0f ? normal * (1.0f / length) : Vec3{};
+}
+
 }  // namespace Geometry
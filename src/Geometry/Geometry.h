@@ -5,6 +5,15 @@ struct Vec3;
 struct Vertex;
 
 namespace Geometry {
-bool AreColinear(std::span<const Vec3> points);
-bool AreCoplanar(std::span<const Vec3> points);
+// Tolerances are relative to the size of the point set (bounding box diagonal), plus
+// the rounding noise of the float coordinates themselves, so the same shape passes or
+// fails at any scale. A tolerance of 0 makes the tests exact.
+inline constexpr float kRelativeTolerance = 1e-5f;
+
+bool AreColinear(std::span<const Vec3> points, float relativeTolerance = kRelativeTolerance);
+bool AreCoplanar(std::span<const Vec3> points, float relativeTolerance = kRelativeTolerance);
+
+// Newell's method: robust for concave and nearly degenerate polygons. Returns the
+// normalised normal, or zero if the polygon has no area.
+Vec3 PolygonNormal(std::span<const Vec3> points);
 }  // namespace Geometry
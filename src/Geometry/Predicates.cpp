@@ -0,0 +1,289 @@
+#include "Predicates.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace Geometry {
+
+namespace {
+
+// -------------------------------------------------
+// Error bounds for the double precision filters
+// -------------------------------------------------
+constexpr double kEpsilon = 0x1p-53;
+constexpr double kOrient2dBound = (3.0 + 16.0 * kEpsilon) * kEpsilon;
+constexpr double kOrient3dBound = (7.0 + 56.0 * kEpsilon) * kEpsilon;
+// One more rounded addition on top of two orient3d evaluations
+constexpr double kOrient3dSumBound = (8.0 + 64.0 * kEpsilon) * kEpsilon;
+
+// -------------------------------------------------
+// Exact arithmetic on expansions: sums of non-overlapping doubles, stored in
+// increasing magnitude with zero components removed
+// -------------------------------------------------
+class Expansion {
+ public:
+  // Largest intermediate: the sum of two orient3d expansions, each three products of
+  // 2 x (2 x 2 - 2 x 2) terms
+  static constexpr int kCapacity = 384;
+
+  Expansion() = default;
+
+  // Copy only the live components
+  Expansion(const Expansion& other) : size_(other.size_) {
+    std::copy_n(other.terms_.begin(), size_, terms_.begin());
+  }
+
+  Expansion& operator=(const Expansion& other) {
+    size_ = other.size_;
+    std::copy_n(other.terms_.begin(), size_, terms_.begin());
+    return *this;
+  }
+
+  // a - b, exactly
+  static Expansion Difference(double a, double b) {
+    Expansion result;
+    const double x = a - b;
+    const double bVirtual = a - x;
+    const double aVirtual = x + bVirtual;
+    const double err = (a - aVirtual) + (bVirtual - b);
+    result.Append(err);
+    result.Append(x);
+    return result;
+  }
+
+  Expansion operator+(const Expansion& other) const {
+    Expansion result = *this;
+    for (int i = 0; i < other.size_; ++i) result.Grow(other.terms_[i]);
+    return result;
+  }
+
+  Expansion operator-(const Expansion& other) const { return *this + other.Scale(-1.0); }
+
+  Expansion operator*(const Expansion& other) const {
+    Expansion result;
+    for (int i = 0; i < other.size_; ++i) {
+      const Expansion scaled = Scale(other.terms_[i]);
+      for (int j = 0; j < scaled.size_; ++j) result.Grow(scaled.terms_[j]);
+    }
+    return result;
+  }
+
+  // The largest component carries the sign of the whole expansion
+  double Estimate() const { return size_ ? terms_[size_ - 1] : 0.0; }
+
+ private:
+  void Append(double term) {
+    if (term != 0.0) terms_[size_++] = term;
+  }
+
+  static void TwoSum(double a, double b, double& sum, double& err) {
+    sum = a + b;
+    const double bVirtual = sum - a;
+    const double aVirtual = sum - bVirtual;
+    err = (a - aVirtual) + (b - bVirtual);
+  }
+
+  static void TwoProduct(double a, double b, double& product, double& err) {
+    product = a * b;
+    err = std::fma(a, b, -product);
+  }
+
+  // Adds b in place; components are only ever written at or below the one being read
+  void Grow(double b) {
+    double q = b;
+    int count = 0;
+    for (int i = 0; i < size_; ++i) {
+      double sum = 0.0;
+      double err = 0.0;
+      TwoSum(q, terms_[i], sum, err);
+      if (err != 0.0) terms_[count++] = err;
+      q = sum;
+    }
+    if (q != 0.0) terms_[count++] = q;
+    size_ = count;
+  }
+
+  Expansion Scale(double b) const {
+    Expansion result;
+    if (size_ == 0) return result;
+
+    double q = 0.0;
+    double err = 0.0;
+    TwoProduct(terms_[0], b, q, err);
+    result.Append(err);
+    for (int i = 1; i < size_; ++i) {
+      double product = 0.0;
+      double productErr = 0.0;
+      TwoProduct(terms_[i], b, product, productErr);
+      double sum = 0.0;
+      TwoSum(q, productErr, sum, err);
+      result.Append(err);
+      TwoSum(product, sum, q, err);
+      result.Append(err);
+    }
+    result.Append(q);
+    return result;
+  }
+
+  std::array<double, kCapacity> terms_;
+  int size_ = 0;
+};
+
+// Rounding error of diff = a - b
+double DifferenceTail(double a, double b, double diff) {
+  const double bVirtual = a - diff;
+  const double aVirtual = diff + bVirtual;
+  return (a - aVirtual) + (bVirtual - b);
+}
+
+double Orient2dExact(double ax, double ay, double bx, double by, double cx, double cy) {
+  const Expansion left = Expansion::Difference(bx, ax) * Expansion::Difference(cy, ay);
+  const Expansion right = Expansion::Difference(by, ay) * Expansion::Difference(cx, ax);
+  return (left - right).Estimate();
+}
+
+Expansion Orient3dExpansion(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d) {
+  const Expansion ux = Expansion::Difference(b.x, a.x);
+  const Expansion uy = Expansion::Difference(b.y, a.y);
+  const Expansion uz = Expansion::Difference(b.z, a.z);
+  const Expansion vx = Expansion::Difference(c.x, a.x);
+  const Expansion vy = Expansion::Difference(c.y, a.y);
+  const Expansion vz = Expansion::Difference(c.z, a.z);
+  const Expansion wx = Expansion::Difference(d.x, a.x);
+  const Expansion wy = Expansion::Difference(d.y, a.y);
+  const Expansion wz = Expansion::Difference(d.z, a.z);
+
+  // (u x v) . w
+  const Expansion nx = uy * vz - uz * vy;
+  const Expansion ny = uz * vx - ux * vz;
+  const Expansion nz = ux * vy - uy * vx;
+  return nx * wx + ny * wy + nz * wz;
+}
+
+double Orient3dExact(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d) {
+  return Orient3dExpansion(a, b, c, d).Estimate();
+}
+
+// Double precision orient3d and the permanent bounding its rounding error
+double Orient3dApprox(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d,
+                      double& permanent) {
+  const double ux = static_cast<double>(b.x) - a.x;
+  const double uy = static_cast<double>(b.y) - a.y;
+  const double uz = static_cast<double>(b.z) - a.z;
+  const double vx = static_cast<double>(c.x) - a.x;
+  const double vy = static_cast<double>(c.y) - a.y;
+  const double vz = static_cast<double>(c.z) - a.z;
+  const double wx = static_cast<double>(d.x) - a.x;
+  const double wy = static_cast<double>(d.y) - a.y;
+  const double wz = static_cast<double>(d.z) - a.z;
+
+  permanent = (std::abs(uy * vz) + std::abs(uz * vy)) * std::abs(wx) +
+              (std::abs(uz * vx) + std::abs(ux * vz)) * std::abs(wy) +
+              (std::abs(ux * vy) + std::abs(uy * vx)) * std::abs(wz);
+  return (uy * vz - uz * vy) * wx + (uz * vx - ux * vz) * wy + (ux * vy - uy * vx) * wz;
+}
+
+float Component(const Vec3& v, int axis) { return axis == 0 ? v.x : axis == 1 ? v.y : v.z; }
+
+}  // namespace
+
+double Orient2d(float ax, float ay, float bx, float by, float cx, float cy) {
+  const double abx = static_cast<double>(bx) - ax;
+  const double acy = static_cast<double>(cy) - ay;
+  const double aby = static_cast<double>(by) - ay;
+  const double acx = static_cast<double>(cx) - ax;
+  const double left = abx * acy;
+  const double right = aby * acx;
+  const double det = left - right;
+
+  const double bound = kOrient2dBound * (std::abs(left) + std::abs(right));
+  if (std::abs(det) > bound) return det;
+
+  // A rounded subtraction keeps its sign, so det is already sign exact when the
+  // differences and products were computed without error. That is the usual case for
+  // collinear corners and settles them without touching expansions.
+  if (DifferenceTail(bx, ax, abx) == 0.0 && DifferenceTail(cy, ay, acy) == 0.0 &&
+      DifferenceTail(by, ay, aby) == 0.0 && DifferenceTail(cx, ax, acx) == 0.0 &&
+      std::fma(abx, acy, -left) == 0.0 && std::fma(aby, acx, -right) == 0.0) {
+    return det;
+  }
+
+  return Orient2dExact(ax, ay, bx, by, cx, cy);
+}
+
+double Orient3d(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d) {
+  const double ux = static_cast<double>(b.x) - a.x;
+  const double uy = static_cast<double>(b.y) - a.y;
+  const double uz = static_cast<double>(b.z) - a.z;
+  const double vx = static_cast<double>(c.x) - a.x;
+  const double vy = static_cast<double>(c.y) - a.y;
+  const double vz = static_cast<double>(c.z) - a.z;
+  const double wx = static_cast<double>(d.x) - a.x;
+  const double wy = static_cast<double>(d.y) - a.y;
+  const double wz = static_cast<double>(d.z) - a.z;
+
+  const double det = (uy * vz - uz * vy) * wx + (uz * vx - ux * vz) * wy + (ux * vy - uy * vx) * wz;
+
+  const double permanent = (std::abs(uy * vz) + std::abs(uz * vy)) * std::abs(wx) +
+                           (std::abs(uz * vx) + std::abs(ux * vz)) * std::abs(wy) +
+                           (std::abs(ux * vy) + std::abs(uy * vx)) * std::abs(wz);
+  if (std::abs(det) > kOrient3dBound * permanent) return det;
+
+  return Orient3dExact(a, b, c, d);
+}
+
+double Orient3dSum(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d, const Vec3& e,
+                   const Vec3& f, const Vec3& g, const Vec3& h) {
+  double firstPermanent = 0.0;
+  double secondPermanent = 0.0;
+  const double sum =
+      Orient3dApprox(a, b, c, d, firstPermanent) + Orient3dApprox(e, f, g, h, secondPermanent);
+  if (std::abs(sum) > kOrient3dSumBound * (firstPermanent + secondPermanent)) return sum;
+
+  return (Orient3dExpansion(a, b, c, d) + Orient3dExpansion(e, f, g, h)).Estimate();
+}
+
+double Orient2dAlong(const Vec3& a, const Vec3& b, const Vec3& c, int axis) {
+  // Keep the remaining axes cyclic (y z, z x, x y) so the sign matches the cross product
+  const int u = (axis + 1) % 3;
+  const int v = (axis + 2) % 3;
+  return Orient2d(Component(a, u), Component(a, v), Component(b, u), Component(b, v),
+                  Component(c, u), Component(c, v));
+}
+
+double CrossAlong(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d, int axis) {
+  const int u = (axis + 1) % 3;
+  const int v = (axis + 2) % 3;
+  const double abu = static_cast<double>(Component(b, u)) - Component(a, u);
+  const double abv = static_cast<double>(Component(b, v)) - Component(a, v);
+  const double cdu = static_cast<double>(Component(d, u)) - Component(c, u);
+  const double cdv = static_cast<double>(Component(d, v)) - Component(c, v);
+  const double left = abu * cdv;
+  const double right = abv * cdu;
+  const double det = left - right;
+
+  const double bound = kOrient2dBound * (std::abs(left) + std::abs(right));
+  if (std::abs(det) > bound) return det;
+
+  const Expansion exactLeft = Expansion::Difference(Component(b, u), Component(a, u)) *
+                              Expansion::Difference(Component(d, v), Component(c, v));
+  const Expansion exactRight = Expansion::Difference(Component(b, v), Component(a, v)) *
+                               Expansion::Difference(Component(d, u), Component(c, u));
+  return (exactLeft - exactRight).Estimate();
+}
+
+bool AreCollinear(const Vec3& a, const Vec3& b, const Vec3& c) {
+  return Orient2dAlong(a, b, c, 0) == 0.0 && Orient2dAlong(a, b, c, 1) == 0.0 &&
+         Orient2dAlong(a, b, c, 2) == 0.0;
+}
+
+int DominantAxis(const Vec3& v) {
+  const float x = std::abs(v.x);
+  const float y = std::abs(v.y);
+  const float z = std::abs(v.z);
+  if (x >= y && x >= z) return 0;
+  return y >= z ? 1 : 2;
+}
+
+}  // namespace Geometry
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Utilities/Vec3.h"
+
+// Orientation predicates with exact signs on float coordinates. A double precision
+// evaluation with a forward error bound settles almost every call; only inputs within
+// rounding distance of degenerate fall back to exact expansion arithmetic (Shewchuk).
+// The magnitude of the result approximates the determinant; only its sign is exact.
+namespace Geometry {
+
+// > 0 when a, b, c turn counter clockwise, < 0 clockwise, 0 when collinear
+double Orient2d(float ax, float ay, float bx, float by, float cx, float cy);
+
+// > 0 when d lies on the side of plane (a, b, c) that (b - a) x (c - a) points to,
+// < 0 on the other side, 0 when the four points are coplanar
+double Orient3d(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d);
+
+// Orient3d(a, b, c, d) + Orient3d(e, f, g, h) with an exact sign
+double Orient3dSum(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d, const Vec3& e,
+                   const Vec3& f, const Vec3& g, const Vec3& h);
+
+// Orient2d of a, b, c projected along axis (0 = x, 1 = y, 2 = z). The sign matches
+// ((b - a) x (c - a))[axis], so with the dominant axis of a plane's normal it gives
+// the turn direction about that normal.
+double Orient2dAlong(const Vec3& a, const Vec3& b, const Vec3& c, int axis);
+
+// Component axis of (b - a) x (d - c), the cross product of two independent
+// segments. Same filtering and exact fallback as Orient2d.
+double CrossAlong(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d, int axis);
+
+// Exact: true when a, b, c lie on one line (or coincide)
+bool AreCollinear(const Vec3& a, const Vec3& b, const Vec3& c);
+
+// Index (0 = x, 1 = y, 2 = z) of the largest magnitude component
+int DominantAxis(const Vec3& v);
+
+}  // namespace Geometry
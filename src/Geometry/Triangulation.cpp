@@ -0,0 +1,158 @@
+#include "Triangulation.h"
+
+#include "Geometry/Predicates.h"
+
+namespace Geometry {
+
+namespace {
+
+// Turn direction about a polygon normal, decided exactly in the plane of the normal's
+// dominant axis
+struct Plane {
+  int axis = 2;
+  double sign = 1.0;
+
+  explicit Plane(const Vec3& normal) : axis(DominantAxis(normal)) {
+    const float dominant = axis == 0 ? normal.x : axis == 1 ? normal.y : normal.z;
+    sign = dominant < 0.0f ? -1.0 : 1.0;
+  }
+
+  // Positive when the turn a -> b -> c is counter clockwise about the normal
+  double Turn(const Vec3& a, const Vec3& b, const Vec3& c) const {
+    return sign * Orient2dAlong(a, b, c, axis);
+  }
+
+  // Inclusive test so points on an ear's boundary block it
+  bool InTriangle(const Vec3& p, const Vec3& a, const Vec3& b, const Vec3& c) const {
+    return Turn(a, b, p) >= 0.0 && Turn(b, c, p) >= 0.0 && Turn(c, a, p) >= 0.0;
+  }
+};
+
+bool SamePosition(const Vec3& a, const Vec3& b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+
+void Fan(uint32_t count, std::vector<uint32_t>& out) {
+  for (uint32_t i = 1; i + 1 < count; ++i) {
+    out.push_back(0);
+    out.push_back(i);
+    out.push_back(i + 1);
+  }
+}
+
+void Quad(std::span<const Vec3> p, const Plane& plane, std::vector<uint32_t>& out) {
+  // A simple quad has at most one reflex corner; the diagonal must start there.
+  // Convex quads split along the shorter diagonal for better shaped triangles.
+  uint32_t k = (p[0] - p[2]).LengthSquared() <= (p[1] - p[3]).LengthSquared() ? 0 : 1;
+  for (uint32_t i = 0; i < 4; ++i) {
+    if (plane.Turn(p[(i + 3) % 4], p[i], p[(i + 1) % 4]) < 0.0) {
+      k = i;
+      break;
+    }
+  }
+
+  const uint32_t corners[6] = {k, (k + 1) % 4, (k + 2) % 4, k, (k + 2) % 4, (k + 3) % 4};
+  out.insert(out.end(), corners, corners + 6);
+}
+
+void EarClip(std::span<const Vec3> p, const Plane& plane, std::vector<uint32_t>& out) {
+  const auto n = static_cast<uint32_t>(p.size());
+
+  // Circular doubly linked list over the remaining corners
+  thread_local std::vector<uint32_t> prev;
+  thread_local std::vector<uint32_t> next;
+  thread_local std::vector<uint8_t> reflex;
+  prev.resize(n);
+  next.resize(n);
+  reflex.resize(n);
+  for (uint32_t i = 0; i < n; ++i) {
+    prev[i] = (i + n - 1) % n;
+    next[i] = (i + 1) % n;
+  }
+
+  auto updateReflex = [&](uint32_t i) {
+    reflex[i] = plane.Turn(p[prev[i]], p[i], p[next[i]]) <= 0.0;
+  };
+  for (uint32_t i = 0; i < n; ++i) updateReflex(i);
+
+  // Only reflex corners can lie inside an ear
+  auto isEar = [&](uint32_t i) {
+    if (reflex[i]) return false;
+    const uint32_t a = prev[i];
+    const uint32_t c = next[i];
+    for (uint32_t j = next[c]; j != a; j = next[j]) {
+      if (!reflex[j]) continue;
+      // Corners duplicated in position (e.g. at a bridge) do not block the ear
+      if (SamePosition(p[j], p[a]) || SamePosition(p[j], p[i]) || SamePosition(p[j], p[c])) {
+        continue;
+      }
+      if (plane.InTriangle(p[j], p[a], p[i], p[c])) return false;
+    }
+    return true;
+  };
+
+  uint32_t remaining = n;
+  uint32_t corner = 0;
+  uint32_t misses = 0;
+  while (remaining > 3) {
+    // A full lap without an ear means the input is not simple; clip anyway so the
+    // output still covers the polygon with n - 2 triangles
+    if (isEar(corner) || misses >= remaining) {
+      const uint32_t a = prev[corner];
+      const uint32_t c = next[corner];
+      out.push_back(a);
+      out.push_back(corner);
+      out.push_back(c);
+
+      next[a] = c;
+      prev[c] = a;
+      --remaining;
+      updateReflex(a);
+      updateReflex(c);
+
+      corner = c;
+      misses = 0;
+    } else {
+      corner = next[corner];
+      ++misses;
+    }
+  }
+
+  out.push_back(prev[corner]);
+  out.push_back(corner);
+  out.push_back(next[corner]);
+}
+
+bool IsConvex(std::span<const Vec3> p, const Plane& plane) {
+  const std::size_t n = p.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    if (plane.Turn(p[(i + n - 1) % n], p[i], p[(i + 1) % n]) < 0.0) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool IsConvexPolygon(std::span<const Vec3> points, const Vec3& normal) {
+  return IsConvex(points, Plane(normal));
+}
+
+void TriangulatePolygon(std::span<const Vec3> points, const Vec3& normal,
+                        std::vector<uint32_t>& outCorners) {
+  const auto n = static_cast<uint32_t>(points.size());
+  if (n < 3) return;
+
+  if (n == 3 || normal.LengthSquared() == 0.0f) {
+    Fan(n, outCorners);
+    return;
+  }
+
+  const Plane plane(normal);
+  if (n == 4) {
+    Quad(points, plane, outCorners);
+  } else if (IsConvex(points, plane)) {
+    Fan(n, outCorners);
+  } else {
+    EarClip(points, plane, outCorners);
+  }
+}
+
+}  // namespace Geometry
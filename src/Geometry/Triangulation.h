@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Utilities/Vec3.h"
+
+namespace Geometry {
+
+// True if every corner turns the same way around normal (collinear corners allowed)
+bool IsConvexPolygon(std::span<const Vec3> points, const Vec3& normal);
+
+// Triangulate a simple planar polygon given in loop order. Appends three corner indices
+// (into points) per triangle to outCorners, wound like the loop. Triangles, quads and
+// convex polygons take O(n) fast paths; anything else is ear clipped in the polygon's
+// plane. normal must follow the loop winding (e.g. PolygonNormal); a zero normal
+// falls back to a fan.
+void TriangulatePolygon(std::span<const Vec3> points, const Vec3& normal,
+                        std::vector<uint32_t>& outCorners);
+
+}  // namespace Geometry
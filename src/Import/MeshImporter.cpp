@@ -0,0 +1,1129 @@
+#include "MeshImporter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "Topology/EdgeTable.h"
+#include "Utilities/JobSystem.h"
+#include "Utilities/MappedFile.h"
+#include "Utilities/TextParsing.h"
+
+namespace Import {
+
+namespace {
+
+using namespace TextParsing;
+
+// -------------------------------------------------
+// Shared plumbing
+// -------------------------------------------------
+
+// Polygon soup produced by the format parsers, before welding and edge building
+struct RawMesh {
+  std::vector<Vec3> positions;
+  std::vector<uint32_t> loopVertices;
+  std::vector<uint32_t> loopOffsets{0};
+
+  std::size_t LoopCount() const { return loopOffsets.size() - 1; }
+};
+
+struct ParseError {
+  Status status;
+  std::string message;
+};
+
+class Progress {
+ public:
+  explicit Progress(const Options& options) : options_(options) {}
+
+  bool Cancelled() const {
+    return options_.cancel && options_.cancel->load(std::memory_order_relaxed);
+  }
+
+  // Map the following Report calls onto [begin, end) of the overall progress
+  void BeginStage(float begin, float end) {
+    stageBegin_ = begin;
+    stageEnd_ = end;
+    Report(0.0f);
+  }
+
+  void Report(float stageFraction) {
+    if (!options_.progress) return;
+
+    const float value =
+        stageBegin_ + (stageEnd_ - stageBegin_) * std::clamp(stageFraction, 0.f, 1.f);
+
+    std::lock_guard lock(mutex_);
+    if (value <= reported_) return;
+    reported_ = value;
+    options_.progress(value);
+  }
+
+ private:
+  const Options& options_;
+  float stageBegin_ = 0.0f;
+  float stageEnd_ = 0.0f;
+  float reported_ = -1.0f;
+  std::mutex mutex_;
+};
+
+// Split text into chunks of roughly chunkBytes, each ending just after a newline
+std::vector<std::string_view> SplitLines(std::string_view text) {
+  const std::size_t threads = Jobs::Concurrency();
+  const std::size_t chunkBytes =
+      std::clamp<std::size_t>(text.size() / (threads * 8), 256 * 1024, 16 * 1024 * 1024);
+
+  std::vector<std::string_view> chunks;
+  std::size_t begin = 0;
+  while (begin < text.size()) {
+    std::size_t end = std::min(text.size(), begin + chunkBytes);
+    if (end < text.size()) {
+      const std::size_t newline = text.find('\n', end);
+      end = newline == std::string_view::npos ? text.size() : newline + 1;
+    }
+    chunks.push_back(text.substr(begin, end - begin));
+    begin = end;
+  }
+  return chunks;
+}
+
+// Run body over every chunk in parallel, reporting progress as chunks complete
+template <typename Body>
+void ForEachChunk(std::size_t chunkCount, Progress& progress, Body&& body) {
+  std::atomic<std::size_t> completed{0};
+  Jobs::ParallelFor(chunkCount, 1, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      if (progress.Cancelled()) return;
+      body(i);
+      progress.Report(static_cast<float>(completed.fetch_add(1) + 1) / chunkCount);
+    }
+  });
+}
+
+// Concatenate per-chunk loops (sizes + vertex indices) into the raw mesh
+void AppendLoops(RawMesh& raw, std::span<const uint32_t> loopSizes,
+                 std::span<const uint32_t> loopVertices) {
+  raw.loopVertices.insert(raw.loopVertices.end(), loopVertices.begin(), loopVertices.end());
+  uint32_t offset = raw.loopOffsets.back();
+  for (uint32_t size : loopSizes) {
+    offset += size;
+    raw.loopOffsets.push_back(offset);
+  }
+}
+
+// -------------------------------------------------
+// OBJ
+// -------------------------------------------------
+
+struct ObjChunk {
+  std::vector<Vec3> positions;
+  std::vector<int64_t> indices;    // 0-based; relative ones are chunk local until fixed up
+  std::vector<uint32_t> relative;  // slots in indices that need the chunk's vertex base
+  std::vector<uint32_t> loopSizes;
+  bool ok = true;
+};
+
+void ParseObjChunk(std::string_view text, ObjChunk& out) {
+  const char* p = text.data();
+  const char* end = p + text.size();
+
+  while (p < end) {
+    p = SkipBlanks(p, end);
+
+    if (p + 1 < end && p[0] == 'v' && IsBlank(p[1])) {
+      Vec3 v;
+      p = ParseFloat(p + 1, end, v.x);
+      if (p) p = ParseFloat(p, end, v.y);
+      if (p) p = ParseFloat(p, end, v.z);
+      if (!p) {
+        out.ok = false;
+        return;
+      }
+      out.positions.push_back(v);
+    } else if (p + 1 < end && p[0] == 'f' && IsBlank(p[1])) {
+      ++p;
+      uint32_t count = 0;
+      for (;;) {
+        p = SkipBlanks(p, end);
+        if (p >= end || *p == '\n' || *p == '#') break;
+
+        int64_t index = 0;
+        p = ParseInt(p, end, index);
+        if (!p || index == 0) {
+          out.ok = false;
+          return;
+        }
+
+        if (index > 0) {
+          out.indices.push_back(index - 1);
+        } else {
+          out.relative.push_back(static_cast<uint32_t>(out.indices.size()));
+          out.indices.push_back(static_cast<int64_t>(out.positions.size()) + index);
+        }
+        ++count;
+
+        // Skip texture / normal references ("i/t/n", "i//n")
+        p = SkipToken(p, end);
+      }
+
+      if (count >= 3) {
+        out.loopSizes.push_back(count);
+      } else {
+        out.indices.resize(out.indices.size() - count);
+        while (!out.relative.empty() && out.relative.back() >= out.indices.size()) {
+          out.relative.pop_back();
+        }
+      }
+    }
+
+    p = SkipLine(p, end);
+  }
+}
+
+std::optional<ParseError> ParseObj(std::string_view text, RawMesh& raw, Progress& progress) {
+  const auto chunks = SplitLines(text);
+  std::vector<ObjChunk> parsed(chunks.size());
+
+  ForEachChunk(chunks.size(), progress,
+               [&](std::size_t i) { ParseObjChunk(chunks[i], parsed[i]); });
+  if (progress.Cancelled()) return ParseError{Status::Cancelled, "Import cancelled"};
+
+  std::size_t vertexCount = 0;
+  std::vector<std::size_t> vertexBase(parsed.size());
+  for (std::size_t i = 0; i < parsed.size(); ++i) {
+    if (!parsed[i].ok) return ParseError{Status::ParseError, "Malformed OBJ vertex or face"};
+    vertexBase[i] = vertexCount;
+    vertexCount += parsed[i].positions.size();
+  }
+
+  raw.positions.reserve(vertexCount);
+  for (const ObjChunk& chunk : parsed) {
+    raw.positions.insert(raw.positions.end(), chunk.positions.begin(), chunk.positions.end());
+  }
+
+  // Resolve relative indices and range check in parallel, then concatenate in order
+  std::atomic<bool> inRange{true};
+  Jobs::ParallelFor(parsed.size(), 1, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t c = begin; c < end; ++c) {
+      ObjChunk& chunk = parsed[c];
+      for (uint32_t slot : chunk.relative) {
+        chunk.indices[slot] += static_cast<int64_t>(vertexBase[c]);
+      }
+      for (int64_t index : chunk.indices) {
+        if (index < 0 || static_cast<std::size_t>(index) >= vertexCount) inRange = false;
+      }
+    }
+  });
+  if (!inRange) return ParseError{Status::ParseError, "OBJ face references a missing vertex"};
+
+  for (const ObjChunk& chunk : parsed) {
+    std::vector<uint32_t> loopVertices(chunk.indices.begin(), chunk.indices.end());
+    AppendLoops(raw, chunk.loopSizes, loopVertices);
+  }
+
+  return std::nullopt;
+}
+
+// -------------------------------------------------
+// PLY
+// -------------------------------------------------
+
+enum class PlyType { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64, Invalid };
+
+struct PlyProperty {
+  std::string name;
+  PlyType type = PlyType::Invalid;
+  bool isList = false;
+  PlyType countType = PlyType::Invalid;
+};
+
+struct PlyElement {
+  std::string name;
+  std::size_t count = 0;
+  std::vector<PlyProperty> properties;
+
+  bool IsFixedSize() const {
+    return std::none_of(properties.begin(), properties.end(),
+                        [](const PlyProperty& property) { return property.isList; });
+  }
+};
+
+enum class PlyEncoding { Ascii, BinaryLittleEndian, BinaryBigEndian };
+
+PlyType ParsePlyType(std::string_view name) {
+  if (name == "char" || name == "int8") return PlyType::Int8;
+  if (name == "uchar" || name == "uint8") return PlyType::UInt8;
+  if (name == "short" || name == "int16") return PlyType::Int16;
+  if (name == "ushort" || name == "uint16") return PlyType::UInt16;
+  if (name == "int" || name == "int32") return PlyType::Int32;
+  if (name == "uint" || name == "uint32") return PlyType::UInt32;
+  if (name == "float" || name == "float32") return PlyType::Float32;
+  if (name == "double" || name == "float64") return PlyType::Float64;
+  return PlyType::Invalid;
+}
+
+std::size_t PlyTypeSize(PlyType type) {
+  switch (type) {
+    case PlyType::Int8:
+    case PlyType::UInt8:
+      return 1;
+    case PlyType::Int16:
+    case PlyType::UInt16:
+      return 2;
+    case PlyType::Int32:
+    case PlyType::UInt32:
+    case PlyType::Float32:
+      return 4;
+    case PlyType::Float64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+template <typename T>
+T LoadBytes(const char* p, bool swap) {
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, p, sizeof(T));
+  if (swap) std::reverse(bytes, bytes + sizeof(T));
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return value;
+}
+
+double ReadPlyScalar(const char* p, PlyType type, bool swap) {
+  switch (type) {
+    case PlyType::Int8:
+      return LoadBytes<int8_t>(p, swap);
+    case PlyType::UInt8:
+      return LoadBytes<uint8_t>(p, swap);
+    case PlyType::Int16:
+      return LoadBytes<int16_t>(p, swap);
+    case PlyType::UInt16:
+      return LoadBytes<uint16_t>(p, swap);
+    case PlyType::Int32:
+      return LoadBytes<int32_t>(p, swap);
+    case PlyType::UInt32:
+      return LoadBytes<uint32_t>(p, swap);
+    case PlyType::Float32:
+      return LoadBytes<float>(p, swap);
+    case PlyType::Float64:
+      return LoadBytes<double>(p, swap);
+    default:
+      return 0.0;
+  }
+}
+
+struct PlyHeader {
+  PlyEncoding encoding = PlyEncoding::Ascii;
+  std::vector<PlyElement> elements;
+  std::size_t bodyOffset = 0;
+};
+
+std::optional<PlyHeader> ParsePlyHeader(std::string_view text) {
+  PlyHeader header;
+  const char* p = text.data();
+  const char* end = p + text.size();
+
+  auto nextWord = [&](const char*& cursor) {
+    cursor = SkipBlanks(cursor, end);
+    const char* start = cursor;
+    cursor = SkipToken(cursor, end);
+    return std::string_view(start, cursor - start);
+  };
+
+  if (nextWord(p) != "ply") return std::nullopt;
+  p = SkipLine(p, end);
+
+  while (p < end) {
+    const char* line = p;
+    const std::string_view keyword = nextWord(line);
+
+    if (keyword == "format") {
+      const std::string_view encoding = nextWord(line);
+      if (encoding == "ascii") {
+        header.encoding = PlyEncoding::Ascii;
+      } else if (encoding == "binary_little_endian") {
+        header.encoding = PlyEncoding::BinaryLittleEndian;
+      } else if (encoding == "binary_big_endian") {
+        header.encoding = PlyEncoding::BinaryBigEndian;
+      } else {
+        return std::nullopt;
+      }
+    } else if (keyword == "element") {
+      PlyElement element;
+      element.name = nextWord(line);
+      int64_t count = 0;
+      if (!ParseInt(line, end, count) || count < 0) return std::nullopt;
+      element.count = static_cast<std::size_t>(count);
+      header.elements.push_back(std::move(element));
+    } else if (keyword == "property") {
+      if (header.elements.empty()) return std::nullopt;
+      PlyProperty property;
+      const std::string_view type = nextWord(line);
+      if (type == "list") {
+        property.isList = true;
+        property.countType = ParsePlyType(nextWord(line));
+        property.type = ParsePlyType(nextWord(line));
+        if (property.countType == PlyType::Invalid) return std::nullopt;
+      } else {
+        property.type = ParsePlyType(type);
+      }
+      if (property.type == PlyType::Invalid) return std::nullopt;
+      property.name = nextWord(line);
+      header.elements.back().properties.push_back(std::move(property));
+    } else if (keyword == "end_header") {
+      header.bodyOffset = static_cast<std::size_t>(SkipLine(line, end) - text.data());
+      return header;
+    }
+
+    p = SkipLine(p, end);
+  }
+
+  return std::nullopt;
+}
+
+struct PlyVertexLayout {
+  int x = -1, y = -1, z = -1;
+  bool Valid() const { return x >= 0 && y >= 0 && z >= 0; }
+};
+
+PlyVertexLayout FindPositionProperties(const PlyElement& element) {
+  PlyVertexLayout layout;
+  for (int i = 0; i < static_cast<int>(element.properties.size()); ++i) {
+    const std::string& name = element.properties[i].name;
+    if (element.properties[i].isList) continue;
+    if (name == "x") layout.x = i;
+    if (name == "y") layout.y = i;
+    if (name == "z") layout.z = i;
+  }
+  return layout;
+}
+
+int FindFaceIndexProperty(const PlyElement& element) {
+  for (int i = 0; i < static_cast<int>(element.properties.size()); ++i) {
+    const PlyProperty& property = element.properties[i];
+    if (property.isList && (property.name == "vertex_indices" || property.name == "vertex_index")) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// ---- Binary PLY ----
+
+// Byte size of one binary record starting at p, or 0 if it runs past the end. Every
+// read is checked against the remaining bytes first, so it is safe on truncated input.
+std::size_t PlyRecordSize(const PlyElement& element, const char* p, const char* end, bool swap) {
+  const std::size_t available = static_cast<std::size_t>(end - p);
+  std::size_t size = 0;
+  for (const PlyProperty& property : element.properties) {
+    const std::size_t itemSize = PlyTypeSize(property.type);
+    if (property.isList) {
+      const std::size_t countSize = PlyTypeSize(property.countType);
+      if (available - size < countSize) return 0;
+      const double count = ReadPlyScalar(p + size, property.countType, swap);
+      size += countSize;
+      if (!(count >= 0.0) || count > static_cast<double>((available - size) / itemSize)) return 0;
+      size += static_cast<std::size_t>(count) * itemSize;
+    } else {
+      if (available - size < itemSize) return 0;
+      size += itemSize;
+    }
+  }
+  return size;
+}
+
+// True when count records of stride bytes fit in [p, end), without overflowing the product
+bool FitsRecords(const char* p, const char* end, std::size_t stride, std::size_t count) {
+  return stride == 0 || count <= static_cast<std::size_t>(end - p) / stride;
+}
+
+std::optional<ParseError> ParsePlyBinary(std::string_view text, const PlyHeader& header,
+                                         RawMesh& raw, Progress& progress) {
+  const bool swap = header.encoding == PlyEncoding::BinaryBigEndian;
+  const char* p = text.data() + header.bodyOffset;
+  const char* end = text.data() + text.size();
+  const ParseError truncated{Status::ParseError, "PLY body is truncated"};
+
+  for (const PlyElement& element : header.elements) {
+    if (progress.Cancelled()) return ParseError{Status::Cancelled, "Import cancelled"};
+
+    if (element.name == "vertex") {
+      const PlyVertexLayout layout = FindPositionProperties(element);
+      if (!layout.Valid()) return ParseError{Status::ParseError, "PLY vertex lacks x/y/z"};
+
+      if (element.IsFixedSize()) {
+        // Fixed stride records parse independently
+        std::size_t offsets[3] = {};
+        std::size_t stride = 0;
+        for (int i = 0; i < static_cast<int>(element.properties.size()); ++i) {
+          if (i == layout.x) offsets[0] = stride;
+          if (i == layout.y) offsets[1] = stride;
+          if (i == layout.z) offsets[2] = stride;
+          stride += PlyTypeSize(element.properties[i].type);
+        }
+        if (!FitsRecords(p, end, stride, element.count)) return truncated;
+
+        const PlyType types[3] = {element.properties[layout.x].type,
+                                  element.properties[layout.y].type,
+                                  element.properties[layout.z].type};
+        const std::size_t base = raw.positions.size();
+        raw.positions.resize(base + element.count);
+        Jobs::ParallelFor(element.count, 64 * 1024, [&](std::size_t begin, std::size_t last) {
+          for (std::size_t i = begin; i < last; ++i) {
+            const char* record = p + i * stride;
+            raw.positions[base + i] = Vec3(
+                static_cast<float>(ReadPlyScalar(record + offsets[0], types[0], swap)),
+                static_cast<float>(ReadPlyScalar(record + offsets[1], types[1], swap)),
+                static_cast<float>(ReadPlyScalar(record + offsets[2], types[2], swap)));
+          }
+        });
+        p += stride * element.count;
+      } else {
+        for (std::size_t i = 0; i < element.count; ++i) {
+          const std::size_t size = PlyRecordSize(element, p, end, swap);
+          if (size == 0) return truncated;
+
+          Vec3 v;
+          const char* cursor = p;
+          for (int k = 0; k < static_cast<int>(element.properties.size()); ++k) {
+            const PlyProperty& property = element.properties[k];
+            if (property.isList) {
+              const double count = ReadPlyScalar(cursor, property.countType, swap);
+              cursor += PlyTypeSize(property.countType) +
+                        static_cast<std::size_t>(count) * PlyTypeSize(property.type);
+              continue;
+            }
+            const float value = static_cast<float>(ReadPlyScalar(cursor, property.type, swap));
+            if (k == layout.x) v.x = value;
+            if (k == layout.y) v.y = value;
+            if (k == layout.z) v.z = value;
+            cursor += PlyTypeSize(property.type);
+          }
+          raw.positions.push_back(v);
+          p += size;
+        }
+      }
+    } else if (element.name == "face") {
+      const int listIndex = FindFaceIndexProperty(element);
+      if (listIndex < 0) return ParseError{Status::ParseError, "PLY face lacks vertex_indices"};
+
+      // Variable length records: a single forward scan
+      raw.loopVertices.reserve(raw.loopVertices.size() + element.count * 3);
+      raw.loopOffsets.reserve(raw.loopOffsets.size() + element.count);
+      for (std::size_t i = 0; i < element.count; ++i) {
+        const std::size_t size = PlyRecordSize(element, p, end, swap);
+        if (size == 0) return truncated;
+
+        const char* cursor = p;
+        for (int k = 0; k < static_cast<int>(element.properties.size()); ++k) {
+          const PlyProperty& property = element.properties[k];
+          if (!property.isList) {
+            cursor += PlyTypeSize(property.type);
+            continue;
+          }
+          const auto count =
+              static_cast<std::size_t>(ReadPlyScalar(cursor, property.countType, swap));
+          cursor += PlyTypeSize(property.countType);
+          if (k == listIndex && count >= 3) {
+            for (std::size_t j = 0; j < count; ++j) {
+              // Signed and 64-bit index types can hold values no vertex id can
+              const double index =
+                  ReadPlyScalar(cursor + j * PlyTypeSize(property.type), property.type, swap);
+              if (!(index >= 0.0) || index > static_cast<double>(UINT32_MAX)) {
+                return ParseError{Status::ParseError, "PLY face index out of range"};
+              }
+              raw.loopVertices.push_back(static_cast<uint32_t>(index));
+            }
+            raw.loopOffsets.push_back(static_cast<uint32_t>(raw.loopVertices.size()));
+          }
+          cursor += count * PlyTypeSize(property.type);
+        }
+        p += size;
+
+        if ((i & 0xFFFF) == 0) {
+          if (progress.Cancelled()) return ParseError{Status::Cancelled, "Import cancelled"};
+          progress.Report(static_cast<float>(p - text.data()) / text.size());
+        }
+      }
+    } else if (element.IsFixedSize()) {
+      std::size_t stride = 0;
+      for (const PlyProperty& property : element.properties) stride += PlyTypeSize(property.type);
+      if (!FitsRecords(p, end, stride, element.count)) return truncated;
+      p += stride * element.count;
+    } else {
+      for (std::size_t i = 0; i < element.count; ++i) {
+        const std::size_t size = PlyRecordSize(element, p, end, swap);
+        if (size == 0) return truncated;
+        p += size;
+      }
+    }
+    progress.Report(static_cast<float>(p - text.data()) / text.size());
+  }
+
+  return std::nullopt;
+}
+
+// ---- ASCII PLY ----
+
+// Byte offsets of line starts, computed with a parallel newline count so records of
+// later elements can be located without scanning the file serially
+class LineIndex {
+ public:
+  explicit LineIndex(std::string_view text) : text_(text) {
+    const std::size_t chunkCount = std::max<std::size_t>(1, Jobs::Concurrency() * 4);
+    chunkSize_ = std::max<std::size_t>(1, (text.size() + chunkCount - 1) / chunkCount);
+    const std::size_t chunks = (text.size() + chunkSize_ - 1) / chunkSize_;
+    newlines_.assign(chunks, 0);
+
+    Jobs::ParallelFor(chunks, 1, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t c = begin; c < end; ++c) {
+        const std::string_view slice = text_.substr(c * chunkSize_, chunkSize_);
+        newlines_[c] = static_cast<std::size_t>(std::count(slice.begin(), slice.end(), '\n'));
+      }
+    });
+  }
+
+  // Offset of the first byte of line `line` (0-based), or text size if out of range
+  std::size_t LineStart(std::size_t line) const {
+    if (line == 0) return 0;
+    std::size_t seen = 0;
+    for (std::size_t c = 0; c < newlines_.size(); ++c) {
+      if (seen + newlines_[c] >= line) {
+        std::size_t offset = c * chunkSize_;
+        for (;; ++offset) {
+          if (text_[offset] == '\n' && ++seen == line) return offset + 1;
+        }
+      }
+      seen += newlines_[c];
+    }
+    return text_.size();
+  }
+
+ private:
+  std::string_view text_;
+  std::size_t chunkSize_ = 1;
+  std::vector<std::size_t> newlines_;
+};
+
+struct PlyAsciiChunk {
+  std::vector<Vec3> positions;
+  std::vector<uint32_t> loopVertices;
+  std::vector<uint32_t> loopSizes;
+  bool ok = true;
+};
+
+void ParsePlyAsciiChunk(std::string_view text, const PlyElement& element, bool isVertex,
+                        PlyVertexLayout layout, int listIndex, PlyAsciiChunk& out) {
+  const char* p = text.data();
+  const char* end = p + text.size();
+
+  while (p < end) {
+    p = SkipSpaces(p, end);
+    if (p >= end) break;
+
+    Vec3 v;
+    for (int k = 0; k < static_cast<int>(element.properties.size()); ++k) {
+      const PlyProperty& property = element.properties[k];
+      if (property.isList) {
+        int64_t count = 0;
+        p = ParseInt(p, end, count);
+        if (!p || count < 0) {
+          out.ok = false;
+          return;
+        }
+        const bool keep = !isVertex && k == listIndex && count >= 3;
+        for (int64_t j = 0; j < count; ++j) {
+          int64_t index = 0;
+          p = ParseInt(p, end, index);
+          if (!p || index < 0 || index > int64_t{UINT32_MAX}) {
+            out.ok = false;
+            return;
+          }
+          if (keep) out.loopVertices.push_back(static_cast<uint32_t>(index));
+        }
+        if (keep) out.loopSizes.push_back(static_cast<uint32_t>(count));
+      } else {
+        float value = 0.0f;
+        p = ParseFloat(p, end, value);
+        if (!p) {
+          out.ok = false;
+          return;
+        }
+        if (k == layout.x) v.x = value;
+        if (k == layout.y) v.y = value;
+        if (k == layout.z) v.z = value;
+      }
+    }
+    if (isVertex) out.positions.push_back(v);
+
+    p = SkipLine(p, end);
+  }
+}
+
+std::optional<ParseError> ParsePlyAscii(std::string_view text, const PlyHeader& header,
+                                        RawMesh& raw, Progress& progress) {
+  const std::string_view body = text.substr(header.bodyOffset);
+  const LineIndex lines(body);
+
+  std::size_t firstLine = 0;
+  for (const PlyElement& element : header.elements) {
+    const bool isVertex = element.name == "vertex";
+    const bool isFace = element.name == "face";
+
+    if (isVertex || isFace) {
+      const PlyVertexLayout layout = FindPositionProperties(element);
+      const int listIndex = FindFaceIndexProperty(element);
+      if (isVertex && !layout.Valid()) {
+        return ParseError{Status::ParseError, "PLY vertex lacks x/y/z"};
+      }
+      if (isFace && listIndex < 0) {
+        return ParseError{Status::ParseError, "PLY face lacks vertex_indices"};
+      }
+
+      const std::size_t begin = lines.LineStart(firstLine);
+      const std::size_t end = lines.LineStart(firstLine + element.count);
+      const auto chunks = SplitLines(body.substr(begin, end - begin));
+      std::vector<PlyAsciiChunk> parsed(chunks.size());
+
+      ForEachChunk(chunks.size(), progress, [&](std::size_t i) {
+        ParsePlyAsciiChunk(chunks[i], element, isVertex, layout, listIndex, parsed[i]);
+      });
+      if (progress.Cancelled()) return ParseError{Status::Cancelled, "Import cancelled"};
+
+      for (const PlyAsciiChunk& chunk : parsed) {
+        if (!chunk.ok) return ParseError{Status::ParseError, "Malformed PLY record"};
+        raw.positions.insert(raw.positions.end(), chunk.positions.begin(), chunk.positions.end());
+        AppendLoops(raw, chunk.loopSizes, chunk.loopVertices);
+      }
+    }
+
+    firstLine += element.count;
+  }
+
+  return std::nullopt;
+}
+
+std::optional<ParseError> ParsePly(std::string_view text, RawMesh& raw, Progress& progress) {
+  const auto header = ParsePlyHeader(text);
+  if (!header) return ParseError{Status::ParseError, "Invalid PLY header"};
+
+  auto error = header->encoding == PlyEncoding::Ascii
+                   ? ParsePlyAscii(text, *header, raw, progress)
+                   : ParsePlyBinary(text, *header, raw, progress);
+  if (error) return error;
+
+  for (uint32_t index : raw.loopVertices) {
+    if (index >= raw.positions.size()) {
+      return ParseError{Status::ParseError, "PLY face references a missing vertex"};
+    }
+  }
+  return std::nullopt;
+}
+
+// -------------------------------------------------
+// STL
+// -------------------------------------------------
+
+constexpr std::size_t kStlHeaderSize = 84;
+constexpr std::size_t kStlTriangleSize = 50;
+
+bool IsBinaryStl(std::string_view text) {
+  if (text.size() < kStlHeaderSize) return false;
+  const uint32_t count = LoadBytes<uint32_t>(text.data() + 80, false);
+  return text.size() == kStlHeaderSize + static_cast<std::size_t>(count) * kStlTriangleSize;
+}
+
+void AddTriangleLoops(RawMesh& raw) {
+  const std::size_t triangles = raw.positions.size() / 3;
+  raw.loopVertices.resize(triangles * 3);
+  raw.loopOffsets.resize(triangles + 1);
+  std::iota(raw.loopVertices.begin(), raw.loopVertices.end(), 0u);
+  for (std::size_t i = 0; i <= triangles; ++i) raw.loopOffsets[i] = static_cast<uint32_t>(i * 3);
+}
+
+std::optional<ParseError> ParseStlBinary(std::string_view text, RawMesh& raw, Progress& progress) {
+  const std::size_t triangles = (text.size() - kStlHeaderSize) / kStlTriangleSize;
+  const char* body = text.data() + kStlHeaderSize;
+
+  raw.positions.resize(triangles * 3);
+  std::atomic<std::size_t> completed{0};
+  Jobs::ParallelFor(triangles, 64 * 1024, [&](std::size_t begin, std::size_t end) {
+    if (progress.Cancelled()) return;
+    for (std::size_t t = begin; t < end; ++t) {
+      // Skip the 12 byte facet normal; it is recomputed from the winding
+      const char* record = body + t * kStlTriangleSize + 12;
+      for (int k = 0; k < 3; ++k) {
+        float xyz[3];
+        std::memcpy(xyz, record + k * 12, sizeof(xyz));
+        raw.positions[t * 3 + k] = Vec3(xyz[0], xyz[1], xyz[2]);
+      }
+    }
+    progress.Report(static_cast<float>(completed.fetch_add(end - begin) + (end - begin)) /
+                    triangles);
+  });
+  if (progress.Cancelled()) return ParseError{Status::Cancelled, "Import cancelled"};
+
+  AddTriangleLoops(raw);
+  return std::nullopt;
+}
+
+struct StlChunk {
+  std::vector<Vec3> positions;
+  bool ok = true;
+};
+
+void ParseStlAsciiChunk(std::string_view text, StlChunk& out) {
+  const char* p = text.data();
+  const char* end = p + text.size();
+
+  while (p < end) {
+    p = SkipBlanks(p, end);
+    if (StartsWithKeyword(p, end, "vertex")) {
+      Vec3 v;
+      p = ParseFloat(p + 6, end, v.x);
+      if (p) p = ParseFloat(p, end, v.y);
+      if (p) p = ParseFloat(p, end, v.z);
+      if (!p) {
+        out.ok = false;
+        return;
+      }
+      out.positions.push_back(v);
+    }
+    p = SkipLine(p, end);
+  }
+}
+
+std::optional<ParseError> ParseStlAscii(std::string_view text, RawMesh& raw, Progress& progress) {
+  const auto chunks = SplitLines(text);
+  std::vector<StlChunk> parsed(chunks.size());
+
+  ForEachChunk(chunks.size(), progress,
+               [&](std::size_t i) { ParseStlAsciiChunk(chunks[i], parsed[i]); });
+  if (progress.Cancelled()) return ParseError{Status::Cancelled, "Import cancelled"};
+
+  for (const StlChunk& chunk : parsed) {
+    if (!chunk.ok) return ParseError{Status::ParseError, "Malformed STL vertex"};
+    raw.positions.insert(raw.positions.end(), chunk.positions.begin(), chunk.positions.end());
+  }
+  if (raw.positions.size() % 3 != 0) {
+    return ParseError{Status::ParseError, "STL facet without three vertices"};
+  }
+
+  AddTriangleLoops(raw);
+  return std::nullopt;
+}
+
+// -------------------------------------------------
+// Welding
+// -------------------------------------------------
+
+struct WeldKey {
+  int64_t x, y, z;
+  bool operator==(const WeldKey&) const = default;
+};
+
+struct WeldKeyHash {
+  std::size_t operator()(const WeldKey& key) const {
+    uint64_t h = static_cast<uint64_t>(key.x) * 0x9E3779B97F4A7C15ull;
+    h ^= static_cast<uint64_t>(key.y) + 0x632BE59BD9B4E019ull + (h << 6) + (h >> 2);
+    h ^= static_cast<uint64_t>(key.z) + 0x85EBCA77C2B2AE63ull + (h << 6) + (h >> 2);
+    return static_cast<std::size_t>(h ^ (h >> 29));
+  }
+};
+
+WeldKey MakeWeldKey(const Vec3& p, float tolerance) {
+  // Bit identical positions; fold -0.0 onto 0.0
+  auto bits = [](float f) {
+    uint32_t b;
+    f = f == 0.0f ? 0.0f : f;
+    std::memcpy(&b, &f, sizeof(b));
+    return static_cast<int64_t>(b);
+  };
+
+  if (tolerance > 0.0f) {
+    // Past 2^62 cells, neighbouring floats are much further apart than the tolerance, so
+    // only identical values weld. Those coordinates key on their bits, offset past every
+    // cell index, instead of overflowing the conversion.
+    constexpr double kMaxCell = 0x1p62;
+    const double inv = 1.0 / tolerance;
+    auto cell = [&](float f) {
+      const double scaled = std::floor(f * inv + 0.5);
+      return std::abs(scaled) < kMaxCell ? static_cast<int64_t>(scaled)
+                                         : (int64_t{1} << 62) + bits(f);
+    };
+    return {cell(p.x), cell(p.y), cell(p.z)};
+  }
+  return {bits(p.x), bits(p.y), bits(p.z)};
+}
+
+// ParseFloat accepts nan and inf tokens and binary formats can hold any bit pattern
+bool AllFinite(const std::vector<Vec3>& positions) {
+  return std::all_of(positions.begin(), positions.end(), [](const Vec3& p) {
+    return std::isfinite(p.x) && std::isfinite(p.y) && std::isfinite(p.z);
+  });
+}
+
+void Weld(RawMesh& raw, float tolerance, Progress& progress) {
+  std::vector<WeldKey> keys(raw.positions.size());
+  std::vector<uint64_t> hashes(raw.positions.size());
+  Jobs::ParallelFor(keys.size(), 64 * 1024, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      keys[i] = MakeWeldKey(raw.positions[i], tolerance);
+      hashes[i] = WeldKeyHash{}(keys[i]);
+    }
+  });
+
+  // Open addressing table of first-occurrence indices, load factor <= 1/2
+  constexpr uint32_t kEmpty = UINT32_MAX;
+  std::size_t tableSize = 16;
+  while (tableSize / 2 < keys.size()) tableSize *= 2;
+  const std::size_t mask = tableSize - 1;
+  std::vector<uint32_t> table(tableSize, kEmpty);
+
+  std::vector<uint32_t> remap(raw.positions.size());
+  std::vector<Vec3> welded;
+  welded.reserve(raw.positions.size());
+  std::vector<uint32_t> firstOccurrence;
+  firstOccurrence.reserve(raw.positions.size());
+
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    std::size_t slot = hashes[i] & mask;
+    for (;; slot = (slot + 1) & mask) {
+      const uint32_t unique = table[slot];
+      if (unique == kEmpty) {
+        table[slot] = static_cast<uint32_t>(welded.size());
+        remap[i] = static_cast<uint32_t>(welded.size());
+        firstOccurrence.push_back(static_cast<uint32_t>(i));
+        welded.push_back(raw.positions[i]);
+        break;
+      }
+      if (keys[firstOccurrence[unique]] == keys[i]) {
+        remap[i] = unique;
+        break;
+      }
+    }
+
+    if ((i & 0x3FFFF) == 0) progress.Report(static_cast<float>(i) / keys.size());
+  }
+  raw.positions = std::move(welded);
+
+  Jobs::ParallelFor(raw.loopVertices.size(), 64 * 1024, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) raw.loopVertices[i] = remap[raw.loopVertices[i]];
+  });
+
+  // Welding can collapse loop corners anywhere in a loop, not just next to each other;
+  // keep the first occurrence of each vertex and drop loops left with fewer than three
+  constexpr uint32_t kUnseen = UINT32_MAX;
+  std::vector<uint32_t> seenInLoop(raw.positions.size(), kUnseen);
+  std::size_t write = 0;
+  std::vector<uint32_t> offsets{0};
+  offsets.reserve(raw.loopOffsets.size());
+  for (std::size_t loop = 0; loop < raw.LoopCount(); ++loop) {
+    const uint32_t begin = raw.loopOffsets[loop];
+    const uint32_t end = raw.loopOffsets[loop + 1];
+    const std::size_t loopStart = write;
+
+    for (uint32_t i = begin; i < end; ++i) {
+      const uint32_t v = raw.loopVertices[i];
+      if (seenInLoop[v] == loop) continue;
+      seenInLoop[v] = static_cast<uint32_t>(loop);
+      raw.loopVertices[write++] = v;
+    }
+
+    if (write - loopStart < 3) {
+      write = loopStart;
+      continue;
+    }
+    offsets.push_back(static_cast<uint32_t>(write));
+  }
+  raw.loopVertices.resize(write);
+  raw.loopOffsets = std::move(offsets);
+}
+
+// -------------------------------------------------
+// Topology
+// -------------------------------------------------
+
+void BuildEdgesAndFaces(const RawMesh& raw, MeshData& mesh, Progress& progress) {
+  mesh.positions = raw.positions;
+
+  Topology::EdgeTable table(mesh.edges);
+  // Closed meshes have about half as many edges as loop corners
+  table.Reserve(raw.loopVertices.size() / 2 + raw.loopVertices.size() / 8);
+
+  mesh.faceEdges.reserve(raw.loopVertices.size());
+  mesh.faceOffsets.reserve(raw.loopOffsets.size());
+
+  const std::size_t loops = raw.LoopCount();
+  for (std::size_t loop = 0; loop < loops; ++loop) {
+    const uint32_t begin = raw.loopOffsets[loop];
+    const uint32_t end = raw.loopOffsets[loop + 1];
+    Topology::AddFaceLoop(
+        mesh, table, std::span<const uint32_t>(raw.loopVertices).subspan(begin, end - begin));
+
+    if ((loop & 0x3FFFF) == 0) progress.Report(static_cast<float>(loop) / loops);
+  }
+}
+
+uint32_t FindRoot(std::vector<uint32_t>& parent, uint32_t i) {
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+// Group faces into edge-connected components and wrap each closed one in a volume
+void BuildVolumes(MeshData& mesh) {
+  const std::size_t faceCount = mesh.FaceCount();
+
+  std::vector<uint32_t> parent(faceCount);
+  std::iota(parent.begin(), parent.end(), 0u);
+
+  constexpr uint32_t kNone = UINT32_MAX;
+  std::vector<uint32_t> edgeUse(mesh.edges.size(), 0);
+  std::vector<uint32_t> edgeFace(mesh.edges.size(), kNone);
+
+  for (uint32_t face = 0; face < faceCount; ++face) {
+    for (uint32_t edge : mesh.FaceEdges(face)) {
+      ++edgeUse[edge];
+      if (edgeFace[edge] == kNone) {
+        edgeFace[edge] = face;
+      } else {
+        const uint32_t a = FindRoot(parent, edgeFace[edge]);
+        const uint32_t b = FindRoot(parent, face);
+        if (a != b) parent[b] = a;
+      }
+    }
+  }
+
+  std::vector<uint8_t> closed(faceCount, 1);
+  std::vector<uint32_t> root(faceCount);
+  for (uint32_t face = 0; face < faceCount; ++face) {
+    root[face] = FindRoot(parent, face);
+    for (uint32_t edge : mesh.FaceEdges(face)) {
+      if (edgeUse[edge] != 2) closed[root[face]] = 0;
+    }
+  }
+
+  std::unordered_map<uint32_t, std::vector<uint32_t>> components;
+  for (uint32_t face = 0; face < faceCount; ++face) {
+    if (closed[root[face]]) components[root[face]].push_back(face);
+  }
+
+  // Emit in order of each component's first face so results are deterministic
+  std::vector<uint32_t> order;
+  order.reserve(components.size());
+  for (const auto& [componentRoot, faces] : components) order.push_back(componentRoot);
+  std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return components[a].front() < components[b].front();
+  });
+
+  for (uint32_t componentRoot : order) {
+    const auto& faces = components[componentRoot];
+    if (faces.size() >= 4) mesh.AddVolume(faces);
+  }
+}
+
+// -------------------------------------------------
+// Driver
+// -------------------------------------------------
+
+Format DetectFormat(std::string_view text) {
+  const char* p = SkipSpaces(text.data(), text.data() + text.size());
+  const std::string_view start(p, text.data() + text.size() - p);
+
+  if (start.starts_with("ply")) return Format::Ply;
+  if (IsBinaryStl(text)) return Format::Stl;
+  if (start.starts_with("solid")) return Format::Stl;
+  return Format::Obj;
+}
+
+Format FormatFromExtension(const std::string& path) {
+  const std::size_t dot = path.find_last_of('.');
+  if (dot == std::string::npos) return Format::Auto;
+
+  std::string extension = path.substr(dot + 1);
+  std::transform(extension.begin(), extension.end(), extension.begin(), ToLower);
+
+  if (extension == "obj") return Format::Obj;
+  if (extension == "ply") return Format::Ply;
+  if (extension == "stl") return Format::Stl;
+  return Format::Auto;
+}
+
+Result Fail(Status status, std::string message) {
+  Result result;
+  result.status = status;
+  result.message = std::move(message);
+  return result;
+}
+
+Result ImportData(std::string_view text, Format format, const Options& options) {
+  Progress progress(options);
+  if (format == Format::Auto) format = DetectFormat(text);
+
+  RawMesh raw;
+  std::optional<ParseError> error;
+
+  progress.BeginStage(0.0f, 0.6f);
+  switch (format) {
+    case Format::Obj:
+      error = ParseObj(text, raw, progress);
+      break;
+    case Format::Ply:
+      error = ParsePly(text, raw, progress);
+      break;
+    case Format::Stl:
+      error = IsBinaryStl(text) ? ParseStlBinary(text, raw, progress)
+                                : ParseStlAscii(text, raw, progress);
+      break;
+    default:
+      return Fail(Status::UnsupportedFormat, "Unsupported mesh format");
+  }
+  if (error) return Fail(error->status, std::move(error->message));
+  if (!AllFinite(raw.positions)) {
+    return Fail(Status::ParseError, "Mesh has a NaN or infinite vertex coordinate");
+  }
+
+  if (progress.Cancelled()) return Fail(Status::Cancelled, "Import cancelled");
+  progress.BeginStage(0.6f, 0.75f);
+  Weld(raw, options.weldTolerance, progress);
+
+  if (progress.Cancelled()) return Fail(Status::Cancelled, "Import cancelled");
+  progress.BeginStage(0.75f, 0.9f);
+  Result result;
+  BuildEdgesAndFaces(raw, result.mesh, progress);
+
+  if (progress.Cancelled()) return Fail(Status::Cancelled, "Import cancelled");
+  progress.BeginStage(0.9f, 1.0f);
+  if (options.buildVolumes) BuildVolumes(result.mesh);
+
+  progress.Report(1.0f);
+  return result;
+}
+
+}  // namespace
+
+Result ImportFile(const std::string& path, const Options& options) {
+  const MappedFile file(path);
+  if (!file.IsOpen()) return Fail(Status::FileError, "Failed to open mesh file: " + path);
+
+  const Format format = options.format != Format::Auto ? options.format : FormatFromExtension(path);
+  return ImportData(file.View(), format, options);
+}
+
+Result ImportBuffer(std::string_view data, const Options& options) {
+  return ImportData(data, options.format, options);
+}
+
+}  // namespace Import
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "Core/MeshData.h"
+
+// Streaming importers for triangle/polygon mesh formats. Input is memory mapped and
+// parsed in parallel, line aligned chunks; the result is a MeshData ready for
+// Model::AppendMesh (or AppendMeshCommand when it should be undoable).
+namespace Import {
+
+enum class Format { Auto, Obj, Ply, Stl };
+
+enum class Status { Ok, Cancelled, FileError, ParseError, UnsupportedFormat };
+
+struct Options {
+  Format format = Format::Auto;
+
+  // Vertices closer than this are merged; 0 merges only bit-identical positions
+  float weldTolerance = 0.0f;
+
+  // Wrap every closed, edge-manifold connected component in a Volume
+  bool buildVolumes = true;
+
+  // Monotonic progress in [0, 1]. May be invoked from worker threads, but never
+  // concurrently.
+  std::function<void(float)> progress;
+
+  // Polled between and inside the import stages; set to abort early
+  const std::atomic<bool>* cancel = nullptr;
+};
+
+struct Result {
+  Status status = Status::Ok;
+  std::string message;
+  MeshData mesh;
+
+  bool Ok() const { return status == Status::Ok; }
+};
+
+// Import a file from disk; Format::Auto picks the parser from the extension or contents
+Result ImportFile(const std::string& path, const Options& options = {});
+
+// Import from an in-memory buffer (Format::Auto sniffs the contents)
+Result ImportBuffer(std::string_view data, const Options& options = {});
+
+}  // namespace Import
@@ -1,14 +1,18 @@
 #include "Model.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <ranges>
 #include <set>
+#include <utility>
 
 #include "Core/Primitives.h"
 #include "Geometry/Geometry.h"
 #include "Topology/Tools.h"
 #include "Topology/Validation.h"
-#include "Utilities/Mapped.h"
+#include "Utilities/BinaryStream.h"
+#include "Utilities/JobSystem.h"
 
 Model::Model()
     : vertices_(verticesDirty_), edges_(edgesDirty_), faces_(facesDirty_), volumes_(volumesDirty_) {
@@ -18,11 +22,33 @@ Model::Model()
   volumesDirty_ = true;
 }
 
+Model::Model(const Model& other)
+    : verticesDirty_(other.verticesDirty_),
+      edgesDirty_(other.edgesDirty_),
+      facesDirty_(other.facesDirty_),
+      volumesDirty_(other.volumesDirty_),
+      untrackedMoves_(other.untrackedMoves_),
+      movedVertices_(other.movedVertices_),
+      reshapedFaces_(other.reshapedFaces_),
+      vertices_(verticesDirty_, other.vertices_),
+      edges_(edgesDirty_, other.edges_),
+      faces_(facesDirty_, other.faces_),
+      volumes_(volumesDirty_, other.volumes_),
+      faceCache_(other.faceCache_),
+      vertexFaces_(other.vertexFaces_),
+      brokenFaces_(other.brokenFaces_) {}
+
+std::shared_ptr<const Model> Model::Snapshot() const {
+  return std::make_shared<const Model>(*this);
+}
+
 VertexId Model::CreateVertex(const Vec3& position) {
   Vertex v{};
   v.position = position;
 
-  return vertices_.Insert(v);
+  const VertexId id = vertices_.Insert(v);
+  ReattachBrokenFaces();
+  return id;
 }
 
 bool Model::RemoveVertex(VertexId id) {
@@ -30,6 +56,12 @@ bool Model::RemoveVertex(VertexId id) {
 
   // TODO: remove dependent edges
 
+  // Faces through the vertex lose a corner
+  if (id < vertexFaces_.size()) {
+    const std::vector<FaceId> faces = std::as_const(vertexFaces_)[id];
+    for (FaceId fid : faces) BreakFace(fid);
+  }
+
   vertices_.Remove(id);
 
   return true;
@@ -44,7 +76,18 @@ void Model::SetVertexPosition(VertexId id, const Vec3& position) {
   assert(vertices_.Contains(id));
   Vertex& vertex = vertices_.Get(id);
   vertex.position = position;
-  verticesDirty_ = true;
+
+  RecordMoves(std::span<const VertexId>(&id, 1));
+}
+
+void Model::SetVertexPositions(std::span<const VertexId> ids, std::span<const Vec3> positions) {
+  assert(ids.size() == positions.size());
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    assert(vertices_.Contains(ids[i]));
+    vertices_.Get(ids[i]).position = positions[i];
+  }
+
+  RecordMoves(ids);
 }
 
 std::optional<EdgeId> Model::CreateEdge(VertexId a, VertexId b) {
@@ -54,12 +97,24 @@ std::optional<EdgeId> Model::CreateEdge(VertexId a, VertexId b) {
   e.a = a;
   e.b = b;
 
-  return edges_.Insert(e);
+  const EdgeId id = edges_.Insert(e);
+  ReattachBrokenFaces();
+  return id;
 }
 
 bool Model::RemoveEdge(EdgeId id) {
   if (!edges_.Contains(id)) return false;
 
+  // Faces built on this edge no longer form a loop
+  const Edge edge = std::as_const(edges_).Get(id);
+  if (edge.a < vertexFaces_.size()) {
+    const std::vector<FaceId> candidates = std::as_const(vertexFaces_)[edge.a];
+    for (FaceId fid : candidates) {
+      const auto& faceEdges = std::as_const(faces_).Get(fid).edges;
+      if (std::find(faceEdges.begin(), faceEdges.end(), id) != faceEdges.end()) BreakFace(fid);
+    }
+  }
+
   edges_.Remove(id);
 
   return true;
@@ -71,19 +126,26 @@ const Edge& Model::GetEdge(EdgeId id) const {
 }
 
 std::optional<FaceId> Model::CreateFace(std::span<const EdgeId> edges) {
-  if (!CanCreateFace(edges)) return std::nullopt;
+  auto loop = ValidateFaceLoop(edges);
+  if (!loop) return std::nullopt;
 
   Face f{};
   f.edges.assign(edges.begin(), edges.end());
 
   const auto id = faces_.Insert(f);
   faces_.Get(id).colorIndex = id;
+
+  FaceCacheEntry entry;
+  entry.loop = std::move(*loop);
+  ComputeFaceGeometry(entry);
+  AttachFaceCache(id, std::move(entry));
   return id;
 }
 
 bool Model::RemoveFace(FaceId id) {
   if (!faces_.Contains(id)) return false;
 
+  DetachFaceCache(id);
   faces_.Remove(id);
 
   return true;
@@ -96,25 +158,21 @@ const Face& Model::GetFace(FaceId id) const {
 
 void Model::ExtrudeFace(FaceId id, float delta) {
   assert(faces_.Contains(id));
-  const Face& face = faces_.Get(id);
-
-  const auto faceVertexIds = Topology::ExtractVertices(face, edges_);
 
-  const Vertex& vertexA = vertices_.Get(faceVertexIds[0]);
-  const Vertex& vertexB = vertices_.Get(faceVertexIds[1]);
-  const Vertex& vertexC = vertices_.Get(faceVertexIds[2]);
-  Vec3 vecAB = vertexB.position - vertexA.position;
-  Vec3 vecBC = vertexC.position - vertexB.position;
-  const Vec3 normal = vecAB.Cross(vecBC).Normalize();
+  const auto loop = FaceLoop(id);
+  const Vec3 offset = FaceNormal(id) * delta;
 
   // move all vertices along normal
-  for (VertexId id : faceVertexIds) {
-    Vertex& vertex = vertices_.Get(id);
-    vertex.position += normal * delta;
+  for (VertexId vid : loop) {
+    Vertex& vertex = vertices_.Get(vid);
+    vertex.position += offset;
   }
 
   verticesDirty_ = true;
   facesDirty_ = true;
+  untrackedMoves_ = true;
+
+  RefreshFacesAround(loop);
 }
 
 std::optional<VolumeId> Model::CreateVolume(std::span<const FaceId> faces) {
@@ -139,23 +197,728 @@ const Volume& Model::GetVolume(VolumeId id) const {
   return volumes_.Get(id);
 }
 
+MeshIds Model::AppendMesh(const MeshData& mesh) {
+  MeshIds ids;
+  ids.vertices.reserve(mesh.positions.size());
+  ids.edges.reserve(mesh.edges.size());
+  ids.faces.reserve(mesh.FaceCount());
+  ids.volumes.reserve(mesh.VolumeCount());
+
+  vertices_.Reserve(vertices_.DenseCount() + mesh.positions.size());
+  edges_.Reserve(edges_.DenseCount() + mesh.edges.size());
+  faces_.Reserve(faces_.DenseCount() + mesh.FaceCount());
+  volumes_.Reserve(volumes_.DenseCount() + mesh.VolumeCount());
+
+  for (const Vec3& position : mesh.positions) {
+    ids.vertices.push_back(vertices_.Emplace(Vertex{position}));
+  }
+
+  for (const Edge& e : mesh.edges) {
+    assert(e.a < ids.vertices.size() && e.b < ids.vertices.size() && e.a != e.b);
+    ids.edges.push_back(edges_.Emplace(Edge{ids.vertices[e.a], ids.vertices[e.b]}));
+  }
+
+  for (std::size_t i = 0; i < mesh.FaceCount(); ++i) {
+    Face f{};
+    const auto faceEdges = mesh.FaceEdges(i);
+    f.edges.reserve(faceEdges.size());
+    for (uint32_t edgeIndex : faceEdges) f.edges.push_back(ids.edges[edgeIndex]);
+
+    const FaceId id = faces_.Emplace(std::move(f));
+    faces_.Get(id).colorIndex = id;
+    ids.faces.push_back(id);
+  }
+
+  for (std::size_t i = 0; i < mesh.VolumeCount(); ++i) {
+    Volume v{};
+    const auto volumeFaces = mesh.VolumeFaces(i);
+    v.faces.reserve(volumeFaces.size());
+    for (uint32_t faceIndex : volumeFaces) v.faces.push_back(ids.faces[faceIndex]);
+
+    ids.volumes.push_back(volumes_.Emplace(std::move(v)));
+  }
+
+  BuildFaceCaches(ids.faces);
+
+  return ids;
+}
+
+ExtrudeRecord Model::ExtrudeFaces(std::span<const FaceId> faces, float delta) {
+  ExtrudeRecord record;
+
+  auto& region = record.faces;
+  for (FaceId fid : faces) {
+    if (faces_.Contains(fid) && FaceLoop(fid).size() >= 3) region.push_back(fid);
+  }
+  std::sort(region.begin(), region.end());
+  region.erase(std::unique(region.begin(), region.end()), region.end());
+  if (region.empty()) return record;
+
+  // Membership by FaceId, so adjacency checks are a single load
+  std::vector<uint8_t> inRegion(faces_.IdCapacity(), 0);
+  for (FaceId fid : region) inRegion[fid] = 1;
+
+  // One corner per region face vertex, paired with the edge leaving it
+  struct Corner {
+    VertexId vertex;
+    EdgeId edge;
+    uint32_t face;    // index into region
+    uint32_t slot;    // position of edge in the face
+    uint32_t next;    // following corner of the same face
+    uint32_t unique;  // index into vertices
+  };
+  struct RegionVertex {
+    VertexId id;
+    Vec3 normal;
+    VertexId target = 0;                       // extruded copy, or id itself when moved
+    EdgeId pillar = SparseSet<Edge>::kInvalid;  // side edge from id to target
+    bool duplicate = false;
+  };
+  std::vector<Corner> corners;
+  std::vector<RegionVertex> vertices;
+
+  for (uint32_t f = 0; f < region.size(); ++f) {
+    const auto loop = FaceLoop(region[f]);
+    const auto& faceEdges = std::as_const(faces_).Get(region[f]).edges;
+    const auto first = static_cast<uint32_t>(corners.size());
+    const auto n = static_cast<uint32_t>(loop.size());
+    for (uint32_t i = 0; i < n; ++i) {
+      corners.push_back({loop[i], faceEdges[i], f, i, first + (i + 1) % n, 0});
+    }
+  }
+
+  // Group corners by vertex and by edge with plain integer sorts of (id << 32 | corner)
+  std::vector<uint64_t> keys(corners.size());
+  for (uint32_t c = 0; c < corners.size(); ++c) {
+    keys[c] = (static_cast<uint64_t>(corners[c].vertex) << 32) | c;
+  }
+  std::sort(keys.begin(), keys.end());
+
+  for (uint64_t key : keys) {
+    const auto c = static_cast<uint32_t>(key);
+    if (vertices.empty() || vertices.back().id != corners[c].vertex) {
+      vertices.push_back({corners[c].vertex, Vec3{}});
+    }
+    vertices.back().normal += FaceNormal(region[corners[c].face]);
+    corners[c].unique = static_cast<uint32_t>(vertices.size() - 1);
+  }
+
+  for (uint32_t c = 0; c < corners.size(); ++c) {
+    keys[c] = (static_cast<uint64_t>(corners[c].edge) << 32) | c;
+  }
+  std::sort(keys.begin(), keys.end());
+
+  // Edges used by a single region face are its boundary. Their endpoints, and any
+  // vertex shared with a face outside the region, get a copy so the faces around the
+  // region keep their geometry.
+  std::vector<uint32_t> boundary;  // corners whose edge is on the boundary
+  std::vector<uint32_t> interior;  // one corner per shared edge
+  for (std::size_t i = 0; i < keys.size();) {
+    std::size_t end = i + 1;
+    while (end < keys.size() && (keys[end] >> 32) == (keys[i] >> 32)) ++end;
+
+    const auto c = static_cast<uint32_t>(keys[i]);
+    if (end - i == 1) {
+      boundary.push_back(c);
+      vertices[corners[c].unique].duplicate = true;
+      vertices[corners[corners[c].next].unique].duplicate = true;
+    } else {
+      interior.push_back(c);
+    }
+    i = end;
+  }
+  for (RegionVertex& v : vertices) {
+    for (FaceId fid : VertexFaces(v.id)) {
+      if (!inRegion[fid]) v.duplicate = true;
+    }
+  }
+
+  // Region faces get new loops; drop their cache entries while the old ones are known
+  for (FaceId fid : region) DetachFaceCache(fid);
+
+  vertices_.Reserve(vertices_.DenseCount() + vertices.size());
+  for (RegionVertex& v : vertices) {
+    const float length = v.normal.Length();
+    const Vec3 offset = length > 0.0f ? v.normal * (delta / length) : Vec3{};
+    const Vec3 position = std::as_const(vertices_).Get(v.id).position;
+
+    if (v.duplicate) {
+      v.target = vertices_.Emplace(Vertex{position + offset});
+      record.createdVertices.push_back(v.target);
+    } else {
+      v.target = v.id;
+      record.movedVertices.push_back(v.id);
+      record.originalPositions.push_back(position);
+      vertices_.Get(v.id).position = position + offset;
+    }
+  }
+  verticesDirty_ = true;
+  if (!record.movedVertices.empty()) untrackedMoves_ = true;
+
+  // Interior edges follow their endpoints onto the copies
+  for (uint32_t c : interior) {
+    const RegionVertex& from = vertices[corners[c].unique];
+    const RegionVertex& to = vertices[corners[corners[c].next].unique];
+    if (from.target == from.id && to.target == to.id) continue;
+
+    const Edge original = std::as_const(edges_).Get(corners[c].edge);
+    record.rewiredEdges.emplace_back(corners[c].edge, original);
+    edges_.Get(corners[c].edge) =
+        original.a == from.id ? Edge{from.target, to.target} : Edge{to.target, from.target};
+  }
+
+  // Stitch a wall along each boundary edge: the region face takes a copy of the edge
+  // and the wall runs from -> to -> to' -> from', facing away from the region
+  edges_.Reserve(edges_.DenseCount() + boundary.size() * 2);
+  faces_.Reserve(faces_.DenseCount() + boundary.size());
+  const auto pillar = [&](RegionVertex& v) {
+    if (v.pillar == SparseSet<Edge>::kInvalid) {
+      v.pillar = edges_.Emplace(Edge{v.id, v.target});
+      record.createdEdges.push_back(v.pillar);
+    }
+    return v.pillar;
+  };
+
+  std::vector<std::pair<FaceId, FaceId>> wallsByOwner;  // (region face, wall)
+  for (uint32_t c : boundary) {
+    const Corner& corner = corners[c];
+    const FaceId owner = region[corner.face];
+    RegionVertex& from = vertices[corner.unique];
+    RegionVertex& to = vertices[corners[corner.next].unique];
+
+    const EdgeId top = edges_.Emplace(Edge{from.target, to.target});
+    record.createdEdges.push_back(top);
+    faces_.Get(owner).edges[corner.slot] = top;
+    record.swappedEdges.push_back({owner, corner.slot, corner.edge});
+
+    Face wall{};
+    wall.edges = {corner.edge, pillar(to), top, pillar(from)};
+    const FaceId wallId = faces_.Emplace(std::move(wall));
+    faces_.Get(wallId).colorIndex = wallId;
+    record.createdFaces.push_back(wallId);
+    wallsByOwner.emplace_back(owner, wallId);
+  }
+  std::sort(wallsByOwner.begin(), wallsByOwner.end());
+  edgesDirty_ = true;
+  facesDirty_ = true;
+
+  // Closed volumes stay closed: walls join every volume that holds their region face
+  for (uint32_t i = 0; i < volumes_.DenseCount(); ++i) {
+    const VolumeId vid = volumes_.IdAt(i);
+    const auto& members = std::as_const(volumes_).Get(vid).faces;
+    if (std::none_of(members.begin(), members.end(), [&](FaceId f) { return inRegion[f]; })) {
+      continue;
+    }
+
+    std::vector<FaceId> walls;
+    for (FaceId fid : members) {
+      if (!inRegion[fid]) continue;
+      auto it = std::lower_bound(wallsByOwner.begin(), wallsByOwner.end(),
+                                 std::pair<FaceId, FaceId>{fid, 0});
+      for (; it != wallsByOwner.end() && it->first == fid; ++it) walls.push_back(it->second);
+    }
+    if (walls.empty()) continue;
+
+    record.grownVolumes.emplace_back(vid, static_cast<uint32_t>(members.size()));
+    auto& grown = volumes_.Get(vid).faces;
+    grown.insert(grown.end(), walls.begin(), walls.end());
+  }
+
+  std::vector<FaceId> refreshed(region.begin(), region.end());
+  refreshed.insert(refreshed.end(), record.createdFaces.begin(), record.createdFaces.end());
+  BuildFaceCaches(refreshed);
+
+  return record;
+}
+
+void Model::RevertExtrude(const ExtrudeRecord& record) {
+  // Undo in reverse dependency order: volumes, walls, region loops, edges, vertices
+  for (const auto& [vid, count] : record.grownVolumes) {
+    if (volumes_.Contains(vid)) volumes_.Get(vid).faces.resize(count);
+  }
+
+  for (FaceId fid : std::views::reverse(record.createdFaces)) RemoveFace(fid);
+
+  for (FaceId fid : record.faces) DetachFaceCache(fid);
+  for (const auto& swap : record.swappedEdges) {
+    faces_.Get(swap.face).edges[swap.slot] = swap.original;
+  }
+  for (const auto& [eid, original] : record.rewiredEdges) edges_.Get(eid) = original;
+
+  // Nothing references the created elements any more; newest first so a redo reuses the ids
+  for (EdgeId eid : std::views::reverse(record.createdEdges)) edges_.Remove(eid);
+  for (VertexId vid : std::views::reverse(record.createdVertices)) RemoveVertex(vid);
+
+  for (std::size_t i = 0; i < record.movedVertices.size(); ++i) {
+    vertices_.Get(record.movedVertices[i]).position = record.originalPositions[i];
+  }
+
+  verticesDirty_ = true;
+  if (!record.movedVertices.empty()) untrackedMoves_ = true;
+  edgesDirty_ = true;
+  facesDirty_ = true;
+
+  BuildFaceCaches(record.faces);
+}
+
+RemovalRecord Model::RemoveVolumes(std::span<const VolumeId> volumes) {
+  RemovalRecord record;
+  for (VolumeId vid : volumes) {
+    if (!volumes_.Contains(vid)) continue;
+    record.volumeIds.push_back(vid);
+    record.volumes.push_back(std::as_const(volumes_).Get(vid));
+    volumes_.Remove(vid);
+  }
+  if (record.volumeIds.empty()) return record;
+
+  // Each level keeps what the surviving level above still references
+  std::vector<uint8_t> used(faces_.IdCapacity(), 0);
+  for (const Volume& v : volumes_.Dense()) {
+    for (FaceId fid : v.faces) used[fid] = 1;
+  }
+  for (const Volume& v : record.volumes) {
+    for (FaceId fid : v.faces) {
+      if (used[fid] || !faces_.Contains(fid)) continue;
+      used[fid] = 1;
+      record.faceIds.push_back(fid);
+      record.faces.push_back(std::as_const(faces_).Get(fid));
+    }
+  }
+  for (FaceId fid : record.faceIds) RemoveFace(fid);
+
+  used.assign(edges_.IdCapacity(), 0);
+  for (const Face& f : faces_.Dense()) {
+    for (EdgeId eid : f.edges) used[eid] = 1;
+  }
+  for (const Face& f : record.faces) {
+    for (EdgeId eid : f.edges) {
+      if (used[eid] || !edges_.Contains(eid)) continue;
+      used[eid] = 1;
+      record.edgeIds.push_back(eid);
+      record.edges.push_back(std::as_const(edges_).Get(eid));
+    }
+  }
+  for (EdgeId eid : record.edgeIds) edges_.Remove(eid);
+
+  used.assign(vertices_.IdCapacity(), 0);
+  for (const Edge& e : edges_.Dense()) {
+    used[e.a] = 1;
+    used[e.b] = 1;
+  }
+  for (const Edge& e : record.edges) {
+    for (VertexId vid : {e.a, e.b}) {
+      if (used[vid] || !vertices_.Contains(vid)) continue;
+      used[vid] = 1;
+      record.vertexIds.push_back(vid);
+      record.vertices.push_back(std::as_const(vertices_).Get(vid));
+    }
+  }
+  for (VertexId vid : record.vertexIds) RemoveVertex(vid);
+
+  return record;
+}
+
+void Model::RestoreRemoved(const RemovalRecord& record) {
+  // Referenced elements before the ones referencing them
+  vertices_.Reinsert(record.vertexIds, record.vertices);
+  edges_.Reinsert(record.edgeIds, record.edges);
+  faces_.Reinsert(record.faceIds, record.faces);
+  volumes_.Reinsert(record.volumeIds, record.volumes);
+
+  BuildFaceCaches(record.faceIds);
+}
+
+// -------------------------------------------------
+// Persistence
+// -------------------------------------------------
+
+namespace {
+
+template <typename T>
+struct SetState {
+  std::vector<T> dense;
+  std::vector<Id> denseIds;
+  uint64_t idCapacity = 0;
+  std::vector<Id> freeIds;
+
+  bool IsValid() const {
+    return SparseSet<T>::IsValidState(dense.size(), denseIds, idCapacity, freeIds);
+  }
+};
+
+// Same layout as BinaryWriter::WriteArray, written chunk by chunk
+template <typename T>
+void WriteChunked(BinaryWriter& out, const CowVector<T>& values) {
+  out.Write(static_cast<uint64_t>(values.size()));
+  for (std::size_t c = 0; c < values.ChunkCount(); ++c) out.WriteRaw(values.ChunkSpan(c));
+}
+
+void WriteElements(BinaryWriter& out, const CowVector<Vertex>& vertices) {
+  WriteChunked(out, vertices);
+}
+
+void WriteElements(BinaryWriter& out, const CowVector<Edge>& edges) { WriteChunked(out, edges); }
+
+void WriteElements(BinaryWriter& out, const CowVector<Face>& faces) {
+  out.Write(static_cast<uint64_t>(faces.size()));
+  for (const Face& f : faces) {
+    out.WriteArray(f.edges);
+    out.Write(f.colorIndex);
+    out.Write(f.roughness);
+    out.Write(f.metallicity);
+  }
+}
+
+void WriteElements(BinaryWriter& out, const CowVector<Volume>& volumes) {
+  out.Write(static_cast<uint64_t>(volumes.size()));
+  for (const Volume& v : volumes) out.WriteArray(v.faces);
+}
+
+bool ReadElements(BinaryReader& in, std::vector<Vertex>& vertices) {
+  return in.ReadArray(vertices);
+}
+
+bool ReadElements(BinaryReader& in, std::vector<Edge>& edges) { return in.ReadArray(edges); }
+
+bool ReadElements(BinaryReader& in, std::vector<Face>& faces) {
+  uint64_t count = 0;
+  if (!in.Read(count) || count > in.Remaining()) return false;
+
+  faces.resize(static_cast<std::size_t>(count));
+  for (Face& f : faces) {
+    if (!in.ReadArray(f.edges) || !in.Read(f.colorIndex) || !in.Read(f.roughness) ||
+        !in.Read(f.metallicity)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ReadElements(BinaryReader& in, std::vector<Volume>& volumes) {
+  uint64_t count = 0;
+  if (!in.Read(count) || count > in.Remaining()) return false;
+
+  volumes.resize(static_cast<std::size_t>(count));
+  for (Volume& v : volumes) {
+    if (!in.ReadArray(v.faces)) return false;
+  }
+  return true;
+}
+
+template <typename T>
+void WriteSet(BinaryWriter& out, const DirtySparseSet<T>& set) {
+  WriteElements(out, set.Dense());
+  WriteChunked(out, set.DenseIds());
+  out.Write(static_cast<uint64_t>(set.IdCapacity()));
+  WriteChunked(out, set.FreeIds());
+}
+
+template <typename T>
+bool ReadSet(BinaryReader& in, SetState<T>& state) {
+  return ReadElements(in, state.dense) && in.ReadArray(state.denseIds) &&
+         in.Read(state.idCapacity) && in.ReadArray(state.freeIds) && state.IsValid();
+}
+
+// Every id an element refers to lies inside the id range of the set it names. Ids in
+// range but removed are fine: faces on them stay broken until the ids are reused.
+bool ReferencesInRange(const SetState<Edge>& edges, uint64_t vertexCapacity) {
+  return std::all_of(edges.dense.begin(), edges.dense.end(), [&](const Edge& e) {
+    return e.a < vertexCapacity && e.b < vertexCapacity;
+  });
+}
+
+bool ReferencesInRange(const SetState<Face>& faces, uint64_t edgeCapacity) {
+  return std::all_of(faces.dense.begin(), faces.dense.end(), [&](const Face& f) {
+    return std::all_of(f.edges.begin(), f.edges.end(),
+                       [&](EdgeId eid) { return eid < edgeCapacity; });
+  });
+}
+
+bool ReferencesInRange(const SetState<Volume>& volumes, uint64_t faceCapacity) {
+  return std::all_of(volumes.dense.begin(), volumes.dense.end(), [&](const Volume& v) {
+    return std::all_of(v.faces.begin(), v.faces.end(),
+                       [&](FaceId fid) { return fid < faceCapacity; });
+  });
+}
+
+template <typename T>
+void RestoreSet(DirtySparseSet<T>& set, SetState<T>& state) {
+  const bool restored = set.Restore(std::move(state.dense), std::move(state.denseIds),
+                                    static_cast<std::size_t>(state.idCapacity),
+                                    std::move(state.freeIds));
+  assert(restored);
+  (void)restored;
+}
+
+}  // namespace
+
+void Model::Serialize(BinaryWriter& out) const {
+  WriteSet(out, vertices_);
+  WriteSet(out, edges_);
+  WriteSet(out, faces_);
+  WriteSet(out, volumes_);
+}
+
+bool Model::Deserialize(BinaryReader& in) {
+  SetState<Vertex> vertices;
+  SetState<Edge> edges;
+  SetState<Face> faces;
+  SetState<Volume> volumes;
+
+  if (!ReadSet(in, vertices) || !ReadSet(in, edges) || !ReadSet(in, faces) ||
+      !ReadSet(in, volumes)) {
+    return false;
+  }
+  if (!ReferencesInRange(edges, vertices.idCapacity) ||
+      !ReferencesInRange(faces, edges.idCapacity) ||
+      !ReferencesInRange(volumes, faces.idCapacity)) {
+    return false;
+  }
+
+  RestoreSet(vertices_, vertices);
+  RestoreSet(edges_, edges);
+  RestoreSet(faces_, faces);
+  RestoreSet(volumes_, volumes);
+  untrackedMoves_ = true;
+
+  RebuildFaceCache();
+  return true;
+}
+
+// -------------------------------------------------
+// Face cache
+// -------------------------------------------------
+
+std::span<const VertexId> Model::FaceLoop(FaceId id) const {
+  if (id >= faceCache_.size()) return {};
+  return faceCache_[id].loop;
+}
+
+const Vec3& Model::FaceNormal(FaceId id) const {
+  assert(id < faceCache_.size());
+  return faceCache_[id].normal;
+}
+
+float Model::FacePlaneOffset(FaceId id) const {
+  assert(id < faceCache_.size());
+  return faceCache_[id].planeOffset;
+}
+
+const Geometry::Aabb& Model::FaceBounds(FaceId id) const {
+  assert(id < faceCache_.size());
+  return faceCache_[id].bounds;
+}
+
+std::span<const FaceId> Model::VertexFaces(VertexId id) const {
+  if (id >= vertexFaces_.size()) return {};
+  return vertexFaces_[id];
+}
+
+namespace {
+
+template <typename T>
+void EnsureSlot(CowVector<T>& values, std::size_t index) {
+  while (values.size() <= index) values.emplace_back();
+}
+
+// Adds values to a sorted, unique list and keeps it that way
+template <typename T>
+void MergeUnique(std::vector<T>& sorted, std::span<const T> values) {
+  const auto middle = static_cast<std::ptrdiff_t>(sorted.size());
+  sorted.insert(sorted.end(), values.begin(), values.end());
+  std::sort(sorted.begin() + middle, sorted.end());
+  std::inplace_merge(sorted.begin(), sorted.begin() + middle, sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+}
+
+}  // namespace
+
+bool Model::ExtractFaceLoop(const Face& face, FaceCacheEntry& entry) const {
+  entry.loop.clear();
+  for (EdgeId eid : face.edges) {
+    if (!edges_.Contains(eid)) return false;
+  }
+
+  entry.loop = Topology::ExtractVertices(face, edges_);
+  const bool complete =
+      entry.loop.size() >= 3 &&
+      std::all_of(entry.loop.begin(), entry.loop.end(),
+                  [&](VertexId vid) { return vertices_.Contains(vid); });
+  if (!complete) entry.loop.clear();
+  return complete;
+}
+
+void Model::ComputeFaceGeometry(FaceCacheEntry& entry) const {
+  entry.bounds = {};
+  entry.normal = Vec3{};
+  entry.planeOffset = 0.0f;
+  if (entry.loop.size() < 3) return;
+
+  // Reused per thread so refreshing a face never allocates
+  thread_local std::vector<Vec3> positions;
+  positions.clear();
+
+  Vec3 centroid{};
+  for (VertexId vid : entry.loop) {
+    const Vec3& p = vertices_.Get(vid).position;
+    positions.push_back(p);
+    centroid += p;
+    entry.bounds.Expand(p);
+  }
+
+  entry.normal = Geometry::PolygonNormal(positions);
+  entry.planeOffset = entry.normal.Dot(centroid / static_cast<float>(positions.size()));
+}
+
+void Model::AttachFaceCache(FaceId id, FaceCacheEntry entry) {
+  EnsureSlot(faceCache_, id);
+  for (VertexId vid : entry.loop) {
+    EnsureSlot(vertexFaces_, vid);
+    vertexFaces_[vid].push_back(id);
+  }
+  faceCache_[id] = std::move(entry);
+}
+
+void Model::DetachFaceCache(FaceId id) {
+  if (id >= faceCache_.size()) return;
+
+  for (VertexId vid : std::as_const(faceCache_)[id].loop) {
+    if (vid >= vertexFaces_.size()) continue;
+    auto& faces = vertexFaces_[vid];
+    faces.erase(std::remove(faces.begin(), faces.end(), id), faces.end());
+  }
+  faceCache_[id] = {};
+}
+
+void Model::BreakFace(FaceId id) {
+  DetachFaceCache(id);
+  brokenFaces_.push_back(id);
+  facesDirty_ = true;
+}
+
+void Model::ReattachBrokenFaces() {
+  if (brokenFaces_.empty()) return;
+
+  std::erase_if(brokenFaces_, [&](FaceId fid) {
+    // Removed, or already given a loop again (possibly as a new face reusing the id)
+    if (!faces_.Contains(fid) || !FaceLoop(fid).empty()) return true;
+
+    FaceCacheEntry entry;
+    if (!ExtractFaceLoop(std::as_const(faces_).Get(fid), entry)) return false;
+
+    ComputeFaceGeometry(entry);
+    AttachFaceCache(fid, std::move(entry));
+    facesDirty_ = true;
+    return true;
+  });
+}
+
+void Model::RefreshFacesAround(std::span<const VertexId> vertices) {
+  // Collect first: the span may point into the cache being refreshed
+  refreshScratch_.clear();
+  for (VertexId vid : vertices) {
+    const auto faces = VertexFaces(vid);
+    refreshScratch_.insert(refreshScratch_.end(), faces.begin(), faces.end());
+  }
+  std::sort(refreshScratch_.begin(), refreshScratch_.end());
+  refreshScratch_.erase(std::unique(refreshScratch_.begin(), refreshScratch_.end()),
+                        refreshScratch_.end());
+
+  for (FaceId fid : refreshScratch_) ComputeFaceGeometry(faceCache_[fid]);
+}
+
+void Model::RecordMoves(std::span<const VertexId> vertices) {
+  RefreshFacesAround(vertices);
+
+  // A full rebuild is already pending, or patching would cost more than rebuilding
+  if (verticesDirty_) {
+    untrackedMoves_ = true;
+    return;
+  }
+  if (movedVertices_.size() + vertices.size() > vertices_.DenseCount() / 2) {
+    verticesDirty_ = true;
+    untrackedMoves_ = true;
+    movedVertices_.clear();
+    reshapedFaces_.clear();
+    return;
+  }
+
+  MergeUnique(movedVertices_, vertices);
+  MergeUnique(reshapedFaces_, std::span<const FaceId>(refreshScratch_));
+}
+
+std::span<const VertexId> Model::MovedVertices() const { return movedVertices_; }
+
+std::span<const FaceId> Model::ReshapedFaces() const { return reshapedFaces_; }
+
+void Model::BuildFaceCaches(std::span<const FaceId> faces) {
+  if (faces.empty()) return;
+
+  // Extract loops and geometry in parallel into private entries, then publish them.
+  // Workers only read: non-const access would clone chunks shared with snapshots.
+  // Faces missing an edge or vertex come back with an empty loop and stay broken.
+  std::vector<FaceCacheEntry> entries(faces.size());
+  Jobs::ParallelFor(faces.size(), 1024, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      if (ExtractFaceLoop(std::as_const(faces_).Get(faces[i]), entries[i])) {
+        ComputeFaceGeometry(entries[i]);
+      }
+    }
+  });
+
+  // Bulk batches size each vertex's face list once instead of growing it face by face
+  if (faces.size() >= 1024) {
+    std::vector<uint32_t> incidence(vertices_.IdCapacity(), 0);
+    for (const FaceCacheEntry& entry : entries) {
+      for (VertexId vid : entry.loop) ++incidence[vid];
+    }
+    if (!incidence.empty()) EnsureSlot(vertexFaces_, incidence.size() - 1);
+    for (VertexId vid = 0; vid < incidence.size(); ++vid) {
+      if (incidence[vid] > 0) vertexFaces_[vid].reserve(vertexFaces_[vid].size() + incidence[vid]);
+    }
+  }
+
+  for (std::size_t i = 0; i < faces.size(); ++i) {
+    if (entries[i].loop.empty()) {
+      BreakFace(faces[i]);
+    } else {
+      AttachFaceCache(faces[i], std::move(entries[i]));
+    }
+  }
+}
+
+void Model::RebuildFaceCache() {
+  faceCache_.clear();
+  vertexFaces_.clear();
+  brokenFaces_.clear();
+
+  std::vector<FaceId> faces(faces_.DenseIds().begin(), faces_.DenseIds().end());
+  BuildFaceCaches(faces);
+}
+
 bool Model::ContainsVertex(VertexId id) const { return vertices_.Contains(id); }
 bool Model::ContainsEdge(EdgeId id) const { return edges_.Contains(id); }
 bool Model::ContainsFace(FaceId id) const { return faces_.Contains(id); }
 bool Model::ContainsVolume(VolumeId id) const { return volumes_.Contains(id); }
 
-std::span<const Vertex> Model::Vertices() const { return vertices_.Dense(); }
+const CowVector<Vertex>& Model::Vertices() const { return vertices_.Dense(); }
 
-std::span<const Edge> Model::Edges() const { return edges_.Dense(); }
+const CowVector<Edge>& Model::Edges() const { return edges_.Dense(); }
 
-std::span<const Face> Model::Faces() const { return faces_.Dense(); }
+const CowVector<Face>& Model::Faces() const { return faces_.Dense(); }
 
-std::span<const Volume> Model::Volumes() const { return volumes_.Dense(); }
+const CowVector<Volume>& Model::Volumes() const { return volumes_.Dense(); }
 
 uint32_t Model::VertexIdToIndex(VertexId id) const { return vertices_.DenseIndex(id); }
 
+VertexId Model::VertexIndexToId(uint32_t index) const { return vertices_.IdAt(index); }
+
+uint32_t Model::EdgeIdToIndex(EdgeId id) const { return edges_.DenseIndex(id); }
+
 FaceId Model::FaceIndexToId(uint32_t index) const { return faces_.IdAt(index); }
 
+VolumeId Model::VolumeIndexToId(uint32_t index) const { return volumes_.IdAt(index); }
+
 bool Model::CanCreateEdge(VertexId a, VertexId b) const {
   if (a == b) return false;
 
@@ -170,37 +933,52 @@ bool Model::CanCreateEdge(VertexId a, VertexId b) const {
 }
 
 bool Model::CanCreateFace(std::span<const EdgeId> edges) const {
-  if (edges.size() < 3) return false;
-
-  for (EdgeId eid : edges)
-    if (!edges_.Contains(eid)) return false;
+  return ValidateFaceLoop(edges).has_value();
+}
 
+std::optional<std::vector<VertexId>> Model::ValidateFaceLoop(
+    std::span<const EdgeId> edges) const {
   Face temp{};
   temp.edges.assign(edges.begin(), edges.end());
 
-  if (!Topology::IsValidFace(temp, edges_)) return false;
+  std::vector<VertexId> loop;
+  if (CheckFaceCandidate(temp, loop) != Topology::Defect::None) return std::nullopt;
 
-  auto vertexIds = Topology::ExtractVertices(temp, edges_);
+  return loop;
+}
 
-  // get vertices
-  const auto vertices = vertices_.Get(vertexIds);
-  const auto positions = Mapped(vertices, &Vertex::position);
+Topology::Defect Model::CheckFaceCandidate(const Face& face, std::vector<VertexId>& outLoop) const {
+  const auto defect = Topology::CheckFace(face, edges_, outLoop);
+  if (defect != Topology::Defect::None) return defect;
 
-  if (!Geometry::AreCoplanar(positions)) return false;
+  // get vertex positions
+  thread_local std::vector<Vec3> positions;
+  positions.clear();
+  for (VertexId vid : outLoop) positions.push_back(vertices_.Get(vid).position);
 
-  return true;
+  if (Geometry::AreColinear(positions)) return Topology::Defect::Degenerate;
+  if (!Geometry::AreCoplanar(positions)) return Topology::Defect::NotPlanar;
+
+  return Topology::Defect::None;
 }
 
 bool Model::CanCreateVolume(std::span<const FaceId> faces) const {
-  if (faces.size() < 4) return false;
-
-  for (FaceId fid : faces)
-    if (!faces_.Contains(fid)) return false;
-
   Volume temp{};
   temp.faces.assign(faces.begin(), faces.end());
 
-  if (!Topology::IsValidVolume(temp, faces_)) return false;
+  return Topology::IsValidVolume(temp, faces_, edges_);
+}
+
+std::vector<Topology::Defect> Model::ValidateFaces(std::span<const Face> candidates) const {
+  std::vector<Topology::Defect> verdicts(candidates.size());
+  Jobs::ParallelFor(candidates.size(), 256, [&](std::size_t begin, std::size_t end) {
+    thread_local std::vector<VertexId> loop;
+    for (std::size_t i = begin; i < end; ++i) verdicts[i] = CheckFaceCandidate(candidates[i], loop);
+  });
+  return verdicts;
+}
 
-  return true;
+std::vector<Topology::Defect> Model::ValidateVolumes(std::span<const Volume> candidates,
+                                                     bool requireConsistentWinding) const {
+  return Topology::CheckVolumes(candidates, faces_, edges_, requireConsistentWinding);
 }
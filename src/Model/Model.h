@@ -1,21 +1,42 @@
 #pragma once
 
+#include <memory>
 #include <optional>
 #include <span>
 
+#include "Core/MeshData.h"
 #include "Core/Primitives.h"
+#include "Geometry/Aabb.h"
 #include "Utilities/SparseSet.h"
 
+class BinaryReader;
+class BinaryWriter;
+
+namespace Topology {
+enum class Defect : uint8_t;
+}
+
 class Model {
  public:
   Model();
 
+  // Copies share element storage copy-on-write, so they cost O(chunks)
+  Model(const Model& other);
+  Model& operator=(const Model&) = delete;
+
+  // Immutable point-in-time view for background readers (export, autosave,
+  // analysis). Edits made afterwards only clone the chunks they touch, and the
+  // snapshot's storage is released when its last holder drops it.
+  std::shared_ptr<const Model> Snapshot() const;
+
   // ---- Vertex -------------------------------------------------
   VertexId CreateVertex(const Vec3& position);
   bool RemoveVertex(VertexId id);
 
   const Vertex& GetVertex(VertexId id) const;
   void SetVertexPosition(VertexId id, const Vec3& position);
+  // Batched move; each affected face's cached geometry is refreshed once
+  void SetVertexPositions(std::span<const VertexId> ids, std::span<const Vec3> positions);
 
   // ---- Edge ---------------------------------------------------
   std::optional<EdgeId> CreateEdge(VertexId a, VertexId b);
@@ -40,6 +61,53 @@ class Model {
 
   const Volume& GetVolume(VolumeId id) const;
 
+  // ---- Bulk -------------------------------------------------
+  // Insert a whole mesh with precomputed topology. Skips the per-element validation
+  // scans, so the caller is responsible for well formed input (see MeshData).
+  MeshIds AppendMesh(const MeshData& mesh);
+
+  // Extrude a region of faces by delta along the averaged normals of its vertices.
+  // Boundary vertices are duplicated so neighbouring faces stay put, a quad side
+  // wall is stitched along every boundary edge and volumes holding region faces gain
+  // the walls. Works on sorted scratch arrays in one pass, without per-element
+  // validation scans.
+  ExtrudeRecord ExtrudeFaces(std::span<const FaceId> faces, float delta);
+  void RevertExtrude(const ExtrudeRecord& record);
+
+  // Remove volumes together with the faces, edges and vertices nothing else uses.
+  // RestoreRemoved puts everything back under the same ids.
+  RemovalRecord RemoveVolumes(std::span<const VolumeId> volumes);
+  void RestoreRemoved(const RemovalRecord& record);
+
+  // ---- Face cache --------------------------------------------
+  // Ordered vertex loop, plane and bounds of every face, kept current as vertices,
+  // edges and faces change so readers never re-extract or allocate. Faces whose
+  // edges no longer form a loop, or that lost a vertex, have an empty loop until
+  // the missing element comes back.
+  std::span<const VertexId> FaceLoop(FaceId id) const;
+  const Vec3& FaceNormal(FaceId id) const;
+  // Plane equation: FaceNormal(id).Dot(p) == FacePlaneOffset(id)
+  float FacePlaneOffset(FaceId id) const;
+  const Geometry::Aabb& FaceBounds(FaceId id) const;
+
+  // Faces whose loop passes through the vertex
+  std::span<const FaceId> VertexFaces(VertexId id) const;
+
+  // ---- Validation --------------------------------------------
+  // Check many candidates in parallel without inserting them; verdicts[i] is the
+  // reason candidates[i] would be rejected, or Defect::None
+  std::vector<Topology::Defect> ValidateFaces(std::span<const Face> candidates) const;
+  std::vector<Topology::Defect> ValidateVolumes(std::span<const Volume> candidates,
+                                                bool requireConsistentWinding = false) const;
+
+  // ---- Persistence -------------------------------------------
+  // Full state including id allocation, so commands replayed after Deserialize
+  // produce the same ids they did originally. Deserialize leaves the model
+  // untouched when the data is malformed, including references to ids outside the
+  // saved id ranges.
+  void Serialize(BinaryWriter& out) const;
+  bool Deserialize(BinaryReader& in);
+
   // ---- Queries -----------------------------------------------
   bool ContainsVertex(VertexId id) const;
   bool ContainsEdge(EdgeId id) const;
@@ -47,29 +115,49 @@ class Model {
   bool ContainsVolume(VolumeId id) const;
 
   // ---- Iteration (read-only views) ---------------------------
-  std::span<const Vertex> Vertices() const;
-  std::span<const Edge> Edges() const;
-  std::span<const Face> Faces() const;
-  std::span<const Volume> Volumes() const;
+  // Dense storage is chunked; use ChunkSpan for contiguous access
+  const CowVector<Vertex>& Vertices() const;
+  const CowVector<Edge>& Edges() const;
+  const CowVector<Face>& Faces() const;
+  const CowVector<Volume>& Volumes() const;
 
   uint32_t VertexIdToIndex(VertexId id) const;
+  VertexId VertexIndexToId(uint32_t index) const;
+  uint32_t EdgeIdToIndex(EdgeId id) const;
   FaceId FaceIndexToId(uint32_t index) const;
+  VolumeId VolumeIndexToId(uint32_t index) const;
 
   // ---- Dirty Flag Management ---------------------------------
-  bool IsVerticesDirty() const { return verticesDirty_; }
+  bool IsVerticesDirty() const { return verticesDirty_ || !movedVertices_.empty(); }
   bool IsEdgesDirty() const { return edgesDirty_; }
   bool IsFacesDirty() const { return facesDirty_; }
   bool IsVolumesDirty() const { return volumesDirty_; }
+  // Existing vertices moved without being listed in MovedVertices (too many moves to
+  // track, ExtrudeFace(s) and their undo, Deserialize); any face may have been reshaped
+  bool HasUntrackedMoves() const { return untrackedMoves_; }
 
   void ResetDirtyFlags() {
     verticesDirty_ = false;
     edgesDirty_ = false;
     facesDirty_ = false;
     volumesDirty_ = false;
+    untrackedMoves_ = false;
+    movedVertices_.clear();
+    reshapedFaces_.clear();
   }
 
   bool ShouldRender() const {
-    return verticesDirty_ || edgesDirty_ || facesDirty_ || volumesDirty_;
+    return IsVerticesDirty() || edgesDirty_ || facesDirty_ || volumesDirty_;
+  }
+
+  // Vertices moved by SetVertexPosition(s) since the last reset and the faces whose
+  // geometry that changed, each sorted and unique. While OnlyVerticesMoved() they are
+  // the whole change, so views can patch those elements instead of rebuilding.
+  std::span<const VertexId> MovedVertices() const;
+  std::span<const FaceId> ReshapedFaces() const;
+  bool OnlyVerticesMoved() const {
+    return !movedVertices_.empty() && !verticesDirty_ && !edgesDirty_ && !facesDirty_ &&
+           !volumesDirty_;
   }
 
  private:
@@ -78,14 +166,53 @@ class Model {
   bool edgesDirty_ = false;
   bool facesDirty_ = false;
   bool volumesDirty_ = false;
+  bool untrackedMoves_ = false;
+
+  // Kept sorted and unique by RecordMoves, so const readers (possibly on other threads
+  // sharing a snapshot) never write
+  std::vector<VertexId> movedVertices_;
+  std::vector<FaceId> reshapedFaces_;
 
   DirtySparseSet<Vertex> vertices_;
   DirtySparseSet<Edge> edges_;
   DirtySparseSet<Face> faces_;
   DirtySparseSet<Volume> volumes_;
 
+  // Derived face data, indexed by id (see FaceLoop)
+  struct FaceCacheEntry {
+    std::vector<VertexId> loop;
+    Vec3 normal{};
+    float planeOffset = 0.0f;
+    Geometry::Aabb bounds;
+  };
+
+  CowVector<FaceCacheEntry> faceCache_;         // by FaceId
+  CowVector<std::vector<FaceId>> vertexFaces_;  // by VertexId
+  std::vector<FaceId> refreshScratch_;
+  // Faces detached because an edge or vertex of theirs was removed; they get their
+  // cache back once the missing elements are recreated (e.g. by undo)
+  std::vector<FaceId> brokenFaces_;
+
   // Centralized validation hooks
   bool CanCreateEdge(VertexId a, VertexId b) const;
   bool CanCreateFace(std::span<const EdgeId> edges) const;
   bool CanCreateVolume(std::span<const FaceId> faces) const;
+
+  // Validates a prospective face and returns its ordered loop
+  std::optional<std::vector<VertexId>> ValidateFaceLoop(std::span<const EdgeId> edges) const;
+  Topology::Defect CheckFaceCandidate(const Face& face, std::vector<VertexId>& outLoop) const;
+
+  // Face cache maintenance
+  // Fills entry.loop from the face's edges. Returns false, leaving the loop empty, when
+  // an edge or vertex of the face is missing or the loop has fewer than three corners.
+  bool ExtractFaceLoop(const Face& face, FaceCacheEntry& entry) const;
+  void ComputeFaceGeometry(FaceCacheEntry& entry) const;
+  void AttachFaceCache(FaceId id, FaceCacheEntry entry);
+  void DetachFaceCache(FaceId id);
+  void BreakFace(FaceId id);
+  void ReattachBrokenFaces();
+  void RefreshFacesAround(std::span<const VertexId> vertices);
+  void RecordMoves(std::span<const VertexId> vertices);
+  void BuildFaceCaches(std::span<const FaceId> faces);
+  void RebuildFaceCache();
 };
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "ModelFile.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Model.h"
+#include "Utilities/BinaryStream.h"
+#include "Utilities/MappedFile.h"
+
+namespace ModelFile {
+
+namespace {
+
+constexpr char kMagic[4] = {'C', 'A', 'D', 'M'};
+constexpr uint32_t kVersion = 1;
+
+// magic, version, generation, payload checksum
+constexpr std::size_t kHeaderSize = sizeof(kMagic) + 2 * sizeof(uint32_t) + sizeof(uint64_t);
+
+bool WriteFileDurably(const std::string& path, const std::vector<char>& data) {
+  const std::string temporary = path + ".tmp";
+
+  const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) return false;
+
+  const char* cursor = data.data();
+  std::size_t remaining = data.size();
+  bool ok = true;
+  while (ok && remaining > 0) {
+    const ssize_t written = ::write(fd, cursor, remaining);
+    if (written < 0 && errno == EINTR) continue;
+    ok = written > 0;
+    if (ok) {
+      cursor += written;
+      remaining -= static_cast<std::size_t>(written);
+    }
+  }
+
+  ok = ok && ::fsync(fd) == 0;
+  ok = ::close(fd) == 0 && ok;
+  ok = ok && std::rename(temporary.c_str(), path.c_str()) == 0;
+
+  if (!ok) std::remove(temporary.c_str());
+  return ok;
+}
+
+}  // namespace
+
+bool Save(const Model& model, const std::string& path, uint64_t generation) {
+  std::vector<char> data(kHeaderSize);
+  BinaryWriter payload(data);
+  model.Serialize(payload);
+
+  const uint32_t checksum =
+      Checksum(std::string_view(data.data() + kHeaderSize, data.size() - kHeaderSize));
+
+  std::vector<char> header;
+  BinaryWriter writer(header);
+  writer.Write(kMagic);
+  writer.Write(kVersion);
+  writer.Write(generation);
+  writer.Write(checksum);
+  std::memcpy(data.data(), header.data(), kHeaderSize);
+
+  return WriteFileDurably(path, data);
+}
+
+std::optional<uint64_t> Load(Model& model, const std::string& path) {
+  const MappedFile file(path);
+  if (!file.IsOpen() || file.Size() < kHeaderSize) return std::nullopt;
+
+  BinaryReader header(file.View().substr(0, kHeaderSize));
+  char magic[4] = {};
+  uint32_t version = 0;
+  uint64_t generation = 0;
+  uint32_t checksum = 0;
+  header.Read(magic);
+  header.Read(version);
+  header.Read(generation);
+  header.Read(checksum);
+
+  const std::string_view payload = file.View().substr(kHeaderSize);
+  if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kVersion ||
+      Checksum(payload) != checksum) {
+    return std::nullopt;
+  }
+
+  BinaryReader in(payload);
+  if (!model.Deserialize(in)) return std::nullopt;
+  return generation;
+}
+
+}  // namespace ModelFile
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+class Model;
+
+// Whole-model snapshot files. Each snapshot carries a generation number that ties it
+// to the command journal recorded on top of it.
+namespace ModelFile {
+
+// Written to a temporary file, synced and renamed into place, so a crash leaves
+// either the old or the new snapshot intact
+bool Save(const Model& model, const std::string& path, uint64_t generation);
+
+// Returns the snapshot generation, or nullopt (model untouched) if the file is
+// missing or invalid
+std::optional<uint64_t> Load(Model& model, const std::string& path);
+
+}  // namespace ModelFile
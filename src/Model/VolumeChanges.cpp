@@ -0,0 +1,53 @@
+#include "Model/VolumeChanges.h"
+
+#include <algorithm>
+
+#include "Model/Model.h"
+
+namespace {
+
+std::size_t CornerCount(const Model& model, std::span<const FaceId> faces) {
+  std::size_t corners = 0;
+  for (FaceId id : faces) {
+    if (model.ContainsFace(id)) corners += model.FaceLoop(id).size();
+  }
+  return corners;
+}
+
+}  // namespace
+
+VolumeStamp::VolumeStamp(const Model& model, std::span<const FaceId> faces)
+    : faces_(faces.begin(), faces.end()),
+      sortedFaces_(faces.begin(), faces.end()),
+      corners_(CornerCount(model, faces)) {
+  std::sort(sortedFaces_.begin(), sortedFaces_.end());
+}
+
+bool VolumeStamp::HasFace(FaceId id) const {
+  return std::binary_search(sortedFaces_.begin(), sortedFaces_.end(), id);
+}
+
+bool VolumeStamp::Matches(const Model& model, std::span<const FaceId> faces) const {
+  return std::equal(faces_.begin(), faces_.end(), faces.begin(), faces.end()) &&
+         CornerCount(model, faces) == corners_;
+}
+
+VolumeChanges::VolumeChanges(const Model& model)
+    : model_(model),
+      reshaped_(model.ReshapedFaces()),
+      structural_(model.IsFacesDirty() || model.IsVolumesDirty() || model.IsEdgesDirty()),
+      allMoved_(model.HasUntrackedMoves()) {}
+
+bool VolumeChanges::Moved(const VolumeStamp& stamp) const {
+  if (allMoved_) return true;
+  return std::any_of(reshaped_.begin(), reshaped_.end(),
+                     [&](FaceId id) { return stamp.HasFace(id); });
+}
+
+bool VolumeChanges::Changed(VolumeId volume, const VolumeStamp& stamp) const {
+  if (structural_) {
+    if (!model_.ContainsVolume(volume)) return true;
+    if (!stamp.Matches(model_, model_.GetVolume(volume).faces)) return true;
+  }
+  return Moved(stamp);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "Core/Primitives.h"
+
+class Model;
+
+// What a per-volume cache entry was derived from: the volume's face list and the
+// summed size of their loops, so later edits can be checked against it
+class VolumeStamp {
+ public:
+  VolumeStamp() = default;
+  VolumeStamp(const Model& model, std::span<const FaceId> faces);
+
+  std::span<const FaceId> Faces() const { return faces_; }
+  bool HasFace(FaceId id) const;
+
+  // Same face list with the same loop sizes as faces has in the model now
+  bool Matches(const Model& model, std::span<const FaceId> faces) const;
+
+ private:
+  std::vector<FaceId> faces_;
+  std::vector<FaceId> sortedFaces_;
+  std::size_t corners_ = 0;
+};
+
+// The edits since the model's dirty flags were last reset, as seen by caches keyed on
+// volumes. Read it before the flags are reset.
+class VolumeChanges {
+ public:
+  explicit VolumeChanges(const Model& model);
+
+  bool Any() const { return structural_ || allMoved_ || !reshaped_.empty(); }
+
+  // Faces, edges or volumes changed, so stamps must be compared with Matches
+  bool Structural() const { return structural_; }
+
+  // Vertex positions under the stamped faces may have changed. Moves leave every list
+  // intact, so this looks for the reshaped faces themselves, and reports every volume
+  // when moves went untracked (see Model::HasUntrackedMoves).
+  bool Moved(const VolumeStamp& stamp) const;
+
+  // The volume is gone, or its faces, loops or vertex positions changed
+  bool Changed(VolumeId volume, const VolumeStamp& stamp) const;
+
+ private:
+  const Model& model_;
+  std::span<const FaceId> reshaped_;
+  bool structural_ = false;
+  bool allMoved_ = false;
+};
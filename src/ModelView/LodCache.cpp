@@ -0,0 +1,194 @@
+#include "LodCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include "Model/Model.h"
+#include "Utilities/JobSystem.h"
+
+namespace {
+
+// A volume only switches to a coarser level once it shows comfortably less error than
+// allowed, so hovering at a threshold does not flicker between levels
+constexpr float kCoarsenMargin = 0.75f;
+
+}  // namespace
+
+bool LodCache::Update(const Vec3& eye, float fovDegrees, uint32_t viewportHeight,
+                      float errorScale) {
+  const VolumeChanges changes(model_);
+  if (!scanned_ || changes.Structural()) {
+    Rescan();
+    scanned_ = true;
+  }
+
+  if (changes.Any()) {
+    for (Entry& entry : entries_) {
+      if (changes.Moved(entry.stamp)) Invalidate(entry);
+    }
+  }
+
+  Collect();
+
+  const float tanHalfFov = std::tan(fovDegrees * std::numbers::pi_v<float> / 360.0f);
+  std::vector<std::pair<std::shared_ptr<const Simplify::LodChain>, uint32_t>> drawn;
+  for (Entry& entry : entries_) {
+    if (!entry.chain && !entry.building) {
+      if (entry.settle > 0) {
+        --entry.settle;
+      } else {
+        Schedule(entry);
+      }
+    }
+
+    entry.level = PickLevel(entry, eye, tanHalfFov, viewportHeight, kMaxPixelError * errorScale);
+    if (entry.level > 0) drawn.emplace_back(entry.chain, entry.level);
+  }
+
+  const bool changed = drawn != drawn_;
+  drawn_ = std::move(drawn);
+  return changed;
+}
+
+void LodCache::Rescan() {
+  std::vector<Entry> entries;
+  const auto& volumes = model_.Volumes();
+  for (uint32_t i = 0; i < volumes.size(); ++i) {
+    const Volume& volume = volumes[i];
+    std::size_t triangles = 0;
+    for (FaceId id : volume.faces) {
+      const std::size_t size = model_.FaceLoop(id).size();
+      if (size >= 3) triangles += size - 2;
+    }
+    if (triangles < minTriangles_) continue;
+
+    const VolumeId id = model_.VolumeIndexToId(i);
+    const auto previous = std::find_if(entries_.begin(), entries_.end(),
+                                       [id](const Entry& entry) { return entry.volume == id; });
+    Entry& entry = previous != entries_.end() ? entries.emplace_back(std::move(*previous))
+                                              : entries.emplace_back();
+    if (previous != entries_.end() && entry.stamp.Matches(model_, volume.faces)) continue;
+
+    entry.volume = id;
+    entry.stamp = VolumeStamp(model_, volume.faces);
+    Invalidate(entry);
+  }
+  entries_ = std::move(entries);
+}
+
+void LodCache::Invalidate(Entry& entry) {
+  entry.chain.reset();
+  entry.ticket = 0;
+  entry.building = false;
+  entry.settle = kSettleFrames;
+  entry.level = 0;
+}
+
+void LodCache::Collect() {
+  std::vector<Inbox::Delivery> deliveries;
+  {
+    std::lock_guard lock(inbox_->mutex);
+    deliveries.swap(inbox_->deliveries);
+  }
+
+  for (Inbox::Delivery& delivery : deliveries) {
+    for (Entry& entry : entries_) {
+      if (entry.building && entry.ticket == delivery.ticket) {
+        entry.chain = std::move(delivery.chain);
+        entry.building = false;
+        break;
+      }
+    }
+  }
+}
+
+void LodCache::Schedule(Entry& entry) {
+  entry.ticket = nextTicket_++;
+  entry.building = true;
+
+  // The worker reads a snapshot, so editing carries on while it decimates
+  Jobs::Submit([snapshot = model_.Snapshot(), stamp = entry.stamp, ticket = entry.ticket,
+                inbox = inbox_] {
+    auto chain = std::make_shared<const Simplify::LodChain>(
+        Simplify::BuildLodChain(*snapshot, stamp.Faces(), kMaxLevels));
+    std::lock_guard lock(inbox->mutex);
+    inbox->deliveries.push_back({ticket, std::move(chain)});
+  });
+}
+
+uint32_t LodCache::PickLevel(const Entry& entry, const Vec3& eye, float tanHalfFov,
+                             uint32_t viewportHeight, float maxPixelError) const {
+  if (!entry.chain || entry.chain->levels.empty() || viewportHeight == 0) return 0;
+
+  // Projected size of the bounding sphere at its nearest point sets how many pixels one
+  // unit of error covers; the camera inside the sphere always gets full detail
+  const Geometry::Aabb& bounds = entry.chain->bounds;
+  const float radius = bounds.Extent().Length() * 0.5f;
+  const float distance = (eye - bounds.Center()).Length() - radius;
+  if (!(distance > 0.0f) || !(tanHalfFov > 0.0f)) return 0;
+  const float pixelsPerUnit = static_cast<float>(viewportHeight) / (2.0f * distance * tanHalfFov);
+
+  // Errors only grow down the chain
+  uint32_t finest = 0;
+  uint32_t coarsest = 0;
+  const auto& levels = entry.chain->levels;
+  for (uint32_t i = 0; i < levels.size(); ++i) {
+    const float pixels = levels[i].error * pixelsPerUnit;
+    if (pixels > maxPixelError) break;
+    finest = i + 1;
+    if (pixels <= maxPixelError * kCoarsenMargin) coarsest = i + 1;
+  }
+  return entry.level > finest ? finest : std::max(entry.level, coarsest);
+}
+
+void LodCache::Apply(FaceView& view) const {
+  if (drawn_.empty() || view.faceFirstVertex.empty()) return;
+
+  std::vector<uint8_t> hidden(view.faceVertexCount.size(), 0);
+  for (const Entry& entry : entries_) {
+    if (entry.level == 0) continue;
+    for (FaceId id : entry.stamp.Faces()) {
+      if (id < hidden.size()) hidden[id] = 1;
+    }
+  }
+
+  // Close the gaps left by hidden faces; the view runs in dense face order
+  uint32_t write = 0;
+  const auto faceCount = static_cast<uint32_t>(model_.Faces().size());
+  for (uint32_t i = 0; i < faceCount; ++i) {
+    const FaceId id = model_.FaceIndexToId(i);
+    if (id >= view.faceVertexCount.size()) continue;
+    const uint32_t first = view.faceFirstVertex[id];
+    const uint32_t count = hidden[id] ? 0 : view.faceVertexCount[id];
+    if (count > 0 && first != write) {
+      std::copy_n(view.vertices.begin() + first, count, view.vertices.begin() + write);
+      std::copy_n(view.primitiveIds.begin() + first, count, view.primitiveIds.begin() + write);
+    }
+    view.faceFirstVertex[id] = write;
+    view.faceVertexCount[id] = count;
+    write += count;
+  }
+  view.vertices.resize(write);
+  view.primitiveIds.resize(write);
+
+  for (const Entry& entry : entries_) {
+    if (entry.level == 0) continue;
+    const FaceView& lod = entry.chain->levels[entry.level - 1].view;
+    view.vertices.insert(view.vertices.end(), lod.vertices.begin(), lod.vertices.end());
+    view.primitiveIds.insert(view.primitiveIds.end(), lod.primitiveIds.begin(),
+                             lod.primitiveIds.end());
+  }
+}
+
+uint32_t LodCache::SelectedLevel(VolumeId volume) const {
+  for (const Entry& entry : entries_) {
+    if (entry.volume == volume) return entry.level;
+  }
+  return 0;
+}
+
+std::size_t LodCache::PendingCount() const {
+  return std::count_if(entries_.begin(), entries_.end(),
+                       [](const Entry& entry) { return entry.building; });
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Core/Primitives.h"
+#include "Model/VolumeChanges.h"
+#include "ModelView/ModelViews.h"
+#include "Simplify/Decimate.h"
+#include "Utilities/Vec3.h"
+
+class Model;
+
+// Decimated stand-ins for large volumes, drawn while a volume is small on screen.
+// Chains are built on a worker from a model snapshot once a volume has gone a while
+// without edits, and dropped as soon as it changes again, so editing always sees the
+// real faces.
+class LodCache {
+ public:
+  // Volumes with fewer triangles than this are always drawn in full
+  static constexpr std::size_t kDefaultMinTriangles = 50000;
+
+  explicit LodCache(const Model& model, std::size_t minTriangles = kDefaultMinTriangles)
+      : model_(model), minTriangles_(minTriangles) {}
+
+  // Call once per frame before the face view is built or patched. Drops the chains of
+  // changed volumes, takes in finished builds, queues new ones and picks a level for
+  // every volume from its projected size. Returns true when the levels to draw
+  // differ from the previous call, so the face view must be rebuilt. errorScale
+  // multiplies the on-screen error allowed, for coarser levels while the view moves.
+  bool Update(const Vec3& eye, float fovDegrees, uint32_t viewportHeight,
+              float errorScale = 1.0f);
+
+  // Swap the selected levels into a view from ModelViewBuilder::BuildFaceView: faces
+  // of decimated volumes lose their vertices and the level's triangles are appended.
+  // The view stays patchable; a moved face of a decimated volume just fails to patch.
+  void Apply(FaceView& view) const;
+
+  // Level drawn for a volume; 0 is full detail
+  uint32_t SelectedLevel(VolumeId volume) const;
+  // Chains being built in the background
+  std::size_t PendingCount() const;
+
+ private:
+  // On-screen error a level may show, in pixels
+  static constexpr float kMaxPixelError = 1.0f;
+  // Frames a volume must go unedited before its chain is built
+  static constexpr uint32_t kSettleFrames = 30;
+  static constexpr uint32_t kMaxLevels = 4;
+
+  struct Entry {
+    VolumeId volume = 0;
+    VolumeStamp stamp;  // the volume's faces when the entry was made
+    std::shared_ptr<const Simplify::LodChain> chain;
+    uint64_t ticket = 0;  // build results carrying another ticket are stale
+    uint32_t settle = kSettleFrames;
+    uint32_t level = 0;
+    bool building = false;
+  };
+
+  // Finished builds, handed over from workers
+  struct Inbox {
+    struct Delivery {
+      uint64_t ticket;
+      std::shared_ptr<const Simplify::LodChain> chain;
+    };
+
+    std::mutex mutex;
+    std::vector<Delivery> deliveries;
+  };
+
+  void Rescan();
+  void Invalidate(Entry& entry);
+  void Collect();
+  void Schedule(Entry& entry);
+  uint32_t PickLevel(const Entry& entry, const Vec3& eye, float tanHalfFov,
+                     uint32_t viewportHeight, float maxPixelError) const;
+
+  const Model& model_;
+  std::size_t minTriangles_;
+  std::vector<Entry> entries_;
+  std::shared_ptr<Inbox> inbox_ = std::make_shared<Inbox>();
+  // Chain and level of every volume drawn decimated after the last Update
+  std::vector<std::pair<std::shared_ptr<const Simplify::LodChain>, uint32_t>> drawn_;
+  uint64_t nextTicket_ = 1;
+  bool scanned_ = false;
+};
@@ -1,10 +1,68 @@
 #include "ModelViewBuilder.h"
 
+#include <algorithm>
 #include <iostream>
 
+#include "Geometry/Triangulation.h"
 #include "Model/Model.h"
 #include "ModelViewBuilder.h"
-#include "Topology/Tools.h"
+#include "Utilities/JobSystem.h"
+
+namespace {
+
+Geometry::Aabb ChunkBounds(const FaceView& faces, std::size_t chunk) {
+  const std::size_t first = chunk * FaceView::kChunkVertices;
+  const std::size_t last = std::min(faces.vertices.size(), first + FaceView::kChunkVertices);
+  Geometry::Aabb bounds;
+  for (std::size_t i = first; i < last; ++i) bounds.Expand(faces.vertices[i]);
+  return bounds;
+}
+
+// Chunks quantized per job
+constexpr std::size_t kQuantizeBatch = 8;
+
+// Quantize one chunk's vertices against its bounds and store the box that decodes them
+void QuantizeChunk(const FaceView& faces, std::size_t chunk, QuantizedFaceView& out) {
+  const Geometry::Aabb& bounds = faces.chunkBounds[chunk];
+  const Vec3 min = bounds.IsEmpty() ? Vec3{0} : bounds.min;
+  const Vec3 extent = bounds.IsEmpty() ? Vec3{0} : bounds.max - bounds.min;
+  float* box = out.chunkBoxes.data() + chunk * 8;
+  box[0] = min.x;
+  box[1] = min.y;
+  box[2] = min.z;
+  box[3] = 0.0f;
+  box[4] = extent.x;
+  box[5] = extent.y;
+  box[6] = extent.z;
+  box[7] = 0.0f;
+
+  // Flat axes decode to min whatever is stored
+  constexpr float kSteps = QuantizedFaceView::kSteps;
+  const float sx = extent.x > 0.0f ? kSteps / extent.x : 0.0f;
+  const float sy = extent.y > 0.0f ? kSteps / extent.y : 0.0f;
+  const float sz = extent.z > 0.0f ? kSteps / extent.z : 0.0f;
+  const std::size_t first = chunk * FaceView::kChunkVertices;
+  const std::size_t last = std::min(faces.vertices.size(), first + FaceView::kChunkVertices);
+  for (std::size_t i = first; i < last; ++i) {
+    const Vec3 p = faces.vertices[i] - min;
+    uint16_t* q = out.positions.data() + 3 * i;
+    q[0] = static_cast<uint16_t>(std::clamp(p.x * sx + 0.5f, 0.0f, kSteps));
+    q[1] = static_cast<uint16_t>(std::clamp(p.y * sy + 0.5f, 0.0f, kSteps));
+    q[2] = static_cast<uint16_t>(std::clamp(p.z * sz + 0.5f, 0.0f, kSteps));
+  }
+}
+
+// Half a quantization step along each axis of the widest chunk
+float QuantizationError(const QuantizedFaceView& out) {
+  float maxError = 0.0f;
+  for (std::size_t box = 0; box + 8 <= out.chunkBoxes.size(); box += 8) {
+    const Vec3 extent{out.chunkBoxes[box + 4], out.chunkBoxes[box + 5], out.chunkBoxes[box + 6]};
+    maxError = std::max(maxError, extent.Length() * 0.5f / QuantizedFaceView::kSteps);
+  }
+  return maxError;
+}
+
+}  // namespace
 
 void ModelViewBuilder::BuildLineView(LineView& outLines) {
   outLines.Clear();
@@ -26,13 +84,61 @@ void ModelViewBuilder::BuildLineView(LineView& outLines) {
   }
 
   outLines.primitiveCount = edgeIndex;
+
+  const auto& vertices = model_.Vertices();
+  outLines.endpoints.reserve(outLines.vertexIndices.size());
+  for (uint32_t index : outLines.vertexIndices) {
+    outLines.endpoints.push_back(vertices[index].position);
+  }
+
+  // Bucket the slots by vertex
+  outLines.vertexSlotOffsets.assign(vertices.size() + 1, 0);
+  for (uint32_t index : outLines.vertexIndices) ++outLines.vertexSlotOffsets[index + 1];
+  for (std::size_t i = 1; i < outLines.vertexSlotOffsets.size(); ++i) {
+    outLines.vertexSlotOffsets[i] += outLines.vertexSlotOffsets[i - 1];
+  }
+  outLines.vertexSlots.resize(outLines.vertexIndices.size());
+  std::vector<uint32_t> fill(outLines.vertexSlotOffsets.begin(),
+                             outLines.vertexSlotOffsets.end() - 1);
+  for (uint32_t slot = 0; slot < outLines.vertexIndices.size(); ++slot) {
+    outLines.vertexSlots[fill[outLines.vertexIndices[slot]]++] = slot;
+  }
+}
+
+bool ModelViewBuilder::PatchLineView(LineView& lines, std::span<const VertexId> moved,
+                                     std::vector<ViewRange>& outRanges) {
+  // Re-sending a few unchanged end points is cheaper than another upload
+  constexpr std::size_t kMaxGap = 8;
+  const auto& vertices = model_.Vertices();
+  if (lines.vertexSlotOffsets.size() != vertices.size() + 1) return false;
+
+  slotScratch_.clear();
+  for (VertexId id : moved) {
+    const uint32_t index = model_.VertexIdToIndex(id);
+    if (index >= vertices.size()) return false;
+    const Vec3& position = vertices[index].position;
+    for (uint32_t s = lines.vertexSlotOffsets[index]; s < lines.vertexSlotOffsets[index + 1];
+         ++s) {
+      const uint32_t slot = lines.vertexSlots[s];
+      lines.endpoints[slot] = position;
+      slotScratch_.push_back(slot);
+    }
+  }
+
+  std::sort(slotScratch_.begin(), slotScratch_.end());
+  for (std::size_t i = 0; i < slotScratch_.size();) {
+    const std::size_t first = slotScratch_[i];
+    std::size_t last = first;
+    while (++i < slotScratch_.size() && slotScratch_[i] - last <= kMaxGap) last = slotScratch_[i];
+    outRanges.push_back({first, last - first + 1});
+  }
+  return true;
 }
 
 void ModelViewBuilder::BuildFaceView(FaceView& outFaces) {
   outFaces.Clear();
 
   const auto& faces = model_.Faces();
-  const auto& edges = model_.Edges();
   const auto& vertices = model_.Vertices();
 
   uint32_t faceIndex = 0;
@@ -40,26 +146,25 @@ void ModelViewBuilder::BuildFaceView(FaceView& outFaces) {
     // Get the actual FaceId for this face
     FaceId faceId = model_.FaceIndexToId(faceIndex);
 
-    auto verts = Topology::ExtractVertices(f, edges);
+    if (faceId >= outFaces.faceFirstVertex.size()) {
+      outFaces.faceFirstVertex.resize(faceId + 1, 0);
+      outFaces.faceVertexCount.resize(faceId + 1, 0);
+    }
+    outFaces.faceFirstVertex[faceId] = static_cast<uint32_t>(outFaces.vertices.size());
+
+    const auto verts = model_.FaceLoop(faceId);
     if (verts.size() < 3) {
       ++faceIndex;
       continue;
     }
 
-    // fan triangulation - expand vertices (no indexing)
-    for (size_t i = 1; i + 1 < verts.size(); ++i) {
-      // Add the 3 vertices of the triangle
-      uint32_t idx0 = model_.VertexIdToIndex(verts[0]);
-      uint32_t idx1 = model_.VertexIdToIndex(verts[i]);
-      uint32_t idx2 = model_.VertexIdToIndex(verts[i + 1]);
+    // expand triangle vertices (no indexing)
+    const auto corners = triangulations_.Get(model_, faceId);
+    outFaces.faceVertexCount[faceId] = static_cast<uint32_t>(corners.size());
+    for (uint32_t corner : corners) {
+      outFaces.vertices.push_back(vertices[model_.VertexIdToIndex(verts[corner])].position);
 
-      outFaces.vertices.push_back(vertices[idx0].position);
-      outFaces.vertices.push_back(vertices[idx1].position);
-      outFaces.vertices.push_back(vertices[idx2].position);
-
-      // Store the actual Face ID once per vertex (3 times)
-      outFaces.primitiveIds.push_back(faceId + 1);
-      outFaces.primitiveIds.push_back(faceId + 1);
+      // Store the actual Face ID once per vertex
       outFaces.primitiveIds.push_back(faceId + 1);
     }
 
@@ -76,34 +181,128 @@ void ModelViewBuilder::BuildFaceView(FaceView& outFaces) {
             << " materials, third: " << (int)outFaces.colorIndices[3] << std::endl;
 }
 
+void ModelViewBuilder::BuildQuantized(const FaceView& faces, QuantizedFaceView& out) {
+  out.Clear();
+  out.positions.resize(faces.vertices.size() * 3);
+  out.chunkBoxes.resize(faces.chunkBounds.size() * 8);
+  Jobs::ParallelFor(faces.chunkBounds.size(), kQuantizeBatch,
+                    [&](std::size_t begin, std::size_t end) {
+                      for (std::size_t c = begin; c < end; ++c) QuantizeChunk(faces, c, out);
+                    });
+  out.maxError = QuantizationError(out);
+
+  const auto widest = std::max_element(faces.primitiveIds.begin(), faces.primitiveIds.end());
+  if (widest == faces.primitiveIds.end() || *widest <= 0xFFFF) {
+    out.ids16.assign(faces.primitiveIds.begin(), faces.primitiveIds.end());
+  } else {
+    out.ids32.assign(faces.primitiveIds.begin(), faces.primitiveIds.end());
+  }
+}
+
+void ModelViewBuilder::PatchQuantized(const FaceView& faces, std::span<const ViewRange> changed,
+                                      QuantizedFaceView& out, std::vector<ViewRange>& outRanges) {
+  // Ranges arrive sorted, so chunks come in order and each is quantized once
+  std::size_t nextChunk = 0;
+  for (const ViewRange& range : changed) {
+    if (range.count == 0) continue;
+    const std::size_t lastChunk = (range.first + range.count - 1) / FaceView::kChunkVertices;
+    for (std::size_t c = std::max(nextChunk, range.first / FaceView::kChunkVertices);
+         c <= lastChunk; ++c) {
+      QuantizeChunk(faces, c, out);
+      const std::size_t first = c * FaceView::kChunkVertices;
+      const std::size_t count = std::min(FaceView::kChunkVertices, faces.vertices.size() - first);
+      if (!outRanges.empty() && outRanges.back().first + outRanges.back().count == first) {
+        outRanges.back().count += count;
+      } else {
+        outRanges.push_back({first, count});
+      }
+    }
+    nextChunk = std::max(nextChunk, lastChunk + 1);
+  }
+  out.maxError = QuantizationError(out);
+}
+
+bool ModelViewBuilder::PatchFaceView(FaceView& faces, std::span<const FaceId> moved,
+                                     std::vector<ViewRange>& outRanges) {
+  const auto& vertices = model_.Vertices();
+  const std::size_t firstRange = outRanges.size();
+
+  for (FaceId faceId : moved) {
+    if (faceId >= faces.faceVertexCount.size()) return false;
+
+    const auto verts = model_.FaceLoop(faceId);
+    const uint32_t first = faces.faceFirstVertex[faceId];
+    const uint32_t count = faces.faceVertexCount[faceId];
+    if (verts.size() < 3) {
+      if (count != 0) return false;
+      continue;
+    }
+
+    // Same loop, so the same number of triangles, but the diagonals may have changed
+    const auto corners = triangulations_.Get(model_, faceId);
+    if (corners.size() != count || first + count > faces.vertices.size()) return false;
+    for (uint32_t i = 0; i < count; ++i) {
+      faces.vertices[first + i] = vertices[model_.VertexIdToIndex(verts[corners[i]])].position;
+    }
+    outRanges.push_back({first, count});
+  }
+
+  // Neighbouring faces usually sit next to each other in the view too
+  const auto begin = outRanges.begin() + static_cast<std::ptrdiff_t>(firstRange);
+  std::sort(begin, outRanges.end(),
+            [](const ViewRange& a, const ViewRange& b) { return a.first < b.first; });
+  auto last = begin;
+  for (auto it = begin; it != outRanges.end(); ++it) {
+    if (it != begin && it->first <= last->first + last->count) {
+      last->count = std::max(last->count, it->first + it->count - last->first);
+    } else if (it != begin) {
+      *++last = *it;
+    }
+  }
+  if (begin != outRanges.end()) outRanges.erase(last + 1, outRanges.end());
+
+  // Refit rather than grow, so a dragged vertex does not leave its chunk oversized
+  if (!faces.chunkBounds.empty()) {
+    std::size_t refitted = faces.chunkBounds.size();
+    for (auto it = outRanges.begin() + static_cast<std::ptrdiff_t>(firstRange);
+         it != outRanges.end(); ++it) {
+      const std::size_t lastChunk = (it->first + it->count - 1) / FaceView::kChunkVertices;
+      for (std::size_t c = it->first / FaceView::kChunkVertices; c <= lastChunk; ++c) {
+        if (c == refitted || c >= faces.chunkBounds.size()) continue;
+        faces.chunkBounds[c] = ChunkBounds(faces, c);
+        refitted = c;
+      }
+    }
+  }
+  return true;
+}
+
+void ModelViewBuilder::BuildChunks(FaceView& faces) {
+  const std::size_t chunkCount =
+      (faces.vertices.size() + FaceView::kChunkVertices - 1) / FaceView::kChunkVertices;
+  faces.chunkBounds.resize(chunkCount);
+  Jobs::ParallelFor(chunkCount, 16, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t c = begin; c < end; ++c) faces.chunkBounds[c] = ChunkBounds(faces, c);
+  });
+}
+
 void ModelViewBuilder::BuildVolumeView(VolumeView& outVolumes) {
   outVolumes.Clear();
 
   const auto& volumes = model_.Volumes();
-  const auto& faces = model_.Faces();
-  const auto& edges = model_.Edges();
   const auto& vertices = model_.Vertices();
 
   uint32_t volumeIndex = 0;
   for (const auto& vol : volumes) {
     for (FaceId fid : vol.faces) {
-      const Face& f = faces[fid];
-      auto verts = Topology::ExtractVertices(f, edges);
+      const auto verts = model_.FaceLoop(fid);
       if (verts.size() < 3) continue;
 
-      for (size_t i = 1; i + 1 < verts.size(); ++i) {
-        // Add the 3 vertices of the triangle
-        uint32_t idx0 = model_.VertexIdToIndex(verts[0]);
-        uint32_t idx1 = model_.VertexIdToIndex(verts[i]);
-        uint32_t idx2 = model_.VertexIdToIndex(verts[i + 1]);
-
-        outVolumes.vertices.push_back(vertices[idx0].position);
-        outVolumes.vertices.push_back(vertices[idx1].position);
-        outVolumes.vertices.push_back(vertices[idx2].position);
+      const auto corners = triangulations_.Get(model_, fid);
+      for (uint32_t corner : corners) {
+        outVolumes.vertices.push_back(vertices[model_.VertexIdToIndex(verts[corner])].position);
 
-        // Store the Face ID once per vertex (3 times) - use the face ID, not volume index
-        outVolumes.primitiveIds.push_back(fid);
-        outVolumes.primitiveIds.push_back(fid);
+        // Store the Face ID once per vertex - use the face ID, not volume index
         outVolumes.primitiveIds.push_back(fid);
       }
     }
@@ -113,3 +312,33 @@ void ModelViewBuilder::BuildVolumeView(VolumeView& outVolumes) {
 
   outVolumes.primitiveCount = volumeIndex;
 }
+
+void ModelViewBuilder::BuildFaceTriangles(std::size_t firstFace, std::size_t faceCount,
+                                          TriangleChunk& outTriangles) const {
+  outTriangles.Clear();
+
+  const auto& faces = model_.Faces();
+  thread_local std::vector<Vec3> positions;
+  thread_local std::vector<uint32_t> corners;
+
+  const std::size_t lastFace = std::min(faces.size(), firstFace + faceCount);
+  for (std::size_t faceIndex = firstFace; faceIndex < lastFace; ++faceIndex) {
+    FaceId faceId = model_.FaceIndexToId(static_cast<uint32_t>(faceIndex));
+
+    const auto verts = model_.FaceLoop(faceId);
+    if (verts.size() < 3) continue;
+
+    // Same triangulation as BuildFaceView, without touching the (non thread safe) cache
+    positions.clear();
+    for (VertexId vid : verts) positions.push_back(model_.GetVertex(vid).position);
+    corners.clear();
+    Geometry::TriangulatePolygon(positions, model_.FaceNormal(faceId), corners);
+
+    for (std::size_t i = 0; i < corners.size(); i += 3) {
+      outTriangles.vertexIndices.push_back(model_.VertexIdToIndex(verts[corners[i]]));
+      outTriangles.vertexIndices.push_back(model_.VertexIdToIndex(verts[corners[i + 1]]));
+      outTriangles.vertexIndices.push_back(model_.VertexIdToIndex(verts[corners[i + 2]]));
+      outTriangles.faceIds.push_back(faceId);
+    }
+  }
+}
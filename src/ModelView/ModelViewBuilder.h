@@ -1,5 +1,9 @@
 #pragma once
+#include <span>
+#include <vector>
+
 #include "ModelViews.h"
+#include "TriangulationCache.h"
 
 class Model;
 
@@ -8,9 +12,41 @@ class ModelViewBuilder {
   explicit ModelViewBuilder(const Model& model) : model_(model) {}
 
   void BuildLineView(LineView& outLines);
+  // Face and volume views reuse cached triangulations of unchanged faces
   void BuildFaceView(FaceView& outFaces);
   void BuildVolumeView(VolumeView& outVolumes);
 
+  // Rewrite the end points of moved vertices in a view built by BuildLineView, appending
+  // the changed slot runs (merged, in view order) to outRanges. Returns false when the
+  // view no longer fits the model and it must be rebuilt instead.
+  bool PatchLineView(LineView& lines, std::span<const VertexId> moved,
+                     std::vector<ViewRange>& outRanges);
+
+  // Rewrite the vertices of moved faces in a view built by BuildFaceView, appending the
+  // changed runs (merged, in view order) to outRanges and refitting the bounds of the
+  // chunks they touch. Returns false when the view's layout no longer fits the model
+  // and it must be rebuilt instead.
+  bool PatchFaceView(FaceView& faces, std::span<const FaceId> moved,
+                     std::vector<ViewRange>& outRanges);
+
+  // Bounds of every chunk of a finished face view (FaceView::chunkBounds). Run after
+  // anything that lays out the view anew: a build, LOD swaps or a subdivision preview.
+  static void BuildChunks(FaceView& faces);
+
+  // Quantized copy of a face view whose chunk bounds are current
+  static void BuildQuantized(const FaceView& faces, QuantizedFaceView& out);
+  // Requantize the chunks holding changed runs, whose bounds PatchFaceView refitted, and
+  // append the vertex runs of those chunks to outRanges
+  static void PatchQuantized(const FaceView& faces, std::span<const ViewRange> changed,
+                             QuantizedFaceView& out, std::vector<ViewRange>& outRanges);
+
+  // Triangulate faces [firstFace, firstFace + faceCount) in dense order. Read-only, so
+  // disjoint ranges may be built concurrently.
+  void BuildFaceTriangles(std::size_t firstFace, std::size_t faceCount,
+                          TriangleChunk& outTriangles) const;
+
  private:
   const Model& model_;
+  TriangulationCache triangulations_;
+  std::vector<uint32_t> slotScratch_;
 };
\ No newline at end of file
@@ -3,15 +3,27 @@
 #include <vector>
 
 #include "Core/Primitives.h"
+#include "Geometry/Aabb.h"
 
 struct LineView {
   std::vector<VertexId> vertexIndices;
   std::vector<EdgeId> primitiveIds;
   std::size_t primitiveCount;
 
+  // Position of every vertexIndices slot, so two per edge: the per-instance data of the
+  // line quads
+  std::vector<Vec3> endpoints;
+  // Slots each vertex (by dense index) fills, vertexSlots[vertexSlotOffsets[i] ..
+  // vertexSlotOffsets[i + 1]), so moved vertices can be rewritten in place
+  std::vector<uint32_t> vertexSlotOffsets;
+  std::vector<uint32_t> vertexSlots;
+
   void Clear() {
     vertexIndices.clear();
     primitiveIds.clear();
+    endpoints.clear();
+    vertexSlotOffsets.clear();
+    vertexSlots.clear();
     primitiveCount = 0;
   }
 };
@@ -24,20 +36,85 @@ struct FaceView {
   std::vector<uint8_t> metallicity;
   std::size_t primitiveCount;
 
+  // Span of vertices each face expanded into, by FaceId (count 0 when not drawn). Lets
+  // moved faces be rewritten in place; left empty by views that cannot be patched.
+  std::vector<uint32_t> faceFirstVertex;
+  std::vector<uint32_t> faceVertexCount;
+
+  // Bounds of consecutive runs of kChunkVertices vertices (the last one may be shorter),
+  // so whole runs can be culled and the rest drawn as ranges of the same buffer
+  static constexpr std::size_t kChunkVertices = 3 * 1024;
+  std::vector<Geometry::Aabb> chunkBounds;
+
   void Clear() {
     vertices.clear();
     primitiveIds.clear();
     colorIndices.clear();
     roughness.clear();
     metallicity.clear();
+    faceFirstVertex.clear();
+    faceVertexCount.clear();
+    chunkBounds.clear();
     primitiveCount = 0;
   }
 };
 
+// Compact GPU copy of a FaceView: positions as 16 bit unorm within the bounds of their
+// chunk (FaceView::chunkBounds), decoded in the vertex shader, and primitive IDs as 16 bit
+// integers while every ID fits, 32 bit otherwise. 6 + 2 bytes per vertex instead of 12 + 4.
+struct QuantizedFaceView {
+  static constexpr float kSteps = 65535.0f;
+
+  std::vector<uint16_t> positions;  // x, y, z per vertex
+  std::vector<uint16_t> ids16;      // one per vertex, unless ids32 is used
+  std::vector<uint32_t> ids32;
+  // Per chunk, two RGBA texels: box min, then box extent; a vertex decodes as
+  // min + unorm * extent
+  std::vector<float> chunkBoxes;
+  // Largest distance between a decoded position and the view's own: half a step along
+  // each axis of the widest chunk
+  float maxError = 0.0f;
+
+  bool WideIds() const { return !ids32.empty(); }
+  std::size_t Bytes() const {
+    return positions.size() * sizeof(uint16_t) + ids16.size() * sizeof(uint16_t) +
+           ids32.size() * sizeof(uint32_t);
+  }
+
+  void Clear() {
+    positions.clear();
+    ids16.clear();
+    ids32.clear();
+    chunkBoxes.clear();
+    maxError = 0.0f;
+  }
+};
+
+// Run of view vertices [first, first + count) that changed since the last upload
+struct ViewRange {
+  std::size_t first = 0;
+  std::size_t count = 0;
+};
+
 using VolumeView = FaceView;
 
+// Indexed triangles for a contiguous range of faces, referencing dense vertex indices.
+// Used by consumers that stream the triangulation in chunks (e.g. exporters).
+struct TriangleChunk {
+  std::vector<uint32_t> vertexIndices;  // 3 per triangle
+  std::vector<FaceId> faceIds;          // 1 per triangle
+
+  std::size_t TriangleCount() const { return faceIds.size(); }
+
+  void Clear() {
+    vertexIndices.clear();
+    faceIds.clear();
+  }
+};
+
 struct ModelViews {
   FaceView faces;
+  QuantizedFaceView quantizedFaces;  // only kept while the renderer draws quantized
   VolumeView volumes;
   LineView lines;
 };
@@ -0,0 +1,49 @@
+#include "TriangulationCache.h"
+
+#include <bit>
+
+#include "Geometry/Triangulation.h"
+#include "Model/Model.h"
+
+namespace {
+
+// 64-bit FNV-1a over the loop ids and the raw position bits
+uint64_t HashFace(std::span<const VertexId> loop, std::span<const Vec3> positions) {
+  uint64_t hash = 14695981039346656037ull;
+  auto mix = [&hash](uint32_t value) {
+    hash ^= value;
+    hash *= 1099511628211ull;
+  };
+
+  mix(static_cast<uint32_t>(loop.size()));
+  for (std::size_t i = 0; i < loop.size(); ++i) {
+    mix(loop[i]);
+    mix(std::bit_cast<uint32_t>(positions[i].x));
+    mix(std::bit_cast<uint32_t>(positions[i].y));
+    mix(std::bit_cast<uint32_t>(positions[i].z));
+  }
+  return hash;
+}
+
+}  // namespace
+
+std::span<const uint32_t> TriangulationCache::Get(const Model& model, FaceId id) {
+  const auto loop = model.FaceLoop(id);
+  if (loop.size() < 3) return {};
+
+  positions_.clear();
+  for (VertexId vid : loop) positions_.push_back(model.GetVertex(vid).position);
+
+  if (entries_.size() <= id) entries_.resize(id + 1);
+  Entry& entry = entries_[id];
+
+  const uint64_t key = HashFace(loop, positions_);
+  if (entry.valid && entry.key == key) return entry.corners;
+
+  entry.corners.clear();
+  Geometry::TriangulatePolygon(positions_, model.FaceNormal(id), entry.corners);
+  entry.key = key;
+  entry.valid = true;
+  ++rebuilds_;
+  return entry.corners;
+}
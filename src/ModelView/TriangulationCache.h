@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Core/Primitives.h"
+
+class Model;
+
+// Per face triangulations, reused while a face's loop and vertex positions are
+// unchanged. Each entry is keyed on a hash of the loop and positions, so moving a few
+// vertices only re-triangulates the faces around them.
+class TriangulationCache {
+ public:
+  // Corner indices into model.FaceLoop(id), three per triangle
+  std::span<const uint32_t> Get(const Model& model, FaceId id);
+
+  void Clear() { entries_.clear(); }
+
+  // Faces triangulated (rather than reused) since construction
+  std::size_t RebuildCount() const { return rebuilds_; }
+
+ private:
+  struct Entry {
+    uint64_t key = 0;
+    bool valid = false;
+    std::vector<uint32_t> corners;
+  };
+
+  std::vector<Entry> entries_;
+  std::vector<Vec3> positions_;
+  std::size_t rebuilds_ = 0;
+};
@@ -0,0 +1,225 @@
+#include "Occlusion/DepthBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Utilities/JobSystem.h"
+#include "Utilities/Mat4.h"
+#include "Utilities/Simd.h"
+
+namespace Occlusion {
+
+namespace {
+
+// Rows per rasterization job; bands own their rows, so jobs never share pixels
+constexpr uint32_t kBandRows = 16;
+constexpr std::size_t kProjectBatch = 4096;
+
+// Points closer to the eye than this (in clip w) are treated as behind it
+constexpr float kMinW = 1e-3f;
+
+// An occluder must be nearer than a box by this fraction of 1 / w before the box
+// counts as hidden, which absorbs interpolation error where they touch
+constexpr float kDepthBias = 1e-3f;
+
+// E(x, y) = a x + b y + c, non-negative on the inner side of the edge p -> q
+struct Edge {
+  float a, b, c;
+
+  Edge(float px, float py, float qx, float qy)
+      : a(py - qy), b(qx - px), c(-(a * px + b * py)) {}
+};
+
+}  // namespace
+
+void DepthBuffer::Resize(uint32_t width, uint32_t height) {
+  width_ = width;
+  height_ = height;
+  stride_ = (width + 3) & ~3u;
+  depth_.assign(static_cast<std::size_t>(stride_) * height_, 0.0f);
+}
+
+void DepthBuffer::Clear(const Mat4& viewProjection) {
+  std::fill(depth_.begin(), depth_.end(), 0.0f);
+  for (int r = 0; r < 4; ++r) {
+    for (int c = 0; c < 4; ++c) rows_[r][c] = viewProjection.At(r, c);
+  }
+}
+
+bool DepthBuffer::Project(const Vec3& p, ScreenPoint& out) const {
+  float clip[4];
+  for (int r = 0; r < 4; ++r) {
+    clip[r] = rows_[r][0] * p.x + rows_[r][1] * p.y + rows_[r][2] * p.z + rows_[r][3];
+  }
+  if (!(clip[3] > kMinW)) return false;
+
+  const float invW = 1.0f / clip[3];
+  out.x = (clip[0] * invW * 0.5f + 0.5f) * static_cast<float>(width_);
+  out.y = (clip[1] * invW * 0.5f + 0.5f) * static_cast<float>(height_);
+  out.invW = invW;
+  return true;
+}
+
+void DepthBuffer::Rasterize(std::span<const Vec3> corners) {
+  if (depth_.empty()) return;
+  const std::size_t triangleCount = corners.size() / 3;
+  screen_.resize(triangleCount * 3);
+
+  // Triangles reaching behind the eye get a negative 1 / w and are skipped
+  Jobs::ParallelFor(triangleCount, kProjectBatch, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t t = begin; t < end; ++t) {
+      ScreenPoint* tri = screen_.data() + 3 * t;
+      for (int k = 0; k < 3; ++k) {
+        if (!Project(corners[3 * t + k], tri[k])) {
+          tri[0].invW = -1.0f;
+          break;
+        }
+      }
+    }
+  });
+
+  const uint32_t bandCount = (height_ + kBandRows - 1) / kBandRows;
+  Jobs::ParallelFor(bandCount, 1, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t band = begin; band < end; ++band) {
+      const auto firstRow = static_cast<uint32_t>(band) * kBandRows;
+      RasterizeBand(screen_, firstRow, std::min(height_, firstRow + kBandRows));
+    }
+  });
+}
+
+void DepthBuffer::RasterizeBand(std::span<const ScreenPoint> triangles, uint32_t firstRow,
+                                uint32_t endRow) {
+  const float bandTop = static_cast<float>(endRow);
+  const float bandBottom = static_cast<float>(firstRow);
+
+  for (std::size_t t = 0; t + 3 <= triangles.size(); t += 3) {
+    ScreenPoint a = triangles[t];
+    ScreenPoint b = triangles[t + 1];
+    ScreenPoint c = triangles[t + 2];
+    if (a.invW < 0.0f) continue;
+
+    const float minY = std::min({a.y, b.y, c.y});
+    const float maxY = std::max({a.y, b.y, c.y});
+    if (maxY < bandBottom || minY >= bandTop) continue;
+
+    // Counter-clockwise on screen, so inside means all edge functions non-negative
+    float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (area < 0.0f) {
+      std::swap(b, c);
+      area = -area;
+    }
+    if (!(area > 1e-6f)) continue;
+
+    const float minX = std::min({a.x, b.x, c.x});
+    const float maxX = std::max({a.x, b.x, c.x});
+    if (maxX < 0.0f || minX >= static_cast<float>(width_)) continue;
+
+    const Edge e0(b.x, b.y, c.x, c.y);
+    const Edge e1(c.x, c.y, a.x, a.y);
+    const Edge e2(a.x, a.y, b.x, b.y);
+
+    // 1 / w as a plane over the screen
+    const float inverseArea = 1.0f / area;
+    const float za = (e0.a * a.invW + e1.a * b.invW + e2.a * c.invW) * inverseArea;
+    const float zb = (e0.b * a.invW + e1.b * b.invW + e2.b * c.invW) * inverseArea;
+    const float zc = (e0.c * a.invW + e1.c * b.invW + e2.c * c.invW) * inverseArea;
+
+    // Pixel centers sit at half coordinates; columns start on a lane boundary
+    const auto x0 = static_cast<uint32_t>(std::max(0.0f, std::floor(minX))) & ~3u;
+    const auto x1 = static_cast<uint32_t>(std::min(static_cast<float>(width_ - 1), maxX));
+    const auto y0 = std::max(firstRow, static_cast<uint32_t>(std::max(0.0f, std::floor(minY))));
+    const auto y1 = std::min(endRow - 1, static_cast<uint32_t>(std::max(0.0f, maxY)));
+
+    for (uint32_t y = y0; y <= y1; ++y) {
+      const float py = static_cast<float>(y) + 0.5f;
+      const float row0 = e0.b * py + e0.c;
+      const float row1 = e1.b * py + e1.c;
+      const float row2 = e2.b * py + e2.c;
+      const float rowZ = zb * py + zc;
+      float* line = depth_.data() + static_cast<std::size_t>(y) * stride_;
+      uint32_t x = x0;
+
+#ifdef CAD_SSE
+      const __m128 zero = _mm_setzero_ps();
+      const __m128 stepX = _mm_set1_ps(4.0f);
+      __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x0)),
+                             _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+      for (; x <= x1; x += 4, px = _mm_add_ps(px, stepX)) {
+        const __m128 w0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e0.a), px), _mm_set1_ps(row0));
+        const __m128 w1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e1.a), px), _mm_set1_ps(row1));
+        const __m128 w2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e2.a), px), _mm_set1_ps(row2));
+        const __m128 inside =
+            _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_cmpge_ps(w1, zero)),
+                       _mm_cmpge_ps(w2, zero));
+        if (_mm_movemask_ps(inside) == 0) continue;
+
+        const __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(za), px), _mm_set1_ps(rowZ));
+        const __m128 old = _mm_loadu_ps(line + x);
+        const __m128 nearer = _mm_max_ps(old, z);
+        _mm_storeu_ps(line + x,
+                      _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, old)));
+      }
+#endif
+
+      for (; x <= x1; ++x) {
+        const float px = static_cast<float>(x) + 0.5f;
+        if (e0.a * px + row0 < 0.0f || e1.a * px + row1 < 0.0f || e2.a * px + row2 < 0.0f) {
+          continue;
+        }
+        line[x] = std::max(line[x], za * px + rowZ);
+      }
+    }
+  }
+}
+
+bool DepthBuffer::IsOccluded(const Geometry::Aabb& box) const {
+  if (depth_.empty() || box.IsEmpty()) return false;
+
+  float minX = std::numeric_limits<float>::max(), maxX = std::numeric_limits<float>::lowest();
+  float minY = minX, maxY = maxX;
+  float nearest = 0.0f;
+  for (int corner = 0; corner < 8; ++corner) {
+    const Vec3 p{(corner & 1) ? box.max.x : box.min.x, (corner & 2) ? box.max.y : box.min.y,
+                 (corner & 4) ? box.max.z : box.min.z};
+    ScreenPoint s;
+    if (!Project(p, s)) return false;
+    minX = std::min(minX, s.x);
+    maxX = std::max(maxX, s.x);
+    minY = std::min(minY, s.y);
+    maxY = std::max(maxY, s.y);
+    nearest = std::max(nearest, s.invW);
+  }
+
+  // Whatever is off screen cannot be proven hidden
+  const auto width = static_cast<float>(width_);
+  const auto height = static_cast<float>(height_);
+  if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height) return false;
+
+  // One pixel of margin covers occluder edges rasterized at pixel centers
+  const auto x0 = static_cast<uint32_t>(std::max(0.0f, std::floor(minX) - 1.0f));
+  const auto x1 = static_cast<uint32_t>(std::min(width - 1.0f, std::floor(maxX) + 1.0f));
+  const auto y0 = static_cast<uint32_t>(std::max(0.0f, std::floor(minY) - 1.0f));
+  const auto y1 = static_cast<uint32_t>(std::min(height - 1.0f, std::floor(maxY) + 1.0f));
+  const float threshold = nearest * (1.0f + kDepthBias);
+
+  for (uint32_t y = y0; y <= y1; ++y) {
+    const float* line = depth_.data() + static_cast<std::size_t>(y) * stride_;
+    uint32_t x = x0;
+
+#ifdef CAD_SSE
+    // Whole lanes from the aligned column down; extra pixels only make the test stricter
+    const __m128 limit = _mm_set1_ps(threshold);
+    for (x &= ~3u; x <= x1; x += 4) {
+      if (_mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(line + x), limit)) != 0) return false;
+    }
+#endif
+
+    for (; x <= x1; ++x) {
+      if (line[x] <= threshold) return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace Occlusion
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Geometry/Aabb.h"
+#include "Utilities/Vec3.h"
+
+class Mat4;
+
+namespace Occlusion {
+
+// Low resolution software depth buffer for occlusion tests. Occluder triangles are
+// rasterized on the CPU, four pixels at a time with SSE and in bands of rows across
+// the job pool; boxes are then tested against the result. Depth is stored as 1 / w,
+// which interpolates linearly across the screen, with 0 meaning nothing drawn.
+class DepthBuffer {
+ public:
+  void Resize(uint32_t width, uint32_t height);
+  uint32_t Width() const { return width_; }
+  uint32_t Height() const { return height_; }
+
+  // Start a frame: forget all occluders and take the camera for the following calls
+  void Clear(const Mat4& viewProjection);
+
+  // Triangles as consecutive corner triples in world space. Triangles crossing the near
+  // plane are skipped, which only ever loses occlusion.
+  void Rasterize(std::span<const Vec3> corners);
+
+  // True when every pixel the box may cover already holds something clearly nearer
+  // than the box's nearest corner. Boxes reaching behind the eye are never occluded.
+  bool IsOccluded(const Geometry::Aabb& box) const;
+
+  // Stored 1 / w of a pixel, rows counted from the bottom of the view
+  float InverseDepthAt(uint32_t x, uint32_t y) const { return depth_[y * stride_ + x]; }
+
+ private:
+  // Screen space corner: pixels from the bottom left, and 1 / w
+  struct ScreenPoint {
+    float x, y, invW;
+  };
+
+  // Maps a world point to the screen; false when it lies behind the near clip distance
+  bool Project(const Vec3& p, ScreenPoint& out) const;
+  void RasterizeBand(std::span<const ScreenPoint> triangles, uint32_t firstRow, uint32_t endRow);
+
+  uint32_t width_ = 0;
+  uint32_t height_ = 0;
+  uint32_t stride_ = 0;  // width rounded up to whole SSE lanes
+  std::vector<float> depth_;
+  float rows_[4][4] = {};  // view projection, row major
+  std::vector<ScreenPoint> screen_;
+};
+
+}  // namespace Occlusion
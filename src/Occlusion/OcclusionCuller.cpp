@@ -0,0 +1,113 @@
+#include "Occlusion/OcclusionCuller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Geometry/Frustum.h"
+#include "Model/Model.h"
+#include "Utilities/JobSystem.h"
+#include "Utilities/Mat4.h"
+
+namespace Occlusion {
+
+namespace {
+
+// Occluders must span at least this angle (bounding radius over distance); smaller ones
+// rarely hide anything and their triangles are better spent elsewhere
+constexpr float kMinProjectedSize = 0.02f;
+constexpr std::size_t kTestBatch = 256;
+
+}  // namespace
+
+void OcclusionCuller::SetCandidates(const Model& model, const FaceView& view) {
+  candidates_.clear();
+  ranges_.clear();
+  // Views without a face layout (subdivision previews) cannot be mapped to volumes
+  if (view.faceVertexCount.empty()) return;
+
+  for (const Volume& volume : model.Volumes()) {
+    std::size_t vertexCount = 0;
+    for (FaceId id : volume.faces) {
+      if (id < view.faceVertexCount.size()) vertexCount += view.faceVertexCount[id];
+      if (vertexCount > 3 * kMaxOccluderTriangles) break;
+    }
+    // Too detailed, or swapped for a LOD and so missing from the face layout
+    if (vertexCount == 0 || vertexCount > 3 * kMaxOccluderTriangles) continue;
+
+    Candidate candidate;
+    candidate.firstRange = static_cast<uint32_t>(ranges_.size());
+    candidate.triangles = static_cast<uint32_t>(vertexCount / 3);
+    for (FaceId id : volume.faces) {
+      if (id >= view.faceVertexCount.size() || view.faceVertexCount[id] == 0) continue;
+      const ViewRange range{view.faceFirstVertex[id], view.faceVertexCount[id]};
+      for (std::size_t i = range.first; i < range.first + range.count; ++i) {
+        candidate.bounds.Expand(view.vertices[i]);
+      }
+      if (ranges_.size() > candidate.firstRange &&
+          ranges_.back().first + ranges_.back().count == range.first) {
+        ranges_.back().count += range.count;
+      } else {
+        ranges_.push_back(range);
+      }
+    }
+    candidate.rangeCount = static_cast<uint32_t>(ranges_.size()) - candidate.firstRange;
+    candidates_.push_back(candidate);
+  }
+}
+
+void OcclusionCuller::Cull(const FaceView& view, const Mat4& viewProjection, const Vec3& eye,
+                           float aspect, std::span<const Geometry::Aabb> boxes,
+                           std::span<uint8_t> visible) {
+  stats_ = {};
+  stats_.tested = static_cast<std::size_t>(std::count(visible.begin(), visible.end(), 1));
+  if (candidates_.empty() || stats_.tested == 0) return;
+
+  // Largest on screen first
+  const auto frustum = Geometry::Frustum::FromViewProjection(viewProjection);
+  ranked_.clear();
+  for (uint32_t i = 0; i < candidates_.size(); ++i) {
+    const Geometry::Aabb& bounds = candidates_[i].bounds;
+    if (!frustum.Intersects(bounds)) continue;
+    const float radius = bounds.Extent().Length() * 0.5f;
+    const float distance = (bounds.Center() - eye).Length();
+    // With the eye inside, most of its triangles would cross the near plane anyway
+    if (distance <= radius) continue;
+    const float size = radius / distance;
+    if (size >= kMinProjectedSize) ranked_.push_back({size, i});
+  }
+  std::sort(ranked_.begin(), ranked_.end(),
+            [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  corners_.clear();
+  for (const auto& [size, index] : ranked_) {
+    const Candidate& candidate = candidates_[index];
+    // A smaller occluder further down may still fit
+    if (stats_.occluderTriangles + candidate.triangles > kTriangleBudget) continue;
+    for (uint32_t r = candidate.firstRange; r < candidate.firstRange + candidate.rangeCount;
+         ++r) {
+      const Vec3* first = view.vertices.data() + ranges_[r].first;
+      corners_.insert(corners_.end(), first, first + ranges_[r].count);
+    }
+    ++stats_.occluders;
+    stats_.occluderTriangles += candidate.triangles;
+  }
+  if (corners_.empty()) return;
+
+  const float rows = aspect > 0.0f ? static_cast<float>(kBufferWidth) / aspect : kBufferWidth;
+  const auto height = static_cast<uint32_t>(std::clamp(rows, 1.0f, 4.0f * kBufferWidth));
+  if (depth_.Width() != kBufferWidth || depth_.Height() != height) {
+    depth_.Resize(kBufferWidth, height);
+  }
+  depth_.Clear(viewProjection);
+  depth_.Rasterize(corners_);
+
+  Jobs::ParallelFor(boxes.size(), kTestBatch, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      if (visible[i] && depth_.IsOccluded(boxes[i])) visible[i] = 0;
+    }
+  });
+  stats_.occluded =
+      stats_.tested - static_cast<std::size_t>(std::count(visible.begin(), visible.end(), 1));
+}
+
+}  // namespace Occlusion
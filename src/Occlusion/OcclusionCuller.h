@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "Geometry/Aabb.h"
+#include "ModelView/ModelViews.h"
+#include "Occlusion/DepthBuffer.h"
+
+class Mat4;
+class Model;
+
+namespace Occlusion {
+
+// Counts from the last Cull call
+struct Stats {
+  std::size_t occluders = 0;          // volumes rasterized into the depth buffer
+  std::size_t occluderTriangles = 0;
+  std::size_t tested = 0;             // boxes still visible after frustum culling
+  std::size_t occluded = 0;           // of those, boxes found hidden
+};
+
+// Hides boxes behind the largest nearby volumes. Volumes with few triangles make the
+// candidates (big simple parts such as walls and housings are the useful occluders);
+// each frame the ones covering most of the view are drawn into a small DepthBuffer,
+// within a triangle budget, and every box still marked visible is tested against it.
+class OcclusionCuller {
+ public:
+  // Volumes above this many triangles are never used as occluders
+  static constexpr std::size_t kMaxOccluderTriangles = 2048;
+  // Triangles rasterized per frame, over all occluders
+  static constexpr std::size_t kTriangleBudget = 32 * 1024;
+  static constexpr uint32_t kBufferWidth = 256;
+
+  // Find the candidate volumes of a face view laid out by ModelViewBuilder; call again
+  // whenever the view's vertices or layout change
+  void SetCandidates(const Model& model, const FaceView& view);
+
+  // Clear the flags of boxes hidden behind the chosen occluders. aspect is the view's
+  // width over height and sizes the depth buffer.
+  void Cull(const FaceView& view, const Mat4& viewProjection, const Vec3& eye, float aspect,
+            std::span<const Geometry::Aabb> boxes, std::span<uint8_t> visible);
+
+  const Stats& GetStats() const { return stats_; }
+  const DepthBuffer& GetDepthBuffer() const { return depth_; }
+
+ private:
+  struct Candidate {
+    Geometry::Aabb bounds;
+    uint32_t firstRange = 0;  // into ranges_
+    uint32_t rangeCount = 0;
+    uint32_t triangles = 0;
+  };
+
+  std::vector<Candidate> candidates_;
+  std::vector<ViewRange> ranges_;  // view vertices of each candidate, merged
+
+  DepthBuffer depth_;
+  Stats stats_;
+  std::vector<std::pair<float, uint32_t>> ranked_;  // projected size, candidate
+  std::vector<Vec3> corners_;                       // triangles of the chosen occluders
+};
+
+}  // namespace Occlusion
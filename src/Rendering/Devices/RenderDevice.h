@@ -8,6 +8,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "App/Input.h"
 #include "Rendering/Devices/GpuHandle.h"
 #include "Rendering/FrameContext.h"
 #include "Rendering/PrimitiveTopology.h"
@@ -27,7 +28,6 @@ class IndexBuffer;
 class Mat4;
 struct VertexAttribute;
 class Vec3;
-class Input;
 
 class RenderDevice {
  public:
@@ -52,11 +52,16 @@ class RenderDevice {
 
   // ----- Buffer updates -----
   void UpdateVertexBuffer(GpuHandle handle, size_t bytes, const void* data);
+  // Overwrite part of a buffer previously sized with UpdateVertexBuffer
+  void UpdateVertexBufferRange(GpuHandle handle, size_t offset, size_t bytes, const void* data);
   void UpdateUniformBuffer(GpuHandle handle, size_t bytes, const void* data, uint32_t position);
   void UpdateIndexBuffer(GpuHandle handle, std::span<const uint32_t> indices);
   void UpdateTexture1D(GpuHandle textureHandle, std::span<const uint32_t> data);
   void UpdateTexture2D(GpuHandle textureHandle, uint32_t width, uint32_t height,
                        std::span<const uint8_t> data);
+  // Rows of RGBA floats into a texture from CreateFloatTexture2D
+  void UpdateFloatTexture2D(GpuHandle textureHandle, uint32_t width, uint32_t height,
+                            std::span<const float> rgba);
 
   // ----- Binding -----
   void BindPipeline(GpuHandle handle);
@@ -82,13 +87,25 @@ class RenderDevice {
   // ----- Draw -----
   void DrawIndexed(PrimitiveTopology topology, std::size_t indexCount);
   void Draw(PrimitiveTopology topology, std::size_t vertexCount);
+  // The bound index buffer's mesh once per instance; attributes with a divisor step per
+  // instance
+  void DrawIndexedInstanced(PrimitiveTopology topology, std::size_t indexCount,
+                            std::size_t instanceCount);
+  // Vertices [firstVertex, firstVertex + vertexCount) of the bound buffers
+  void DrawRange(PrimitiveTopology topology, std::size_t firstVertex, std::size_t vertexCount);
 
   // ----- Viewport -----
   void SetViewport(int x, int y, int width, int height);
 
+  // ----- Scissor -----
+  // Limit drawing and clears to a rectangle until DisableScissor
+  void SetScissor(int x, int y, int width, int height);
+  void DisableScissor();
+
   // ----- Clear -----
   void SetClearColor(float r, float g, float b, float a);
   void Clear();
+  void ClearDepth();  // Leaves the color as it is
 
   // ----- Blending -----
   void EnableBlending();
@@ -96,6 +113,9 @@ class RenderDevice {
 
   // ----- Frame control -----
   void BeginFrame();
+  // Copy a framebuffer's color to the window, stretched from src to dst size
+  void BlitToScreen(GpuHandle frameBuffer, int srcWidth, int srcHeight, int dstWidth,
+                    int dstHeight);
   void EndFrame();
 
   // ----- Window management -----
@@ -105,7 +125,9 @@ class RenderDevice {
 
   // ----- Input capture -----
   void CaptureFrameContext(FrameContext& context);
-  void CaptureInput(Input& input);
+  // Key, button, motion and scroll events as the window reports them, for InputHandler.
+  // GLFW calls back inside PollEvents, which is the only producer.
+  InputEventQueue& GetInputEvents() { return inputEvents_; }
 
   // ----- Framebuffer dimensions -----
   int GetFramebufferWidth() const { return fbWidth_; }
@@ -116,7 +138,11 @@ class RenderDevice {
   void InitializePlatform();
 
   // Input handling
+  static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+  static void MouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+  static void CursorPositionCallback(GLFWwindow* window, double x, double y);
   static void MouseScrollCallback(GLFWwindow* window, double xoffset, double yoffset);
+  void PushInputEvent(InputEvent event);
   static void FramebufferSizeCallback(GLFWwindow* window, int width, int height);
 
   // Common state
@@ -128,7 +154,7 @@ class RenderDevice {
   GLuint currentShader_ = 0;
 
   // Input state
-  float scrollAccumulator_ = 0.0f;
+  InputEventQueue inputEvents_;
   bool framebufferResized_ = false;
 
   // Utility functions
@@ -1,6 +1,8 @@
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <iostream>
+#include <optional>
 #include <vector>
 
 #include "RenderDevice.h"
@@ -11,6 +13,64 @@
 
 // Constructor, destructor, and InitializePlatform are in platform-specific files
 
+namespace {
+
+std::optional<KEYS> ToKey(int glfwKey) {
+  switch (glfwKey) {
+    case GLFW_KEY_LEFT_SHIFT:
+    case GLFW_KEY_RIGHT_SHIFT:
+      return KEYS::SHIFT;
+    case GLFW_KEY_LEFT_CONTROL:
+    case GLFW_KEY_RIGHT_CONTROL:
+#ifdef __APPLE__
+    // CMD as CTRL on Mac for consistency
+    case GLFW_KEY_LEFT_SUPER:
+    case GLFW_KEY_RIGHT_SUPER:
+#endif
+      return KEYS::CTRL;
+    case GLFW_KEY_LEFT_ALT:
+    case GLFW_KEY_RIGHT_ALT:
+      return KEYS::ALT;
+    case GLFW_KEY_Z:
+      return KEYS::Z;
+    case GLFW_KEY_Y:
+      return KEYS::Y;
+    case GLFW_KEY_UP:
+      return KEYS::UP;
+    case GLFW_KEY_DOWN:
+      return KEYS::DOWN;
+    case GLFW_KEY_LEFT:
+      return KEYS::LEFT;
+    case GLFW_KEY_RIGHT:
+      return KEYS::RIGHT;
+    case GLFW_KEY_SPACE:
+      return KEYS::SPACE;
+    case GLFW_KEY_ESCAPE:
+      return KEYS::ESCAPE;
+    default:
+      return std::nullopt;
+  }
+}
+
+// Modifiers stay down while either of their keys is, so releasing left shift with right
+// shift held reports nothing. GLFW updates its key state before calling back.
+bool IsModifierDown(GLFWwindow* window, KEYS key) {
+  const auto down = [window](int glfwKey) { return glfwGetKey(window, glfwKey) == GLFW_PRESS; };
+  switch (key) {
+    case KEYS::SHIFT:
+      return down(GLFW_KEY_LEFT_SHIFT) || down(GLFW_KEY_RIGHT_SHIFT);
+    case KEYS::CTRL:
+#ifdef __APPLE__
+      if (down(GLFW_KEY_LEFT_SUPER) || down(GLFW_KEY_RIGHT_SUPER)) return true;
+#endif
+      return down(GLFW_KEY_LEFT_CONTROL) || down(GLFW_KEY_RIGHT_CONTROL);
+    default:
+      return down(GLFW_KEY_LEFT_ALT) || down(GLFW_KEY_RIGHT_ALT);
+  }
+}
+
+}  // namespace
+
 GpuHandle RenderDevice::CreatePipeline() {
   GLuint vao;
   glGenVertexArrays(1, &vao);
@@ -156,6 +216,13 @@ void RenderDevice::UpdateVertexBuffer(GpuHandle handle, const size_t bytes, cons
   glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
+void RenderDevice::UpdateVertexBufferRange(GpuHandle handle, const size_t offset,
+                                           const size_t bytes, const void* data) {
+  glBindBuffer(GL_ARRAY_BUFFER, handle);
+  glBufferSubData(GL_ARRAY_BUFFER, offset, bytes, data);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
 void RenderDevice::UpdateUniformBuffer(GpuHandle handle, const size_t bytes, const void* data,
                                        const uint32_t position) {
   glBindBuffer(GL_UNIFORM_BUFFER, handle);
@@ -193,6 +260,12 @@ void RenderDevice::UpdateTexture2D(GpuHandle textureHandle, uint32_t width, uint
   // Don't unbind - texture should remain bound to its texture unit
 }
 
+void RenderDevice::UpdateFloatTexture2D(GpuHandle textureHandle, uint32_t width,
+                                        uint32_t height, std::span<const float> rgba) {
+  glBindTexture(GL_TEXTURE_2D, textureHandle);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_FLOAT, rgba.data());
+}
+
 void RenderDevice::BindPipeline(GpuHandle handle) { glBindVertexArray(handle); }
 
 void RenderDevice::BindVertexBuffer(GpuHandle handle) { glBindBuffer(GL_ARRAY_BUFFER, handle); }
@@ -201,18 +274,37 @@ void RenderDevice::SetVertexAttributes(GpuHandle handle,
                                        const std::span<VertexAttribute>& attributes) {
   BindVertexBuffer(handle);
 
+  const auto componentBytes = [](AttributeType type) -> unsigned int {
+    return type == AttributeType::Float || type == AttributeType::UInt32 ? 4 : 2;
+  };
   unsigned int stride = 0;
   for (const VertexAttribute& attribute : attributes) {
-    stride += attribute.size;
+    stride += attribute.size * componentBytes(attribute.type);
   }
 
-  stride *= sizeof(float);
-
   for (const VertexAttribute& attribute : attributes) {
+    const auto* offset = reinterpret_cast<void*>(attribute.offset);
     glEnableVertexAttribArray(attribute.location);
-    glVertexAttribPointer(attribute.location,
-                          attribute.size,  // 3 for Vec3
-                          GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(attribute.offset));
+    switch (attribute.type) {
+      case AttributeType::Float:
+        glVertexAttribPointer(attribute.location,
+                              attribute.size,  // 3 for Vec3
+                              GL_FLOAT, GL_FALSE, stride, offset);
+        break;
+      case AttributeType::UNorm16:
+        glVertexAttribPointer(attribute.location, attribute.size, GL_UNSIGNED_SHORT, GL_TRUE,
+                              stride, offset);
+        break;
+      case AttributeType::UInt16:
+        glVertexAttribIPointer(attribute.location, attribute.size, GL_UNSIGNED_SHORT, stride,
+                               offset);
+        break;
+      case AttributeType::UInt32:
+        glVertexAttribIPointer(attribute.location, attribute.size, GL_UNSIGNED_INT, stride,
+                               offset);
+        break;
+    }
+    glVertexAttribDivisor(attribute.location, attribute.divisor);
 
     GLenum error = glGetError();
     if (error != GL_NO_ERROR) {
@@ -310,14 +402,6 @@ void RenderDevice::DrawIndexed(PrimitiveTopology topology, std::size_t indexCoun
 
   GLenum mode = TopologyToGLenum(topology);
 
-#ifdef __EMSCRIPTEN__
-  // WebGL doesn't support geometry shaders, so use glLineWidth for line thickness
-  // Note: Most WebGL implementations only support line width of 1
-  if (topology == PrimitiveTopology::Lines) {
-    glLineWidth(2.0f);  // WebGL typically only supports lineWidth = 1
-  }
-#endif
-
   glDrawElements(mode, static_cast<GLsizei>(indexCount), GL_UNSIGNED_INT, nullptr);
 
   GLenum error = glGetError();
@@ -347,14 +431,37 @@ void RenderDevice::Draw(PrimitiveTopology topology, std::size_t vertexCount) {
   }
 }
 
+void RenderDevice::DrawIndexedInstanced(PrimitiveTopology topology, std::size_t indexCount,
+                                        std::size_t instanceCount) {
+  if (instanceCount == 0) return;
+  glDrawElementsInstanced(TopologyToGLenum(topology), static_cast<GLsizei>(indexCount),
+                          GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(instanceCount));
+}
+
+void RenderDevice::DrawRange(PrimitiveTopology topology, std::size_t firstVertex,
+                             std::size_t vertexCount) {
+  // Called once per visible range, so without the state queries Draw makes
+  glDrawArrays(TopologyToGLenum(topology), static_cast<GLint>(firstVertex),
+               static_cast<GLsizei>(vertexCount));
+}
+
 void RenderDevice::SetViewport(int x, int y, int width, int height) {
   glViewport(x, y, width, height);
 }
 
+void RenderDevice::SetScissor(int x, int y, int width, int height) {
+  glEnable(GL_SCISSOR_TEST);
+  glScissor(x, y, width, height);
+}
+
+void RenderDevice::DisableScissor() { glDisable(GL_SCISSOR_TEST); }
+
 void RenderDevice::SetClearColor(float r, float g, float b, float a) { glClearColor(r, g, b, a); }
 
 void RenderDevice::Clear() { glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); }
 
+void RenderDevice::ClearDepth() { glClear(GL_DEPTH_BUFFER_BIT); }
+
 void RenderDevice::EnableBlending() {
   glEnable(GL_BLEND);
   glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -367,6 +474,16 @@ void RenderDevice::BeginFrame() {
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+void RenderDevice::BlitToScreen(GpuHandle frameBuffer, int srcWidth, int srcHeight, int dstWidth,
+                                int dstHeight) {
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, frameBuffer);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+  const GLenum filter = (srcWidth == dstWidth && srcHeight == dstHeight) ? GL_NEAREST : GL_LINEAR;
+  glBlitFramebuffer(0, 0, srcWidth, srcHeight, 0, 0, dstWidth, dstHeight, GL_COLOR_BUFFER_BIT,
+                    filter);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
 GLuint RenderDevice::CompileShader(GLenum type, const std::string& source) {
   GLuint shader = glCreateShader(type);
   const char* sourcePtr = source.c_str();
@@ -536,3 +653,70 @@ std::string RenderDevice::GetErrorString(GLenum error) const {
 GLint RenderDevice::GetUniformLocation(const std::string& name) {
   return glGetUniformLocation(currentShader_, name.c_str());
 }
+
+// ----- Input events -----
+
+void RenderDevice::PushInputEvent(InputEvent event) {
+  event.time = std::chrono::steady_clock::now();
+  // A full queue means nobody drained it for about a thousand events; drop the newest
+  inputEvents_.TryPush(event);
+}
+
+void RenderDevice::KeyCallback(GLFWwindow* window, int key, int /*scancode*/, int action,
+                               int /*mods*/) {
+  auto* device = static_cast<RenderDevice*>(glfwGetWindowUserPointer(window));
+  const std::optional<KEYS> mapped = ToKey(key);
+  if (!device || !mapped || action == GLFW_REPEAT) return;
+
+  bool down = action == GLFW_PRESS;
+  if (*mapped == KEYS::SHIFT || *mapped == KEYS::CTRL || *mapped == KEYS::ALT) {
+    down = IsModifierDown(window, *mapped);
+  }
+  InputEvent event;
+  event.type = down ? InputEvent::Type::KeyDown : InputEvent::Type::KeyUp;
+  event.key = *mapped;
+  device->PushInputEvent(event);
+}
+
+void RenderDevice::MouseButtonCallback(GLFWwindow* window, int button, int action, int /*mods*/) {
+  auto* device = static_cast<RenderDevice*>(glfwGetWindowUserPointer(window));
+  if (!device) return;
+
+  InputEvent event;
+  switch (button) {
+    case GLFW_MOUSE_BUTTON_LEFT:
+      event.key = KEYS::MOUSE_LEFT;
+      break;
+    case GLFW_MOUSE_BUTTON_MIDDLE:
+      event.key = KEYS::MOUSE_MIDDLE;
+      break;
+    case GLFW_MOUSE_BUTTON_RIGHT:
+      event.key = KEYS::MOUSE_RIGHT;
+      break;
+    default:
+      return;
+  }
+  event.type = action == GLFW_PRESS ? InputEvent::Type::KeyDown : InputEvent::Type::KeyUp;
+  device->PushInputEvent(event);
+}
+
+void RenderDevice::CursorPositionCallback(GLFWwindow* window, double x, double y) {
+  auto* device = static_cast<RenderDevice*>(glfwGetWindowUserPointer(window));
+  if (!device) return;
+
+  InputEvent event;
+  event.type = InputEvent::Type::Motion;
+  event.x = static_cast<float>(x);
+  event.y = static_cast<float>(y);
+  device->PushInputEvent(event);
+}
+
+void RenderDevice::MouseScrollCallback(GLFWwindow* window, double /*xoffset*/, double yoffset) {
+  auto* device = static_cast<RenderDevice*>(glfwGetWindowUserPointer(window));
+  if (!device) return;
+
+  InputEvent event;
+  event.type = InputEvent::Type::Scroll;
+  event.y = static_cast<float>(yoffset);
+  device->PushInputEvent(event);
+}
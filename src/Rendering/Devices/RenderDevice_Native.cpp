@@ -1,10 +1,8 @@
 #ifndef __EMSCRIPTEN__
 
 #include <iostream>
-#include <set>
 #include <stdexcept>
 
-#include "App/Input.h"
 #include "RenderDevice.h"
 #include "Rendering/FrameContext.h"
 
@@ -64,6 +62,9 @@ void RenderDevice::InitializePlatform() {
 
   // Set up input callbacks
   glfwSetWindowUserPointer(window_, this);
+  glfwSetKeyCallback(window_, KeyCallback);
+  glfwSetMouseButtonCallback(window_, MouseButtonCallback);
+  glfwSetCursorPosCallback(window_, CursorPositionCallback);
   glfwSetScrollCallback(window_, MouseScrollCallback);
   glfwSetFramebufferSizeCallback(window_, FramebufferSizeCallback);
 
@@ -86,13 +87,6 @@ void RenderDevice::PollEvents() { glfwPollEvents(); }
 
 // ----- Input handling -----
 
-void RenderDevice::MouseScrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
-  auto* device = static_cast<RenderDevice*>(glfwGetWindowUserPointer(window));
-  if (device) {
-    device->scrollAccumulator_ += static_cast<float>(yoffset);
-  }
-}
-
 void RenderDevice::FramebufferSizeCallback(GLFWwindow* window, int width, int height) {
   auto* device = static_cast<RenderDevice*>(glfwGetWindowUserPointer(window));
   if (device) {
@@ -112,83 +106,4 @@ void RenderDevice::CaptureFrameContext(FrameContext& context) {
   }
 }
 
-void RenderDevice::CaptureInput(Input& input) {
-  // Collect current key states
-  std::set<KEYS> keysCurrentlyDown;
-
-  // Mouse buttons
-  if (glfwGetMouseButton(window_, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::MOUSE_LEFT);
-  }
-  if (glfwGetMouseButton(window_, GLFW_MOUSE_BUTTON_MIDDLE) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::MOUSE_MIDDLE);
-  }
-  if (glfwGetMouseButton(window_, GLFW_MOUSE_BUTTON_RIGHT) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::MOUSE_RIGHT);
-  }
-
-  // Keyboard modifiers
-  if (glfwGetKey(window_, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
-      glfwGetKey(window_, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::SHIFT);
-  }
-  if (glfwGetKey(window_, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS ||
-      glfwGetKey(window_, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::CTRL);
-  }
-  if (glfwGetKey(window_, GLFW_KEY_LEFT_ALT) == GLFW_PRESS ||
-      glfwGetKey(window_, GLFW_KEY_RIGHT_ALT) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::ALT);
-  }
-
-  // Keyboard keys
-  if (glfwGetKey(window_, GLFW_KEY_Z) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::Z);
-  }
-  if (glfwGetKey(window_, GLFW_KEY_Y) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::Y);
-  }
-  if (glfwGetKey(window_, GLFW_KEY_UP) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::UP);
-  }
-  if (glfwGetKey(window_, GLFW_KEY_DOWN) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::DOWN);
-  }
-  if (glfwGetKey(window_, GLFW_KEY_LEFT) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::LEFT);
-  }
-  if (glfwGetKey(window_, GLFW_KEY_RIGHT) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::RIGHT);
-  }
-  if (glfwGetKey(window_, GLFW_KEY_SPACE) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::SPACE);
-  }
-  if (glfwGetKey(window_, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::ESCAPE);
-  }
-
-#ifdef __APPLE__
-  // Add CMD key as CTRL equivalent on Mac for consistency
-  if (glfwGetKey(window_, GLFW_KEY_LEFT_SUPER) == GLFW_PRESS ||
-      glfwGetKey(window_, GLFW_KEY_RIGHT_SUPER) == GLFW_PRESS) {
-    keysCurrentlyDown.insert(KEYS::CTRL);
-  }
-#endif
-
-  // Collect mouse state
-  double mouseX, mouseY;
-  glfwGetCursorPos(window_, &mouseX, &mouseY);
-
-  MouseState mouseState;
-  mouseState.x = static_cast<float>(mouseX);
-  mouseState.y = static_cast<float>(mouseY);
-  mouseState.scrollDelta = scrollAccumulator_;
-
-  // Reset scroll accumulator after capturing
-  scrollAccumulator_ = 0.0f;
-
-  // Update the Input object with collected state
-  input.Update(keysCurrentlyDown, mouseState);
-}
-
 #endif  // __EMSCRIPTEN__
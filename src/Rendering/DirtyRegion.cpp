@@ -0,0 +1,77 @@
+#include "Rendering/DirtyRegion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Utilities/Mat4.h"
+
+namespace {
+
+// Corners closer to the eye than this (in clip w) cannot be projected
+constexpr float kMinW = 1e-3f;
+
+}  // namespace
+
+void DirtyRegion::Reset(int width, int height) {
+  width_ = width;
+  height_ = height;
+  bounds_ = {};
+}
+
+void DirtyRegion::AddBox(const Geometry::Aabb& box, const Mat4& viewProjection) {
+  if (box.IsEmpty()) return;
+
+  float minX = std::numeric_limits<float>::max(), maxX = std::numeric_limits<float>::lowest();
+  float minY = minX, maxY = maxX;
+  for (int corner = 0; corner < 8; ++corner) {
+    const Vec3 p{(corner & 1) ? box.max.x : box.min.x, (corner & 2) ? box.max.y : box.min.y,
+                 (corner & 4) ? box.max.z : box.min.z};
+    float clip[4];
+    for (int r = 0; r < 4; ++r) {
+      clip[r] = viewProjection.At(r, 0) * p.x + viewProjection.At(r, 1) * p.y +
+                viewProjection.At(r, 2) * p.z + viewProjection.At(r, 3);
+    }
+    if (!(clip[3] > kMinW)) {
+      AddAll();
+      return;
+    }
+    const float x = (clip[0] / clip[3] * 0.5f + 0.5f) * static_cast<float>(width_);
+    const float y = (clip[1] / clip[3] * 0.5f + 0.5f) * static_cast<float>(height_);
+    minX = std::min(minX, x);
+    maxX = std::max(maxX, x);
+    minY = std::min(minY, y);
+    maxY = std::max(maxY, y);
+  }
+
+  const auto width = static_cast<float>(width_);
+  const auto height = static_cast<float>(height_);
+  if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height) return;
+  Add(static_cast<int>(std::max(0.0f, std::floor(minX))) - kMargin,
+      static_cast<int>(std::max(0.0f, std::floor(minY))) - kMargin,
+      static_cast<int>(std::min(width, std::floor(maxX))) + kMargin,
+      static_cast<int>(std::min(height, std::floor(maxY))) + kMargin);
+}
+
+void DirtyRegion::AddAll() { Add(0, 0, width_ - 1, height_ - 1); }
+
+bool DirtyRegion::IsFull() const {
+  return bounds_.x == 0 && bounds_.y == 0 && bounds_.width == width_ &&
+         bounds_.height == height_;
+}
+
+void DirtyRegion::Add(int x0, int y0, int x1, int y1) {
+  x0 = std::max(x0, 0);
+  y0 = std::max(y0, 0);
+  x1 = std::min(x1, width_ - 1);
+  y1 = std::min(y1, height_ - 1);
+  if (x1 < x0 || y1 < y0) return;
+
+  if (!bounds_.IsEmpty()) {
+    x0 = std::min(x0, bounds_.x);
+    y0 = std::min(y0, bounds_.y);
+    x1 = std::max(x1, bounds_.x + bounds_.width - 1);
+    y1 = std::max(y1, bounds_.y + bounds_.height - 1);
+  }
+  bounds_ = {x0, y0, x1 - x0 + 1, y1 - y0 + 1};
+}
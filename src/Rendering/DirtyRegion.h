@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Geometry/Aabb.h"
+
+class Mat4;
+
+// Pixel rectangle with its origin at the bottom left, like GL viewports
+struct ScreenRect {
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+
+  bool IsEmpty() const { return width <= 0 || height <= 0; }
+};
+
+// Part of the screen that must be redrawn, grown by the projected bounds of whatever
+// changed. A box that cannot be bounded on screen (one reaching behind the eye) makes
+// the whole screen dirty; boxes entirely off screen add nothing.
+class DirtyRegion {
+ public:
+  // Pixels added around each box, for edges rasterized just outside it
+  static constexpr int kMargin = 2;
+
+  // Start clean, for a screen of this size
+  void Reset(int width, int height);
+
+  void AddBox(const Geometry::Aabb& box, const Mat4& viewProjection);
+  void AddAll();
+
+  bool IsEmpty() const { return bounds_.IsEmpty(); }
+  bool IsFull() const;
+  const ScreenRect& Bounds() const { return bounds_; }
+
+ private:
+  void Add(int x0, int y0, int x1, int y1);  // inclusive pixel bounds
+
+  int width_ = 0;
+  int height_ = 0;
+  ScreenRect bounds_;
+};
@@ -1,11 +1,9 @@
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in float aPrimitiveId;
-
+// Inputs and facePosition() / facePrimitiveId() come from the face vertex format
 flat out uint vPrimitiveId;
 
 void main() {
-    gl_Position = projectionMatrix * viewMatrix * vec4(aPos, 1.0);
+    gl_Position = projectionMatrix * viewMatrix * vec4(facePosition(), 1.0);
     
     // Pass through the primitive ID from vertex attribute
-    vPrimitiveId = uint(aPrimitiveId);
+    vPrimitiveId = facePrimitiveId();
 }
\ No newline at end of file
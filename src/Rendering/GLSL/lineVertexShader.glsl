@@ -0,0 +1,29 @@
+// One screen-space quad per edge, instanced over a 4 vertex template
+layout (location = 0) in vec2 aCorner;  // x: 0 at the start, 1 at the end; y: side, -1 or 1
+layout (location = 1) in vec3 aStart;   // per edge
+layout (location = 2) in vec3 aEnd;
+#ifdef LINE_COLOR
+layout (location = 3) in vec4 aColor;   // per edge, preview overlay only
+out vec4 vColor;
+#endif
+
+void main() {
+    mat4 viewProjection = projectionMatrix * viewMatrix;
+    vec4 p0 = viewProjection * vec4(aStart, 1.0);
+    vec4 p1 = viewProjection * vec4(aEnd, 1.0);
+
+    // Line direction in NDC; degenerate edges still get a square
+    vec2 delta = p1.xy / p1.w - p0.xy / p0.w;
+    vec2 dir = dot(delta, delta) > 0.0 ? normalize(delta) : vec2(1.0, 0.0);
+    vec2 normal = vec2(-dir.y, dir.x);
+
+    // Convert thickness from pixels to NDC
+    vec2 pixelToNDC = vec2(2.0) / viewPortSize;
+    vec2 offset = normal * lineThickness * 0.5 * pixelToNDC * aCorner.y;
+
+#ifdef LINE_COLOR
+    vColor = aColor;
+#endif
+    vec4 p = aCorner.x < 0.5 ? p0 : p1;
+    gl_Position = vec4(p.xy + offset * p.w, p.z, p.w);
+}
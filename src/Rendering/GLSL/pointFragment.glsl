@@ -1,6 +1,6 @@
-in vec4 gColor;
+in vec4 vColor;
 out vec4 FragColor;
 
 void main() {
-    FragColor = gColor;
+    FragColor = vColor;
 }
@@ -1,8 +1,24 @@
-layout (location = 0) in vec3 aPos;
+// Axis cross at every vertex, instanced over a template of 3 axes x 2 quads. Each quad
+// is a thin strip along its axis, widened towards the camera; the second one is turned
+// a quarter so the axis stays visible edge on.
+layout (location = 0) in vec4 aCorner;  // along (-1, 1), side (-1, 1), axis, quad
+layout (location = 1) in vec3 aCenter;  // per vertex
 
-out vec3 worldPos;
+out vec4 vColor;
 
 void main() {
-    worldPos = aPos;
-    gl_Position = projectionMatrix * viewMatrix * vec4(aPos, 1.0);
+    int axisIndex = int(aCorner.z);
+    vec3 lineDir = vec3(axisIndex == 0, axisIndex == 1, axisIndex == 2);
+    vColor = vec4(lineDir, 1.0);
+
+    // Camera forward in world space, from the rotation rows of the view matrix
+    vec3 viewDir = -vec3(viewMatrix[0][2], viewMatrix[1][2], viewMatrix[2][2]);
+    vec3 right = cross(lineDir, viewDir);
+    right = dot(right, right) > 0.0 ? normalize(right) : cross(lineDir, vec3(lineDir.yzx));
+    vec3 up = normalize(cross(lineDir, right));
+    vec3 side = aCorner.w < 0.5 ? right : up;
+
+    float halfThickness = axisLength * 0.05;  // Proportional to axis length
+    vec3 position = aCenter + lineDir * axisLength * aCorner.x + side * halfThickness * aCorner.y;
+    gl_Position = projectionMatrix * viewMatrix * vec4(position, 1.0);
 }
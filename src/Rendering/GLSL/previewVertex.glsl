@@ -0,0 +1,10 @@
+// Preview overlay triangles, already in world space
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aColor;
+
+out vec4 vColor;
+
+void main() {
+    vColor = aColor;
+    gl_Position = projectionMatrix * viewMatrix * vec4(aPos, 1.0);
+}
@@ -85,14 +85,71 @@ vec3 skyColor(float rayY) {
     }
 }
 
-// Get the fully composited pixel color at a given position
-vec4 getCompositeColor(vec2 position) {
-    vec4 t2 = texture(tex2, position);
+// Composite the layers of one rendered texel over the background
+vec4 compositeLayers(ivec2 texel, vec4 backgroundColor, float groundDepth) {
+    vec4 t2 = texelFetch(tex2, texel, 0);
     uint faceId = decodeId(t2.r, t2.g);
     t2 = faceId != 0u ? idToColor(faceId) : vec4(0);
-    vec4 t1 = texture(tex1, position);
-    vec4 t0 = texture(tex0, position);
+    vec4 t1 = texelFetch(tex1, texel, 0);
+    vec4 t0 = texelFetch(tex0, texel, 0);
+
+    // Sample depth and color from render passes
+    float d0 = texelFetch(depth0, texel, 0).r;
+    float d1 = texelFetch(depth1, texel, 0).r;
+    float d2 = texelFetch(depth2, texel, 0).r;
+    
+    // Start with background (ground/sky)
+    vec4 color = backgroundColor;
+    
+    // Composite layers front-to-back with depth testing
     
+    // Layer 2 (faces) - furthest back
+    if (t2.a > 0.0 && d2 < groundDepth) {
+        color = mix(color, t2, t2.a);
+    }
+    
+    // Layer 1 (lines) - middle
+    if (t1.a > 0.0 && d1 < groundDepth) {
+        color = mix(color, t1, t1.a);
+    }
+    
+    // Layer 0 (points) - front
+    if (t0.a > 0.0 && d0 < groundDepth) {
+        color = mix(color, t0, t0.a);
+    }
+    
+    return color;
+}
+
+// While the view changes the offscreen passes may only fill the lower left renderScale
+// of their targets. The layers are then rebuilt from the 4 nearest rendered texels,
+// weighted bilinearly and by how close their depth is to the nearest one, so
+// silhouettes stay sharp. Each texel is composited before blending, so encoded face
+// IDs are never mixed.
+vec4 upsampleLayers(vec2 position, vec4 backgroundColor, float groundDepth) {
+    vec2 rendered = vec2(textureSize(tex2, 0)) * renderScale;
+    ivec2 lastTexel = ivec2(rendered) - 1;
+    vec2 p = position * rendered - 0.5;
+    ivec2 base = ivec2(floor(p));
+    vec2 f = p - floor(p);
+    float nearestDepth = texelFetch(depth2, clamp(ivec2(floor(p + 0.5)), ivec2(0), lastTexel), 0).r;
+
+    vec4 color = vec4(0);
+    float total = 0.0;
+    for (int i = 0; i < 4; ++i) {
+        ivec2 offset = ivec2(i & 1, i >> 1);
+        ivec2 texel = clamp(base + offset, ivec2(0), lastTexel);
+        vec2 bilinear = mix(1.0 - f, f, vec2(offset));
+        float depthDelta = abs(texelFetch(depth2, texel, 0).r - nearestDepth);
+        float weight = bilinear.x * bilinear.y / (1.0 + depthDelta * 1000.0) + 1e-5;
+        color += compositeLayers(texel, backgroundColor, groundDepth) * weight;
+        total += weight;
+    }
+    return color / total;
+}
+
+// Get the fully composited pixel color at a given screen position
+vec4 getCompositeColor(vec2 position) {
     // Reconstruct ray direction from NDC
     vec2 ndc = position * 2.0 - 1.0;
     
@@ -138,32 +195,12 @@ vec4 getCompositeColor(vec2 position) {
         backgroundColor = vec4(skyColor(rayDir.y), 1.0);
     }
     
-    // Sample depth and color from render passes
-    float d0 = texture(depth0, position).r;
-    float d1 = texture(depth1, position).r;
-    float d2 = texture(depth2, position).r;
-    
-    // Start with background (ground/sky)
-    vec4 color = backgroundColor;
-    
-    // Composite layers front-to-back with depth testing
-    
-    // Layer 2 (faces) - furthest back
-    if (t2.a > 0.0 && d2 < groundDepth) {
-        color = mix(color, t2, t2.a);
-    }
-    
-    // Layer 1 (lines) - middle
-    if (t1.a > 0.0 && d1 < groundDepth) {
-        color = mix(color, t1, t1.a);
+    // Full resolution frames take the texel under the pixel as is
+    if (renderScale.x >= 1.0 && renderScale.y >= 1.0) {
+        ivec2 texel = ivec2(position * vec2(textureSize(tex2, 0)));
+        return compositeLayers(texel, backgroundColor, groundDepth);
     }
-    
-    // Layer 0 (points) - front
-    if (t0.a > 0.0 && d0 < groundDepth) {
-        color = mix(color, t0, t0.a);
-    }
-    
-    return color;
+    return upsampleLayers(position, backgroundColor, groundDepth);
 }
 
 void main() {    
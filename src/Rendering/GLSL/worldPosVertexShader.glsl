@@ -1,11 +1,10 @@
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in float aPrimitiveId;
-
+// Inputs and facePosition() come from the face vertex format
 out vec3 worldPos;
 
 void main() {
-    gl_Position = projectionMatrix * viewMatrix * vec4(aPos, 1.0);
+    vec3 position = facePosition();
+    gl_Position = projectionMatrix * viewMatrix * vec4(position, 1.0);
     
     // Pass world position to fragment shader
-    worldPos = aPos;
+    worldPos = position;
 }
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+// Render quality that follows camera motion. While the camera moves, frames use
+// coarser LODs and leave out the passes nobody looks at mid-motion (vertex points,
+// and the world position target that only picking reads). Once the camera stops,
+// detail comes back one step per frame, so no single frame pays for all of it, and
+// the last step leaves the image exactly as if the camera had never moved.
+class InteractionQuality {
+ public:
+  // LOD error allowed while moving, as a multiple of the still image's
+  static constexpr float kMovingLodErrorScale = 8.0f;
+
+  // Restoration steps, in frames since the camera last moved
+  static constexpr uint32_t kFullLodFrame = 1;
+  static constexpr uint32_t kWorldPositionFrame = 2;
+  static constexpr uint32_t kPointFrame = 3;
+
+  // Call once per frame with whether the camera changed since the last call. Returns
+  // true when quality stepped up, so the frame must be redrawn although nothing moved.
+  bool Advance(bool cameraMoved) {
+    if (cameraMoved) {
+      idleFrames_ = 0;
+      return false;
+    }
+    if (idleFrames_ >= kPointFrame) return false;
+    ++idleFrames_;
+    return true;
+  }
+
+  bool IsMoving() const { return idleFrames_ == 0; }
+  bool IsFull() const { return idleFrames_ >= kPointFrame; }
+
+  float LodErrorScale() const { return idleFrames_ < kFullLodFrame ? kMovingLodErrorScale : 1.0f; }
+  bool DrawWorldPositions() const { return idleFrames_ >= kWorldPositionFrame; }
+  bool DrawPoints() const { return idleFrames_ >= kPointFrame; }
+
+ private:
+  uint32_t idleFrames_ = kPointFrame;  // start out still
+};
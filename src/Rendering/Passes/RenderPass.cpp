@@ -4,37 +4,58 @@
 
 #include "Rendering/Devices/RenderDevice.h"
 
-void RenderPass::Execute(RenderDevice& device, size_t count) const {
-  device.BindPipeline(pipeline);
-  device.BindVertexBuffer(vertexBuffer);
-  if (indexBuffer != 0) {
-    device.BindIndexBuffer(indexBuffer);
+namespace {
+
+void Bind(const RenderPass& pass, RenderDevice& device) {
+  device.BindPipeline(pass.pipeline);
+  device.BindVertexBuffer(pass.vertexBuffer);
+  if (pass.indexBuffer != 0) {
+    device.BindIndexBuffer(pass.indexBuffer);
+  }
+  device.BindFrameBuffer(pass.frameBuffer);
+  if (pass.texture != 0) {
+    device.BindTexture(pass.texture, pass.textureUnit);
   }
-  device.BindFrameBuffer(frameBuffer);
 
   // Set viewport if specified
-  if (viewportWidth > 0 && viewportHeight > 0) {
-    device.SetViewport(viewportX, viewportY, viewportWidth, viewportHeight);
+  if (pass.viewportWidth > 0 && pass.viewportHeight > 0) {
+    device.SetViewport(pass.viewportX, pass.viewportY, pass.viewportWidth, pass.viewportHeight);
   }
 
   // Apply clear settings if configured
-  if (clearOnBind) {
-    device.SetClearColor(clearColor[0], clearColor[1], clearColor[2], clearColor[3]);
+  if (pass.clearOnBind) {
+    device.SetClearColor(pass.clearColor[0], pass.clearColor[1], pass.clearColor[2],
+                         pass.clearColor[3]);
     device.Clear();
   }
 
   // Enable or disable blending
-  if (blendEnabled) {
+  if (pass.blendEnabled) {
     device.EnableBlending();
   } else {
     device.DisableBlending();
   }
 
-  device.BindShader(shaderProgram);
+  device.BindShader(pass.shaderProgram);
+}
+
+}  // namespace
 
-  if (indexBuffer != 0) {
+void RenderPass::Execute(RenderDevice& device, size_t count) const {
+  Bind(*this, device);
+
+  if (templateIndexCount > 0) {
+    device.DrawIndexedInstanced(topology, templateIndexCount, count);
+  } else if (indexBuffer != 0) {
     device.DrawIndexed(topology, count);
   } else {
     device.Draw(topology, count);
   }
 }
+
+void RenderPass::Execute(RenderDevice& device, std::span<const ViewRange> ranges) const {
+  Bind(*this, device);
+  for (const ViewRange& range : ranges) {
+    device.DrawRange(topology, range.first, range.count);
+  }
+}
@@ -1,6 +1,9 @@
 #pragma once
 #include <cstddef>
+#include <cstdint>
+#include <span>
 
+#include "ModelView/ModelViews.h"
 #include "Rendering/Devices/GpuHandle.h"
 #include "Rendering/PrimitiveTopology.h"
 
@@ -8,7 +11,10 @@ class RenderDevice;
 class RenderResources;
 
 struct RenderPass {
+  // count is the number of indices or vertices drawn, or of instances for instanced passes
   void Execute(RenderDevice& device, size_t count) const;
+  // Same state, but draws only the given vertex ranges (non-indexed passes)
+  void Execute(RenderDevice& device, std::span<const ViewRange> ranges) const;
 
   GpuHandle pipeline = 0;
   GpuHandle vertexBuffer = 0;
@@ -16,6 +22,12 @@ struct RenderPass {
   GpuHandle frameBuffer = 0;
   GpuHandle shaderProgram = 0;
   PrimitiveTopology topology;
+  // Instanced passes draw the indexBuffer's template mesh of this many indices per
+  // instance
+  size_t templateIndexCount = 0;
+  // Data texture the shader samples, bound to textureUnit with the pass (0 for none)
+  GpuHandle texture = 0;
+  uint32_t textureUnit = 0;
 
   // Clear settings
   bool clearOnBind = true;
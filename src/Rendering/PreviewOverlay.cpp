@@ -0,0 +1,91 @@
+#include "Rendering/PreviewOverlay.h"
+
+#include <array>
+
+#include "Geometry/Geometry.h"
+#include "Geometry/Triangulation.h"
+#include "Model/Model.h"
+
+namespace {
+
+constexpr PreviewOverlay::Color kExtrudedFace{0.2f, 0.5f, 1.0f, 0.45f};
+constexpr PreviewOverlay::Color kExtrudedSide{0.2f, 0.5f, 1.0f, 0.2f};
+constexpr PreviewOverlay::Color kExtrudedEdge{0.1f, 0.3f, 0.9f, 1.0f};
+constexpr PreviewOverlay::Color kExtrudedCorner{0.1f, 0.3f, 0.9f, 1.0f};
+// Corner markers, as a part of the face's size
+constexpr float kCornerRadius = 0.03f;
+
+// Unit sphere triangles: each octant's face split into four and pushed out
+const std::array<Vec3, 3 * PreviewOverlay::kSphereTriangles>& UnitSphere() {
+  static const std::array<Vec3, 3 * PreviewOverlay::kSphereTriangles> sphere = [] {
+    std::array<Vec3, 3 * PreviewOverlay::kSphereTriangles> corners;
+    std::size_t next = 0;
+    for (int octant = 0; octant < 8; ++octant) {
+      const Vec3 a{octant & 1 ? -1.0f : 1.0f, 0, 0};
+      const Vec3 b{0, octant & 2 ? -1.0f : 1.0f, 0};
+      const Vec3 c{0, 0, octant & 4 ? -1.0f : 1.0f};
+      const Vec3 ab = (a + b).Normalized();
+      const Vec3 bc = (b + c).Normalized();
+      const Vec3 ca = (c + a).Normalized();
+      for (const Vec3& p : {a, ab, ca, ab, b, bc, ca, bc, c, ab, bc, ca}) corners[next++] = p;
+    }
+    return corners;
+  }();
+  return sphere;
+}
+
+}  // namespace
+
+void PreviewOverlay::Clear() {
+  if (IsEmpty()) return;
+  triangles_.clear();
+  edges_.clear();
+  dirty_ = true;
+}
+
+void PreviewOverlay::AddVertex(const Vec3& position, const Color& color) {
+  triangles_.insert(triangles_.end(),
+                    {position.x, position.y, position.z, color.r, color.g, color.b, color.a});
+}
+
+void PreviewOverlay::AddPolygon(std::span<const Vec3> loop, const Color& color) {
+  if (loop.size() < 3) return;
+
+  cornerScratch_.clear();
+  Geometry::TriangulatePolygon(loop, Geometry::PolygonNormal(loop), cornerScratch_);
+  for (uint32_t corner : cornerScratch_) AddVertex(loop[corner], color);
+  dirty_ = true;
+}
+
+void PreviewOverlay::AddEdge(const Vec3& a, const Vec3& b, const Color& color) {
+  edges_.insert(edges_.end(),
+                {a.x, a.y, a.z, b.x, b.y, b.z, color.r, color.g, color.b, color.a});
+  dirty_ = true;
+}
+
+void PreviewOverlay::AddSphere(const Vec3& center, float radius, const Color& color) {
+  for (const Vec3& p : UnitSphere()) AddVertex(center + p * radius, color);
+  dirty_ = true;
+}
+
+void PreviewOverlay::AddExtrusion(const Model& model, FaceId face, float delta) {
+  if (!model.ContainsFace(face)) return;
+  const auto loop = model.FaceLoop(face);
+  if (loop.size() < 3) return;
+
+  const Vec3 offset = model.FaceNormal(face) * delta;
+  std::vector<Vec3> moved;
+  moved.reserve(loop.size());
+  for (VertexId id : loop) moved.push_back(model.GetVertex(id).position + offset);
+
+  const float radius = model.FaceBounds(face).Extent().Length() * kCornerRadius;
+  AddPolygon(moved, kExtrudedFace);
+  for (std::size_t i = 0; i < loop.size(); ++i) {
+    const std::size_t j = (i + 1) % loop.size();
+    const Vec3 side[] = {model.GetVertex(loop[i]).position, model.GetVertex(loop[j]).position,
+                         moved[j], moved[i]};
+    AddPolygon(side, kExtrudedSide);
+    AddEdge(moved[i], moved[j], kExtrudedEdge);
+    AddSphere(moved[i], radius, kExtrudedCorner);
+  }
+}
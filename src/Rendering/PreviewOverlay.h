@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Core/Primitives.h"
+#include "Utilities/Vec3.h"
+
+class Model;
+
+// Transient geometry drawn over the model while an edit is in progress: extrusion and
+// drag previews, and the vertices, edges and hover markers of a face being drawn. Tools
+// refill it whenever the preview changes, without touching Model; Renderer streams it into
+// its own small buffers and draws it over the finished image, so a preview frame costs the
+// size of the preview and never a view rebuild. Only the final edit becomes a command.
+class PreviewOverlay {
+ public:
+  struct Color {
+    float r, g, b, a;
+  };
+
+  // Floats per triangle vertex (position, RGBA) and per edge (start, end, RGBA)
+  static constexpr std::size_t kVertexFloats = 7;
+  static constexpr std::size_t kEdgeFloats = 10;
+  // Triangles per sphere: an octahedron split once
+  static constexpr std::size_t kSphereTriangles = 32;
+
+  void Clear();
+
+  // Planar polygon, convex or not, triangulated the way the model triangulates faces
+  void AddPolygon(std::span<const Vec3> loop, const Color& color);
+  void AddEdge(const Vec3& a, const Vec3& b, const Color& color);
+  // Vertex and hover markers
+  void AddSphere(const Vec3& center, float radius, const Color& color);
+  // What ExtrudeFacesCommand would make of the face: the face moved along its normal by
+  // delta, a wall along each edge back to where it was, its outline and its corners
+  void AddExtrusion(const Model& model, FaceId face, float delta);
+
+  bool IsEmpty() const { return triangles_.empty() && edges_.empty(); }
+  // Changed since the last ClearDirty
+  bool IsDirty() const { return dirty_; }
+  void ClearDirty() { dirty_ = false; }
+
+  std::span<const float> TriangleVertices() const { return triangles_; }
+  std::size_t TriangleVertexCount() const { return triangles_.size() / kVertexFloats; }
+  std::span<const float> EdgeInstances() const { return edges_; }
+  std::size_t EdgeCount() const { return edges_.size() / kEdgeFloats; }
+
+ private:
+  void AddVertex(const Vec3& position, const Color& color);
+
+  std::vector<float> triangles_;
+  std::vector<float> edges_;
+  std::vector<uint32_t> cornerScratch_;
+  bool dirty_ = false;
+};
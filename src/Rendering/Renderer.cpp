@@ -1,20 +1,39 @@
 #include "Renderer.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <type_traits>
 
 #include "App/Commands/CommandStack.h"
 #include "App/Commands/Commands.h"
 #include "App/Input.h"
+#include "Geometry/Frustum.h"
 #include "Model/Model.h"
 #include "ModelView/ModelViews.h"
 #include "Rendering/Devices/RenderDevice.h"
 #include "Rendering/FrameContext.h"
 #include "Rendering/Resources/RenderResources.h"
 #include "Rendering/Resources/UniformBuffer.h"
+#include "Rendering/Resources/VertexAttribute.h"
+#include "Subdivision/CatmullClark.h"
 #include "Utilities/Vec3.h"
 
+namespace {
+
+// Pixel of a full size target, in a frame rendered to its lower left renderSize pixels
+uint32_t ToRenderTarget(uint32_t pixel, int fullSize, int renderSize) {
+  if (fullSize <= 0 || renderSize >= fullSize) return pixel;
+  const auto scaled = static_cast<uint64_t>(pixel) * static_cast<uint64_t>(renderSize) /
+                      static_cast<uint64_t>(fullSize);
+  return static_cast<uint32_t>(std::min<uint64_t>(scaled, renderSize - 1));
+}
+
+}  // namespace
+
 Renderer::Renderer(RenderDevice& device, Model& model)
-    : device_(device), model_(model), viewBuilder_(model) {
+    : device_(device), model_(model), viewBuilder_(model), lods_(model) {
   Initialise();
 }
 
@@ -29,6 +48,11 @@ void Renderer::Initialise() {
   linePass_ = resources_.BuildLinePass();
   screenPass_ = resources_.BuildScreenPass();
   debugPass_ = resources_.BuildDebugPass();
+  overlayPass_ = resources_.BuildPreviewPass();
+  overlayLinePass_ = resources_.BuildPreviewLinePass();
+  renderWidth_ = resources_.fbWidth;
+  renderHeight_ = resources_.fbHeight;
+  dirtyRegion_.Reset(resources_.fbWidth, resources_.fbHeight);
 }
 
 void Renderer::ProcessPendingUpdates(const FrameContext& context, Input& input) {
@@ -41,56 +65,145 @@ void Renderer::ProcessPendingUpdates(const FrameContext& context, Input& input)
   }
 
   // Check if camera changed
-  if (camera_.IsDirty()) {
+  const bool cameraMoved = camera_.IsDirty();
+  if (cameraMoved) {
     shouldUpdateUniforms_ = true;
+    worldPositionsCurrent_ = false;
     camera_.ClearDirty();
   }
 
-  if (model_.IsVerticesDirty()) {
-    UpdateVertices();
+  // Cheaper frames while the camera moves; detail returns over the frames after it stops
+  if (quality_.Advance(cameraMoved)) {
+    shouldUpdateUniforms_ = true;
   }
-  if (model_.IsEdgesDirty()) {
-    viewBuilder_.BuildLineView(views_.lines);
-    UpdateEdgeIndices();
+
+  // Large volumes are drawn decimated while they are small on screen
+  const bool lodsChanged = lods_.Update(camera_.GetPosition(), camera_.GetFieldOfView(),
+                                        lastViewportHeight_, quality_.LodErrorScale());
+  if (lodsChanged) {
+    shouldUpdateUniforms_ = true;  // redraw even though the model is unchanged
   }
-  if (model_.IsFacesDirty() || model_.IsVerticesDirty()) {
-    viewBuilder_.BuildFaceView(views_.faces);
-    UpdateFaceIndices();
+
+  const bool movedInPlace = model_.OnlyVerticesMoved() && previewLevels_ == 0 &&
+                            !previewDirty_ && !lodsChanged && !formatDirty_;
+  if (movedInPlace) {
+    // Sculpting and dragging: upload just the moved vertices, faces and edge end points
+    UpdateMovedVertices();
+    UpdateMovedFaces();
+    UpdateMovedEdges();
+  } else {
+    if (model_.IsVerticesDirty()) {
+      UpdateVertices();
+    }
+    if (model_.IsFacesDirty() || model_.IsVerticesDirty() || previewDirty_ || lodsChanged ||
+        formatDirty_) {
+      BuildFaceView();
+      UpdateFaceIndices();
+    }
+  }
+  // Line instances carry their end points, so they are rebuilt with the vertices too
+  if (model_.IsEdgesDirty() || (model_.IsVerticesDirty() && !movedInPlace)) {
+    viewBuilder_.BuildLineView(views_.lines);
+    UpdateEdgeInstances();
   }
   if (model_.IsVolumesDirty()) {
     viewBuilder_.BuildVolumeView(views_.volumes);
     UpdateVolumeIndices();
   }
+  // Previews stream into their own buffers and leave the views alone
+  if (overlay_.IsDirty()) {
+    UpdateOverlay();
+  }
+
+  // Only the chunks in view are drawn; redone whenever the camera or the view moved
+  if (cullDirty_ || shouldUpdateUniforms_) {
+    CullFaceChunks();
+  }
 
   // Handle pending pick after geometry updates
   HandlePick(input);
 
-  if (shouldUpdateUniforms_) {
+  // Frames showing a change render at the governor's scale and are timed. The first still
+  // frame after a scaled one is redrawn at full resolution, so still images stay exact.
+  const bool changing = cameraMoved || model_.ShouldRender();
+  if (!changing && renderScale_ < 1.0f) {
+    shouldUpdateUniforms_ = true;
+  }
+  measureFrame_ = changing;
+  const float scale = changing ? governor_.Scale() : 1.0f;
+  if (scale != renderScale_) {
+    SetRenderScale(scale);
+    shouldUpdateUniforms_ = true;
+  }
+
+  if (shouldUpdateUniforms_ || selectionDirty_) {
     UpdateFrameContext(context);
   }
 }
 
-void Renderer::Render(const FrameContext& context) {
+bool Renderer::Render(const FrameContext& context) {
   // Always render if there's a pending pick (need fresh framebuffer data)
-  if (!model_.ShouldRender() && !shouldUpdateUniforms_ && !hasPendingPick_) {
-    return;
+  const bool sceneChanged = model_.ShouldRender() || shouldUpdateUniforms_ || hasPendingPick_;
+  if (!sceneChanged && !selectionDirty_ && !overlayChanged_) {
+    lastMeasuredFrame_.reset();  // idle time is not frame time
+    return false;
   }
 
-  device_.BeginFrame();
+  // GL calls return before the GPU is done, and on WebGL EndFrame returns at once, so
+  // timing this call would miss the fill cost. Time from one measured frame to the next
+  // instead, which takes in the GPU work and presentation the previous frame queued.
+  const auto frameStart = std::chrono::steady_clock::now();
+  const bool measured = measureFrame_ && sceneChanged;
+  if (measured && lastMeasuredFrame_) {
+    const std::chrono::duration<float, std::milli> frameTime = frameStart - *lastMeasuredFrame_;
+    governor_.AddFrame(frameTime.count());
+  }
+  lastMeasuredFrame_ = measured ? std::optional(frameStart) : std::nullopt;
 
-  // Render geometry to framebuffers
-  pointPass_.Execute(device_, model_.Vertices().size());
-  facePass_.Execute(device_, views_.faces.vertices.size());  // Face IDs
+  device_.BeginFrame();
 
-  // Render world positions: ground plane first, then faces on top
-  groundPlanePass_.Execute(device_, 6);  // Fullscreen quad (6 indices for 2 triangles)
-  worldPosPass_.Execute(device_, views_.faces.vertices.size());  // World positions
+  if (sceneChanged) {
+    // Render geometry to framebuffers
+    // Mid-motion frames only clear the point target, so no stale points are composited
+    pointPass_.Execute(device_, quality_.DrawPoints() ? model_.Vertices().size() : 0);
+    facePass_.Execute(device_, drawRanges_);  // Face IDs
+
+    // Render world positions: ground plane first, then faces on top. Only picking reads
+    // them, so they wait until the camera stops.
+    worldPositionsCurrent_ = quality_.DrawWorldPositions();
+    if (worldPositionsCurrent_) {
+      groundPlanePass_.Execute(device_, 6);  // Fullscreen quad (6 indices for 2 triangles)
+      worldPosPass_.Execute(device_, drawRanges_);  // World positions
+    }
 
-  linePass_.Execute(device_, views_.lines.vertexIndices.size());
+    linePass_.Execute(device_, views_.lines.endpoints.size() / 2);  // One quad per edge
+  }
 
-  // Composite to screen
+  // Composite into the kept screen target. The selection colour is only applied here, so
+  // when nothing else changed the offscreen targets are reused and just the pixels of
+  // the old and new selected faces are recomposited.
+  const bool partial = !sceneChanged && !dirtyRegion_.IsFull();
+  if (partial) {
+    const ScreenRect& rect = dirtyRegion_.Bounds();
+    device_.SetScissor(rect.x, rect.y, rect.width, rect.height);
+  }
   device_.BindTexture(resources_.faceMaterialTexture, 7);
-  screenPass_.Execute(device_, 6);
+  if (!partial || !dirtyRegion_.IsEmpty()) {
+    screenPass_.Execute(device_, 6);
+  }
+  if (partial) {
+    device_.DisableScissor();
+  }
+  device_.BlitToScreen(resources_.framebuffer4, resources_.fbWidth, resources_.fbHeight,
+                       lastViewportWidth_ > 0 ? lastViewportWidth_ : resources_.fbWidth,
+                       lastViewportHeight_ > 0 ? lastViewportHeight_ : resources_.fbHeight);
+
+  // The overlay goes on the window, never into the kept composite
+  if (!overlay_.IsEmpty()) {
+    device_.ClearDepth();
+    overlayPass_.Execute(device_, overlay_.TriangleVertexCount());
+    overlayLinePass_.Execute(device_, overlay_.EdgeCount());
+  }
 
   if (context.debug) {
     debugPass_.Execute(device_, 6);
@@ -99,24 +212,152 @@ void Renderer::Render(const FrameContext& context) {
   device_.EndFrame();
 
   shouldUpdateUniforms_ = false;
+  selectionDirty_ = false;
+  overlayChanged_ = false;
+  dirtyRegion_.Reset(resources_.fbWidth, resources_.fbHeight);
+  return true;
 }
 
 void Renderer::UpdateVertices() {
   const auto& vertices = model_.Vertices();
-  device_.UpdateVertexBuffer(resources_.vertexBuffer, vertices.size() * sizeof(Vertex),
-                             vertices.data());
+  device_.UpdateVertexBuffer(resources_.vertexBuffer, vertices.size() * sizeof(Vertex), nullptr);
+
+  // Storage is only contiguous per chunk
+  size_t offset = 0;
+  for (size_t c = 0; c < vertices.ChunkCount(); ++c) {
+    const auto chunk = vertices.ChunkSpan(c);
+    device_.UpdateVertexBufferRange(resources_.vertexBuffer, offset, chunk.size_bytes(),
+                                    chunk.data());
+    offset += chunk.size_bytes();
+  }
+}
+
+void Renderer::UpdateMovedVertices() {
+  const auto& vertices = model_.Vertices();
+  constexpr std::size_t kChunkSize = std::remove_cvref_t<decltype(vertices)>::kChunkSize;
+  // Re-sending a few unchanged vertices is cheaper than another upload call
+  constexpr std::size_t kMaxGap = 16;
+
+  movedScratch_.clear();
+  for (VertexId id : model_.MovedVertices()) movedScratch_.push_back(model_.VertexIdToIndex(id));
+  std::sort(movedScratch_.begin(), movedScratch_.end());
+
+  // Runs of dense indices, split where storage stops being contiguous
+  for (std::size_t i = 0; i < movedScratch_.size();) {
+    const std::size_t first = movedScratch_[i];
+    std::size_t last = first;
+    while (++i < movedScratch_.size() && movedScratch_[i] - last <= kMaxGap &&
+           movedScratch_[i] / kChunkSize == first / kChunkSize) {
+      last = movedScratch_[i];
+    }
+
+    const auto chunk = vertices.ChunkSpan(first / kChunkSize);
+    device_.UpdateVertexBufferRange(resources_.vertexBuffer, first * sizeof(Vertex),
+                                    (last - first + 1) * sizeof(Vertex),
+                                    chunk.data() + first % kChunkSize);
+  }
+}
+
+void Renderer::UpdateMovedFaces() {
+  rangeScratch_.clear();
+  if (!viewBuilder_.PatchFaceView(views_.faces, model_.ReshapedFaces(), rangeScratch_)) {
+    BuildFaceView();
+    UpdateFaceIndices();
+    return;
+  }
+
+  if (quantized_) {
+    // Whole chunks are requantized, since their refitted boxes moved every vertex in them
+    quantizedRanges_.clear();
+    ModelViewBuilder::PatchQuantized(views_.faces, rangeScratch_, views_.quantizedFaces,
+                                     quantizedRanges_);
+    constexpr std::size_t kVertexBytes = 3 * sizeof(uint16_t);
+    for (const ViewRange& range : quantizedRanges_) {
+      device_.UpdateVertexBufferRange(resources_.quantizedPositionBuffer,
+                                      range.first * kVertexBytes, range.count * kVertexBytes,
+                                      views_.quantizedFaces.positions.data() + 3 * range.first);
+    }
+    UpdateChunkBoxes();
+  } else {
+    for (const ViewRange& range : rangeScratch_) {
+      device_.UpdateVertexBufferRange(resources_.faceVertexBuffer, range.first * sizeof(Vec3),
+                                      range.count * sizeof(Vec3),
+                                      views_.faces.vertices.data() + range.first);
+    }
+  }
+  cullDirty_ = true;  // the patched chunks were refitted
+  occludersDirty_ = true;
 }
 
-void Renderer::UpdateEdgeIndices() {
-  // Upload edge indices
-  if (!views_.lines.vertexIndices.empty()) {
-    device_.UpdateIndexBuffer(resources_.edgeIndexBuffer, views_.lines.vertexIndices);
+void Renderer::UpdateEdgeInstances() {
+  // Upload both end points of every edge
+  if (!views_.lines.endpoints.empty()) {
+    device_.UpdateVertexBuffer(resources_.edgeInstanceBuffer,
+                               views_.lines.endpoints.size() * sizeof(Vec3),
+                               views_.lines.endpoints.data());
   }
 }
 
+void Renderer::UpdateMovedEdges() {
+  rangeScratch_.clear();
+  if (!viewBuilder_.PatchLineView(views_.lines, model_.MovedVertices(), rangeScratch_)) {
+    viewBuilder_.BuildLineView(views_.lines);
+    UpdateEdgeInstances();
+    return;
+  }
+
+  for (const ViewRange& range : rangeScratch_) {
+    device_.UpdateVertexBufferRange(resources_.edgeInstanceBuffer, range.first * sizeof(Vec3),
+                                    range.count * sizeof(Vec3),
+                                    views_.lines.endpoints.data() + range.first);
+  }
+}
+
+void Renderer::SetSubdivisionPreview(uint32_t levels) {
+  if (levels == previewLevels_) return;
+  previewLevels_ = levels;
+  previewDirty_ = true;
+  shouldUpdateUniforms_ = true;  // redraw even though the model is unchanged
+}
+
+void Renderer::SetQuantizedVertices(bool enabled) {
+  if (enabled == quantized_) return;
+  quantized_ = enabled;
+  facePass_ = resources_.BuildFacePass(quantized_);
+  worldPosPass_ = resources_.BuildWorldPosPass(quantized_);
+  SetRenderScale(renderScale_);
+  if (!quantized_) {
+    views_.quantizedFaces = {};  // release it rather than keep it for the next toggle
+  }
+  formatDirty_ = true;
+  shouldUpdateUniforms_ = true;  // redraw even though the model is unchanged
+}
+
+void Renderer::BuildFaceView() {
+  previewDirty_ = false;
+  if (previewLevels_ == 0) {
+    viewBuilder_.BuildFaceView(views_.faces);
+    lods_.Apply(views_.faces);
+  } else {
+    std::vector<FaceId> faces;
+    faces.reserve(model_.Faces().size());
+    for (uint32_t i = 0; i < model_.Faces().size(); ++i) {
+      faces.push_back(model_.FaceIndexToId(i));
+    }
+    Subdivision::BuildPreview(model_, faces, previewLevels_, views_.faces);
+  }
+  ModelViewBuilder::BuildChunks(views_.faces);
+  cullDirty_ = true;
+  occludersDirty_ = true;
+}
+
 void Renderer::UpdateFaceIndices() {
+  formatDirty_ = false;
+  if (quantized_) {
+    UpdateQuantizedFaces();
+  }
   // Upload expanded face vertices (non-indexed rendering now)
-  if (!views_.faces.vertices.empty()) {
+  if (!quantized_ && !views_.faces.vertices.empty()) {
     // Create a temporary buffer to match face vertices to the main vertex buffer
     // We need to upload these as Vec3 positions
     device_.UpdateVertexBuffer(resources_.faceVertexBuffer,
@@ -126,7 +367,7 @@ void Renderer::UpdateFaceIndices() {
 
   // Upload face primitive IDs as vertex attribute (one per vertex)
   // Convert to float for GL_FLOAT vertex attribute
-  if (!views_.faces.primitiveIds.empty()) {
+  if (!quantized_ && !views_.faces.primitiveIds.empty()) {
     std::vector<float> primitiveIdsFloat;
     primitiveIdsFloat.reserve(views_.faces.primitiveIds.size());
     for (uint32_t id : views_.faces.primitiveIds) {
@@ -158,6 +399,58 @@ void Renderer::UpdateFaceIndices() {
   }
 }
 
+void Renderer::UpdateQuantizedFaces() {
+  QuantizedFaceView& quantized = views_.quantizedFaces;
+  ModelViewBuilder::BuildQuantized(views_.faces, quantized);
+  if (!quantized.positions.empty()) {
+    device_.UpdateVertexBuffer(resources_.quantizedPositionBuffer,
+                               quantized.positions.size() * sizeof(uint16_t),
+                               quantized.positions.data());
+  }
+
+  // The ID attribute follows the width the builder picked
+  if (quantized.WideIds() != quantizedWideIds_) {
+    quantizedWideIds_ = quantized.WideIds();
+    std::vector<VertexAttribute> idAttr = {
+        {"aPrimitiveId", 1, 1, 0, 0,
+         quantizedWideIds_ ? AttributeType::UInt32 : AttributeType::UInt16}};
+    device_.BindPipeline(resources_.quantizedFacePipeline);
+    device_.SetVertexAttributes(resources_.quantizedIdBuffer, idAttr);
+  }
+  if (quantized.WideIds()) {
+    device_.UpdateVertexBuffer(resources_.quantizedIdBuffer,
+                               quantized.ids32.size() * sizeof(uint32_t), quantized.ids32.data());
+  } else if (!quantized.ids16.empty()) {
+    device_.UpdateVertexBuffer(resources_.quantizedIdBuffer,
+                               quantized.ids16.size() * sizeof(uint16_t), quantized.ids16.data());
+  }
+  UpdateChunkBoxes();
+}
+
+void Renderer::UpdateChunkBoxes() {
+  // Whole rows of kChunkBoxesPerRow boxes; the padding decodes nothing
+  constexpr int kBoxesPerRow = RenderResources::kChunkBoxesPerRow;
+  std::vector<float>& boxes = views_.quantizedFaces.chunkBoxes;
+  const std::size_t chunks = boxes.size() / 8;
+  const int rows = std::max(1, static_cast<int>((chunks + kBoxesPerRow - 1) / kBoxesPerRow));
+  boxes.resize(static_cast<std::size_t>(rows) * kBoxesPerRow * 8, 0.0f);
+  if (rows != resources_.chunkBoundsTextureRows) {
+    if (resources_.chunkBoundsTextureRows > 0) {
+      device_.DestroyTexture(resources_.chunkBoundsTexture);
+    }
+    resources_.chunkBoundsTexture = device_.CreateFloatTexture2D(2 * kBoxesPerRow, rows);
+    resources_.chunkBoundsTextureRows = rows;
+    // The quantized passes bind it themselves, so they need the new handle
+    facePass_.texture = resources_.chunkBoundsTexture;
+    worldPosPass_.texture = resources_.chunkBoundsTexture;
+  }
+  device_.UpdateFloatTexture2D(resources_.chunkBoundsTexture, 2 * kBoxesPerRow, rows, boxes);
+
+  // Creating and updating bind to whichever unit is active; put the material texture
+  // back on unit 7 for the screen pass
+  device_.BindTexture(resources_.faceMaterialTexture, 7);
+}
+
 void Renderer::UpdateVolumeIndices() {
   // Upload volume vertices (expanded geometry, non-indexed)
   if (!views_.volumes.vertices.empty()) {
@@ -180,30 +473,104 @@ void Renderer::UpdateVolumeIndices() {
   }
 }
 
+void Renderer::UpdateOverlay() {
+  overlay_.ClearDirty();
+  overlayChanged_ = true;
+  const auto triangles = overlay_.TriangleVertices();
+  if (!triangles.empty()) {
+    device_.UpdateVertexBuffer(resources_.previewTriangleBuffer, triangles.size_bytes(),
+                               triangles.data());
+  }
+  const auto edges = overlay_.EdgeInstances();
+  if (!edges.empty()) {
+    device_.UpdateVertexBuffer(resources_.previewEdgeBuffer, edges.size_bytes(), edges.data());
+  }
+}
+
+void Renderer::CullFaceChunks() {
+  cullDirty_ = false;
+  const auto& bounds = views_.faces.chunkBounds;
+  chunkVisible_.resize(bounds.size());
+  const Mat4 viewProjection = camera_.GetViewProjectionMatrix();
+  Geometry::Frustum::FromViewProjection(viewProjection).Cull(bounds, chunkVisible_);
+  const auto inFrustum =
+      static_cast<std::size_t>(std::count(chunkVisible_.begin(), chunkVisible_.end(), 1));
+
+  // Software depth test of what survived, identical on every backend
+  if (occludersDirty_) {
+    occlusion_.SetCandidates(model_, views_.faces);
+    occludersDirty_ = false;
+  }
+  occlusion_.Cull(views_.faces, viewProjection, camera_.GetPosition(), camera_.GetAspectRatio(),
+                  bounds, chunkVisible_);
+
+  // Neighbouring visible chunks become one draw
+  drawRanges_.clear();
+  const std::size_t vertexCount = views_.faces.vertices.size();
+  std::size_t drawnVertices = 0;
+  for (std::size_t c = 0; c < bounds.size(); ++c) {
+    if (!chunkVisible_[c]) continue;
+    const std::size_t first = c * FaceView::kChunkVertices;
+    const std::size_t count = std::min(FaceView::kChunkVertices, vertexCount - first);
+    drawnVertices += count;
+    if (!drawRanges_.empty() && drawRanges_.back().first + drawRanges_.back().count == first) {
+      drawRanges_.back().count += count;
+    } else {
+      drawRanges_.push_back({first, count});
+    }
+  }
+
+  cullingStats_.chunks = bounds.size();
+  cullingStats_.outsideFrustum = bounds.size() - inFrustum;
+  cullingStats_.drawnTriangles = drawnVertices / 3;
+  cullingStats_.culledTriangles = (vertexCount - drawnVertices) / 3;
+  cullingStats_.occlusion = occlusion_.GetStats();
+}
+
+void Renderer::SetRenderScale(float scale) {
+  renderScale_ = scale;
+  renderWidth_ = std::max(1, static_cast<int>(std::lround(resources_.fbWidth * scale)));
+  renderHeight_ = std::max(1, static_cast<int>(std::lround(resources_.fbHeight * scale)));
+  for (RenderPass* pass :
+       {&pointPass_, &linePass_, &facePass_, &groundPlanePass_, &worldPosPass_}) {
+    pass->viewportWidth = renderWidth_;
+    pass->viewportHeight = renderHeight_;
+  }
+}
+
 void Renderer::UpdateFrameContext(const FrameContext& context) {
   // Update camera matrices and viewport size in uniform buffer
   UniformBuffer uniforms;
   uniforms.viewMatrix = camera_.GetViewMatrix();
   uniforms.projectionMatrix = camera_.GetProjectionMatrix();
 
-  // Update viewport size for geometry shaders
+  // Update viewport size for the line quads, sized in pixels
   uniforms.viewPortSize[0] = static_cast<float>(context.viewportWidth);
   uniforms.viewPortSize[1] = static_cast<float>(context.viewportHeight);
   uniforms.selectedFace = selectedFaceId_;
   uniforms.maxFaces = views_.faces.primitiveCount;
+  // The exact fraction after rounding, so the screen pass finds the last rendered texel
+  if (resources_.fbWidth > 0 && resources_.fbHeight > 0) {
+    uniforms.renderScale[0] = static_cast<float>(renderWidth_) / resources_.fbWidth;
+    uniforms.renderScale[1] = static_cast<float>(renderHeight_) / resources_.fbHeight;
+  }
 
   device_.UpdateUniformBuffer(resources_.frameUniformBuffer, sizeof(UniformBuffer), &uniforms, 0);
 }
 
 void Renderer::HandleViewportResize(uint32_t width, uint32_t height) {
-  // Update screen pass viewport to match window size
-  screenPass_.viewportWidth = width;
-  screenPass_.viewportHeight = height;
+  // The composite keeps the targets' size and is stretched to the window when copied
 
   // Update camera aspect ratio to match window
   float aspect = static_cast<float>(width) / static_cast<float>(height);
   camera_.SetAspectRatio(aspect);
 
+  // The overlay is drawn on the window itself
+  for (RenderPass* pass : {&overlayPass_, &overlayLinePass_}) {
+    pass->viewportWidth = static_cast<int>(width);
+    pass->viewportHeight = static_cast<int>(height);
+  }
+
   // Track dimensions and flag uniforms for update
   lastViewportWidth_ = width;
   lastViewportHeight_ = height;
@@ -225,8 +592,9 @@ void Renderer::HandlePick(Input& input) {
   mouseY *= 2;
 #endif
 
-  uint32_t fbX = mouseX;
-  uint32_t fbY = lastViewportHeight_ - mouseY;
+  // The targets hold the last frame, which may have been rendered at a lower scale
+  uint32_t fbX = ToRenderTarget(mouseX, resources_.fbWidth, renderWidth_);
+  uint32_t fbY = ToRenderTarget(lastViewportHeight_ - mouseY, resources_.fbHeight, renderHeight_);
 
   std::cout << "HandlePick: mouseX=" << mouseX << ", mouseY=" << mouseY << ", fbX=" << fbX
             << ", fbY=" << fbY << ", viewportHeight=" << lastViewportHeight_ << std::endl;
@@ -251,9 +619,13 @@ void Renderer::HandlePick(Input& input) {
   }
 
   // Update both renderer's internal state and the input state
+  if (pickedFaceId != selectedFaceId_) {
+    AddSelectionToDirtyRegion(selectedFaceId_);
+    AddSelectionToDirtyRegion(pickedFaceId);
+    selectionDirty_ = true;
+  }
   selectedFaceId_ = pickedFaceId;
   input.SetSelectedFaceId(pickedFaceId);
-  shouldUpdateUniforms_ = true;
 
   if (pickedFaceId != 0) {
     std::cout << "Picked face ID: " << pickedFaceId - 1 << std::endl;
@@ -265,7 +637,30 @@ void Renderer::HandlePick(Input& input) {
   }
 }
 
+void Renderer::AddSelectionToDirtyRegion(uint32_t selectedFaceId) {
+  if (selectedFaceId == 0) return;
+  // Face IDs are encoded one based; faces without a span of their own (LOD swapped, or
+  // a subdivision preview) could be anywhere
+  const FaceId face = selectedFaceId - 1;
+  const FaceView& view = views_.faces;
+  if (face >= view.faceVertexCount.size() || view.faceVertexCount[face] == 0) {
+    dirtyRegion_.AddAll();
+    return;
+  }
+
+  Geometry::Aabb bounds;
+  const uint32_t first = view.faceFirstVertex[face];
+  for (uint32_t i = first; i < first + view.faceVertexCount[face]; ++i) {
+    bounds.Expand(view.vertices[i]);
+  }
+  dirtyRegion_.AddBox(bounds, camera_.GetViewProjectionMatrix());
+}
+
 std::optional<Vec3> Renderer::GetPickedWorldPosition(uint32_t fbX, uint32_t fbY) {
+  if (!worldPositionsCurrent_) {
+    return std::nullopt;
+  }
+
   // Read world position from framebuffer3 (RGB32F texture)
   device_.BindFrameBuffer(resources_.framebuffer3);
 
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <chrono>
 #include <optional>
+#include <vector>
 
+#include "ModelView/LodCache.h"
 #include "ModelView/ModelViewBuilder.h"
 #include "ModelView/ModelViews.h"
+#include "Occlusion/OcclusionCuller.h"
 #include "Rendering/Camera.h"
+#include "Rendering/DirtyRegion.h"
 #include "Rendering/FrameContext.h"
+#include "Rendering/InteractionQuality.h"
+#include "Rendering/PreviewOverlay.h"
+#include "Rendering/ResolutionGovernor.h"
 #include "Rendering/Passes/RenderPass.h"
 #include "Rendering/Resources/RenderResources.h"
 
@@ -15,39 +23,107 @@ class Input;
 
 class Renderer {
  public:
+  // Face view chunks drawn and skipped by the last culling pass
+  struct CullingStats {
+    std::size_t chunks = 0;
+    std::size_t outsideFrustum = 0;
+    std::size_t drawnTriangles = 0;
+    std::size_t culledTriangles = 0;
+    Occlusion::Stats occlusion;  // chunks hidden behind occluders, and the occluders used
+  };
+
   explicit Renderer(RenderDevice& device, Model& model);
   ~Renderer();
 
   void Initialise();
 
   void ProcessPendingUpdates(const FrameContext& context, Input& input);
-  void Render(const FrameContext& context);
+  // Returns whether a new image went to the display
+  bool Render(const FrameContext& context);
 
   void Resize(uint32_t width, uint32_t height);
   void MarkDirty() { shouldUpdateUniforms_ = true; }
 
+  // Draw faces as their Catmull-Clark limit approximation; 0 shows the cage itself.
+  // Only the view changes, the model is never touched.
+  void SetSubdivisionPreview(uint32_t levels);
+  uint32_t GetSubdivisionPreview() const { return previewLevels_; }
+
+  // Geometry of in-progress edits, drawn over the model until cleared
+  PreviewOverlay& GetPreviewOverlay() { return overlay_; }
+
+  // Upload faces as QuantizedFaceView, half the GPU memory and upload bytes of full
+  // floats, at an error of QuantizedFaceView::maxError
+  void SetQuantizedVertices(bool enabled);
+  bool GetQuantizedVertices() const { return quantized_; }
+
   Camera& GetCamera() { return camera_; }
+  const CullingStats& GetCullingStats() const { return cullingStats_; }
+  ResolutionGovernor& GetResolutionGovernor() { return governor_; }
+  // Part of the offscreen targets the last frame rendered to
+  float GetRenderScale() const { return renderScale_; }
 
-  // Get the 3D world position at framebuffer coordinates (returns nullopt if no geometry)
+  // Get the 3D world position at framebuffer coordinates (returns nullopt if no geometry,
+  // or while the camera moves and world positions are not drawn)
   std::optional<Vec3> GetPickedWorldPosition(uint32_t fbX, uint32_t fbY);
 
  private:
   void UpdateVertices();
-  void UpdateEdgeIndices();
+  // Partial uploads while only vertex positions changed (Model::OnlyVerticesMoved)
+  void UpdateMovedVertices();
+  void UpdateMovedFaces();
+  void UpdateEdgeInstances();
+  void UpdateMovedEdges();
+  void BuildFaceView();
   void UpdateFaceIndices();
+  void UpdateQuantizedFaces();
+  void UpdateChunkBoxes();
   void UpdateVolumeIndices();
+  void UpdateOverlay();
+  // Draw ranges of the face view chunks inside the camera frustum and not hidden
+  // behind occluders
+  void CullFaceChunks();
+  // Render the offscreen passes into the lower left scale of their targets
+  void SetRenderScale(float scale);
   void UpdateFrameContext(const FrameContext& context);
   void HandleViewportResize(uint32_t width, uint32_t height);
   void HandlePick(Input& input);
+  // Mark the screen area of a selected face ID (0 for none) for recompositing
+  void AddSelectionToDirtyRegion(uint32_t selectedFaceId);
 
   RenderDevice& device_;
   Model& model_;
   Camera camera_;
   ModelViewBuilder viewBuilder_;
+  LodCache lods_;
   ModelViews views_;
   RenderResources resources_;
 
+  std::vector<std::size_t> movedScratch_;
+  std::vector<ViewRange> rangeScratch_;
+  std::vector<uint8_t> chunkVisible_;
+  std::vector<ViewRange> drawRanges_;  // visible face vertices, merged
+  bool cullDirty_ = true;
+  Occlusion::OcclusionCuller occlusion_;
+  bool occludersDirty_ = true;
+  CullingStats cullingStats_;
+
   bool shouldUpdateUniforms_ = true;
+  InteractionQuality quality_;
+  bool worldPositionsCurrent_ = false;  // the world position target matches the camera
+  ResolutionGovernor governor_;
+  float renderScale_ = 1.0f;
+  int renderWidth_ = 0;  // offscreen viewport at renderScale_
+  int renderHeight_ = 0;
+  bool measureFrame_ = false;  // the next frame's time feeds the governor
+  // Start of the last measured frame while measured frames follow each other
+  std::optional<std::chrono::steady_clock::time_point> lastMeasuredFrame_;
+  uint32_t previewLevels_ = 0;
+  bool previewDirty_ = false;
+  bool quantized_ = false;
+  bool formatDirty_ = false;      // the face buffers hold the other vertex format
+  bool quantizedWideIds_ = false;  // the quantized ID attribute is specified as 32 bit
+  std::vector<ViewRange> quantizedRanges_;
   uint32_t lastViewportWidth_ = 0;
   uint32_t lastViewportHeight_ = 0;
 
@@ -58,10 +134,19 @@ class Renderer {
   RenderPass worldPosPass_;     // Render world positions to texture
   RenderPass screenPass_;
   RenderPass debugPass_;
+  RenderPass overlayPass_;
+  RenderPass overlayLinePass_;
+
+  PreviewOverlay overlay_;
+  bool overlayChanged_ = false;  // redraw the window although the scene is unchanged
 
   // Pending pick request (to be processed after face rendering)
   bool hasPendingPick_ = false;
   uint32_t pendingPickX_ = 0;
   uint32_t pendingPickY_ = 0;
   uint32_t selectedFaceId_ = 0;
+  // Only the selection changed since the last frame: the offscreen targets are current
+  // and just dirtyRegion_ of the composite is redrawn
+  bool selectionDirty_ = false;
+  DirtyRegion dirtyRegion_;
 };
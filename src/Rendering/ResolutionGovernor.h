@@ -0,0 +1,66 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Render scale of the offscreen passes, picked from measured frame times. Fill cost
+// grows with the pixel count, so a slow frame drops the scale at once by the square root
+// of how far it overran the budget; the scale then climbs back one step at a time after
+// a run of frames that fit. Scales are multiples of kStep so the viewport changes rarely.
+class ResolutionGovernor {
+ public:
+  static constexpr float kMinScale = 0.5f;
+  static constexpr float kStep = 0.0625f;
+  // Frames over this multiple of the budget lower the scale
+  static constexpr float kOverBudget = 1.2f;
+  // Frames within this multiple of the budget count towards raising it
+  static constexpr float kWithinBudget = 1.05f;
+  static constexpr uint32_t kRaiseAfterFrames = 30;
+  // Frames after a change before the scale may drop again, while the new one shows up
+  static constexpr uint32_t kSettleFrames = 4;
+
+  explicit ResolutionGovernor(float budgetMilliseconds = 1000.0f / 60.0f)
+      : budget_(budgetMilliseconds) {}
+
+  void SetBudget(float milliseconds) { budget_ = milliseconds; }
+  float GetBudget() const { return budget_; }
+  float Scale() const { return scale_; }
+
+  // Call with the duration of each frame rendered at Scale(). Returns true when the scale
+  // changed.
+  bool AddFrame(float milliseconds) {
+    ++sinceChange_;
+    if (milliseconds > budget_ * kOverBudget) {
+      fitting_ = 0;
+      if (sinceChange_ <= kSettleFrames || scale_ <= kMinScale) return false;
+      const float target = scale_ * std::sqrt(budget_ / milliseconds);
+      return SetScale(std::min(scale_ - kStep, std::floor(target / kStep) * kStep));
+    }
+    if (milliseconds > budget_ * kWithinBudget || scale_ >= 1.0f) {
+      fitting_ = 0;
+      return false;
+    }
+    if (++fitting_ < kRaiseAfterFrames) return false;
+    return SetScale(scale_ + kStep);
+  }
+
+  void Reset() {
+    scale_ = 1.0f;
+    fitting_ = 0;
+    sinceChange_ = kSettleFrames;
+  }
+
+ private:
+  bool SetScale(float scale) {
+    scale_ = std::clamp(scale, kMinScale, 1.0f);
+    fitting_ = 0;
+    sinceChange_ = 0;
+    return true;
+  }
+
+  float budget_;
+  float scale_ = 1.0f;
+  uint32_t fitting_ = 0;                  // frames in a row within the budget
+  uint32_t sinceChange_ = kSettleFrames;  // a slow first frame may drop the scale at once
+};
@@ -1,14 +1,46 @@
 #include "RenderResources.h"
 
+#include <string>
 #include <vector>
 
 #include "Core/Constants.h"
+#include "ModelView/ModelViews.h"
 #include "Rendering/Devices/RenderDevice.h"
 #include "Rendering/Passes/RenderPass.h"
 #include "Rendering/Resources/UniformBuffer.h"
 #include "Rendering/Resources/VertexAttribute.h"
 #include "Utilities/IO.h"
 
+namespace {
+
+// Point crosses are 3 axes x 2 quads
+constexpr uint32_t kCrossQuads = 6;
+
+// Corners of the cross quads as (along, side, axis, quad), see pointVertex.glsl
+std::vector<float> PointCrossVertices() {
+  std::vector<float> vertices;
+  for (uint32_t quad = 0; quad < kCrossQuads; ++quad) {
+    for (float along : {-1.0f, 1.0f}) {
+      for (float side : {-1.0f, 1.0f}) {
+        vertices.insert(vertices.end(), {along, side, static_cast<float>(quad / 2),
+                                         static_cast<float>(quad % 2)});
+      }
+    }
+  }
+  return vertices;
+}
+
+// Two triangles for each run of 4 corners ordered (0, 0), (0, 1), (1, 0), (1, 1)
+std::vector<uint32_t> QuadIndices(uint32_t quadCount) {
+  std::vector<uint32_t> indices;
+  for (uint32_t base = 0; base < 4 * quadCount; base += 4) {
+    indices.insert(indices.end(), {base, base + 1, base + 2, base + 2, base + 1, base + 3});
+  }
+  return indices;
+}
+
+}  // namespace
+
 void RenderResources::LoadResources(RenderDevice& device) {
   // Store framebuffer dimensions
   fbWidth = device.GetFramebufferWidth();
@@ -32,8 +64,19 @@ void RenderResources::LoadResources(RenderDevice& device) {
   std::vector<VertexAttribute> primitiveIdAttr = {{"aPrimitiveId", 1, 1, 0}};
   device.SetVertexAttributes(facePrimitiveIdBuffer, primitiveIdAttr);  // ID at location 1
 
+  // Quantized faces; Renderer switches the ID attribute to 32 bit when IDs need it
+  quantizedFacePipeline = device.CreatePipeline();
+  quantizedPositionBuffer = device.CreateBuffer();
+  quantizedIdBuffer = device.CreateBuffer();
+  device.BindPipeline(quantizedFacePipeline);
+  std::vector<VertexAttribute> quantizedAttr = {
+      {"aPosition", 0, 3, 0, 0, AttributeType::UNorm16}};
+  device.SetVertexAttributes(quantizedPositionBuffer, quantizedAttr);
+  std::vector<VertexAttribute> quantizedIdAttr = {
+      {"aPrimitiveId", 1, 1, 0, 0, AttributeType::UInt16}};
+  device.SetVertexAttributes(quantizedIdBuffer, quantizedIdAttr);
+
   // indices
-  edgeIndexBuffer = device.CreateBuffer();
   faceIndexBuffer = device.CreateBuffer();
   volumeIndexBuffer = device.CreateBuffer();
 
@@ -51,43 +94,48 @@ void RenderResources::LoadResources(RenderDevice& device) {
   const std::string worldPosFragmentSource = IO::LoadSource("worldPosFragmentShader.glsl");
   const std::string groundPlaneVertexSource = IO::LoadSource("groundPlaneVertexShader.glsl");
   const std::string groundPlaneFragmentSource = IO::LoadSource("groundPlaneFragmentShader.glsl");
+  const std::string lineVertexSource = IO::LoadSource("lineVertexShader.glsl");
   const std::string pointVertexSource = IO::LoadSource("pointVertex.glsl");
   const std::string pointFragmentSource = IO::LoadSource("pointFragment.glsl");
   const std::string debugVertexSource = IO::LoadSource("debugVertex.glsl");
   const std::string debugFragmentSource = IO::LoadSource("debugFragment.glsl");
+  const std::string previewVertexSource = IO::LoadSource("previewVertex.glsl");
 
-#ifndef __EMSCRIPTEN__
-  // Geometry shaders are not supported in WebGL/OpenGL ES
-  const std::string geometrySource = IO::LoadSource("lineThicknessGeometryShader.glsl");
-  const std::string pointGeometrySource = IO::LoadSource("pointGeometry.glsl");
-  pointShader = device.CreateShader(pointVertexSource, pointFragmentSource, pointGeometrySource);
-#else
-  // For Emscripten, use simple point rendering
-  const std::string pointVertexInstancedSource = IO::LoadSource("pointVertexInstanced.glsl");
-  const std::string pointFragmentInstancedSource = IO::LoadSource("pointFragmentInstanced.glsl");
-  pointShader = device.CreateShader(pointVertexInstancedSource, pointFragmentInstancedSource);
-#endif
+  // Points and lines are template meshes expanded per instance in the vertex shader,
+  // which WebGL runs the same as desktop GL (it has no geometry shaders)
+  pointShader = device.CreateShader(pointVertexSource, pointFragmentSource);
 
   device.BindShader(pointShader);
   device.UpdateUniformBuffer(frameUniformBuffer, sizeof(UniformBuffer), &uniforms, 0);
-  basicShader = device.CreateShader(vertexSource, fragmentSource);
+  // Face shaders come in both vertex formats
+  const std::string floatInputs = ShaderCommon::GLSL_FACE_VERTEX_FLOAT;
+  const std::string quantizedInputs =
+      "const int kChunkVertices = " + std::to_string(FaceView::kChunkVertices) +
+      ";\nconst int kChunkBoxesPerRow = " + std::to_string(kChunkBoxesPerRow) + ";\n" +
+      ShaderCommon::GLSL_FACE_VERTEX_QUANTIZED;
+  basicShader = device.CreateShader(floatInputs + vertexSource, fragmentSource);
   device.BindShader(basicShader);
   device.UpdateUniformBuffer(frameUniformBuffer, sizeof(UniformBuffer), &uniforms, 0);
   device.SetUniform("faceIdTexture", 6);
+  quantizedBasicShader = device.CreateShader(quantizedInputs + vertexSource, fragmentSource);
+  device.BindShader(quantizedBasicShader);
+  device.UpdateUniformBuffer(frameUniformBuffer, sizeof(UniformBuffer), &uniforms, 0);
+  device.SetUniform("chunkBoundsTex", 8);
 
-#ifndef __EMSCRIPTEN__
-  lineShader = device.CreateShader(vertexSource, lineFragmentSource, geometrySource);
-#else
-  lineShader = device.CreateShader(vertexSource, lineFragmentSource);
-#endif
+  lineShader = device.CreateShader(lineVertexSource, lineFragmentSource);
 
   device.BindShader(lineShader);
   device.UpdateUniformBuffer(frameUniformBuffer, sizeof(UniformBuffer), &uniforms, 0);
   screenShader = device.CreateShader(textureVertexSource, renderTexFragmentSource);
-  worldPosShader = device.CreateShader(worldPosVertexSource, worldPosFragmentSource);
+  worldPosShader = device.CreateShader(floatInputs + worldPosVertexSource, worldPosFragmentSource);
+  quantizedWorldPosShader =
+      device.CreateShader(quantizedInputs + worldPosVertexSource, worldPosFragmentSource);
   groundPlaneShader = device.CreateShader(groundPlaneVertexSource, groundPlaneFragmentSource);
   device.BindShader(worldPosShader);
   device.UpdateUniformBuffer(frameUniformBuffer, sizeof(UniformBuffer), &uniforms, 0);
+  device.BindShader(quantizedWorldPosShader);
+  device.UpdateUniformBuffer(frameUniformBuffer, sizeof(UniformBuffer), &uniforms, 0);
+  device.SetUniform("chunkBoundsTex", 8);
   device.BindShader(groundPlaneShader);
   device.UpdateUniformBuffer(frameUniformBuffer, sizeof(UniformBuffer), &uniforms, 0);
   device.BindShader(screenShader);
@@ -102,6 +150,15 @@ void RenderResources::LoadResources(RenderDevice& device) {
   device.SetUniform("depth2", 6);
   device.SetUniform("faceMaterialTex", 7);
 
+  // Preview overlay colors come with the geometry
+  previewShader = device.CreateShader(previewVertexSource, pointFragmentSource);
+  device.BindShader(previewShader);
+  device.UpdateUniformBuffer(frameUniformBuffer, sizeof(UniformBuffer), &uniforms, 0);
+  previewLineShader =
+      device.CreateShader("#define LINE_COLOR\n" + lineVertexSource, pointFragmentSource);
+  device.BindShader(previewLineShader);
+  device.UpdateUniformBuffer(frameUniformBuffer, sizeof(UniformBuffer), &uniforms, 0);
+
   debugShader = device.CreateShader(debugVertexSource, debugFragmentSource);
   device.BindShader(debugShader);
   device.UpdateUniformBuffer(frameUniformBuffer, sizeof(UniformBuffer), &uniforms, 0);
@@ -119,6 +176,7 @@ void RenderResources::LoadResources(RenderDevice& device) {
   texture1 = device.CreateTexture2D(fbWidth, fbHeight, false);
   texture2 = device.CreateTexture2D(fbWidth, fbHeight, false);
   texture3 = device.CreateFloatTexture2D(fbWidth, fbHeight);  // Float texture for world positions
+  texture4 = device.CreateTexture2D(fbWidth, fbHeight, false);
 
   depthTexture0 = device.CreateDepthTexture2D(fbWidth, fbHeight);
   depthTexture1 = device.CreateDepthTexture2D(fbWidth, fbHeight);
@@ -141,6 +199,7 @@ void RenderResources::LoadResources(RenderDevice& device) {
   framebuffer1 = device.CreateFrameBuffer(texture1, depthTexture1, 0);
   framebuffer2 = device.CreateFrameBuffer(texture2, depthTexture2, 0);
   framebuffer3 = device.CreateFrameBuffer(texture3, depthTexture3, 0);
+  framebuffer4 = device.CreateFrameBuffer(texture4, 0, 0);
 
   screenPipeline = device.CreatePipeline();
 
@@ -170,14 +229,65 @@ void RenderResources::LoadResources(RenderDevice& device) {
                                            {"aTexCoord", 1, 2, sizeof(float) * 3}};
   device.BindPipeline(screenPipeline);  // Bind VAO before setting attributes
   device.SetVertexAttributes(fullscreenQuadVertexBuffer, quadAttr);
+
+  // Point crosses: the template per vertex, reading centers straight from vertexBuffer
+  const std::vector<float> crossVertices = PointCrossVertices();
+  const std::vector<uint32_t> crossIndices = QuadIndices(kCrossQuads);
+  pointCrossVertexCount = static_cast<int>(crossVertices.size() / 4);
+  pointCrossIndexCount = static_cast<int>(crossIndices.size());
+  pointCrossPipeline = device.CreatePipeline();
+  pointCrossTemplateBuffer = device.CreateBuffer();
+  pointCrossIndexBuffer = device.CreateBuffer();
+  device.UpdateVertexBuffer(pointCrossTemplateBuffer, crossVertices.size() * sizeof(float),
+                            crossVertices.data());
+  device.UpdateIndexBuffer(pointCrossIndexBuffer, crossIndices);
+  std::vector<VertexAttribute> crossAttr = {{"aCorner", 0, 4, 0}};
+  std::vector<VertexAttribute> centerAttr = {{"aCenter", 1, 3, 0, 1}};
+  device.BindPipeline(pointCrossPipeline);
+  device.SetVertexAttributes(pointCrossTemplateBuffer, crossAttr);
+  device.SetVertexAttributes(vertexBuffer, centerAttr);
+
+  // Lines: one quad per edge, over the end point pairs uploaded by Renderer
+  const std::vector<float> lineQuad = {0.0f, -1.0f, 0.0f, 1.0f, 1.0f, -1.0f, 1.0f, 1.0f};
+  linePipeline = device.CreatePipeline();
+  lineQuadTemplateBuffer = device.CreateBuffer();
+  lineQuadIndexBuffer = device.CreateBuffer();
+  edgeInstanceBuffer = device.CreateBuffer();
+  device.UpdateVertexBuffer(lineQuadTemplateBuffer, lineQuad.size() * sizeof(float),
+                            lineQuad.data());
+  device.UpdateIndexBuffer(lineQuadIndexBuffer, QuadIndices(1));
+  std::vector<VertexAttribute> cornerAttr = {{"aCorner", 0, 2, 0}};
+  std::vector<VertexAttribute> edgeAttr = {{"aStart", 1, 3, 0, 1},
+                                           {"aEnd", 2, 3, sizeof(float) * 3, 1}};
+  device.BindPipeline(linePipeline);
+  device.SetVertexAttributes(lineQuadTemplateBuffer, cornerAttr);
+  device.SetVertexAttributes(edgeInstanceBuffer, edgeAttr);
+
+  // Preview overlay: interleaved triangles, and colored edges over the same line quad
+  previewPipeline = device.CreatePipeline();
+  previewTriangleBuffer = device.CreateBuffer();
+  std::vector<VertexAttribute> previewAttr = {{"aPos", 0, 3, 0},
+                                              {"aColor", 1, 4, sizeof(float) * 3}};
+  device.BindPipeline(previewPipeline);
+  device.SetVertexAttributes(previewTriangleBuffer, previewAttr);
+  previewLinePipeline = device.CreatePipeline();
+  previewEdgeBuffer = device.CreateBuffer();
+  std::vector<VertexAttribute> previewEdgeAttr = {{"aStart", 1, 3, 0, 1},
+                                                  {"aEnd", 2, 3, sizeof(float) * 3, 1},
+                                                  {"aColor", 3, 4, sizeof(float) * 6, 1}};
+  device.BindPipeline(previewLinePipeline);
+  device.SetVertexAttributes(lineQuadTemplateBuffer, cornerAttr);
+  device.SetVertexAttributes(previewEdgeBuffer, previewEdgeAttr);
 }
 
 const RenderPass RenderResources::BuildPointPass() {
   RenderPass pass;
 
-  pass.pipeline = geometryPipeline;
-  pass.vertexBuffer = vertexBuffer;
-  pass.topology = PrimitiveTopology::Points;
+  pass.pipeline = pointCrossPipeline;  // One cross per vertex (instanced)
+  pass.vertexBuffer = pointCrossTemplateBuffer;
+  pass.indexBuffer = pointCrossIndexBuffer;
+  pass.templateIndexCount = pointCrossIndexCount;
+  pass.topology = PrimitiveTopology::Triangles;
   pass.shaderProgram = pointShader;
   pass.frameBuffer = framebuffer0;
   pass.clearOnBind = true;
@@ -193,14 +303,16 @@ const RenderPass RenderResources::BuildPointPass() {
   return pass;
 }
 
-const RenderPass RenderResources::BuildFacePass() {
+const RenderPass RenderResources::BuildFacePass(bool quantized) {
   RenderPass pass;
 
-  pass.pipeline = facePipeline;          // Use face pipeline with expanded vertices
-  pass.vertexBuffer = faceVertexBuffer;  // Use expanded vertex buffer
-  pass.indexBuffer = 0;                  // No index buffer (non-indexed rendering)
+  pass.pipeline = quantized ? quantizedFacePipeline : facePipeline;  // Expanded vertices
+  pass.vertexBuffer = quantized ? quantizedPositionBuffer : faceVertexBuffer;
+  pass.indexBuffer = 0;  // No index buffer (non-indexed rendering)
   pass.topology = PrimitiveTopology::Triangles;
-  pass.shaderProgram = basicShader;
+  pass.shaderProgram = quantized ? quantizedBasicShader : basicShader;
+  pass.texture = quantized ? chunkBoundsTexture : 0;  // decodes the quantized positions
+  pass.textureUnit = 8;
   pass.frameBuffer = framebuffer2;
   pass.clearOnBind = true;
   pass.clearColor[0] = 0.0f;  // R
@@ -237,14 +349,16 @@ const RenderPass RenderResources::BuildGroundPlanePass() {
   return pass;
 }
 
-const RenderPass RenderResources::BuildWorldPosPass() {
+const RenderPass RenderResources::BuildWorldPosPass(bool quantized) {
   RenderPass pass;
 
-  pass.pipeline = facePipeline;          // Use face pipeline with expanded vertices
-  pass.vertexBuffer = faceVertexBuffer;  // Use expanded vertex buffer
-  pass.indexBuffer = 0;                  // No index buffer (non-indexed rendering)
+  pass.pipeline = quantized ? quantizedFacePipeline : facePipeline;  // Expanded vertices
+  pass.vertexBuffer = quantized ? quantizedPositionBuffer : faceVertexBuffer;
+  pass.indexBuffer = 0;  // No index buffer (non-indexed rendering)
   pass.topology = PrimitiveTopology::Triangles;
-  pass.shaderProgram = worldPosShader;
+  pass.shaderProgram = quantized ? quantizedWorldPosShader : worldPosShader;
+  pass.texture = quantized ? chunkBoundsTexture : 0;  // decodes the quantized positions
+  pass.textureUnit = 8;
   pass.frameBuffer = framebuffer3;
   pass.clearOnBind = false;  // Don't clear - ground plane already rendered
   pass.viewportX = 0;
@@ -258,10 +372,11 @@ const RenderPass RenderResources::BuildWorldPosPass() {
 const RenderPass RenderResources::BuildLinePass() {
   RenderPass pass;
 
-  pass.pipeline = geometryPipeline;
-  pass.vertexBuffer = vertexBuffer;
-  pass.indexBuffer = edgeIndexBuffer;
-  pass.topology = PrimitiveTopology::Lines;
+  pass.pipeline = linePipeline;  // One quad per edge (instanced)
+  pass.vertexBuffer = lineQuadTemplateBuffer;
+  pass.indexBuffer = lineQuadIndexBuffer;
+  pass.templateIndexCount = 6;
+  pass.topology = PrimitiveTopology::Triangles;
   pass.shaderProgram = lineShader;
   pass.frameBuffer = framebuffer1;
   pass.clearOnBind = true;
@@ -285,7 +400,7 @@ const RenderPass RenderResources::BuildScreenPass() {
   pass.indexBuffer = fullscreenQuadIndexBuffer;
   pass.topology = PrimitiveTopology::Triangles;
   pass.shaderProgram = screenShader;
-  pass.frameBuffer = 0;
+  pass.frameBuffer = framebuffer4;  // copied to the window by Renderer
   pass.clearOnBind = true;
   pass.clearColor[0] = .8f;   // R
   pass.clearColor[1] = .8f;   // G
@@ -315,5 +430,36 @@ const RenderPass RenderResources::BuildDebugPass() {
   pass.viewportWidth = fbWidth;
   pass.viewportHeight = fbHeight;
 
+  return pass;
+}
+
+const RenderPass RenderResources::BuildPreviewPass() {
+  RenderPass pass;
+
+  pass.pipeline = previewPipeline;
+  pass.vertexBuffer = previewTriangleBuffer;
+  pass.indexBuffer = 0;
+  pass.topology = PrimitiveTopology::Triangles;
+  pass.shaderProgram = previewShader;
+  pass.frameBuffer = 0;
+  pass.clearOnBind = false;
+  pass.blendEnabled = true;  // Previews are see-through
+  pass.viewportX = 0;
+  pass.viewportY = 0;
+  pass.viewportWidth = fbWidth;
+  pass.viewportHeight = fbHeight;
+
+  return pass;
+}
+
+const RenderPass RenderResources::BuildPreviewLinePass() {
+  RenderPass pass = BuildPreviewPass();
+
+  pass.pipeline = previewLinePipeline;  // One quad per edge (instanced)
+  pass.vertexBuffer = lineQuadTemplateBuffer;
+  pass.indexBuffer = lineQuadIndexBuffer;
+  pass.templateIndexCount = 6;
+  pass.shaderProgram = previewLineShader;
+
   return pass;
 }
\ No newline at end of file
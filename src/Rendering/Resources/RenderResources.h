@@ -7,36 +7,53 @@ class RenderPass;
 
 class RenderResources {
  public:
+  // Chunk boxes per row of chunkBoundsTexture (two texels each)
+  static constexpr int kChunkBoxesPerRow = 512;
+
   void LoadResources(RenderDevice& device);
 
   const RenderPass BuildPointPass();
   const RenderPass BuildLinePass();
-  const RenderPass BuildFacePass();
+  // Face passes draw faceVertexBuffer, or the quantized buffers when asked to
+  const RenderPass BuildFacePass(bool quantized = false);
   const RenderPass BuildGroundPlanePass();  // Render ground plane to world pos texture
-  const RenderPass BuildWorldPosPass();     // Render world positions to texture
+  const RenderPass BuildWorldPosPass(bool quantized = false);  // World positions to texture
   const RenderPass BuildScreenPass();
   const RenderPass BuildDebugPass();
+  // Preview overlay, drawn on the window over the composite
+  const RenderPass BuildPreviewPass();
+  const RenderPass BuildPreviewLinePass();
 
   // vertices
   GpuHandle vertexBuffer;
   GpuHandle faceVertexBuffer;  // Expanded vertices for faces (non-indexed)
   GpuHandle fullscreenQuadVertexBuffer;
   GpuHandle pointCrossTemplateBuffer;  // Template mesh for point crosses (instanced)
+  GpuHandle lineQuadTemplateBuffer;    // Template quad for edges (instanced)
+  GpuHandle edgeInstanceBuffer;        // Both end points of every edge
   GpuHandle facePrimitiveIdBuffer;     // Buffer for per-vertex primitive IDs
+  GpuHandle quantizedPositionBuffer;   // QuantizedFaceView positions
+  GpuHandle quantizedIdBuffer;         // QuantizedFaceView IDs, 16 or 32 bit
+  GpuHandle previewTriangleBuffer;     // PreviewOverlay triangles, streamed
+  GpuHandle previewEdgeBuffer;         // PreviewOverlay edges, streamed
   // indices
-  GpuHandle edgeIndexBuffer;
   GpuHandle faceIndexBuffer;
   GpuHandle volumeIndexBuffer;
   GpuHandle fullscreenQuadIndexBuffer;
   GpuHandle pointCrossIndexBuffer;  // Indices for point cross template
+  GpuHandle lineQuadIndexBuffer;
   // shaders
   GpuHandle pointShader;
   GpuHandle basicShader;
   GpuHandle lineShader;
   GpuHandle screenShader;
   GpuHandle debugShader;
-  GpuHandle worldPosShader;     // Shader for rendering world positions
+  GpuHandle worldPosShader;           // Shader for rendering world positions
+  GpuHandle quantizedBasicShader;     // Same as basicShader, over quantized vertices
+  GpuHandle quantizedWorldPosShader;  // Same as worldPosShader, over quantized vertices
   GpuHandle groundPlaneShader;  // Shader for rendering ground plane to world pos texture
+  GpuHandle previewShader;      // Overlay triangles with per vertex color
+  GpuHandle previewLineShader;  // lineShader with per edge color
   // render textures
   GpuHandle framebuffer0;
   GpuHandle texture0;
@@ -49,13 +66,21 @@ class RenderResources {
   GpuHandle depthTexture2;
   GpuHandle faceMaterialTexture;
   int faceMaterialTextureWidth = 0;
+  GpuHandle chunkBoundsTexture = 0;  // Boxes decoding quantized positions, at unit 8
+  int chunkBoundsTextureRows = 0;
   GpuHandle framebuffer3;   // World position framebuffer
   GpuHandle texture3;       // World position texture (RGBA8 encoded)
   GpuHandle depthTexture3;  // Depth for world position framebuffer
+  GpuHandle framebuffer4;   // Composited image, kept between frames for partial redraws
+  GpuHandle texture4;
   // vao
   GpuHandle geometryPipeline;
   GpuHandle facePipeline;  // Pipeline for faces with expanded vertices
+  GpuHandle quantizedFacePipeline;
   GpuHandle screenPipeline;
+  GpuHandle linePipeline;  // Line quad template, instanced over edgeInstanceBuffer
+  GpuHandle previewPipeline;
+  GpuHandle previewLinePipeline;  // Line quad template, instanced over previewEdgeBuffer
   // uniforms
   GpuHandle frameUniformBuffer;
 
@@ -16,6 +16,8 @@ struct alignas(16) UniformBuffer {
   Mat4 projectionMatrix = Mat4::Identity();
   int32_t selectedFace;
   int32_t maxFaces;
+  // Part of the offscreen targets the last frame rendered to (dynamic resolution)
+  float renderScale[2] = {1.f, 1.f};
 };
 
 // GLSL uniform block definition generated from the struct above
@@ -44,6 +46,7 @@ layout(std140) uniform GlobalUniforms
     mat4 projectionMatrix;
     int selectedFace;
     int maxFaces;
+    vec2 renderScale;
 };
 )";
 
@@ -58,6 +61,35 @@ uniform sampler2D depth1;
 uniform sampler2D depth2;
 )";
 
+// Face vertex inputs, placed in front of the face and world position vertex shaders.
+// Each format defines facePosition() and facePrimitiveId() over its own attributes.
+constexpr const char* GLSL_FACE_VERTEX_FLOAT = R"(
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in float aPrimitiveId;
+
+vec3 facePosition() { return aPos; }
+uint facePrimitiveId() { return uint(aPrimitiveId); }
+)";
+
+// Quantized views (QuantizedFaceView): unorm positions within the box of their chunk,
+// found by vertex index. Boxes are two texels each (min, extent), kChunkBoxesPerRow to a
+// row; both constants are defined in front of this by RenderResources.
+constexpr const char* GLSL_FACE_VERTEX_QUANTIZED = R"(
+layout (location = 0) in vec3 aPosition;
+layout (location = 1) in uint aPrimitiveId;
+
+uniform highp sampler2D chunkBoundsTex;
+
+vec3 facePosition() {
+    int chunk = gl_VertexID / kChunkVertices;
+    ivec2 texel = ivec2((chunk % kChunkBoxesPerRow) * 2, chunk / kChunkBoxesPerRow);
+    vec3 boxMin = texelFetch(chunkBoundsTex, texel, 0).xyz;
+    vec3 extent = texelFetch(chunkBoundsTex, texel + ivec2(1, 0), 0).xyz;
+    return boxMin + aPosition * extent;
+}
+uint facePrimitiveId() { return aPrimitiveId; }
+)";
+
 // Helper to get the appropriate version string based on platform
 #ifdef __EMSCRIPTEN__
 constexpr const char* GetGLSLVersion() { return GLSL_VERSION_ES; }
@@ -2,9 +2,14 @@
 #include <cstdint>
 #include <string>
 
+// Component format in the buffer; integer types reach the shader as uint
+enum class AttributeType { Float, UNorm16, UInt16, UInt32 };
+
 struct VertexAttribute {
   std::string name;
   uint32_t location;
   uint32_t size;
   uint32_t offset;
+  uint32_t divisor = 0;  // instances per step; 0 steps per vertex
+  AttributeType type = AttributeType::Float;
 };
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "Sculpt/Brush.h"
+
+#include <cmath>
+
+#include "Utilities/Simd.h"
+
+namespace Sculpt {
+
+void ComputeFalloff(const float* xs, const float* ys, const float* zs, std::size_t count,
+                    const Vec3& center, float radius, float strength, float* outWeights) {
+  const float radiusSquared = radius * radius;
+  const float inverseRadius = 1.0f / radius;
+  std::size_t i = 0;
+
+#ifdef CAD_SSE
+  const __m128 cx = _mm_set1_ps(center.x);
+  const __m128 cy = _mm_set1_ps(center.y);
+  const __m128 cz = _mm_set1_ps(center.z);
+  const __m128 r2 = _mm_set1_ps(radiusSquared);
+  const __m128 invR = _mm_set1_ps(inverseRadius);
+  const __m128 scale = _mm_set1_ps(strength);
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 three = _mm_set1_ps(3.0f);
+  const __m128 two = _mm_set1_ps(2.0f);
+
+  for (; i + 4 <= count; i += 4) {
+    const __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), cx);
+    const __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), cy);
+    const __m128 dz = _mm_sub_ps(_mm_loadu_ps(zs + i), cz);
+    const __m128 d2 =
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+    const __m128 inside = _mm_cmplt_ps(d2, r2);
+
+    // smoothstep(t) = t * t * (3 - 2t)
+    const __m128 t = _mm_sub_ps(one, _mm_mul_ps(_mm_sqrt_ps(d2), invR));
+    const __m128 w = _mm_mul_ps(_mm_mul_ps(t, t), _mm_sub_ps(three, _mm_mul_ps(two, t)));
+    _mm_storeu_ps(outWeights + i, _mm_and_ps(_mm_mul_ps(w, scale), inside));
+  }
+#endif
+
+  for (; i < count; ++i) {
+    const float dx = xs[i] - center.x;
+    const float dy = ys[i] - center.y;
+    const float dz = zs[i] - center.z;
+    const float d2 = dx * dx + dy * dy + dz * dz;
+    if (d2 >= radiusSquared) {
+      outWeights[i] = 0.0f;
+      continue;
+    }
+    const float t = 1.0f - std::sqrt(d2) * inverseRadius;
+    outWeights[i] = t * t * (3.0f - 2.0f * t) * strength;
+  }
+}
+
+}  // namespace Sculpt
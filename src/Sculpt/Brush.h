@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Utilities/Vec3.h"
+
+// Sculpting brushes: each dab moves the vertices within radius of its centre, weighted
+// by a smooth falloff that fades to nothing at the rim
+namespace Sculpt {
+
+enum class Brush : uint8_t {
+  Grab,     // drag vertices along with the cursor
+  Inflate,  // push vertices out along their normals
+  Smooth,   // pull vertices towards the average of their neighbours
+  Flatten,  // pull vertices onto the average plane under the brush
+};
+inline constexpr std::size_t kBrushCount = 4;
+
+inline const char* BrushName(Brush brush) {
+  switch (brush) {
+    case Brush::Grab: return "grab";
+    case Brush::Inflate: return "inflate";
+    case Brush::Smooth: return "smooth";
+    case Brush::Flatten: return "flatten";
+  }
+  return "unknown";
+}
+
+struct BrushSettings {
+  Brush brush = Brush::Inflate;
+  float radius = 0.5f;
+  // Weight at the centre of a dab, in [0, 1]. A full strength inflate dab moves the
+  // centre a tenth of the radius; the other brushes move it all the way to their target.
+  float strength = 0.5f;
+};
+
+// Falloff weights strength * smoothstep(1 - distance / radius) for count points given
+// as separate coordinate arrays; 0 outside the sphere. Four points at a time with SSE
+// where available.
+void ComputeFalloff(const float* xs, const float* ys, const float* zs, std::size_t count,
+                    const Vec3& center, float radius, float strength, float* outWeights);
+
+}  // namespace Sculpt
@@ -0,0 +1,171 @@
+#include "Sculpt/Stroke.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "Model/Model.h"
+
+namespace Sculpt {
+namespace {
+
+// Inflate distance at the centre of a full strength dab, relative to the radius
+constexpr float kInflateStep = 0.1f;
+
+uint32_t Bits(float v) { return std::bit_cast<uint32_t>(v); }
+
+}  // namespace
+
+// -------------------------------------------------
+// Stroke
+// -------------------------------------------------
+Stroke::Stroke(Model& model, const BrushSettings& settings)
+    : model_(model), settings_(settings), grid_(settings.radius) {
+  settings_.radius = grid_.CellSize();
+  settings_.strength = std::clamp(settings_.strength, 0.0f, 1.0f);
+  grid_.Build(model_);
+}
+
+std::size_t Stroke::Dab(const Vec3& center, const Vec3& drag) {
+  const float radius = settings_.radius;
+
+  ids_.clear();
+  grid_.Query(center, radius, ids_);
+
+  const std::size_t count = ids_.size();
+  xs_.resize(count);
+  ys_.resize(count);
+  zs_.resize(count);
+  weights_.resize(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const Vec3& p = model_.GetVertex(ids_[i]).position;
+    xs_[i] = p.x;
+    ys_[i] = p.y;
+    zs_[i] = p.z;
+  }
+  ComputeFalloff(xs_.data(), ys_.data(), zs_.data(), count, center, radius, settings_.strength,
+                 weights_.data());
+
+  // Keep the vertices inside the brush
+  std::size_t kept = 0;
+  before_.clear();
+  for (std::size_t i = 0; i < count; ++i) {
+    if (weights_[i] <= 0.0f) continue;
+    ids_[kept] = ids_[i];
+    weights_[kept] = weights_[i];
+    before_.push_back(Vec3{xs_[i], ys_[i], zs_[i]});
+    ++kept;
+  }
+  ids_.resize(kept);
+  weights_.resize(kept);
+  if (kept == 0) return 0;
+
+  // Flatten works towards the weighted average plane of everything under the brush
+  Vec3 planePoint{};
+  Vec3 planeNormal{};
+  if (settings_.brush == Brush::Flatten) {
+    float total = 0.0f;
+    for (std::size_t i = 0; i < kept; ++i) {
+      planePoint += before_[i] * weights_[i];
+      planeNormal += VertexNormal(ids_[i]) * weights_[i];
+      total += weights_[i];
+    }
+    const float length = planeNormal.Length();
+    if (length <= 1e-12f) return 0;
+    planePoint = planePoint * (1.0f / total);
+    planeNormal = planeNormal * (1.0f / length);
+  }
+
+  // Every target is computed from positions before the dab, so the visiting order
+  // does not matter
+  after_.resize(kept);
+  for (std::size_t i = 0; i < kept; ++i) {
+    const Vec3& p = before_[i];
+    const float w = weights_[i];
+    switch (settings_.brush) {
+      case Brush::Grab:
+        after_[i] = p + drag * w;
+        break;
+      case Brush::Inflate:
+        after_[i] = p + VertexNormal(ids_[i]) * (w * radius * kInflateStep);
+        break;
+      case Brush::Smooth:
+        after_[i] = p + (NeighbourAverage(ids_[i], p) - p) * w;
+        break;
+      case Brush::Flatten:
+        after_[i] = p - planeNormal * (planeNormal.Dot(p - planePoint) * w);
+        break;
+    }
+  }
+
+  for (std::size_t i = 0; i < kept; ++i) {
+    Remember(ids_[i], before_[i]);
+    grid_.Move(ids_[i], before_[i], after_[i]);
+  }
+  model_.SetVertexPositions(ids_, after_);
+  return kept;
+}
+
+StrokeDelta Stroke::Finish() const {
+  std::vector<VertexId> ids(touchedIds_);
+  std::sort(ids.begin(), ids.end());
+
+  // Vertices the stroke brought back to where they started need no record
+  std::vector<VertexId> moved;
+  std::vector<Vec3> before;
+  std::vector<Vec3> after;
+  moved.reserve(ids.size());
+  before.reserve(ids.size());
+  after.reserve(ids.size());
+  for (VertexId id : ids) {
+    if (!model_.ContainsVertex(id)) continue;
+    const Vec3& original = originals_[id];
+    const Vec3& current = model_.GetVertex(id).position;
+    if (Bits(original.x) == Bits(current.x) && Bits(original.y) == Bits(current.y) &&
+        Bits(original.z) == Bits(current.z)) {
+      continue;
+    }
+    moved.push_back(id);
+    before.push_back(original);
+    after.push_back(current);
+  }
+  return EncodeStrokeDelta(moved, before, after);
+}
+
+Vec3 Stroke::VertexNormal(VertexId id) const {
+  Vec3 sum{};
+  for (FaceId face : model_.VertexFaces(id)) sum += model_.FaceNormal(face);
+  const float length = sum.Length();
+  return length > 1e-12f ? sum * (1.0f / length) : Vec3{};
+}
+
+Vec3 Stroke::NeighbourAverage(VertexId id, const Vec3& fallback) const {
+  // Both loop neighbours in every face, so each edge counts once per side
+  Vec3 sum{};
+  uint32_t count = 0;
+  for (FaceId face : model_.VertexFaces(id)) {
+    const auto loop = model_.FaceLoop(face);
+    const auto it = std::find(loop.begin(), loop.end(), id);
+    if (it == loop.end()) continue;
+
+    const std::size_t i = static_cast<std::size_t>(it - loop.begin());
+    const std::size_t n = loop.size();
+    sum += model_.GetVertex(loop[(i + n - 1) % n]).position;
+    sum += model_.GetVertex(loop[(i + 1) % n]).position;
+    count += 2;
+  }
+  return count > 0 ? sum * (1.0f / static_cast<float>(count)) : fallback;
+}
+
+void Stroke::Remember(VertexId id, const Vec3& position) {
+  if (id >= touched_.size()) {
+    const std::size_t size = std::max<std::size_t>(std::size_t{id} + 1, touched_.size() * 2);
+    touched_.resize(size, 0);
+    originals_.resize(size);
+  }
+  if (touched_[id]) return;
+  touched_[id] = 1;
+  originals_[id] = position;
+  touchedIds_.push_back(id);
+}
+
+}  // namespace Sculpt
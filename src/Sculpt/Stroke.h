@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Core/Primitives.h"
+#include "Sculpt/Brush.h"
+#include "Sculpt/StrokeDelta.h"
+#include "Sculpt/VertexGrid.h"
+#include "Utilities/Vec3.h"
+
+class Model;
+
+namespace Sculpt {
+
+// A brush stroke applied live to the model, one dab per input event. Vertices are found
+// through a grid built once per stroke, every dab is one batched move (so the renderer
+// only re-uploads what it touched) and the first position of every touched vertex is
+// kept until Finish turns the stroke into a single delta.
+class Stroke {
+ public:
+  Stroke(Model& model, const BrushSettings& settings);
+
+  // Apply one dab centred at center. drag is the cursor movement since the previous dab
+  // and only used by Grab. Returns the number of vertices moved.
+  std::size_t Dab(const Vec3& center, const Vec3& drag = Vec3{});
+
+  // Every vertex moved since construction, from its original to its current position
+  StrokeDelta Finish() const;
+
+  std::size_t TouchedCount() const { return touchedIds_.size(); }
+  const BrushSettings& Settings() const { return settings_; }
+
+ private:
+  Vec3 VertexNormal(VertexId id) const;
+  Vec3 NeighbourAverage(VertexId id, const Vec3& fallback) const;
+  void Remember(VertexId id, const Vec3& position);
+
+  Model& model_;
+  BrushSettings settings_;
+  VertexGrid grid_;
+
+  // Original positions by vertex id, for the vertices in touchedIds_
+  std::vector<uint8_t> touched_;
+  std::vector<Vec3> originals_;
+  std::vector<VertexId> touchedIds_;
+
+  // Per dab scratch: candidate ids, their coordinates and weights, then the moves
+  std::vector<VertexId> ids_;
+  std::vector<float> xs_, ys_, zs_, weights_;
+  std::vector<Vec3> before_, after_;
+};
+
+}  // namespace Sculpt
@@ -0,0 +1,92 @@
+#include "Sculpt/StrokeDelta.h"
+
+#include <bit>
+#include <cassert>
+
+#include "Model/Model.h"
+
+namespace Sculpt {
+namespace {
+
+void PutVarint(std::vector<uint8_t>& out, uint32_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+bool GetVarint(const std::vector<uint8_t>& in, std::size_t& offset, uint32_t& value) {
+  value = 0;
+  for (uint32_t shift = 0; shift < 35; shift += 7) {
+    if (offset >= in.size()) return false;
+    const uint8_t byte = in[offset++];
+    if (shift == 28 && byte > 0x0F) return false;  // more than 32 bits
+    value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) return true;
+  }
+  return false;
+}
+
+uint32_t Bits(float v) { return std::bit_cast<uint32_t>(v); }
+
+}  // namespace
+
+StrokeDelta EncodeStrokeDelta(std::span<const VertexId> ids, std::span<const Vec3> before,
+                              std::span<const Vec3> after) {
+  assert(ids.size() == before.size() && ids.size() == after.size());
+
+  StrokeDelta delta;
+  delta.vertexCount = static_cast<uint32_t>(ids.size());
+  delta.bytes.reserve(ids.size() * 8);
+
+  VertexId previous = 0;
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    assert(i == 0 || ids[i] > previous);
+    PutVarint(delta.bytes, ids[i] - previous);
+    PutVarint(delta.bytes, Bits(before[i].x) ^ Bits(after[i].x));
+    PutVarint(delta.bytes, Bits(before[i].y) ^ Bits(after[i].y));
+    PutVarint(delta.bytes, Bits(before[i].z) ^ Bits(after[i].z));
+    previous = ids[i];
+  }
+  return delta;
+}
+
+bool ApplyStrokeDelta(Model& model, const StrokeDelta& delta) {
+  // Every vertex takes at least four bytes
+  if (delta.vertexCount > delta.bytes.size() / 4) return false;
+
+  std::vector<VertexId> ids;
+  std::vector<Vec3> positions;
+  ids.reserve(delta.vertexCount);
+  positions.reserve(delta.vertexCount);
+
+  std::size_t offset = 0;
+  VertexId previous = 0;
+  for (uint32_t i = 0; i < delta.vertexCount; ++i) {
+    uint32_t step = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t z = 0;
+    if (!GetVarint(delta.bytes, offset, step) || !GetVarint(delta.bytes, offset, x) ||
+        !GetVarint(delta.bytes, offset, y) || !GetVarint(delta.bytes, offset, z)) {
+      return false;
+    }
+    if (i > 0 && (step == 0 || step > UINT32_MAX - previous)) return false;
+
+    const VertexId id = previous + step;
+    if (!model.ContainsVertex(id)) return false;
+    const Vec3& p = model.GetVertex(id).position;
+    ids.push_back(id);
+    positions.push_back(Vec3{std::bit_cast<float>(Bits(p.x) ^ x),
+                             std::bit_cast<float>(Bits(p.y) ^ y),
+                             std::bit_cast<float>(Bits(p.z) ^ z)});
+    previous = id;
+  }
+  if (offset != delta.bytes.size()) return false;
+
+  if (!ids.empty()) model.SetVertexPositions(ids, positions);
+  return true;
+}
+
+}  // namespace Sculpt
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Core/Primitives.h"
+#include "Utilities/Vec3.h"
+
+class Model;
+
+namespace Sculpt {
+
+// Compressed record of the vertex moves made by one stroke. Vertex ids are stored as
+// varint deltas in ascending order, and each coordinate keeps only the bits the stroke
+// changed (before ^ after) as a varint, so small moves and untouched axes cost a byte or
+// two. Being an XOR, the same record takes the model either way between the states.
+struct StrokeDelta {
+  uint32_t vertexCount = 0;
+  std::vector<uint8_t> bytes;
+};
+
+// Encode the moves of ascending ids from before[i] to after[i]
+StrokeDelta EncodeStrokeDelta(std::span<const VertexId> ids, std::span<const Vec3> before,
+                              std::span<const Vec3> after);
+
+// Toggle the model between the states before and after the stroke in one batched move.
+// Returns false and leaves the model untouched when the record is malformed or names a
+// vertex the model does not have.
+bool ApplyStrokeDelta(Model& model, const StrokeDelta& delta);
+
+}  // namespace Sculpt
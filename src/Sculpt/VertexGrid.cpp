@@ -0,0 +1,78 @@
+#include "Sculpt/VertexGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Model/Model.h"
+
+namespace Sculpt {
+namespace {
+
+// 21 bits per axis, wrapping far outside any sensible model
+constexpr uint64_t kAxisMask = (uint64_t{1} << 21) - 1;
+
+}  // namespace
+
+VertexGrid::VertexGrid(float cellSize)
+    : cellSize_(std::max(cellSize, 1e-4f)), inverseCellSize_(1.0f / cellSize_) {}
+
+int64_t VertexGrid::CellCoord(float v) const {
+  return static_cast<int64_t>(std::floor(v * inverseCellSize_));
+}
+
+uint64_t VertexGrid::PackKey(int64_t x, int64_t y, int64_t z) {
+  return (static_cast<uint64_t>(x) & kAxisMask) << 42 |
+         (static_cast<uint64_t>(y) & kAxisMask) << 21 | (static_cast<uint64_t>(z) & kAxisMask);
+}
+
+uint64_t VertexGrid::CellKey(const Vec3& p) const {
+  return PackKey(CellCoord(p.x), CellCoord(p.y), CellCoord(p.z));
+}
+
+void VertexGrid::Build(const Model& model) {
+  cells_.clear();
+
+  const auto& vertices = model.Vertices();
+  cells_.reserve(vertices.size() / 4 + 1);
+  for (uint32_t i = 0; i < vertices.size(); ++i) {
+    cells_[CellKey(vertices[i].position)].push_back(model.VertexIndexToId(i));
+  }
+}
+
+void VertexGrid::Move(VertexId id, const Vec3& from, const Vec3& to) {
+  const uint64_t fromKey = CellKey(from);
+  const uint64_t toKey = CellKey(to);
+  if (fromKey == toKey) return;
+
+  const auto cell = cells_.find(fromKey);
+  if (cell != cells_.end()) {
+    auto& ids = cell->second;
+    const auto it = std::find(ids.begin(), ids.end(), id);
+    if (it != ids.end()) {
+      *it = ids.back();
+      ids.pop_back();
+    }
+  }
+  cells_[toKey].push_back(id);
+}
+
+void VertexGrid::Query(const Vec3& center, float radius, std::vector<VertexId>& outIds) const {
+  const int64_t minX = CellCoord(center.x - radius);
+  const int64_t minY = CellCoord(center.y - radius);
+  const int64_t minZ = CellCoord(center.z - radius);
+  const int64_t maxX = CellCoord(center.x + radius);
+  const int64_t maxY = CellCoord(center.y + radius);
+  const int64_t maxZ = CellCoord(center.z + radius);
+
+  for (int64_t x = minX; x <= maxX; ++x) {
+    for (int64_t y = minY; y <= maxY; ++y) {
+      for (int64_t z = minZ; z <= maxZ; ++z) {
+        const auto cell = cells_.find(PackKey(x, y, z));
+        if (cell == cells_.end()) continue;
+        outIds.insert(outIds.end(), cell->second.begin(), cell->second.end());
+      }
+    }
+  }
+}
+
+}  // namespace Sculpt
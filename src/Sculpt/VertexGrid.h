@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "Core/Primitives.h"
+#include "Utilities/Vec3.h"
+
+class Model;
+
+namespace Sculpt {
+
+// Hashed uniform grid over vertex positions. With cells as wide as the brush radius a
+// query visits at most 3x3x3 cells, and moving a vertex only touches the two cells it
+// leaves and enters, so the grid follows the surface through a whole stroke.
+class VertexGrid {
+ public:
+  explicit VertexGrid(float cellSize);
+
+  void Build(const Model& model);
+  void Clear() { cells_.clear(); }
+
+  // The caller keeps the model in sync; from is the position the grid last saw
+  void Move(VertexId id, const Vec3& from, const Vec3& to);
+
+  // Appends every vertex in the cells overlapping the sphere's bounds. Candidates may lie
+  // outside the sphere itself; the brush falloff rejects those.
+  void Query(const Vec3& center, float radius, std::vector<VertexId>& outIds) const;
+
+  float CellSize() const { return cellSize_; }
+
+ private:
+  uint64_t CellKey(const Vec3& p) const;
+  static uint64_t PackKey(int64_t x, int64_t y, int64_t z);
+  int64_t CellCoord(float v) const;
+
+  float cellSize_;
+  float inverseCellSize_;
+  std::unordered_map<uint64_t, std::vector<VertexId>> cells_;
+};
+
+}  // namespace Sculpt
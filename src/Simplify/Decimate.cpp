@@ -0,0 +1,619 @@
+#include "Decimate.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "Geometry/Triangulation.h"
+#include "Model/Model.h"
+#include "Topology/EdgeTable.h"
+#include "Utilities/JobSystem.h"
+
+namespace Simplify {
+
+namespace {
+
+constexpr uint32_t kNone = UINT32_MAX;
+constexpr std::size_t kBatch = 4096;
+
+// Open borders resist sideways motion this much more than the surface resists motion
+// off its planes
+constexpr double kBorderWeight = 4.0;
+
+// A collapse may tilt a surviving triangle by at most about 78 degrees
+constexpr float kMinNormalCos = 0.2f;
+
+// A quadric minimiser further than this many edge lengths from the edge is a sign of
+// a badly conditioned system, and the endpoints are tried instead
+constexpr float kMaxTargetReach = 2.0f;
+
+enum VertexFlags : uint8_t {
+  kBorder = 1,  // on an edge used by one triangle
+  kLocked = 2,  // on a non-manifold edge; never collapsed
+  kRemoved = 4,
+};
+
+// Symmetric plane quadric: Cost(p) = p.A.p + 2 b.p + c, the summed squared distances
+// of p to every plane added
+struct Quadric {
+  double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+  double b0 = 0, b1 = 0, b2 = 0;
+  double c = 0;
+
+  // Plane n.p + d = 0 with n of unit length
+  static Quadric FromPlane(const Vec3& n, double d, double weight) {
+    Quadric q;
+    q.a00 = weight * n.x * n.x;
+    q.a01 = weight * n.x * n.y;
+    q.a02 = weight * n.x * n.z;
+    q.a11 = weight * n.y * n.y;
+    q.a12 = weight * n.y * n.z;
+    q.a22 = weight * n.z * n.z;
+    q.b0 = weight * n.x * d;
+    q.b1 = weight * n.y * d;
+    q.b2 = weight * n.z * d;
+    q.c = weight * d * d;
+    return q;
+  }
+
+  Quadric& operator+=(const Quadric& o) {
+    a00 += o.a00;
+    a01 += o.a01;
+    a02 += o.a02;
+    a11 += o.a11;
+    a12 += o.a12;
+    a22 += o.a22;
+    b0 += o.b0;
+    b1 += o.b1;
+    b2 += o.b2;
+    c += o.c;
+    return *this;
+  }
+
+  double Cost(const Vec3& p) const {
+    const double x = p.x, y = p.y, z = p.z;
+    const double cost = x * (a00 * x + 2.0 * (a01 * y + a02 * z + b0)) +
+                        y * (a11 * y + 2.0 * (a12 * z + b1)) + z * (a22 * z + 2.0 * b2) + c;
+    return std::max(cost, 0.0);
+  }
+
+  // Point of least cost, when A is far enough from singular (flat or creased regions
+  // have a line or plane of minimisers instead)
+  bool Minimum(Vec3& out) const {
+    const double c00 = a11 * a22 - a12 * a12;
+    const double c01 = a02 * a12 - a01 * a22;
+    const double c02 = a01 * a12 - a02 * a11;
+    const double det = a00 * c00 + a01 * c01 + a02 * c02;
+    const double trace = a00 + a11 + a22;
+    if (!(std::abs(det) > 1e-6 * trace * trace * trace)) return false;
+
+    const double c11 = a00 * a22 - a02 * a02;
+    const double c12 = a01 * a02 - a00 * a12;
+    const double c22 = a00 * a11 - a01 * a01;
+    const double inv = -1.0 / det;
+    out = Vec3(static_cast<float>(inv * (c00 * b0 + c01 * b1 + c02 * b2)),
+               static_cast<float>(inv * (c01 * b0 + c11 * b1 + c12 * b2)),
+               static_cast<float>(inv * (c02 * b0 + c12 * b1 + c22 * b2)));
+    return std::isfinite(out.x) && std::isfinite(out.y) && std::isfinite(out.z);
+  }
+};
+
+// Edge waiting in the collapse queue. Entries go stale rather than being removed: one
+// is only acted on while its endpoints' stamps still add up to what they were when it
+// was scored. Stamps only grow, so the sum changes whenever either of them does.
+struct Candidate {
+  float cost;
+  uint32_t a;
+  uint32_t b;
+  uint32_t stamps;
+};
+
+// Priority queue bucketed on the top 16 bits of the cost. Non-negative floats sort like
+// their bit patterns, so a bucket spans costs within 1% of each other; candidates in
+// one bucket come out in any order, and pushes and pops cost a bitmap scan at most.
+// A binary heap spends most of a large decimation in cache misses instead.
+class CostQueue {
+ public:
+  CostQueue() : buckets_(kBuckets), occupied_(kBuckets / 64, 0) {}
+
+  bool Empty() const { return size_ == 0; }
+
+  void Push(const Candidate& candidate) {
+    const uint32_t bucket = std::bit_cast<uint32_t>(candidate.cost) >> 16;
+    buckets_[bucket].push_back(candidate);
+    occupied_[bucket / 64] |= uint64_t{1} << (bucket % 64);
+    lowest_ = std::min(lowest_, bucket);
+    ++size_;
+  }
+
+  Candidate Pop() {
+    uint32_t word = lowest_ / 64;
+    uint64_t bits = occupied_[word] & (~uint64_t{0} << (lowest_ % 64));
+    while (bits == 0) bits = occupied_[++word];
+    lowest_ = word * 64 + static_cast<uint32_t>(std::countr_zero(bits));
+
+    std::vector<Candidate>& bucket = buckets_[lowest_];
+    const Candidate candidate = bucket.back();
+    bucket.pop_back();
+    if (bucket.empty()) occupied_[word] &= ~(uint64_t{1} << (lowest_ % 64));
+    --size_;
+    return candidate;
+  }
+
+ private:
+  // Finite non-negative floats stay below 0x7F800000
+  static constexpr uint32_t kBuckets = 0x8000;
+
+  std::vector<std::vector<Candidate>> buckets_;
+  std::vector<uint64_t> occupied_;
+  uint32_t lowest_ = kBuckets;
+  std::size_t size_ = 0;
+};
+
+// Triangle soup with per-vertex quadrics and incident triangle lists, collapsed in
+// place. Incident lists live in one pool; a collapse writes the merged list of the
+// surviving vertex at the end, and the pool is compacted once it doubles.
+class Decimator {
+ public:
+  Decimator(const Model& model, std::span<const FaceId> faces);
+
+  // Collapse until at most target triangles are left, or the next collapse would cost
+  // more than maxError
+  void Reduce(std::size_t target, float maxError);
+
+  std::size_t TriangleCount() const { return liveTriangles_; }
+  float Error() const { return error_; }
+  const Geometry::Aabb& Bounds() const { return bounds_; }
+
+  Result ToResult() const;
+  void ToView(FaceView& out) const;
+
+ private:
+  Vec3 TriangleNormal(uint32_t t) const {
+    const Vec3& p0 = positions_[corners_[3 * t]];
+    return (positions_[corners_[3 * t + 1]] - p0).Cross(positions_[corners_[3 * t + 2]] - p0);
+  }
+
+  bool Contains(uint32_t t, uint32_t v) const {
+    return corners_[3 * t] == v || corners_[3 * t + 1] == v || corners_[3 * t + 2] == v;
+  }
+
+  std::span<const uint32_t> Incident(uint32_t v) const {
+    return std::span<const uint32_t>(refs_).subspan(refStart_[v], refCount_[v]);
+  }
+
+  void BuildQuadrics(const std::vector<Edge>& edges, const std::vector<uint8_t>& edgeUses,
+                     const std::vector<uint32_t>& edgeTriangles);
+  void BuildQueue(const std::vector<Edge>& edges);
+
+  float Score(uint32_t a, uint32_t b, Vec3& target) const;
+  Candidate MakeCandidate(uint32_t a, uint32_t b) const;
+  bool CanCollapse(uint32_t a, uint32_t b, const Vec3& target);
+  void Collapse(uint32_t a, uint32_t b, const Vec3& target);
+  void CompactRefs();
+
+  std::vector<Vec3> positions_;
+  std::vector<Quadric> quadrics_;
+  std::vector<uint32_t> stamps_;
+  std::vector<uint8_t> flags_;
+  std::vector<uint32_t> refStart_;
+  std::vector<uint32_t> refCount_;
+  std::vector<uint32_t> refs_;
+  std::size_t compactRefSize_ = 0;
+
+  std::vector<uint32_t> corners_;  // 3 per triangle
+  std::vector<FaceId> origins_;
+  std::vector<uint8_t> deadTriangles_;
+  std::size_t liveTriangles_ = 0;
+
+  CostQueue queue_;
+  std::vector<uint32_t> marks_;
+  uint32_t markToken_ = 0;
+
+  Geometry::Aabb bounds_;
+  float error_ = 0.0f;
+  bool closed_ = false;
+};
+
+Decimator::Decimator(const Model& model, std::span<const FaceId> faces) {
+  std::vector<FaceId> region;
+  region.reserve(faces.size());
+  for (FaceId fid : faces) {
+    if (model.ContainsFace(fid) && model.FaceLoop(fid).size() >= 3) region.push_back(fid);
+  }
+  std::sort(region.begin(), region.end());
+  region.erase(std::unique(region.begin(), region.end()), region.end());
+
+  // Model vertices are renumbered densely in first use order
+  std::vector<uint32_t> compact(model.Vertices().size(), kNone);
+  std::vector<Vec3> loopPoints;
+  std::vector<uint32_t> loopCorners;
+  for (FaceId fid : region) {
+    const auto loop = model.FaceLoop(fid);
+    loopPoints.clear();
+    for (VertexId vid : loop) loopPoints.push_back(model.GetVertex(vid).position);
+    loopCorners.clear();
+    Geometry::TriangulatePolygon(loopPoints, model.FaceNormal(fid), loopCorners);
+
+    for (std::size_t i = 0; i < loopCorners.size(); i += 3) {
+      uint32_t triangle[3];
+      for (int k = 0; k < 3; ++k) {
+        const VertexId vid = loop[loopCorners[i + k]];
+        uint32_t& index = compact[model.VertexIdToIndex(vid)];
+        if (index == kNone) {
+          index = static_cast<uint32_t>(positions_.size());
+          positions_.push_back(model.GetVertex(vid).position);
+          bounds_.Expand(positions_.back());
+        }
+        triangle[k] = index;
+      }
+      if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[2] == triangle[0]) {
+        continue;
+      }
+      corners_.insert(corners_.end(), triangle, triangle + 3);
+      origins_.push_back(fid);
+    }
+  }
+
+  const std::size_t vertexCount = positions_.size();
+  const std::size_t triangleCount = origins_.size();
+  liveTriangles_ = triangleCount;
+  deadTriangles_.assign(triangleCount, 0);
+  stamps_.assign(vertexCount, 0);
+  flags_.assign(vertexCount, 0);
+  marks_.assign(vertexCount, 0);
+
+  // Counting sort of triangles by corner vertex
+  refStart_.assign(vertexCount + 1, 0);
+  for (uint32_t v : corners_) ++refStart_[v + 1];
+  for (std::size_t v = 0; v < vertexCount; ++v) refStart_[v + 1] += refStart_[v];
+  refCount_.assign(vertexCount, 0);
+  refs_.resize(corners_.size());
+  for (uint32_t c = 0; c < corners_.size(); ++c) {
+    const uint32_t v = corners_[c];
+    refs_[refStart_[v] + refCount_[v]++] = c / 3;
+  }
+  refStart_.pop_back();
+  compactRefSize_ = refs_.size();
+
+  // Edges with the number of triangles using them; one is a border, three or more is
+  // non-manifold
+  std::vector<Edge> edges;
+  std::vector<uint8_t> edgeUses;
+  std::vector<uint32_t> edgeTriangles;
+  Topology::EdgeTable table(edges);
+  table.Reserve(corners_.size() / 2 + 3);
+  for (uint32_t t = 0; t < triangleCount; ++t) {
+    for (int k = 0; k < 3; ++k) {
+      const uint32_t e = table.FindOrAdd(corners_[3 * t + k], corners_[3 * t + (k + 1) % 3]);
+      if (e == edgeUses.size()) {
+        edgeUses.push_back(0);
+        edgeTriangles.push_back(t);
+      }
+      if (edgeUses[e] < UINT8_MAX) ++edgeUses[e];
+    }
+  }
+  closed_ = triangleCount > 0 &&
+            std::all_of(edgeUses.begin(), edgeUses.end(), [](uint8_t u) { return u == 2; });
+  for (std::size_t e = 0; e < edges.size(); ++e) {
+    const uint8_t flag = edgeUses[e] == 1 ? kBorder : edgeUses[e] > 2 ? kLocked : 0;
+    flags_[edges[e].a] |= flag;
+    flags_[edges[e].b] |= flag;
+  }
+
+  BuildQuadrics(edges, edgeUses, edgeTriangles);
+  BuildQueue(edges);
+}
+
+void Decimator::BuildQuadrics(const std::vector<Edge>& edges,
+                              const std::vector<uint8_t>& edgeUses,
+                              const std::vector<uint32_t>& edgeTriangles) {
+  // Every vertex sums the planes of its own triangles, so vertices are independent
+  quadrics_.assign(positions_.size(), Quadric{});
+  Jobs::ParallelFor(positions_.size(), kBatch, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t v = begin; v < end; ++v) {
+      for (uint32_t t : Incident(static_cast<uint32_t>(v))) {
+        const Vec3 normal = TriangleNormal(t);
+        const float length = normal.Length();
+        if (!(length > 0.0f)) continue;
+        const Vec3 n = normal * (1.0f / length);
+        quadrics_[v] += Quadric::FromPlane(n, -n.Dot(positions_[corners_[3 * t]]), 1.0);
+      }
+    }
+  });
+
+  // Borders: a plane through the edge, perpendicular to its triangle
+  for (std::size_t e = 0; e < edges.size(); ++e) {
+    if (edgeUses[e] != 1) continue;
+    const Vec3& a = positions_[edges[e].a];
+    const Vec3 side = (positions_[edges[e].b] - a).Cross(TriangleNormal(edgeTriangles[e]));
+    const float length = side.Length();
+    if (!(length > 0.0f)) continue;
+    const Vec3 n = side * (1.0f / length);
+    const Quadric border = Quadric::FromPlane(n, -n.Dot(a), kBorderWeight);
+    quadrics_[edges[e].a] += border;
+    quadrics_[edges[e].b] += border;
+  }
+}
+
+void Decimator::BuildQueue(const std::vector<Edge>& edges) {
+  std::vector<Candidate> candidates(edges.size());
+  Jobs::ParallelFor(edges.size(), kBatch, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t e = begin; e < end; ++e) {
+      candidates[e] = MakeCandidate(edges[e].a, edges[e].b);
+    }
+  });
+  for (const Candidate& candidate : candidates) {
+    if (std::isfinite(candidate.cost)) queue_.Push(candidate);
+  }
+}
+
+float Decimator::Score(uint32_t a, uint32_t b, Vec3& target) const {
+  Quadric q = quadrics_[a];
+  q += quadrics_[b];
+
+  // A border vertex stays where it is when the other end is inside
+  const bool borderA = (flags_[a] & kBorder) != 0;
+  const bool borderB = (flags_[b] & kBorder) != 0;
+  if (borderA != borderB) {
+    target = borderA ? positions_[a] : positions_[b];
+    return static_cast<float>(q.Cost(target));
+  }
+
+  const Vec3& pa = positions_[a];
+  const Vec3& pb = positions_[b];
+  const Vec3 middle = (pa + pb) * 0.5f;
+  if (q.Minimum(target) && (target - middle).LengthSquared() <=
+                               kMaxTargetReach * kMaxTargetReach * (pb - pa).LengthSquared()) {
+    return static_cast<float>(q.Cost(target));
+  }
+
+  target = middle;
+  double best = q.Cost(middle);
+  for (const Vec3* p : {&pa, &pb}) {
+    const double cost = q.Cost(*p);
+    if (cost < best) {
+      best = cost;
+      target = *p;
+    }
+  }
+  return static_cast<float>(best);
+}
+
+Candidate Decimator::MakeCandidate(uint32_t a, uint32_t b) const {
+  if ((flags_[a] | flags_[b]) & kLocked) return {INFINITY, a, b, 0};
+  Vec3 target;
+  return {Score(a, b, target), a, b, stamps_[a] + stamps_[b]};
+}
+
+void Decimator::Reduce(std::size_t target, float maxError) {
+  while (liveTriangles_ > target && !queue_.Empty()) {
+    const Candidate candidate = queue_.Pop();
+
+    const uint32_t a = candidate.a;
+    const uint32_t b = candidate.b;
+    if (((flags_[a] | flags_[b]) & kRemoved) || stamps_[a] + stamps_[b] != candidate.stamps) {
+      continue;
+    }
+
+    // Everything still queued costs at least as much; keep it for a later call with a
+    // looser bound
+    const float error = std::sqrt(candidate.cost);
+    if (error > maxError) {
+      queue_.Push(candidate);
+      return;
+    }
+
+    Vec3 position;
+    Score(a, b, position);
+    if (!CanCollapse(a, b, position)) continue;
+    Collapse(a, b, position);
+    error_ = std::max(error_, error);
+  }
+}
+
+bool Decimator::CanCollapse(uint32_t a, uint32_t b, const Vec3& target) {
+  // Triangles on the edge, and the vertices around a
+  const uint32_t aroundA = ++markToken_;
+  uint32_t shared = 0;
+  for (uint32_t t : Incident(a)) {
+    if (deadTriangles_[t]) continue;
+    if (Contains(t, b)) ++shared;
+    for (int k = 0; k < 3; ++k) marks_[corners_[3 * t + k]] = aroundA;
+  }
+  if (shared == 0 || shared > 2) return false;
+
+  // Joining two border vertices across the inside would pinch the surface
+  const bool borderA = (flags_[a] & kBorder) != 0;
+  const bool borderB = (flags_[b] & kBorder) != 0;
+  if (borderA && borderB && shared != 1) return false;
+
+  // Link condition: the only vertices next to both ends are the tips of the edge's own
+  // triangles
+  const uint32_t counted = ++markToken_;
+  uint32_t common = 0;
+  for (uint32_t t : Incident(b)) {
+    if (deadTriangles_[t]) continue;
+    for (int k = 0; k < 3; ++k) {
+      const uint32_t v = corners_[3 * t + k];
+      if (v != a && v != b && marks_[v] == aroundA) {
+        marks_[v] = counted;
+        ++common;
+      }
+    }
+  }
+  if (common != shared) return false;
+
+  // No surviving triangle may flip, collapse to a sliver or duplicate one around a
+  for (const uint32_t v : {a, b}) {
+    for (uint32_t t : Incident(v)) {
+      if (deadTriangles_[t] || Contains(t, v == a ? b : a)) continue;
+
+      Vec3 p[3];
+      uint32_t others[2];
+      int otherCount = 0;
+      for (int k = 0; k < 3; ++k) {
+        const uint32_t corner = corners_[3 * t + k];
+        p[k] = corner == v ? target : positions_[corner];
+        if (corner != v) others[otherCount++] = corner;
+      }
+      const Vec3 before = TriangleNormal(t);
+      const Vec3 after = (p[1] - p[0]).Cross(p[2] - p[0]);
+      const float scale = before.Length() * after.Length();
+      if (!(scale > 0.0f) || before.Dot(after) < kMinNormalCos * scale) return false;
+
+      if (v == b) {
+        for (uint32_t u : Incident(a)) {
+          if (!deadTriangles_[u] && Contains(u, others[0]) && Contains(u, others[1])) return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+void Decimator::Collapse(uint32_t a, uint32_t b, const Vec3& target) {
+  positions_[a] = target;
+  quadrics_[a] += quadrics_[b];
+  flags_[a] |= flags_[b] & kBorder;
+  flags_[b] |= kRemoved;
+  ++stamps_[a];
+
+  // Merged incident list of a, written at the end of the pool. Indexing rather than
+  // iterating since the pool may grow underneath.
+  const auto start = static_cast<uint32_t>(refs_.size());
+  for (uint32_t i = refStart_[a], end = refStart_[a] + refCount_[a]; i < end; ++i) {
+    const uint32_t t = refs_[i];
+    if (deadTriangles_[t]) continue;
+    if (Contains(t, b)) {
+      deadTriangles_[t] = 1;
+      --liveTriangles_;
+      continue;
+    }
+    refs_.push_back(t);
+  }
+  for (uint32_t i = refStart_[b], end = refStart_[b] + refCount_[b]; i < end; ++i) {
+    const uint32_t t = refs_[i];
+    if (deadTriangles_[t]) continue;
+    for (int k = 0; k < 3; ++k) {
+      if (corners_[3 * t + k] == b) corners_[3 * t + k] = a;
+    }
+    refs_.push_back(t);
+  }
+  refStart_[a] = start;
+  refCount_[a] = static_cast<uint32_t>(refs_.size()) - start;
+  refCount_[b] = 0;
+
+  // Rescore the edges around a
+  const uint32_t queued = ++markToken_;
+  marks_[a] = queued;
+  for (uint32_t t : Incident(a)) {
+    for (int k = 0; k < 3; ++k) {
+      const uint32_t v = corners_[3 * t + k];
+      if (marks_[v] == queued) continue;
+      marks_[v] = queued;
+      const Candidate candidate = MakeCandidate(a, v);
+      if (std::isfinite(candidate.cost)) queue_.Push(candidate);
+    }
+  }
+
+  if (refs_.size() > 2 * compactRefSize_) CompactRefs();
+}
+
+void Decimator::CompactRefs() {
+  std::vector<uint32_t> packed;
+  packed.reserve(3 * liveTriangles_);
+  for (std::size_t v = 0; v < positions_.size(); ++v) {
+    const auto start = static_cast<uint32_t>(packed.size());
+    for (uint32_t t : Incident(static_cast<uint32_t>(v))) {
+      if (!deadTriangles_[t]) packed.push_back(t);
+    }
+    refStart_[v] = start;
+    refCount_[v] = static_cast<uint32_t>(packed.size()) - start;
+  }
+  refs_ = std::move(packed);
+  compactRefSize_ = std::max<std::size_t>(refs_.size(), 1024);
+}
+
+Result Decimator::ToResult() const {
+  Result result;
+  result.error = error_;
+
+  std::vector<uint32_t> compact(positions_.size(), kNone);
+  Topology::EdgeTable table(result.mesh.edges);
+  table.Reserve(liveTriangles_ * 3 / 2 + 3);
+  result.mesh.faceEdges.reserve(liveTriangles_ * 3);
+  result.mesh.faceOffsets.reserve(liveTriangles_ + 1);
+  result.faceOrigins.reserve(liveTriangles_);
+
+  for (uint32_t t = 0; t < origins_.size(); ++t) {
+    if (deadTriangles_[t]) continue;
+    uint32_t loop[3];
+    for (int k = 0; k < 3; ++k) {
+      uint32_t& index = compact[corners_[3 * t + k]];
+      if (index == kNone) {
+        index = static_cast<uint32_t>(result.mesh.positions.size());
+        result.mesh.positions.push_back(positions_[corners_[3 * t + k]]);
+      }
+      loop[k] = index;
+    }
+    Topology::AddFaceLoop(result.mesh, table, loop);
+    result.faceOrigins.push_back(origins_[t]);
+  }
+
+  // Collapses that pass the link condition keep a closed surface closed
+  if (closed_ && liveTriangles_ > 0) {
+    std::vector<uint32_t> volume(result.mesh.FaceCount());
+    for (uint32_t f = 0; f < volume.size(); ++f) volume[f] = f;
+    result.mesh.AddVolume(volume);
+  }
+  return result;
+}
+
+void Decimator::ToView(FaceView& out) const {
+  out.Clear();
+  out.vertices.reserve(liveTriangles_ * 3);
+  out.primitiveIds.reserve(liveTriangles_ * 3);
+  for (uint32_t t = 0; t < origins_.size(); ++t) {
+    if (deadTriangles_[t]) continue;
+    for (int k = 0; k < 3; ++k) {
+      out.vertices.push_back(positions_[corners_[3 * t + k]]);
+      out.primitiveIds.push_back(origins_[t] + 1);
+    }
+  }
+  out.primitiveCount = liveTriangles_;
+}
+
+}  // namespace
+
+Result Decimate(const Model& model, std::span<const FaceId> faces, const Options& options) {
+  Decimator decimator(model, faces);
+  decimator.Reduce(options.targetTriangles, options.maxError);
+  return decimator.ToResult();
+}
+
+LodChain BuildLodChain(const Model& model, std::span<const FaceId> faces, uint32_t maxLevels,
+                       float ratio, std::size_t minTriangles) {
+  Decimator decimator(model, faces);
+  LodChain chain;
+  chain.bounds = decimator.Bounds();
+
+  // One decimator walks down through every level, so the whole chain costs about as
+  // much as decimating to the coarsest level once
+  while (chain.levels.size() < maxLevels && decimator.TriangleCount() > minTriangles) {
+    const std::size_t count = decimator.TriangleCount();
+    const auto target = std::max(minTriangles, static_cast<std::size_t>(count * ratio));
+    decimator.Reduce(target, INFINITY);
+
+    // Stop once collapses are mostly refused; another level would barely be cheaper
+    if (decimator.TriangleCount() > count - (count - target) / 2) break;
+
+    Lod& lod = chain.levels.emplace_back();
+    decimator.ToView(lod.view);
+    lod.error = decimator.Error();
+    lod.triangleCount = decimator.TriangleCount();
+  }
+  return chain;
+}
+
+}  // namespace Simplify
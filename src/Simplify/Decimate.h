@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Core/MeshData.h"
+#include "Core/Primitives.h"
+#include "Geometry/Aabb.h"
+#include "ModelView/ModelViews.h"
+
+class Model;
+
+// Quadric error metric simplification of a face region. Faces are triangulated and
+// edges collapsed cheapest first, each vertex carrying the summed squared distances
+// to the planes of the triangles it has absorbed; open borders are held in place by
+// perpendicular constraint planes. Collapses that would fold a triangle over or
+// pinch the surface (the link condition) are skipped, so closed manifold input stays
+// closed.
+namespace Simplify {
+
+// Collapsing stops at whichever limit is reached first
+struct Options {
+  std::size_t targetTriangles = 0;
+  // Largest geometric error allowed, in model units (see Result::error)
+  float maxError = INFINITY;
+};
+
+struct Result {
+  // Simplified triangles, ready for Model::AppendMesh (or DecimateCommand when it
+  // should be undoable). A closed region is wrapped in one volume.
+  MeshData mesh;
+
+  // faceOrigins[i] is the region face that mesh triangle i was cut from
+  std::vector<FaceId> faceOrigins;
+
+  // Square root of the largest quadric cost paid by a collapse: no vertex moved further
+  // than this from the planes of the triangles it replaced
+  float error = 0.0f;
+};
+
+// Simplify the given faces; faces that are missing or have no valid loop are skipped
+Result Decimate(const Model& model, std::span<const FaceId> faces, const Options& options);
+
+// One level of detail as a ready to draw FaceView (non indexed triangles whose ids are
+// the region faces they came from, offset by one as in ModelViewBuilder::BuildFaceView).
+// Materials are left empty since they stay per model face.
+struct Lod {
+  FaceView view;
+  float error = 0.0f;
+  std::size_t triangleCount = 0;
+};
+
+struct LodChain {
+  std::vector<Lod> levels;  // progressively coarser, full detail not included
+  Geometry::Aabb bounds;
+};
+
+// Decimate the region progressively, keeping a level each time the triangle count
+// drops by ratio, down to minTriangles or maxLevels levels
+LodChain BuildLodChain(const Model& model, std::span<const FaceId> faces, uint32_t maxLevels,
+                       float ratio = 0.25f, std::size_t minTriangles = 256);
+
+}  // namespace Simplify
@@ -0,0 +1,412 @@
+#include "CatmullClark.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "Model/Model.h"
+#include "Utilities/JobSystem.h"
+
+namespace Subdivision {
+
+namespace {
+
+constexpr uint32_t kNone = UINT32_MAX;
+constexpr std::size_t kBatch = 4096;
+
+// Polygon mesh with explicit corner loops. Face f owns corners
+// [faceOffsets[f], faceOffsets[f + 1]); cornerEdges[c] joins corner c to the next one.
+struct Cage {
+  std::vector<Vec3> positions;
+  std::vector<Edge> edges;
+  std::vector<uint32_t> cornerVertices;
+  std::vector<uint32_t> cornerEdges;
+  std::vector<uint32_t> faceOffsets{0};
+  std::vector<FaceId> faceOrigins;
+
+  std::size_t FaceCount() const { return faceOffsets.size() - 1; }
+  std::size_t CornerCount() const { return cornerVertices.size(); }
+};
+
+// Compressed lists of the faces and edges around each vertex
+struct VertexAdjacency {
+  std::vector<uint32_t> faceOffsets;
+  std::vector<uint32_t> faces;
+  std::vector<uint32_t> edgeOffsets;
+  std::vector<uint32_t> edges;
+};
+
+Cage BuildCage(const Model& model, std::span<const FaceId> faces) {
+  std::vector<FaceId> region;
+  region.reserve(faces.size());
+  for (FaceId fid : faces) {
+    if (model.ContainsFace(fid) && model.FaceLoop(fid).size() >= 3) region.push_back(fid);
+  }
+  std::sort(region.begin(), region.end());
+  region.erase(std::unique(region.begin(), region.end()), region.end());
+
+  Cage cage;
+  cage.faceOrigins = region;
+  cage.faceOffsets.reserve(region.size() + 1);
+
+  // Model vertices and edges are renumbered densely in first use order. A face loop
+  // runs along its edge list, so loop[i] -> loop[i + 1] is face.edges[i].
+  std::vector<uint32_t> compactVertices(model.Vertices().size(), kNone);
+  std::vector<uint32_t> compactEdges(model.Edges().size(), kNone);
+  for (FaceId fid : region) {
+    const auto loop = model.FaceLoop(fid);
+    for (VertexId vid : loop) {
+      uint32_t& index = compactVertices[model.VertexIdToIndex(vid)];
+      if (index == kNone) {
+        index = static_cast<uint32_t>(cage.positions.size());
+        cage.positions.push_back(model.GetVertex(vid).position);
+      }
+      cage.cornerVertices.push_back(index);
+    }
+
+    for (EdgeId eid : model.GetFace(fid).edges) {
+      uint32_t& index = compactEdges[model.EdgeIdToIndex(eid)];
+      if (index == kNone) {
+        const Edge& edge = model.GetEdge(eid);
+        index = static_cast<uint32_t>(cage.edges.size());
+        cage.edges.push_back(Edge{compactVertices[model.VertexIdToIndex(edge.a)],
+                                  compactVertices[model.VertexIdToIndex(edge.b)]});
+      }
+      cage.cornerEdges.push_back(index);
+    }
+    cage.faceOffsets.push_back(static_cast<uint32_t>(cage.cornerVertices.size()));
+  }
+  return cage;
+}
+
+// Up to two faces per edge; edgeUses counts all of them so borders (1) and
+// non-manifold edges (3+) can be told apart
+void BuildEdgeFaces(const Cage& cage, std::vector<uint32_t>& edgeFaces,
+                    std::vector<uint8_t>& edgeUses) {
+  edgeFaces.assign(cage.edges.size() * 2, kNone);
+  edgeUses.assign(cage.edges.size(), 0);
+  for (uint32_t f = 0; f < cage.FaceCount(); ++f) {
+    for (uint32_t c = cage.faceOffsets[f]; c < cage.faceOffsets[f + 1]; ++c) {
+      const uint32_t e = cage.cornerEdges[c];
+      if (edgeUses[e] < 2) edgeFaces[2 * e + edgeUses[e]] = f;
+      if (edgeUses[e] < UINT8_MAX) ++edgeUses[e];
+    }
+  }
+}
+
+void BuildVertexAdjacency(const Cage& cage, VertexAdjacency& out) {
+  const std::size_t vertexCount = cage.positions.size();
+
+  // Counting sort of corners by vertex
+  out.faceOffsets.assign(vertexCount + 1, 0);
+  for (uint32_t v : cage.cornerVertices) ++out.faceOffsets[v + 1];
+  for (std::size_t v = 0; v < vertexCount; ++v) out.faceOffsets[v + 1] += out.faceOffsets[v];
+
+  out.faces.resize(cage.CornerCount());
+  std::vector<uint32_t> cursor(out.faceOffsets.begin(), out.faceOffsets.end() - 1);
+  for (uint32_t f = 0; f < cage.FaceCount(); ++f) {
+    for (uint32_t c = cage.faceOffsets[f]; c < cage.faceOffsets[f + 1]; ++c) {
+      out.faces[cursor[cage.cornerVertices[c]]++] = f;
+    }
+  }
+
+  // And of edges by endpoint
+  out.edgeOffsets.assign(vertexCount + 1, 0);
+  for (const Edge& e : cage.edges) {
+    ++out.edgeOffsets[e.a + 1];
+    ++out.edgeOffsets[e.b + 1];
+  }
+  for (std::size_t v = 0; v < vertexCount; ++v) out.edgeOffsets[v + 1] += out.edgeOffsets[v];
+
+  out.edges.resize(cage.edges.size() * 2);
+  cursor.assign(out.edgeOffsets.begin(), out.edgeOffsets.end() - 1);
+  for (uint32_t e = 0; e < cage.edges.size(); ++e) {
+    out.edges[cursor[cage.edges[e].a]++] = e;
+    out.edges[cursor[cage.edges[e].b]++] = e;
+  }
+}
+
+// Points of one Catmull-Clark step, laid out as [vertex points, edge points, face
+// points] so every index is known before any is computed
+std::vector<Vec3> RefinePoints(const Cage& in) {
+  const auto vertexCount = static_cast<uint32_t>(in.positions.size());
+  const auto edgeCount = static_cast<uint32_t>(in.edges.size());
+  const auto faceCount = static_cast<uint32_t>(in.FaceCount());
+  const uint32_t edgeBase = vertexCount;
+  const uint32_t faceBase = vertexCount + edgeCount;
+
+  std::vector<uint32_t> edgeFaces;
+  std::vector<uint8_t> edgeUses;
+  BuildEdgeFaces(in, edgeFaces, edgeUses);
+
+  VertexAdjacency adjacency;
+  BuildVertexAdjacency(in, adjacency);
+
+  std::vector<Vec3> points(vertexCount + edgeCount + faceCount);
+
+  // Face points: centroid of the face
+  Jobs::ParallelFor(faceCount, kBatch, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t f = begin; f < end; ++f) {
+      Vec3 sum{};
+      for (uint32_t c = in.faceOffsets[f]; c < in.faceOffsets[f + 1]; ++c) {
+        sum += in.positions[in.cornerVertices[c]];
+      }
+      points[faceBase + f] =
+          sum * (1.0f / static_cast<float>(in.faceOffsets[f + 1] - in.faceOffsets[f]));
+    }
+  });
+
+  // Edge points: average of the endpoints and both face points; midpoint on borders
+  Jobs::ParallelFor(edgeCount, kBatch, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t e = begin; e < end; ++e) {
+      const Edge& edge = in.edges[e];
+      const Vec3 ends = in.positions[edge.a] + in.positions[edge.b];
+      if (edgeUses[e] == 2) {
+        const Vec3& f0 = points[faceBase + edgeFaces[2 * e]];
+        const Vec3& f1 = points[faceBase + edgeFaces[2 * e + 1]];
+        points[edgeBase + e] = (ends + f0 + f1) * 0.25f;
+      } else {
+        points[edgeBase + e] = ends * 0.5f;
+      }
+    }
+  });
+
+  // Vertex points: (F + 2R + (n - 3)P) / n inside, (6P + a + b) / 8 on a border, and
+  // pinned where borders cross or the surface is non-manifold
+  Jobs::ParallelFor(vertexCount, kBatch, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t v = begin; v < end; ++v) {
+      const Vec3& p = in.positions[v];
+      const uint32_t firstEdge = adjacency.edgeOffsets[v];
+      const uint32_t lastEdge = adjacency.edgeOffsets[v + 1];
+
+      uint32_t borderEdges = 0;
+      bool manifold = true;
+      Vec3 borderSum{};
+      Vec3 midpointSum{};
+      for (uint32_t i = firstEdge; i < lastEdge; ++i) {
+        const uint32_t e = adjacency.edges[i];
+        const Edge& edge = in.edges[e];
+        const Vec3& other = in.positions[edge.a == v ? edge.b : edge.a];
+        midpointSum += (p + other) * 0.5f;
+        if (edgeUses[e] == 1) {
+          ++borderEdges;
+          borderSum += other;
+        } else if (edgeUses[e] > 2) {
+          manifold = false;
+        }
+      }
+
+      const uint32_t n = lastEdge - firstEdge;
+      if (!manifold || (borderEdges != 0 && borderEdges != 2) || (borderEdges == 0 && n < 3)) {
+        points[v] = p;
+      } else if (borderEdges == 2) {
+        points[v] = (p * 6.0f + borderSum) * 0.125f;
+      } else {
+        Vec3 faceSum{};
+        const uint32_t firstFace = adjacency.faceOffsets[v];
+        const uint32_t lastFace = adjacency.faceOffsets[v + 1];
+        for (uint32_t i = firstFace; i < lastFace; ++i) {
+          faceSum += points[faceBase + adjacency.faces[i]];
+        }
+        const float valence = static_cast<float>(n);
+        const Vec3 f = faceSum * (1.0f / static_cast<float>(lastFace - firstFace));
+        const Vec3 r = midpointSum * (1.0f / valence);
+        points[v] = (f + r * 2.0f + p * (valence - 3.0f)) * (1.0f / valence);
+      }
+    }
+  });
+
+  return points;
+}
+
+// One Catmull-Clark step. Corner c of the input becomes quad c of the output, so all
+// topology is written in parallel into pre-sized arrays.
+Cage Refine(const Cage& in) {
+  const auto vertexCount = static_cast<uint32_t>(in.positions.size());
+  const auto edgeCount = static_cast<uint32_t>(in.edges.size());
+  const auto faceCount = static_cast<uint32_t>(in.FaceCount());
+  const auto cornerCount = static_cast<uint32_t>(in.CornerCount());
+  const uint32_t edgeBase = vertexCount;
+  const uint32_t faceBase = vertexCount + edgeCount;
+
+  Cage out;
+  out.positions = RefinePoints(in);
+  out.edges.resize(edgeCount * 2 + cornerCount);
+  out.cornerVertices.resize(cornerCount * 4);
+  out.cornerEdges.resize(cornerCount * 4);
+  out.faceOffsets.resize(cornerCount + 1);
+  out.faceOrigins.resize(cornerCount);
+  out.faceOffsets[0] = 0;
+
+  // Each edge splits in two halves (a, e) and (e, b)
+  Jobs::ParallelFor(edgeCount, kBatch, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t e = begin; e < end; ++e) {
+      const auto point = static_cast<uint32_t>(edgeBase + e);
+      out.edges[2 * e] = Edge{in.edges[e].a, point};
+      out.edges[2 * e + 1] = Edge{point, in.edges[e].b};
+    }
+  });
+
+  // Corner c becomes the quad v -> edge point -> face point -> previous edge point,
+  // keeping the winding of its face. Its inner edge joins the edge point to the face
+  // point.
+  Jobs::ParallelFor(faceCount, kBatch / 4, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t f = begin; f < end; ++f) {
+      const uint32_t first = in.faceOffsets[f];
+      const uint32_t last = in.faceOffsets[f + 1];
+      const auto facePoint = static_cast<uint32_t>(faceBase + f);
+
+      for (uint32_t c = first; c < last; ++c) {
+        const uint32_t prev = c == first ? last - 1 : c - 1;
+        const uint32_t v = in.cornerVertices[c];
+        const uint32_t next = in.cornerEdges[c];
+        const uint32_t back = in.cornerEdges[prev];
+        const uint32_t nextHalf = 2 * next + (in.edges[next].a == v ? 0 : 1);
+        const uint32_t backHalf = 2 * back + (in.edges[back].a == v ? 0 : 1);
+
+        out.edges[2 * edgeCount + c] = Edge{edgeBase + next, facePoint};
+
+        const uint32_t q = 4 * c;
+        out.cornerVertices[q] = v;
+        out.cornerVertices[q + 1] = edgeBase + next;
+        out.cornerVertices[q + 2] = facePoint;
+        out.cornerVertices[q + 3] = edgeBase + back;
+        out.cornerEdges[q] = nextHalf;
+        out.cornerEdges[q + 1] = 2 * edgeCount + c;
+        out.cornerEdges[q + 2] = 2 * edgeCount + prev;
+        out.cornerEdges[q + 3] = backHalf;
+        out.faceOffsets[c + 1] = q + 4;
+        out.faceOrigins[c] = in.faceOrigins[f];
+      }
+    }
+  });
+
+  return out;
+}
+
+// Two triangles, split along the shorter diagonal, which folds less on curved surfaces
+Vec3* EmitQuad(Vec3* out, const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d) {
+  const bool alternate = (d - b).LengthSquared() < (c - a).LengthSquared();
+  const std::array<const Vec3*, 6> corners =
+      alternate ? std::array<const Vec3*, 6>{&b, &c, &d, &b, &d, &a}
+                : std::array<const Vec3*, 6>{&a, &b, &c, &a, &c, &d};
+  for (const Vec3* corner : corners) *out++ = *corner;
+  return out;
+}
+
+// Fan out the cage polygons as they are
+void TessellateCage(const Cage& cage, FaceView& outFaces) {
+  std::vector<uint32_t> firstVertex(cage.FaceCount() + 1, 0);
+  for (std::size_t f = 0; f < cage.FaceCount(); ++f) {
+    const uint32_t n = cage.faceOffsets[f + 1] - cage.faceOffsets[f];
+    firstVertex[f + 1] = firstVertex[f] + (n - 2) * 3;
+  }
+  outFaces.vertices.resize(firstVertex.back());
+  outFaces.primitiveIds.resize(firstVertex.back());
+
+  Jobs::ParallelFor(cage.FaceCount(), kBatch, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t f = begin; f < end; ++f) {
+      const uint32_t* loop = cage.cornerVertices.data() + cage.faceOffsets[f];
+      const uint32_t n = cage.faceOffsets[f + 1] - cage.faceOffsets[f];
+      Vec3* out = outFaces.vertices.data() + firstVertex[f];
+
+      if (n == 4) {
+        EmitQuad(out, cage.positions[loop[0]], cage.positions[loop[1]], cage.positions[loop[2]],
+                 cage.positions[loop[3]]);
+      } else {
+        for (uint32_t i = 1; i + 1 < n; ++i) {
+          *out++ = cage.positions[loop[0]];
+          *out++ = cage.positions[loop[i]];
+          *out++ = cage.positions[loop[i + 1]];
+        }
+      }
+      std::fill(outFaces.primitiveIds.begin() + firstVertex[f],
+                outFaces.primitiveIds.begin() + firstVertex[f + 1], cage.faceOrigins[f] + 1);
+    }
+  });
+}
+
+// Last step straight from its points: corner c of face f is the quad vertex point,
+// edge point, face point, previous edge point, and never needs refined topology
+void TessellateRefined(const Cage& cage, FaceView& outFaces) {
+  const std::vector<Vec3> points = RefinePoints(cage);
+  const auto vertexCount = static_cast<uint32_t>(cage.positions.size());
+  const uint32_t faceBase = vertexCount + static_cast<uint32_t>(cage.edges.size());
+
+  outFaces.vertices.resize(cage.CornerCount() * 6);
+  outFaces.primitiveIds.resize(cage.CornerCount() * 6);
+
+  Jobs::ParallelFor(cage.FaceCount(), kBatch / 4, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t f = begin; f < end; ++f) {
+      const uint32_t first = cage.faceOffsets[f];
+      const uint32_t last = cage.faceOffsets[f + 1];
+      const Vec3& facePoint = points[faceBase + f];
+      Vec3* out = outFaces.vertices.data() + first * 6;
+
+      for (uint32_t c = first; c < last; ++c) {
+        const uint32_t prev = c == first ? last - 1 : c - 1;
+        out = EmitQuad(out, points[cage.cornerVertices[c]],
+                       points[vertexCount + cage.cornerEdges[c]], facePoint,
+                       points[vertexCount + cage.cornerEdges[prev]]);
+      }
+      std::fill(outFaces.primitiveIds.begin() + first * 6, outFaces.primitiveIds.begin() + last * 6,
+                cage.faceOrigins[f] + 1);
+    }
+  });
+}
+
+}  // namespace
+
+Result CatmullClark(const Model& model, std::span<const FaceId> faces, uint32_t levels) {
+  Cage cage = BuildCage(model, faces);
+
+  // Refinement keeps a closed cage closed, so checking the input is enough
+  std::vector<uint32_t> edgeFaces;
+  std::vector<uint8_t> edgeUses;
+  BuildEdgeFaces(cage, edgeFaces, edgeUses);
+  const bool closed =
+      cage.FaceCount() > 0 &&
+      std::all_of(edgeUses.begin(), edgeUses.end(), [](uint8_t u) { return u == 2; });
+
+  for (uint32_t level = 0; level < levels && cage.FaceCount() > 0; ++level) {
+    cage = Refine(cage);
+  }
+
+  Result result;
+  result.mesh.positions = std::move(cage.positions);
+  result.mesh.edges = std::move(cage.edges);
+  result.mesh.faceEdges = std::move(cage.cornerEdges);
+  result.mesh.faceOffsets = std::move(cage.faceOffsets);
+  result.faceOrigins = std::move(cage.faceOrigins);
+
+  if (closed) {
+    std::vector<uint32_t> volume(result.mesh.FaceCount());
+    for (uint32_t f = 0; f < volume.size(); ++f) volume[f] = f;
+    result.mesh.AddVolume(volume);
+  }
+  return result;
+}
+
+void BuildPreview(const Model& model, std::span<const FaceId> faces, uint32_t levels,
+                  FaceView& outFaces) {
+  outFaces.Clear();
+  Cage cage = BuildCage(model, faces);
+  if (levels == 0) {
+    TessellateCage(cage, outFaces);
+  } else {
+    for (uint32_t level = 1; level < levels && cage.FaceCount() > 0; ++level) {
+      cage = Refine(cage);
+    }
+    TessellateRefined(cage, outFaces);
+  }
+
+  // Materials stay per model face, exactly as in the unsmoothed view
+  for (const Face& face : model.Faces()) {
+    outFaces.colorIndices.push_back(face.colorIndex);
+    outFaces.roughness.push_back(face.roughness);
+    outFaces.metallicity.push_back(face.metallicity);
+  }
+  outFaces.primitiveCount = model.Faces().size();
+}
+
+}  // namespace Subdivision
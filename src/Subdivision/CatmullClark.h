@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Core/MeshData.h"
+#include "Core/Primitives.h"
+#include "ModelView/ModelViews.h"
+
+class Model;
+
+// Catmull-Clark subdivision of a face region. Each level computes face, edge and
+// vertex points in parallel and writes the refined quads into arrays sized up front,
+// so a level is a handful of linear passes with no per-element allocation. Open
+// region borders follow the cubic B-spline boundary rules.
+namespace Subdivision {
+
+struct Result {
+  // Refined geometry, ready for Model::AppendMesh (or AppendMeshCommand when it
+  // should be undoable). A closed region is wrapped in one volume.
+  MeshData mesh;
+
+  // faceOrigins[i] is the region face that mesh face i was refined from
+  std::vector<FaceId> faceOrigins;
+};
+
+// Subdivide the given faces levels times; faces that are missing or have no valid
+// loop are skipped
+Result CatmullClark(const Model& model, std::span<const FaceId> faces, uint32_t levels);
+
+// Tessellate the refined region straight into a FaceView without touching the model.
+// Triangles carry the id of the face they were refined from, offset by one as in
+// ModelViewBuilder::BuildFaceView, so picking still selects cage faces.
+void BuildPreview(const Model& model, std::span<const FaceId> faces, uint32_t levels,
+                  FaceView& outFaces);
+
+}  // namespace Subdivision
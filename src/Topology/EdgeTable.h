@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Core/MeshData.h"
+#include "Core/Primitives.h"
+
+namespace Topology {
+
+// -------------------------------------------------
+// Undirected edge lookup keyed on the (min, max) vertex pair
+// -------------------------------------------------
+class EdgeTable {
+ public:
+  explicit EdgeTable(std::vector<Edge>& edges) : edges_(edges) {
+    Rehash(edges.size());
+    for (uint32_t i = 0; i < edges.size(); ++i) Insert(Key(edges[i].a, edges[i].b), i);
+  }
+
+  void Reserve(std::size_t count) {
+    edges_.reserve(count);
+    if (count > Capacity()) Rehash(count);
+  }
+
+  std::optional<uint32_t> Find(uint32_t a, uint32_t b) const {
+    const uint64_t key = Key(a, b);
+    for (std::size_t slot = Hash(key) & mask_;; slot = (slot + 1) & mask_) {
+      if (slots_[slot].value == kEmpty) return std::nullopt;
+      if (slots_[slot].key == key) return slots_[slot].value;
+    }
+  }
+
+  // Returns the index of the edge joining a and b, appending it if it is new
+  uint32_t FindOrAdd(uint32_t a, uint32_t b) {
+    const uint64_t key = Key(a, b);
+    for (std::size_t slot = Hash(key) & mask_;; slot = (slot + 1) & mask_) {
+      if (slots_[slot].value == kEmpty) {
+        const auto index = static_cast<uint32_t>(edges_.size());
+        edges_.push_back(Edge{a, b});
+        slots_[slot] = {key, index};
+        if (edges_.size() > Capacity()) Rehash(edges_.size() * 2);
+        return index;
+      }
+      if (slots_[slot].key == key) return slots_[slot].value;
+    }
+  }
+
+ private:
+  // Open addressing with linear probing; far fewer cache misses than node based maps
+  struct Slot {
+    uint64_t key = 0;
+    uint32_t value = kEmpty;
+  };
+
+  static constexpr uint32_t kEmpty = UINT32_MAX;
+
+  static uint64_t Key(uint32_t a, uint32_t b) {
+    const uint64_t lo = a < b ? a : b;
+    const uint64_t hi = a < b ? b : a;
+    return (hi << 32) | lo;
+  }
+
+  static std::size_t Hash(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDull;
+    key ^= key >> 33;
+    return static_cast<std::size_t>(key);
+  }
+
+  // Keep the load factor at or below one half
+  std::size_t Capacity() const { return slots_.size() / 2; }
+
+  void Insert(uint64_t key, uint32_t value) {
+    std::size_t slot = Hash(key) & mask_;
+    while (slots_[slot].value != kEmpty && slots_[slot].key != key) slot = (slot + 1) & mask_;
+    slots_[slot] = {key, value};
+  }
+
+  void Rehash(std::size_t count) {
+    std::size_t size = 16;
+    while (size / 2 < count) size *= 2;
+
+    std::vector<Slot> old = std::move(slots_);
+    slots_.assign(size, Slot{});
+    mask_ = size - 1;
+    for (const Slot& slot : old) {
+      if (slot.value != kEmpty) Insert(slot.key, slot.value);
+    }
+  }
+
+  std::vector<Slot> slots_;
+  std::size_t mask_ = 0;
+  std::vector<Edge>& edges_;
+};
+
+// -------------------------------------------------
+// Append a face given as an ordered vertex loop, sharing existing edges
+// -------------------------------------------------
+inline uint32_t AddFaceLoop(MeshData& mesh, EdgeTable& table, std::span<const uint32_t> loop) {
+  const std::size_t n = loop.size();
+  for (std::size_t i = 0; i < n; ++i) {
+    mesh.faceEdges.push_back(table.FindOrAdd(loop[i], loop[(i + 1) % n]));
+  }
+  mesh.faceOffsets.push_back(static_cast<uint32_t>(mesh.faceEdges.size()));
+  return static_cast<uint32_t>(mesh.FaceCount() - 1);
+}
+
+}  // namespace Topology
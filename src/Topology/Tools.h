@@ -9,37 +9,51 @@
 namespace Topology {
 
 // -------------------------------------------------
-// Extract ordered vertex loop from a face
+// Extract ordered vertex loop from a face into a reusable buffer.
+// Edge face.edges[i] runs from out[i] to out[(i + 1) % n]. out is left empty if the
+// edges do not chain.
 // -------------------------------------------------
 template <typename EdgeContainer>
-std::vector<VertexId> ExtractVertices(const Face& face, const EdgeContainer& edges) {
-  std::vector<VertexId> result;
+void ExtractVertices(const Face& face, const EdgeContainer& edges, std::vector<VertexId>& out) {
+  out.clear();
 
-  if (face.edges.size() < 3) return result;
+  if (face.edges.size() < 3) return;
+  out.reserve(face.edges.size() + 1);
 
-  // Start with first edge
+  // Start with first edge, oriented so that it leads into the second one
   const Edge& first = edges[face.edges[0]];
-  result.push_back(first.a);
-  result.push_back(first.b);
+  const Edge& second = edges[face.edges[1]];
+  const bool reversed = first.a == second.a || first.a == second.b;
+  out.push_back(reversed ? first.b : first.a);
+  out.push_back(reversed ? first.a : first.b);
 
   // Chain remaining edges
   for (size_t i = 1; i < face.edges.size(); ++i) {
     const Edge& e = edges[face.edges[i]];
-    VertexId last = result.back();
+    VertexId last = out.back();
 
     if (e.a == last) {
-      result.push_back(e.b);
+      out.push_back(e.b);
     } else if (e.b == last) {
-      result.push_back(e.a);
+      out.push_back(e.a);
     } else {
       // Non-contiguous edge → invalid face
-      return {};
+      out.clear();
+      return;
     }
   }
 
   // Close loop: remove duplicate final vertex if needed
-  if (result.front() == result.back()) result.pop_back();
+  if (out.front() == out.back()) out.pop_back();
+}
 
+// -------------------------------------------------
+// Extract ordered vertex loop from a face
+// -------------------------------------------------
+template <typename EdgeContainer>
+std::vector<VertexId> ExtractVertices(const Face& face, const EdgeContainer& edges) {
+  std::vector<VertexId> result;
+  ExtractVertices(face, edges, result);
   return result;
 }
 
@@ -1,58 +1,272 @@
 #pragma once
 
-#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
 
 #include "Core/Primitives.h"
 #include "Topology/Tools.h"
+#include "Utilities/JobSystem.h"
 
 namespace Topology {
+
+// -------------------------------------------------
+// Validation verdicts
+// -------------------------------------------------
+enum class Defect : uint8_t {
+  None,
+  TooFewElements,       // fewer than 3 edges / 4 faces
+  MissingElement,       // references an edge or face that does not exist
+  DuplicateElement,     // the same edge or face is listed twice
+  BadVertexDegree,      // a face vertex is not shared by exactly two of its edges
+  BrokenLoop,           // face edges do not chain into a single loop
+  Degenerate,           // face vertices are collinear, enclosing no area (geometric)
+  NotPlanar,            // face vertices do not lie in one plane (geometric)
+  OpenBoundary,         // a volume edge is used by only one face
+  NonManifoldEdge,      // a volume edge is used by more than two faces
+  NonOrientable,        // no choice of face windings makes the shell consistent
+  InconsistentWinding,  // shell is orientable but faces are not wound consistently
+};
+
+inline const char* DefectName(Defect defect) {
+  switch (defect) {
+    case Defect::None: return "valid";
+    case Defect::TooFewElements: return "too few elements";
+    case Defect::MissingElement: return "missing element";
+    case Defect::DuplicateElement: return "duplicate element";
+    case Defect::BadVertexDegree: return "vertex not shared by exactly two edges";
+    case Defect::BrokenLoop: return "edges do not form a single loop";
+    case Defect::Degenerate: return "vertices are collinear";
+    case Defect::NotPlanar: return "vertices are not coplanar";
+    case Defect::OpenBoundary: return "edge used by only one face";
+    case Defect::NonManifoldEdge: return "edge used by more than two faces";
+    case Defect::NonOrientable: return "shell is not orientable";
+    case Defect::InconsistentWinding: return "faces are not wound consistently";
+  }
+  return "unknown";
+}
+
+namespace detail {
+
+// Edge use packed as edge << 32 | face << 1 | forward, so plain integer sorting groups
+// the uses of each edge. face indexes the volume's face list; forward is set when the
+// face loop runs edge.a -> edge.b.
+inline uint64_t PackEdgeUse(EdgeId edge, uint32_t face, bool forward) {
+  return (static_cast<uint64_t>(edge) << 32) | (static_cast<uint64_t>(face) << 1) |
+         (forward ? 1u : 0u);
+}
+
+// Per thread buffers so validation never touches the allocator once warmed up
+struct ValidationScratch {
+  std::vector<VertexId> endpoints;
+  std::vector<VertexId> loop;
+  std::vector<FaceId> faceIds;
+  std::vector<Edge> faceEdges;
+  std::vector<uint64_t> uses;
+  std::vector<uint32_t> parent;
+  std::vector<uint8_t> parity;
+};
+
+inline ValidationScratch& Scratch() {
+  thread_local ValidationScratch scratch;
+  return scratch;
+}
+
+// Union-find over faces, tracking whether each face is flipped relative to its root
+inline uint32_t FindRoot(ValidationScratch& s, uint32_t face, uint8_t& flipped) {
+  flipped = 0;
+  uint32_t root = face;
+  while (s.parent[root] != root) {
+    flipped ^= s.parity[root];
+    root = s.parent[root];
+  }
+
+  // Path compression, keeping parities relative to the new parent
+  uint8_t remaining = flipped;
+  while (s.parent[face] != root) {
+    const uint32_t next = s.parent[face];
+    const uint8_t step = s.parity[face];
+    s.parent[face] = root;
+    s.parity[face] = remaining;
+    remaining ^= step;
+    face = next;
+  }
+  return root;
+}
+
+}  // namespace detail
+
 // -------------------------------------------------
 // Validate face topology
 // -------------------------------------------------
 template <typename EdgeContainer>
-bool IsValidFace(const Face& face, const EdgeContainer& edges) {
-  if (face.edges.size() < 3) return false;
+Defect CheckFace(const Face& face, const EdgeContainer& edges, std::vector<VertexId>& outLoop) {
+  outLoop.clear();
+  if (face.edges.size() < 3) return Defect::TooFewElements;
 
-  // Count vertex degrees
-  std::unordered_map<VertexId, int> degree;
+  for (EdgeId eid : face.edges) {
+    if (!edges.Contains(eid)) return Defect::MissingElement;
+  }
 
+  // In a closed loop every vertex has degree 2, so sorted endpoints come in exact pairs
+  auto& endpoints = detail::Scratch().endpoints;
+  endpoints.clear();
   for (EdgeId eid : face.edges) {
     const Edge& e = edges.Get(eid);
-    degree[e.a]++;
-    degree[e.b]++;
+    endpoints.push_back(e.a);
+    endpoints.push_back(e.b);
   }
+  std::sort(endpoints.begin(), endpoints.end());
 
-  // In a closed loop, each vertex has degree 2
-  for (const auto& [_, count] : degree) {
-    if (count != 2) return false;
+  for (std::size_t i = 0; i < endpoints.size(); i += 2) {
+    if (endpoints[i] != endpoints[i + 1]) return Defect::BadVertexDegree;
+    if (i + 2 < endpoints.size() && endpoints[i + 2] == endpoints[i]) {
+      return Defect::BadVertexDegree;
+    }
   }
 
   // Ensure edges form a single loop
-  auto verts = ExtractVertices(face, edges);
-  return verts.size() >= 3;
+  ExtractVertices(face, edges, outLoop);
+  if (outLoop.size() != face.edges.size()) {
+    outLoop.clear();
+    return Defect::BrokenLoop;
+  }
+  return Defect::None;
+}
+
+template <typename EdgeContainer>
+bool IsValidFace(const Face& face, const EdgeContainer& edges, std::vector<VertexId>& outLoop) {
+  return CheckFace(face, edges, outLoop) == Defect::None;
+}
+
+template <typename EdgeContainer>
+bool IsValidFace(const Face& face, const EdgeContainer& edges) {
+  return CheckFace(face, edges, detail::Scratch().loop) == Defect::None;
 }
 
 // -------------------------------------------------
 // Validate volume topology
 // -------------------------------------------------
-template <typename FaceContainer>
-bool IsValidVolume(const Volume& volume, const FaceContainer& faces) {
-  if (volume.faces.size() < 4) return false;
+// Each edge of a closed shell must be shared by exactly two faces, and the faces must
+// admit a consistent orientation. With requireConsistentWinding the faces must also
+// already be wound that way (every shared edge traversed in opposite directions).
+template <typename FaceContainer, typename EdgeContainer>
+Defect CheckVolume(const Volume& volume, const FaceContainer& faces, const EdgeContainer& edges,
+                   bool requireConsistentWinding = false) {
+  if (volume.faces.size() < 4) return Defect::TooFewElements;
 
-  std::unordered_map<EdgeId, int> edgeUsage;
+  auto& s = detail::Scratch();
 
-  for (FaceId fid : volume.faces) {
-    const Face& face = faces.Get(fid);
+  s.faceIds.assign(volume.faces.begin(), volume.faces.end());
+  std::sort(s.faceIds.begin(), s.faceIds.end());
+  for (std::size_t i = 0; i < s.faceIds.size(); ++i) {
+    if (!faces.Contains(s.faceIds[i])) return Defect::MissingElement;
+    if (i > 0 && s.faceIds[i] == s.faceIds[i - 1]) return Defect::DuplicateElement;
+  }
+
+  // Record which way each face loop traverses each of its edges, chaining the loop
+  // from one lookup per edge
+  s.uses.clear();
+  for (uint32_t f = 0; f < volume.faces.size(); ++f) {
+    const Face& face = faces.Get(volume.faces[f]);
+    if (face.edges.size() < 3) return Defect::BrokenLoop;
+
+    s.faceEdges.clear();
     for (EdgeId eid : face.edges) {
-      edgeUsage[eid]++;
+      if (!edges.Contains(eid)) return Defect::MissingElement;
+      s.faceEdges.push_back(edges.Get(eid));
+    }
+
+    // Start with first edge, oriented so that it leads into the second one
+    const Edge& first = s.faceEdges[0];
+    const Edge& second = s.faceEdges[1];
+    const bool reversed = first.a == second.a || first.a == second.b;
+    const VertexId start = reversed ? first.b : first.a;
+    VertexId last = reversed ? first.a : first.b;
+    s.uses.push_back(detail::PackEdgeUse(face.edges[0], f, !reversed));
+
+    for (std::size_t i = 1; i < face.edges.size(); ++i) {
+      const Edge& e = s.faceEdges[i];
+      const bool forward = e.a == last;
+      if (!forward && e.b != last) return Defect::BrokenLoop;
+      last = forward ? e.b : e.a;
+      s.uses.push_back(detail::PackEdgeUse(face.edges[i], f, forward));
     }
+    if (last != start) return Defect::BrokenLoop;
   }
 
-  // Each edge in a closed volume must belong to exactly 2 faces
-  for (const auto& [_, count] : edgeUsage) {
-    if (count != 2) return false;
+  std::sort(s.uses.begin(), s.uses.end());
+
+  const auto faceCount = static_cast<uint32_t>(volume.faces.size());
+  s.parent.resize(faceCount);
+  s.parity.assign(faceCount, 0);
+  for (uint32_t f = 0; f < faceCount; ++f) s.parent[f] = f;
+
+  bool consistent = true;
+  for (std::size_t i = 0; i < s.uses.size();) {
+    const uint64_t edge = s.uses[i] >> 32;
+    std::size_t end = i + 1;
+    while (end < s.uses.size() && (s.uses[end] >> 32) == edge) ++end;
+
+    if (end - i == 1) return Defect::OpenBoundary;
+    if (end - i > 2) return Defect::NonManifoldEdge;
+
+    // Two faces crossing an edge the same way need opposite flips to agree
+    const auto faceX = static_cast<uint32_t>(s.uses[i] & 0xFFFFFFFFu) >> 1;
+    const auto faceY = static_cast<uint32_t>(s.uses[i + 1] & 0xFFFFFFFFu) >> 1;
+    const uint8_t needFlip = (s.uses[i] & 1) == (s.uses[i + 1] & 1) ? 1 : 0;
+    consistent = consistent && !needFlip;
+
+    uint8_t flipX = 0;
+    uint8_t flipY = 0;
+    const uint32_t rootX = detail::FindRoot(s, faceX, flipX);
+    const uint32_t rootY = detail::FindRoot(s, faceY, flipY);
+    if (rootX == rootY) {
+      if ((flipX ^ flipY) != needFlip) return Defect::NonOrientable;
+    } else {
+      s.parent[rootY] = rootX;
+      s.parity[rootY] = flipX ^ flipY ^ needFlip;
+    }
+
+    i = end;
   }
 
-  return true;
+  if (requireConsistentWinding && !consistent) return Defect::InconsistentWinding;
+  return Defect::None;
+}
+
+template <typename FaceContainer, typename EdgeContainer>
+bool IsValidVolume(const Volume& volume, const FaceContainer& faces, const EdgeContainer& edges) {
+  return CheckVolume(volume, faces, edges) == Defect::None;
 }
-}  // namespace Topology
\ No newline at end of file
+
+// -------------------------------------------------
+// Batch validation
+// -------------------------------------------------
+// Candidates are checked in parallel against read-only containers; verdicts[i]
+// belongs to candidates[i].
+template <typename EdgeContainer>
+std::vector<Defect> CheckFaces(std::span<const Face> candidates, const EdgeContainer& edges) {
+  std::vector<Defect> verdicts(candidates.size());
+  Jobs::ParallelFor(candidates.size(), 256, [&](std::size_t begin, std::size_t end) {
+    auto& loop = detail::Scratch().loop;
+    for (std::size_t i = begin; i < end; ++i) verdicts[i] = CheckFace(candidates[i], edges, loop);
+  });
+  return verdicts;
+}
+
+template <typename FaceContainer, typename EdgeContainer>
+std::vector<Defect> CheckVolumes(std::span<const Volume> candidates, const FaceContainer& faces,
+                                 const EdgeContainer& edges,
+                                 bool requireConsistentWinding = false) {
+  std::vector<Defect> verdicts(candidates.size());
+  Jobs::ParallelFor(candidates.size(), 64, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      verdicts[i] = CheckVolume(candidates[i], faces, edges, requireConsistentWinding);
+    }
+  });
+  return verdicts;
+}
+
+}  // namespace Topology
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Little helpers for flat binary encodings (journal records, model files). Values are
+// stored in host byte order; files are not meant to move between architectures.
+
+class BinaryWriter {
+ public:
+  explicit BinaryWriter(std::vector<char>& out) : out_(out) {}
+
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out_.insert(out_.end(), bytes, bytes + sizeof(T));
+  }
+
+  // Values back to back, without a length prefix
+  template <typename T>
+  void WriteRaw(std::span<const T> values) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const char* bytes = reinterpret_cast<const char*>(values.data());
+    out_.insert(out_.end(), bytes, bytes + values.size_bytes());
+  }
+
+  // Length prefixed array of trivially copyable values
+  template <typename T>
+  void WriteArray(std::span<const T> values) {
+    Write(static_cast<uint64_t>(values.size()));
+    WriteRaw(values);
+  }
+
+  template <typename T>
+  void WriteArray(const std::vector<T>& values) {
+    WriteArray(std::span<const T>(values));
+  }
+
+  std::size_t Size() const { return out_.size(); }
+
+ private:
+  std::vector<char>& out_;
+};
+
+// FNV-1a; cheap integrity check for torn or corrupted records
+inline uint32_t Checksum(std::string_view data) {
+  uint32_t hash = 2166136261u;
+  for (char c : data) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Bounds-checked reader; any short read clears Ok() and leaves outputs untouched
+class BinaryReader {
+ public:
+  explicit BinaryReader(std::string_view data) : data_(data) {}
+
+  template <typename T>
+  bool Read(T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (!ok_ || data_.size() - offset_ < sizeof(T)) return ok_ = false;
+    std::memcpy(&value, data_.data() + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  template <typename T>
+  bool ReadArray(std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    uint64_t count = 0;
+    if (!Read(count)) return false;
+    if (count > (data_.size() - offset_) / sizeof(T)) return ok_ = false;
+
+    values.resize(static_cast<std::size_t>(count));
+    std::memcpy(values.data(), data_.data() + offset_, values.size() * sizeof(T));
+    offset_ += values.size() * sizeof(T);
+    return true;
+  }
+
+  bool Ok() const { return ok_; }
+  bool AtEnd() const { return offset_ == data_.size(); }
+  std::size_t Remaining() const { return data_.size() - offset_; }
+
+ private:
+  std::string_view data_;
+  std::size_t offset_ = 0;
+  bool ok_ = true;
+};
@@ -0,0 +1,74 @@
+#include "BufferedWriter.h"
+
+#include <cstring>
+
+BufferedWriter::BufferedWriter(std::size_t capacity) : capacity_(capacity) {
+  buffer_.reserve(capacity_);
+}
+
+BufferedWriter::~BufferedWriter() { Close(); }
+
+bool BufferedWriter::Open(const std::string& path) {
+  Close();
+
+  file_ = std::fopen(path.c_str(), "wb");
+  ok_ = file_ != nullptr;
+  flushed_ = 0;
+  if (file_) {
+    // We already buffer; skip the stdio copy
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+  }
+  return ok_;
+}
+
+bool BufferedWriter::Close() {
+  if (!file_) return ok_;
+
+  Flush();
+  if (std::fclose(file_) != 0) ok_ = false;
+  file_ = nullptr;
+  return ok_;
+}
+
+void BufferedWriter::Write(const void* data, std::size_t size) {
+  if (!ok_) return;
+
+  if (buffer_.size() + size > capacity_) {
+    Flush();
+    // Large blocks bypass the buffer entirely
+    if (size >= capacity_) {
+      if (file_ && std::fwrite(data, 1, size, file_) != size) ok_ = false;
+      flushed_ += size;
+      return;
+    }
+  }
+
+  const char* bytes = static_cast<const char*>(data);
+  buffer_.insert(buffer_.end(), bytes, bytes + size);
+}
+
+void BufferedWriter::WriteAt(std::size_t offset, const void* data, std::size_t size) {
+  if (!ok_) return;
+
+  if (offset >= flushed_ && offset + size <= Position()) {
+    std::memcpy(buffer_.data() + (offset - flushed_), data, size);
+    return;
+  }
+
+  Flush();
+  if (!file_ || std::fseek(file_, static_cast<long>(offset), SEEK_SET) != 0 ||
+      std::fwrite(data, 1, size, file_) != size || std::fseek(file_, 0, SEEK_END) != 0) {
+    ok_ = false;
+  }
+}
+
+bool BufferedWriter::Flush() {
+  if (!buffer_.empty() && ok_) {
+    if (!file_ || std::fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size()) {
+      ok_ = false;
+    }
+    flushed_ += buffer_.size();
+  }
+  buffer_.clear();
+  return ok_;
+}
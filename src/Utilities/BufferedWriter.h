@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Sequential file writer that gathers small writes into one large buffer, so the OS
+// only sees big contiguous writes. Errors are sticky: once a write fails, Ok() stays
+// false and further writes are dropped.
+class BufferedWriter {
+ public:
+  static constexpr std::size_t kDefaultCapacity = 4 * 1024 * 1024;
+
+  explicit BufferedWriter(std::size_t capacity = kDefaultCapacity);
+  ~BufferedWriter();
+
+  BufferedWriter(const BufferedWriter&) = delete;
+  BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+  // Create or truncate the file at path
+  bool Open(const std::string& path);
+  bool Close();
+
+  bool IsOpen() const { return file_ != nullptr; }
+  bool Ok() const { return ok_; }
+
+  void Write(const void* data, std::size_t size);
+  void Write(std::string_view text) { Write(text.data(), text.size()); }
+
+  template <typename T>
+  void WriteValue(const T& value) {
+    Write(&value, sizeof(T));
+  }
+
+  // Overwrite bytes that were already written (e.g. a count in a header)
+  void WriteAt(std::size_t offset, const void* data, std::size_t size);
+
+  bool Flush();
+
+  // Total bytes written so far, including buffered ones
+  std::size_t Position() const { return flushed_ + buffer_.size(); }
+
+ private:
+  std::FILE* file_ = nullptr;
+  std::vector<char> buffer_;
+  std::size_t capacity_;
+  std::size_t flushed_ = 0;
+  bool ok_ = true;
+};
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Vector split into fixed size chunks that are shared between copies. Copying costs
+// O(chunks); a write clones only the chunk it lands in, and only while that chunk is
+// still shared with another copy. Chunks are freed when the last copy drops them.
+//
+// A copy may be read on another thread while the original keeps being modified on
+// its own thread; copies themselves are not synchronised.
+template <typename T, std::size_t ChunkSize = 1024>
+class CowVector {
+  static_assert((ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two");
+
+  struct Chunk {
+    std::vector<T> items;
+  };
+
+ public:
+  using value_type = T;
+  static constexpr std::size_t kChunkSize = ChunkSize;
+
+  class const_iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    const_iterator() = default;
+    const_iterator(const CowVector* owner, std::size_t index) : owner_(owner), index_(index) {}
+
+    reference operator*() const { return (*owner_)[index_]; }
+    pointer operator->() const { return &(*owner_)[index_]; }
+    reference operator[](difference_type n) const { return (*owner_)[index_ + n]; }
+
+    const_iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator copy = *this;
+      ++index_;
+      return copy;
+    }
+    const_iterator& operator--() {
+      --index_;
+      return *this;
+    }
+    const_iterator operator--(int) {
+      const_iterator copy = *this;
+      --index_;
+      return copy;
+    }
+    const_iterator& operator+=(difference_type n) {
+      index_ += n;
+      return *this;
+    }
+    const_iterator& operator-=(difference_type n) {
+      index_ -= n;
+      return *this;
+    }
+    friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+    friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+    friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const const_iterator& a, const const_iterator& b) {
+      return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+    }
+    friend bool operator==(const const_iterator& a, const const_iterator& b) {
+      return a.index_ == b.index_;
+    }
+    friend auto operator<=>(const const_iterator& a, const const_iterator& b) {
+      return a.index_ <=> b.index_;
+    }
+
+   private:
+    const CowVector* owner_ = nullptr;
+    std::size_t index_ = 0;
+  };
+
+  CowVector() = default;
+
+  explicit CowVector(std::vector<T> values) {
+    chunks_.reserve(ChunkCountFor(values.size()));
+    for (std::size_t begin = 0; begin < values.size(); begin += ChunkSize) {
+      auto chunk = std::make_shared<Chunk>();
+      const std::size_t end = std::min(values.size(), begin + ChunkSize);
+      chunk->items.reserve(ChunkSize);
+      chunk->items.assign(std::make_move_iterator(values.begin() + begin),
+                          std::make_move_iterator(values.begin() + end));
+      chunks_.push_back(std::move(chunk));
+    }
+    size_ = values.size();
+  }
+
+  // ---- Size ---------------------------------------------------
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Only the chunk table is reserved; chunks are allocated at full size on demand
+  void reserve(std::size_t count) { chunks_.reserve(ChunkCountFor(count)); }
+
+  void clear() {
+    chunks_.clear();
+    size_ = 0;
+  }
+
+  void assign(std::size_t count, const T& value) {
+    clear();
+    for (std::size_t i = 0; i < count; ++i) push_back(value);
+  }
+
+  // ---- Element access -----------------------------------------
+  const T& operator[](std::size_t index) const {
+    assert(index < size_);
+    return chunks_[index / ChunkSize]->items[index % ChunkSize];
+  }
+
+  // Mutable access clones the containing chunk if it is shared
+  T& operator[](std::size_t index) {
+    assert(index < size_);
+    return MutableChunk(index / ChunkSize).items[index % ChunkSize];
+  }
+
+  const T& back() const { return (*this)[size_ - 1]; }
+  T& back() { return (*this)[size_ - 1]; }
+
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size_); }
+
+  // ---- Modifiers ----------------------------------------------
+  template <typename... Args>
+  T& emplace_back(Args&&... args) {
+    if (size_ % ChunkSize == 0) {
+      auto chunk = std::make_shared<Chunk>();
+      chunk->items.reserve(ChunkSize);
+      chunks_.push_back(std::move(chunk));
+    }
+    T& value = MutableChunk(chunks_.size() - 1).items.emplace_back(std::forward<Args>(args)...);
+    ++size_;
+    return value;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  void pop_back() {
+    assert(size_ > 0);
+    --size_;
+    if (size_ % ChunkSize == 0) {
+      chunks_.pop_back();
+    } else {
+      MutableChunk(chunks_.size() - 1).items.pop_back();
+    }
+  }
+
+  // ---- Chunk access -------------------------------------------
+  // Contiguous storage is only guaranteed per chunk
+  std::size_t ChunkCount() const { return chunks_.size(); }
+
+  std::span<const T> ChunkSpan(std::size_t chunk) const { return chunks_[chunk]->items; }
+
+  // True if the chunk's storage is shared with another copy (diagnostics / tests)
+  bool IsChunkShared(std::size_t chunk) const { return chunks_[chunk].use_count() > 1; }
+
+ private:
+  static std::size_t ChunkCountFor(std::size_t count) {
+    return (count + ChunkSize - 1) / ChunkSize;
+  }
+
+  Chunk& MutableChunk(std::size_t chunk) {
+    std::shared_ptr<Chunk>& ptr = chunks_[chunk];
+    if (ptr.use_count() != 1) {
+      auto copy = std::make_shared<Chunk>();
+      copy->items.reserve(ChunkSize);
+      copy->items = ptr->items;
+      ptr = std::move(copy);
+    } else {
+      // Pairs with the release in the last other owner's reference drop, so its
+      // reads complete before we write
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return *ptr;
+  }
+
+  std::vector<std::shared_ptr<Chunk>> chunks_;
+  std::size_t size_ = 0;
+};
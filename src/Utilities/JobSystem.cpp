@@ -0,0 +1,163 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#ifndef __EMSCRIPTEN__
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace Jobs {
+
+#ifdef __EMSCRIPTEN__
+
+unsigned int Concurrency() { return 1; }
+
+void ParallelFor(std::size_t count, std::size_t /*minBatch*/,
+                 const std::function<void(std::size_t, std::size_t)>& body) {
+  if (count > 0) body(0, count);
+}
+
+void Submit(std::function<void()> task) { task(); }
+
+#else
+
+namespace {
+
+class WorkerPool {
+ public:
+  WorkerPool() {
+    const unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int i = 0; i + 1 < hardware; ++i) {
+      workers_.emplace_back([this] { WorkerLoop(); });
+    }
+  }
+
+  ~WorkerPool() {
+    {
+      std::lock_guard lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) worker.join();
+  }
+
+  unsigned int WorkerCount() const { return static_cast<unsigned int>(workers_.size()); }
+
+  void Push(std::function<void()> task) {
+    {
+      std::lock_guard lock(mutex_);
+      queue_.push_back(std::move(task));
+    }
+    wake_.notify_one();
+  }
+
+ private:
+  void WorkerLoop() {
+    for (;;) {
+      std::function<void()> task;
+      {
+        std::unique_lock lock(mutex_);
+        wake_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (stopping_ && queue_.empty()) return;
+        task = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> queue_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+};
+
+WorkerPool& Pool() {
+  static WorkerPool pool;
+  return pool;
+}
+
+// Shared between the caller and helper tasks; helpers may outlive the caller's frame
+// if they are dequeued after every batch has already been claimed.
+struct ParallelForState {
+  std::function<void(std::size_t, std::size_t)> body;
+  std::size_t count = 0;
+  std::size_t batchSize = 0;
+  std::size_t batchCount = 0;
+  std::atomic<std::size_t> nextBatch{0};
+  std::atomic<std::size_t> doneBatches{0};
+  std::mutex mutex;
+  std::condition_variable done;
+
+  void Drain() {
+    for (;;) {
+      const std::size_t batch = nextBatch.fetch_add(1);
+      if (batch >= batchCount) return;
+
+      const std::size_t begin = batch * batchSize;
+      const std::size_t end = std::min(count, begin + batchSize);
+      body(begin, end);
+
+      if (doneBatches.fetch_add(1) + 1 == batchCount) {
+        std::lock_guard lock(mutex);
+        done.notify_all();
+      }
+    }
+  }
+};
+
+}  // namespace
+
+unsigned int Concurrency() { return Pool().WorkerCount() + 1; }
+
+void ParallelFor(std::size_t count, std::size_t minBatch,
+                 const std::function<void(std::size_t, std::size_t)>& body) {
+  if (count == 0) return;
+
+  minBatch = std::max<std::size_t>(1, minBatch);
+  const std::size_t threads = Concurrency();
+
+  // Oversubscribe a little so uneven batches still balance across threads
+  const std::size_t maxBatches = (count + minBatch - 1) / minBatch;
+  const std::size_t batchCount = std::min(maxBatches, threads * 4);
+
+  if (batchCount <= 1 || threads == 1) {
+    body(0, count);
+    return;
+  }
+
+  auto state = std::make_shared<ParallelForState>();
+  state->body = body;
+  state->count = count;
+  state->batchSize = (count + batchCount - 1) / batchCount;
+  state->batchCount = (count + state->batchSize - 1) / state->batchSize;
+
+  const std::size_t helpers = std::min(threads - 1, state->batchCount - 1);
+  for (std::size_t i = 0; i < helpers; ++i) {
+    Pool().Push([state] { state->Drain(); });
+  }
+
+  state->Drain();
+
+  std::unique_lock lock(state->mutex);
+  state->done.wait(lock, [&] { return state->doneBatches.load() == state->batchCount; });
+}
+
+void Submit(std::function<void()> task) {
+  if (Pool().WorkerCount() == 0) {
+    task();
+    return;
+  }
+  Pool().Push(std::move(task));
+}
+
+#endif
+
+}  // namespace Jobs
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+// Minimal shared worker pool. Native builds run jobs on hardware threads; Emscripten
+// builds are single threaded, so everything runs inline on the caller.
+namespace Jobs {
+
+// Number of threads that take part in a ParallelFor (workers + calling thread)
+unsigned int Concurrency();
+
+// Split [0, count) into batches of at least minBatch items and run body(begin, end)
+// on the pool. The calling thread participates and the call blocks until all batches
+// are done, so it is safe to call from inside another job.
+void ParallelFor(std::size_t count, std::size_t minBatch,
+                 const std::function<void(std::size_t, std::size_t)>& body);
+
+// Queue a fire-and-forget task on a worker thread
+void Submit(std::function<void()> task);
+
+}  // namespace Jobs
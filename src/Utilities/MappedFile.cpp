@@ -0,0 +1,48 @@
+#include "MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return;
+
+  struct stat info {};
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    return;
+  }
+
+  size_ = static_cast<std::size_t>(info.st_size);
+
+  // mmap rejects zero-length mappings; an empty file is still a valid (empty) view
+  if (size_ == 0) {
+    ::close(fd);
+    open_ = true;
+    return;
+  }
+
+  void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+
+  if (mapping == MAP_FAILED) {
+    size_ = 0;
+    return;
+  }
+
+#ifndef __EMSCRIPTEN__
+  // Parsers stream front to back; let the kernel read ahead aggressively
+  ::madvise(mapping, size_, MADV_SEQUENTIAL);
+#endif
+
+  data_ = static_cast<const char*>(mapping);
+  open_ = true;
+}
+
+MappedFile::~MappedFile() {
+  if (data_) {
+    ::munmap(const_cast<char*>(data_), size_);
+  }
+}
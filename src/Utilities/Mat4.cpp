@@ -46,12 +46,13 @@ Mat4 Mat4::LookAt(const Vec3& eye, const Vec3& center, const Vec3& up) {
 }
 
 Mat4 Mat4::operator*(const Mat4& other) const {
+  // Column-major: element (row, col) lives at col * 4 + row
   Mat4 result;
-  for (int i = 0; i < 4; ++i) {
-    for (int j = 0; j < 4; ++j) {
-      result.data_[i * 4 + j] = 0;
+  for (int col = 0; col < 4; ++col) {
+    for (int row = 0; row < 4; ++row) {
+      result.data_[col * 4 + row] = 0;
       for (int k = 0; k < 4; ++k) {
-        result.data_[i * 4 + j] += data_[i * 4 + k] * other.data_[k * 4 + j];
+        result.data_[col * 4 + row] += data_[k * 4 + row] * other.data_[col * 4 + k];
       }
     }
   }
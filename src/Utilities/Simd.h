@@ -0,0 +1,14 @@
+#pragma once
+
+// One place to decide which vector paths the build can take. CAD_SSE and CAD_SSE2 are
+// defined, with their intrinsics included, when the target has them (x64 always does);
+// code checks them with #ifdef and keeps a scalar path for everything else.
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define CAD_SSE 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define CAD_SSE2 1
+#endif
@@ -3,10 +3,15 @@
 #include <cassert>
 #include <cstdint>
 #include <span>
+#include <utility>
 #include <vector>
 
+#include "Utilities/CowVector.h"
+
 using Id = uint32_t;
 
+// Storage is chunked copy-on-write (see CowVector): copying a set is O(chunks) and
+// the copy stays valid while the original keeps changing.
 template <typename T>
 class SparseSet {
  public:
@@ -29,6 +34,37 @@ class SparseSet {
   // Insert by copy
   Id Insert(const T& value) { return Emplace(value); }
 
+  // Put elements back under ids that are currently free, as when undoing a removal.
+  // The ids leave the free list in one pass, keeping the order of the rest.
+  void Reinsert(std::span<const Id> ids, std::span<const T> values) {
+    assert(ids.size() == values.size());
+    if (ids.empty()) return;
+
+    std::vector<bool> taken(sparse_.size(), false);
+    for (Id id : ids) {
+      while (id >= sparse_.size()) {
+        free_ids_.push_back(static_cast<Id>(sparse_.size()));
+        sparse_.push_back(kInvalid);
+        taken.push_back(false);
+      }
+      assert(!Contains(id));
+      taken[id] = true;
+    }
+
+    std::vector<Id> remaining;
+    remaining.reserve(free_ids_.size());
+    for (Id id : std::as_const(free_ids_)) {
+      if (!taken[id]) remaining.push_back(id);
+    }
+    free_ids_ = CowVector<Id>(std::move(remaining));
+
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+      sparse_[ids[i]] = static_cast<uint32_t>(dense_.size());
+      dense_.push_back(values[i]);
+      dense_to_id_.push_back(ids[i]);
+    }
+  }
+
   // Remove element using end-swap erase
   void Remove(Id id) {
     assert(Contains(id));
@@ -53,9 +89,10 @@ class SparseSet {
 
   bool Contains(Id id) const { return id < sparse_.size() && sparse_[id] != kInvalid; }
 
+  // Mutable access; only the touched dense chunk is cloned if shared
   T& Get(Id id) {
     assert(Contains(id));
-    return dense_[sparse_[id]];
+    return dense_[std::as_const(sparse_)[id]];
   }
 
   const T& Get(Id id) const {
@@ -65,7 +102,7 @@ class SparseSet {
 
   T& operator[](Id id) {
     assert(Contains(id));
-    return dense_[sparse_[id]];
+    return dense_[std::as_const(sparse_)[id]];
   }
 
   const T& operator[](Id id) const {
@@ -99,7 +136,53 @@ class SparseSet {
 
   uint32_t DenseCount() const { return static_cast<uint32_t>(dense_.size()); }
 
-  const std::vector<T>& Dense() const { return dense_; }
+  const CowVector<T>& Dense() const { return dense_; }
+
+  // Pre-size storage ahead of a bulk insertion
+  void Reserve(std::size_t count) {
+    dense_.reserve(count);
+    dense_to_id_.reserve(count);
+    sparse_.reserve(count);
+  }
+
+  // ---- Persistence --------------------------------------------
+  // Raw state, enough to rebuild the set with identical ids and id reuse order
+  const CowVector<Id>& DenseIds() const { return dense_to_id_; }
+  const CowVector<Id>& FreeIds() const { return free_ids_; }
+  std::size_t IdCapacity() const { return sparse_.size(); }
+
+  // Checks that every id below idCapacity is either live exactly once or free
+  static bool IsValidState(std::size_t denseCount, std::span<const Id> denseIds,
+                           std::size_t idCapacity, std::span<const Id> freeIds) {
+    if (denseCount != denseIds.size() || denseIds.size() + freeIds.size() != idCapacity) {
+      return false;
+    }
+
+    std::vector<bool> seen(idCapacity, false);
+    for (Id id : denseIds) {
+      if (id >= idCapacity || seen[id]) return false;
+      seen[id] = true;
+    }
+    for (Id id : freeIds) {
+      if (id >= idCapacity || seen[id]) return false;
+      seen[id] = true;
+    }
+    return true;
+  }
+
+  bool Restore(std::vector<T> dense, std::vector<Id> denseIds, std::size_t idCapacity,
+               std::vector<Id> freeIds) {
+    if (!IsValidState(dense.size(), denseIds, idCapacity, freeIds)) return false;
+
+    std::vector<uint32_t> sparse(idCapacity, kInvalid);
+    for (uint32_t i = 0; i < denseIds.size(); ++i) sparse[denseIds[i]] = i;
+
+    dense_ = CowVector<T>(std::move(dense));
+    dense_to_id_ = CowVector<Id>(std::move(denseIds));
+    sparse_ = CowVector<uint32_t>(std::move(sparse));
+    free_ids_ = CowVector<Id>(std::move(freeIds));
+    return true;
+  }
 
  private:
   Id AllocateId() {
@@ -113,10 +196,10 @@ class SparseSet {
     return id;
   }
 
-  std::vector<T> dense_;
-  std::vector<Id> dense_to_id_;
-  std::vector<uint32_t> sparse_;
-  std::vector<Id> free_ids_;
+  CowVector<T> dense_;
+  CowVector<Id> dense_to_id_;
+  CowVector<uint32_t> sparse_;
+  CowVector<Id> free_ids_;
 };
 
 template <typename T>
@@ -124,6 +207,13 @@ class DirtySparseSet {
  public:
   DirtySparseSet(bool& dirtyFlag) : dirtyFlag_(dirtyFlag) {}
 
+  // Share other's storage (copy-on-write) but report changes to a different flag
+  DirtySparseSet(bool& dirtyFlag, const DirtySparseSet& other)
+      : sparse_(other.sparse_), dirtyFlag_(dirtyFlag) {}
+
+  DirtySparseSet(const DirtySparseSet&) = delete;
+  DirtySparseSet& operator=(const DirtySparseSet&) = delete;
+
   // Insert by forwarding arguments
   template <typename... Args>
   Id Emplace(Args&&... args) {
@@ -137,6 +227,11 @@ class DirtySparseSet {
     return sparse_.Insert(value);
   }
 
+  void Reinsert(std::span<const Id> ids, std::span<const T> values) {
+    dirtyFlag_ = true;
+    sparse_.Reinsert(ids, values);
+  }
+
   // Remove element using end-swap erase
   void Remove(Id id) {
     dirtyFlag_ = true;
@@ -163,7 +258,19 @@ class DirtySparseSet {
 
   uint32_t DenseCount() const { return sparse_.DenseCount(); }
 
-  const std::vector<T>& Dense() const { return sparse_.Dense(); }
+  const CowVector<T>& Dense() const { return sparse_.Dense(); }
+
+  void Reserve(std::size_t count) { sparse_.Reserve(count); }
+
+  const CowVector<Id>& DenseIds() const { return sparse_.DenseIds(); }
+  const CowVector<Id>& FreeIds() const { return sparse_.FreeIds(); }
+  std::size_t IdCapacity() const { return sparse_.IdCapacity(); }
+
+  bool Restore(std::vector<T> dense, std::vector<Id> denseIds, std::size_t idCapacity,
+               std::vector<Id> freeIds) {
+    dirtyFlag_ = true;
+    return sparse_.Restore(std::move(dense), std::move(denseIds), idCapacity, std::move(freeIds));
+  }
 
  private:
   SparseSet<T> sparse_;
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Fixed capacity ring buffer for exactly one producer thread and one consumer thread.
+// Neither side locks or allocates: each owns one index and only reads the other's, so a
+// push or pop is a copy plus one release store. Capacity must be a power of two; one
+// slot stays empty to tell a full queue from an empty one.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+  static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+  static_assert(Capacity >= 2, "Capacity must leave room for an item");
+
+ public:
+  static constexpr std::size_t kCapacity = Capacity - 1;
+
+  // Producer side. False when full; the item is dropped.
+  bool TryPush(const T& item) {
+    const std::size_t tail = tail_.load(std::memory_order_relaxed);
+    const std::size_t next = (tail + 1) & (Capacity - 1);
+    if (next == headCache_) {
+      headCache_ = head_.load(std::memory_order_acquire);
+      if (next == headCache_) return false;
+    }
+    items_[tail] = item;
+    tail_.store(next, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. False when empty.
+  bool TryPop(T& out) {
+    const std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tailCache_) {
+      tailCache_ = tail_.load(std::memory_order_acquire);
+      if (head == tailCache_) return false;
+    }
+    out = items_[head];
+    head_.store((head + 1) & (Capacity - 1), std::memory_order_release);
+    return true;
+  }
+
+  // Either side; only a snapshot while the other side is running
+  bool IsEmpty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+ private:
+  // Keeps the two indices, and what each side caches of the other, on separate cache lines
+  static constexpr std::size_t kLine = 64;
+
+  alignas(kLine) std::atomic<std::size_t> head_{0};  // next item to pop, written by consumer
+  std::size_t tailCache_ = 0;                        // consumer's last view of tail_
+  alignas(kLine) std::atomic<std::size_t> tail_{0};  // next free slot, written by producer
+  std::size_t headCache_ = 0;                        // producer's last view of head_
+  alignas(kLine) std::array<T, Capacity> items_{};
+};
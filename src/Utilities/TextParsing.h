@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+
+// Allocation-free scanners for ASCII mesh formats. Every function takes the current
+// cursor and the end of the buffer and returns the advanced cursor, or nullptr when the
+// input does not match. None of them rely on null termination or the C locale.
+namespace TextParsing {
+
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline bool IsSpace(char c) { return IsBlank(c) || c == '\n'; }
+
+inline char ToLower(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : c; }
+
+// Skip spaces and tabs, stopping at end of line
+inline const char* SkipBlanks(const char* p, const char* end) {
+  while (p < end && IsBlank(*p)) ++p;
+  return p;
+}
+
+// Skip all whitespace including newlines
+inline const char* SkipSpaces(const char* p, const char* end) {
+  while (p < end && IsSpace(*p)) ++p;
+  return p;
+}
+
+// Advance to the first character of the next line
+inline const char* SkipLine(const char* p, const char* end) {
+  while (p < end && *p != '\n') ++p;
+  return p < end ? p + 1 : end;
+}
+
+// Advance past the current whitespace separated token
+inline const char* SkipToken(const char* p, const char* end) {
+  while (p < end && !IsSpace(*p)) ++p;
+  return p;
+}
+
+// True when [p, end) starts with the given keyword followed by whitespace or end
+inline bool StartsWithKeyword(const char* p, const char* end, const char* keyword) {
+  while (*keyword) {
+    if (p >= end || *p != *keyword) return false;
+    ++p;
+    ++keyword;
+  }
+  return p == end || IsSpace(*p);
+}
+
+// Decimal integer; values that do not fit in int64_t are rejected instead of wrapping
+inline const char* ParseInt(const char* p, const char* end, int64_t& out) {
+  p = SkipBlanks(p, end);
+  // from_chars accepts a leading '-' but not '+'
+  if (p + 1 < end && *p == '+' && IsDigit(p[1])) ++p;
+
+  const auto [next, error] = std::from_chars(p, end, out);
+  return error == std::errc() ? next : nullptr;
+}
+
+// Decimal float parser: accumulates up to 19 significant digits into an integer and
+// applies the decimal exponent once. Exact powers of ten keep common inputs correctly
+// rounded; the result is well within float precision for anything else.
+inline const char* ParseFloat(const char* p, const char* end, float& out) {
+  static constexpr double kPow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                      1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                      1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  p = SkipBlanks(p, end);
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = *p == '-';
+    ++p;
+  }
+
+  // Non-finite values written by some exporters
+  if (p < end && (ToLower(*p) == 'n' || ToLower(*p) == 'i')) {
+    const bool isNan = ToLower(*p) == 'n';
+    p = SkipToken(p, end);
+    out = isNan ? std::numeric_limits<float>::quiet_NaN()
+                : (negative ? -std::numeric_limits<float>::infinity()
+                            : std::numeric_limits<float>::infinity());
+    return p;
+  }
+
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+  bool any = false;
+
+  while (p < end && IsDigit(*p)) {
+    if (digits < 19) {
+      mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+      if (mantissa != 0) ++digits;
+    } else {
+      ++exponent;
+    }
+    any = true;
+    ++p;
+  }
+
+  if (p < end && *p == '.') {
+    ++p;
+    while (p < end && IsDigit(*p)) {
+      if (digits < 19) {
+        mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+        if (mantissa != 0) ++digits;
+        --exponent;
+      }
+      any = true;
+      ++p;
+    }
+  }
+
+  if (!any) return nullptr;
+
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    int64_t exp = 0;
+    const char* next = ParseInt(p + 1, end, exp);
+    if (!next) return nullptr;
+    exponent += static_cast<int>(std::max<int64_t>(-400, std::min<int64_t>(400, exp)));
+    p = next;
+  }
+
+  double value = static_cast<double>(mantissa);
+  if (mantissa != 0 && exponent != 0) {
+    if (exponent > 0 && exponent <= 22) {
+      value *= kPow10[exponent];
+    } else if (exponent < 0 && exponent >= -22) {
+      value /= kPow10[-exponent];
+    } else {
+      value *= std::pow(10.0, exponent);
+    }
+  }
+
+  out = static_cast<float>(negative ? -value : value);
+  return p;
+}
+
+}  // namespace TextParsing
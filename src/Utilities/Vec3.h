@@ -43,11 +43,11 @@ inline constexpr Vec3 Forward{0, 0, 1};
 inline auto operator*(float scalar, const Vec3& vec3) -> Vec3 { return vec3 * scalar; }
 
 inline constexpr auto IsEqual(const float a, const float b, const float epsilon = 0.0001) -> bool {
-  return abs(a - b) < epsilon;
+  return std::abs(a - b) < epsilon;
 }
 
 inline constexpr auto IsEqual(const Vec3& a, const Vec3& b, const float epsilon = 0.0001) -> bool {
-  return abs((a - b).LengthSquared()) < epsilon;
+  return std::abs((a - b).LengthSquared()) < epsilon;
 }
 
 // Stream output operator
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Core/MeshData.h"
+#include "Geometry/Aabb.h"
+#include "Model/Model.h"
+#include "Rendering/Camera.h"
+#include "Topology/EdgeTable.h"
+#include "Utilities/Vec3.h"
+
+// Small fixtures shared by the test files
+
+// nx * ny unit quads in the z = 0 plane, wound to face +z
+inline MeshData Grid(uint32_t nx, uint32_t ny) {
+  MeshData mesh;
+  for (uint32_t y = 0; y <= ny; ++y) {
+    for (uint32_t x = 0; x <= nx; ++x) {
+      mesh.positions.push_back({static_cast<float>(x), static_cast<float>(y), 0.0f});
+    }
+  }
+
+  Topology::EdgeTable table(mesh.edges);
+  for (uint32_t y = 0; y < ny; ++y) {
+    for (uint32_t x = 0; x < nx; ++x) {
+      const uint32_t i = y * (nx + 1) + x;
+      const std::array<uint32_t, 4> loop{i, i + 1, i + nx + 2, i + nx + 1};
+      Topology::AddFaceLoop(mesh, table, loop);
+    }
+  }
+  return mesh;
+}
+
+// Unit cube as one volume, faces wound outward; face 5 is the top
+inline MeshData Cube() {
+  MeshData mesh;
+  mesh.positions = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                    {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+
+  Topology::EdgeTable table(mesh.edges);
+  const std::array<std::array<uint32_t, 4>, 6> loops{{{0, 3, 2, 1},
+                                                      {0, 1, 5, 4},
+                                                      {1, 2, 6, 5},
+                                                      {2, 3, 7, 6},
+                                                      {3, 0, 4, 7},
+                                                      {4, 5, 6, 7}}};
+  std::vector<uint32_t> faces;
+  for (const auto& loop : loops) faces.push_back(Topology::AddFaceLoop(mesh, table, loop));
+  mesh.AddVolume(faces);
+  return mesh;
+}
+
+// Volume enclosed by the faces, positive when they are wound outward
+inline float SignedVolume(const Model& model, std::span<const FaceId> faces) {
+  double sum = 0.0;
+  for (FaceId id : faces) {
+    const auto loop = model.FaceLoop(id);
+    const Vec3& origin = model.GetVertex(loop[0]).position;
+    for (std::size_t i = 1; i + 1 < loop.size(); ++i) {
+      const Vec3& b = model.GetVertex(loop[i]).position;
+      const Vec3& c = model.GetVertex(loop[i + 1]).position;
+      sum += origin.Dot(b.Cross(c));
+    }
+  }
+  return static_cast<float>(sum / 6.0);
+}
+
+inline MeshData Moved(MeshData mesh, const Vec3& offset) {
+  for (Vec3& p : mesh.positions) p += offset;
+  return mesh;
+}
+
+// Cube of half size halfSize around center
+inline Geometry::Aabb Box(const Vec3& center, float halfSize) {
+  Geometry::Aabb box;
+  box.Expand(center - Vec3{halfSize});
+  box.Expand(center + Vec3{halfSize});
+  return box;
+}
+
+// Default camera: at (0, 0, 5) looking down -z at the origin, 45 degree fov, near 0.1,
+// far 1000, square viewport
+inline Camera SquareCamera() {
+  Camera camera;
+  camera.SetAspectRatio(1.0f);
+  return camera;
+}
@@ -0,0 +1,309 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "App/Commands/CommandJournal.h"
+#include "App/Commands/CommandSerialization.h"
+#include "App/Commands/CommandStack.h"
+#include "Model/Model.h"
+#include "Model/ModelFile.h"
+#include "Utilities/BinaryStream.h"
+
+class CommandJournalTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const auto dir = std::filesystem::temp_directory_path();
+    const std::string suffix = std::to_string(::testing::UnitTest::GetInstance()->random_seed());
+    snapshotPath = (dir / ("cad_test_" + suffix + ".snapshot")).string();
+    journalPath = (dir / ("cad_test_" + suffix + ".journal")).string();
+  }
+
+  void TearDown() override {
+    std::filesystem::remove(snapshotPath);
+    std::filesystem::remove(journalPath);
+  }
+
+  // Records a short session on top of a snapshot of the initial model
+  void RecordSession(FsyncPolicy policy) {
+    Model model;
+    model.CreateVertex({5, 5, 5});
+    ASSERT_TRUE(ModelFile::Save(model, snapshotPath, 7));
+
+    CommandJournal journal(JournalOptions{policy});
+    ASSERT_TRUE(journal.Open(journalPath, 7));
+
+    CommandStack stack(model);
+    stack.SetJournal(&journal);
+    stack.Do<CreateVertexCommand>(Vec3{0, 0, 0});
+    stack.Do<CreateVertexCommand>(Vec3{1, 0, 0});
+    stack.Do<CreateVertexCommand>(Vec3{0, 1, 0});
+    stack.Do<CreateEdgeCommand>(1u, 2u);
+    stack.Do<CreateEdgeCommand>(2u, 3u);
+    stack.Do<CreateEdgeCommand>(3u, 1u);
+    stack.Do<CreateFaceCommand>(std::vector<EdgeId>{0, 1, 2});
+    stack.Do<ExtrudeFaceCommand>(0u, 2.0f);
+    stack.Undo();
+    stack.Undo();
+    stack.Redo();
+
+    EXPECT_TRUE(journal.Flush());
+    journal.Close();
+
+    expectedVertices.assign(model.Vertices().begin(), model.Vertices().end());
+    expectedFaces = model.Faces().size();
+  }
+
+  std::string snapshotPath;
+  std::string journalPath;
+  std::vector<Vertex> expectedVertices;
+  std::size_t expectedFaces = 0;
+};
+
+TEST(CommandSerializationTest, RoundTripsCommandInputs) {
+  std::vector<char> bytes;
+  SerializeCommand(CreateFaceCommand{{4, 5, 6}}, bytes);
+  SerializeCommand(ExtrudeFaceCommand{3, 1.5f}, bytes);
+  SerializeCommand(ExtrudeFacesCommand{{7, 8}, -0.5f}, bytes);
+  SerializeCommand(
+      GenerateShapeCommand{{Generators::Shape::Torus, Vec3{1, 2, 3}, Vec3{4, 1, 4}, 24, 8}},
+      bytes);
+  SerializeCommand(SweepCommand{4, {Vec3{0, 0, 0}, Vec3{0, 2, 0}}}, bytes);
+
+  BinaryReader in(std::string_view(bytes.data(), bytes.size()));
+  auto face = DeserializeCommand(in);
+  auto extrude = DeserializeCommand(in);
+  auto region = DeserializeCommand(in);
+  auto shape = DeserializeCommand(in);
+  auto sweep = DeserializeCommand(in);
+
+  ASSERT_TRUE(face && extrude && region && shape && sweep);
+  EXPECT_EQ(std::get<CreateFaceCommand>(*face).edges, (std::vector<EdgeId>{4, 5, 6}));
+  EXPECT_EQ(std::get<ExtrudeFaceCommand>(*extrude).faceId, 3u);
+  EXPECT_FLOAT_EQ(std::get<ExtrudeFaceCommand>(*extrude).delta, 1.5f);
+  EXPECT_EQ(std::get<ExtrudeFacesCommand>(*region).faces, (std::vector<FaceId>{7, 8}));
+  EXPECT_FLOAT_EQ(std::get<ExtrudeFacesCommand>(*region).delta, -0.5f);
+  const Generators::ShapeParams& params = std::get<GenerateShapeCommand>(*shape).params;
+  EXPECT_EQ(params.shape, Generators::Shape::Torus);
+  EXPECT_TRUE(IsEqual(params.center, Vec3{1, 2, 3}));
+  EXPECT_TRUE(IsEqual(params.size, Vec3{4, 1, 4}));
+  EXPECT_EQ(params.segments, 24u);
+  EXPECT_EQ(params.rings, 8u);
+  EXPECT_EQ(std::get<SweepCommand>(*sweep).face, 4u);
+  ASSERT_EQ(std::get<SweepCommand>(*sweep).path.size(), 2u);
+  EXPECT_TRUE(IsEqual(std::get<SweepCommand>(*sweep).path[1], Vec3{0, 2, 0}));
+  EXPECT_TRUE(in.AtEnd());
+}
+
+TEST(CommandSerializationTest, RejectsTruncatedInput) {
+  std::vector<char> bytes;
+  SerializeCommand(CreateFaceCommand{{4, 5, 6}}, bytes);
+  bytes.pop_back();
+
+  BinaryReader in(std::string_view(bytes.data(), bytes.size()));
+  EXPECT_FALSE(DeserializeCommand(in).has_value());
+}
+
+TEST(CommandSerializationTest, RejectsOversizedShapeResolution) {
+  std::vector<char> bytes;
+  SerializeCommand(GenerateShapeCommand{{Generators::Shape::Grid, Vec3{}, Vec3{1, 1, 1},
+                                         Generators::kMaxResolution + 1, 1}},
+                   bytes);
+
+  BinaryReader in(std::string_view(bytes.data(), bytes.size()));
+  EXPECT_FALSE(DeserializeCommand(in).has_value());
+}
+
+TEST(CommandSerializationTest, RejectsOversizedProfileResolution) {
+  std::vector<char> lathe;
+  SerializeCommand(LatheCommand{1, Vec3{}, Vec3{0, 1, 0}, 1.0f, UINT32_MAX}, lathe);
+  BinaryReader latheIn(std::string_view(lathe.data(), lathe.size()));
+  EXPECT_FALSE(DeserializeCommand(latheIn).has_value());
+
+  std::vector<char> loft;
+  SerializeCommand(LoftCommand{1, 2, Generators::kMaxResolution + 1}, loft);
+  BinaryReader loftIn(std::string_view(loft.data(), loft.size()));
+  EXPECT_FALSE(DeserializeCommand(loftIn).has_value());
+}
+
+TEST(CommandSerializationTest, RejectsAppendedMeshesWithBadIndices) {
+  // One triangle wrapped in a volume
+  MeshData triangle;
+  triangle.positions = {Vec3{0, 0, 0}, Vec3{1, 0, 0}, Vec3{0, 1, 0}};
+  triangle.edges = {Edge{0, 1}, Edge{1, 2}, Edge{2, 0}};
+  triangle.faceEdges = {0, 1, 2};
+  triangle.faceOffsets = {0, 3};
+  triangle.volumeFaces = {0};
+  triangle.volumeOffsets = {0, 1};
+
+  const auto reads = [](MeshData mesh) {
+    std::vector<char> bytes;
+    SerializeCommand(AppendMeshCommand{std::move(mesh)}, bytes);
+    BinaryReader in(std::string_view(bytes.data(), bytes.size()));
+    return DeserializeCommand(in).has_value();
+  };
+  EXPECT_TRUE(reads(triangle));
+
+  MeshData mesh = triangle;
+  mesh.edges[1].b = 3;
+  EXPECT_FALSE(reads(mesh));
+
+  mesh = triangle;
+  mesh.faceEdges[2] = 3;
+  EXPECT_FALSE(reads(mesh));
+
+  mesh = triangle;
+  mesh.volumeFaces[0] = 1;
+  EXPECT_FALSE(reads(mesh));
+
+  mesh = triangle;
+  mesh.faceOffsets = {1, 3};
+  EXPECT_FALSE(reads(mesh));
+
+  mesh = triangle;
+  mesh.faceOffsets = {0, 3, 2, 3};
+  EXPECT_FALSE(reads(mesh));
+
+  mesh = triangle;
+  mesh.faceOffsets = {0, 2};
+  EXPECT_FALSE(reads(mesh));
+
+  mesh = triangle;
+  mesh.volumeOffsets = {0, 2};
+  EXPECT_FALSE(reads(mesh));
+}
+
+TEST(ModelSerializationTest, PreservesIdReuseOrder) {
+  Model original;
+  original.CreateVertex({0, 0, 0});
+  const VertexId removed = original.CreateVertex({1, 0, 0});
+  original.CreateVertex({2, 0, 0});
+  original.RemoveVertex(removed);
+
+  std::vector<char> bytes;
+  BinaryWriter out(bytes);
+  original.Serialize(out);
+
+  Model restored;
+  BinaryReader in(std::string_view(bytes.data(), bytes.size()));
+  ASSERT_TRUE(restored.Deserialize(in));
+
+  EXPECT_EQ(restored.Vertices().size(), 2u);
+  EXPECT_FALSE(restored.ContainsVertex(removed));
+  EXPECT_EQ(restored.CreateVertex({3, 0, 0}), original.CreateVertex({3, 0, 0}));
+}
+
+namespace {
+
+// Unit quad in the z = 0 plane, returning its edges in loop order
+std::array<EdgeId, 4> AddQuad(Model& model) {
+  std::array<VertexId, 4> vertices{};
+  const std::array<Vec3, 4> corners{Vec3{0, 0, 0}, Vec3{1, 0, 0}, Vec3{1, 1, 0}, Vec3{0, 1, 0}};
+  for (std::size_t i = 0; i < 4; ++i) vertices[i] = model.CreateVertex(corners[i]);
+
+  std::array<EdgeId, 4> edges{};
+  for (std::size_t i = 0; i < 4; ++i) {
+    edges[i] = model.CreateEdge(vertices[i], vertices[(i + 1) % 4]).value();
+  }
+  return edges;
+}
+
+}  // namespace
+
+TEST(ModelSerializationTest, FaceWithRemovedEdgeStaysBrokenUntilTheEdgeReturns) {
+  Model original;
+  const std::array<EdgeId, 4> edges = AddQuad(original);
+  const FaceId face = original.CreateFace(edges).value();
+  const Edge removed = original.GetEdge(edges[2]);
+  ASSERT_TRUE(original.RemoveEdge(edges[2]));
+
+  std::vector<char> bytes;
+  BinaryWriter out(bytes);
+  original.Serialize(out);
+
+  Model restored;
+  BinaryReader in(std::string_view(bytes.data(), bytes.size()));
+  ASSERT_TRUE(restored.Deserialize(in));
+  ASSERT_TRUE(restored.ContainsFace(face));
+  EXPECT_TRUE(restored.FaceLoop(face).empty());
+  EXPECT_TRUE(restored.VertexFaces(removed.a).empty());
+
+  // Recreating the edge reuses its id and gives the face its loop back
+  EXPECT_EQ(restored.CreateEdge(removed.a, removed.b), edges[2]);
+  EXPECT_EQ(restored.FaceLoop(face).size(), 4u);
+}
+
+TEST(ModelSerializationTest, RejectsReferencesOutsideTheIdRange) {
+  Model original;
+  const std::array<EdgeId, 4> edges = AddQuad(original);
+  ASSERT_TRUE(original.CreateFace(edges).has_value());
+
+  std::vector<char> bytes;
+  BinaryWriter out(bytes);
+  original.Serialize(out);
+
+  // The face's edge list is the last run of those four ids (vertex and edge ids come first)
+  std::array<char, sizeof(edges)> pattern;
+  std::memcpy(pattern.data(), edges.data(), sizeof(edges));
+  const auto at = std::find_end(bytes.begin(), bytes.end(), pattern.begin(), pattern.end());
+  ASSERT_NE(at, bytes.end());
+  const EdgeId outOfRange = 1000;
+  std::memcpy(&*at + 3 * sizeof(EdgeId), &outOfRange, sizeof(outOfRange));
+
+  Model restored;
+  restored.CreateVertex({5, 5, 5});
+  BinaryReader in(std::string_view(bytes.data(), bytes.size()));
+  EXPECT_FALSE(restored.Deserialize(in));
+  EXPECT_EQ(restored.Vertices().size(), 1u);
+}
+
+TEST_F(CommandJournalTest, ReplayReproducesSession) {
+  RecordSession(FsyncPolicy::EveryCommit);
+
+  Model recovered;
+  auto generation = ModelFile::Load(recovered, snapshotPath);
+  ASSERT_EQ(generation, 7u);
+
+  CommandStack stack(recovered);
+  auto replay = CommandJournal::Replay(journalPath, *generation, stack);
+
+  EXPECT_TRUE(replay.applied);
+  EXPECT_FALSE(replay.truncatedTail);
+  EXPECT_EQ(replay.records, 11u);
+  EXPECT_EQ(recovered.Faces().size(), expectedFaces);
+  ASSERT_EQ(recovered.Vertices().size(), expectedVertices.size());
+  for (std::size_t i = 0; i < expectedVertices.size(); ++i) {
+    EXPECT_TRUE(IsEqual(recovered.Vertices()[i].position, expectedVertices[i].position));
+  }
+  EXPECT_EQ(stack.UndoCount(), 7u);
+  EXPECT_EQ(stack.RedoCount(), 1u);
+}
+
+TEST_F(CommandJournalTest, GenerationMismatchIsIgnored) {
+  RecordSession(FsyncPolicy::Never);
+
+  Model model;
+  CommandStack stack(model);
+  auto replay = CommandJournal::Replay(journalPath, 8, stack);
+
+  EXPECT_FALSE(replay.applied);
+  EXPECT_TRUE(model.Vertices().empty());
+}
+
+TEST_F(CommandJournalTest, TornTailStopsAtLastCompleteRecord) {
+  RecordSession(FsyncPolicy::Periodic);
+  std::filesystem::resize_file(journalPath, std::filesystem::file_size(journalPath) - 1);
+
+  Model model;
+  ASSERT_TRUE(ModelFile::Load(model, snapshotPath));
+  CommandStack stack(model);
+  auto replay = CommandJournal::Replay(journalPath, 7, stack);
+
+  EXPECT_TRUE(replay.applied);
+  EXPECT_TRUE(replay.truncatedTail);
+  EXPECT_EQ(replay.records, 10u);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <thread>
+
+#include "Model/Model.h"
+#include "Utilities/CowVector.h"
+
+using SmallCow = CowVector<int, 4>;
+
+TEST(CowVectorTest, PushPopAcrossChunks) {
+  SmallCow values;
+  for (int i = 0; i < 10; ++i) values.push_back(i);
+
+  EXPECT_EQ(values.size(), 10u);
+  EXPECT_EQ(values.ChunkCount(), 3u);
+  EXPECT_EQ(values[9], 9);
+
+  for (int i = 0; i < 6; ++i) values.pop_back();
+  EXPECT_EQ(values.size(), 4u);
+  EXPECT_EQ(values.ChunkCount(), 1u);
+  EXPECT_EQ(values.back(), 3);
+}
+
+TEST(CowVectorTest, CopySharesChunksUntilWritten) {
+  SmallCow original;
+  for (int i = 0; i < 12; ++i) original.push_back(i);
+
+  const SmallCow copy = original;
+  EXPECT_TRUE(original.IsChunkShared(0));
+  EXPECT_TRUE(original.IsChunkShared(2));
+
+  original[5] = 100;
+
+  EXPECT_TRUE(original.IsChunkShared(0));
+  EXPECT_FALSE(original.IsChunkShared(1));
+  EXPECT_TRUE(original.IsChunkShared(2));
+  EXPECT_EQ(original[5], 100);
+  EXPECT_EQ(copy[5], 5);
+}
+
+TEST(CowVectorTest, DroppedCopyReleasesChunks) {
+  SmallCow original;
+  for (int i = 0; i < 8; ++i) original.push_back(i);
+
+  { const SmallCow copy = original; }
+
+  EXPECT_FALSE(original.IsChunkShared(0));
+  EXPECT_FALSE(original.IsChunkShared(1));
+}
+
+TEST(CowVectorTest, IteratesInOrder) {
+  SmallCow values;
+  for (int i = 0; i < 9; ++i) values.push_back(i);
+
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 36);
+  EXPECT_EQ(values.end() - values.begin(), 9);
+}
+
+TEST(ModelSnapshotTest, SnapshotIsIsolatedFromLaterEdits) {
+  Model model;
+  const VertexId a = model.CreateVertex({0, 0, 0});
+  const VertexId b = model.CreateVertex({1, 0, 0});
+
+  auto snapshot = model.Snapshot();
+
+  model.SetVertexPosition(a, {5, 5, 5});
+  model.RemoveVertex(b);
+  model.CreateVertex({2, 0, 0});
+
+  ASSERT_EQ(snapshot->Vertices().size(), 2u);
+  EXPECT_TRUE(IsEqual(snapshot->GetVertex(a).position, Vec3{0, 0, 0}));
+  EXPECT_TRUE(snapshot->ContainsVertex(b));
+  EXPECT_TRUE(IsEqual(model.GetVertex(a).position, Vec3{5, 5, 5}));
+}
+
+TEST(ModelSnapshotTest, BackgroundReaderSeesConsistentState) {
+  Model model;
+  for (int i = 0; i < 5000; ++i) model.CreateVertex({1, 1, 1});
+
+  auto snapshot = model.Snapshot();
+  float sum = 0.0f;
+  std::thread reader([&] {
+    for (const Vertex& v : snapshot->Vertices()) sum += v.position.x;
+  });
+
+  for (VertexId id = 0; id < 5000; id += 7) model.SetVertexPosition(id, {-1, -1, -1});
+  reader.join();
+
+  EXPECT_FLOAT_EQ(sum, 5000.0f);
+}
@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "App/Commands/CommandSerialization.h"
+#include "App/Commands/CommandStack.h"
+#include "App/Commands/Commands.h"
+#include "Csg/Boolean.h"
+#include "Generators/Shapes.h"
+#include "Geometry/Bvh.h"
+#include "Model/Model.h"
+#include "Topology/Validation.h"
+#include "Utilities/BinaryStream.h"
+#include "Utilities/Vec3.h"
+
+#include "TestHelpers.h"
+
+using Csg::Operation;
+
+namespace {
+
+class CsgTest : public ::testing::Test {
+ protected:
+  // Two volumes, the second moved by offset; both boxes unless given
+  void Operands(const Vec3& offset, MeshData first = Generators::Box(Vec3{2, 2, 2}),
+                MeshData second = Generators::Box(Vec3{2, 2, 2})) {
+    a = model.AppendMesh(first).volumes.front();
+    b = model.AppendMesh(Moved(std::move(second), offset)).volumes.front();
+  }
+
+  // Combines the operands in a scratch copy and returns the result's volume, checking
+  // that it is one closed, consistently wound shell
+  float ResultVolume(Operation operation) {
+    const std::optional<MeshData> mesh = Csg::Combine(model, a, b, operation);
+    EXPECT_TRUE(mesh);
+    if (!mesh || mesh->Empty()) return 0.0f;
+
+    Model result;
+    const MeshIds ids = result.AppendMesh(*mesh);
+    EXPECT_EQ(ids.volumes.size(), 1u);
+    EXPECT_EQ(result.ValidateVolumes(std::span<const Volume>(&result.GetVolume(ids.volumes[0]), 1),
+                                     true)
+                  .front(),
+              Topology::Defect::None);
+    return SignedVolume(result, ids.faces);
+  }
+
+  Model model;
+  VolumeId a = 0;
+  VolumeId b = 0;
+};
+
+}  // namespace
+
+TEST(BvhTest, QueryMatchesBruteForce) {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> coord(-10.0f, 10.0f);
+  std::uniform_real_distribution<float> size(0.0f, 1.5f);
+
+  std::vector<Geometry::Aabb> boxes(500);
+  for (auto& box : boxes) {
+    const Vec3 p{coord(rng), coord(rng), coord(rng)};
+    box.Expand(p);
+    box.Expand(p + Vec3{size(rng), size(rng), size(rng)});
+  }
+  Geometry::Bvh bvh;
+  bvh.Build(boxes);
+
+  for (int q = 0; q < 50; ++q) {
+    Geometry::Aabb query;
+    const Vec3 p{coord(rng), coord(rng), coord(rng)};
+    query.Expand(p);
+    query.Expand(p + Vec3{3, 3, 3});
+
+    std::vector<uint32_t> found;
+    bvh.Query(query, [&](uint32_t i) { found.push_back(i); });
+    std::sort(found.begin(), found.end());
+
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+      if (boxes[i].Overlaps(query)) expected.push_back(i);
+    }
+    EXPECT_EQ(found, expected);
+  }
+}
+
+TEST_F(CsgTest, OverlappingBoxes) {
+  // Unit cube of overlap in the corner
+  Operands(Vec3{1, 1, 1});
+  EXPECT_NEAR(ResultVolume(Operation::Union), 15.0f, 1e-4f);
+  EXPECT_NEAR(ResultVolume(Operation::Difference), 7.0f, 1e-4f);
+  EXPECT_NEAR(ResultVolume(Operation::Intersection), 1.0f, 1e-4f);
+}
+
+TEST_F(CsgTest, FlushFacesLeaveNoSlivers) {
+  // Half overlap sharing four face planes
+  Operands(Vec3{1, 0, 0});
+  EXPECT_NEAR(ResultVolume(Operation::Union), 12.0f, 1e-4f);
+  EXPECT_NEAR(ResultVolume(Operation::Difference), 4.0f, 1e-4f);
+  EXPECT_NEAR(ResultVolume(Operation::Intersection), 4.0f, 1e-4f);
+
+  // Half boxes keep six faces; the union only gains the split side faces, with no wall
+  // left inside where the second box began
+  const std::size_t expected[Csg::kOperationCount] = {10, 6, 6};
+  for (uint8_t op = 0; op < Csg::kOperationCount; ++op) {
+    const auto mesh = Csg::Combine(model, a, b, static_cast<Operation>(op));
+    ASSERT_TRUE(mesh);
+    EXPECT_EQ(mesh->FaceCount(), expected[op]) << Csg::OperationName(static_cast<Operation>(op));
+  }
+}
+
+TEST_F(CsgTest, StackedBoxesMerge) {
+  // Touching along a whole face: the union is one 2 x 4 x 2 box
+  Operands(Vec3{0, 2, 0});
+  EXPECT_NEAR(ResultVolume(Operation::Union), 16.0f, 1e-4f);
+  EXPECT_NEAR(ResultVolume(Operation::Difference), 8.0f, 1e-4f);
+  const auto nothing = Csg::Combine(model, a, b, Operation::Intersection);
+  ASSERT_TRUE(nothing);
+  EXPECT_TRUE(nothing->Empty());
+}
+
+TEST_F(CsgTest, DisjointSolids) {
+  Operands(Vec3{5, 0, 0});
+  EXPECT_NEAR(ResultVolume(Operation::Union), 16.0f, 1e-4f);
+  EXPECT_NEAR(ResultVolume(Operation::Difference), 8.0f, 1e-4f);
+  const auto nothing = Csg::Combine(model, a, b, Operation::Intersection);
+  ASSERT_TRUE(nothing);
+  EXPECT_TRUE(nothing->Empty());
+}
+
+TEST_F(CsgTest, NestedSolids) {
+  // Unit box well inside the larger one: no faces cross at all
+  Operands(Vec3{0.2f, 0.1f, 0}, Generators::Box(Vec3{2, 2, 2}), Generators::Box(Vec3{1, 1, 1}));
+  EXPECT_NEAR(ResultVolume(Operation::Union), 8.0f, 1e-4f);
+  EXPECT_NEAR(ResultVolume(Operation::Intersection), 1.0f, 1e-4f);
+
+  // A hollow box: the inner shell is kept inside out
+  EXPECT_NEAR(ResultVolume(Operation::Difference), 7.0f, 1e-4f);
+}
+
+TEST_F(CsgTest, CurvedSolidsStayClosed) {
+  // Sphere poking through a box face: the cut face gains a hole bridged to its rim
+  Operands(Vec3{0, 1.2f, 0.1f}, Generators::Box(Vec3{2, 2, 2}),
+           Generators::UvSphere(Vec3{1.5f, 1.5f, 1.5f}, 24, 12));
+  const float box = 8.0f;
+  const float united = ResultVolume(Operation::Union);
+  const float removed = ResultVolume(Operation::Difference);
+  const float common = ResultVolume(Operation::Intersection);
+  EXPECT_GT(united, box);
+  EXPECT_LT(removed, box);
+  EXPECT_GT(common, 0.0f);
+  EXPECT_NEAR(removed + common, box, 1e-3f);
+}
+
+TEST_F(CsgTest, CommandReplacesOperandsAsOneUndoStep) {
+  Operands(Vec3{1, 1, 1});
+  const std::size_t vertices = model.Vertices().size();
+  const std::size_t faces = model.Faces().size();
+
+  CommandStack stack(model);
+  ASSERT_TRUE(stack.Do<BooleanCommand>(a, b, Operation::Union));
+  EXPECT_EQ(stack.UndoCount(), 1u);
+  ASSERT_EQ(model.Volumes().size(), 1u);
+  EXPECT_FALSE(model.ContainsVolume(a) && model.ContainsVolume(b));
+  std::vector<FaceId> result(model.Volumes()[0].faces);
+  EXPECT_NEAR(SignedVolume(model, result), 15.0f, 1e-4f);
+
+  // Undo puts both boxes back under their old ids
+  ASSERT_TRUE(stack.Undo());
+  ASSERT_TRUE(model.ContainsVolume(a));
+  ASSERT_TRUE(model.ContainsVolume(b));
+  EXPECT_EQ(model.Vertices().size(), vertices);
+  EXPECT_EQ(model.Faces().size(), faces);
+  EXPECT_NEAR(SignedVolume(model, model.GetVolume(a).faces), 8.0f, 1e-4f);
+  EXPECT_NEAR(SignedVolume(model, model.GetVolume(b).faces), 8.0f, 1e-4f);
+
+  ASSERT_TRUE(stack.Redo());
+  EXPECT_EQ(model.Volumes().size(), 1u);
+  ASSERT_TRUE(stack.Undo());
+
+  // A result combined ahead, as Application::CombineVolumes does to keep failures off
+  // the undo stack, is used as given
+  std::optional<MeshData> common = Csg::Combine(model, a, b, Operation::Intersection);
+  ASSERT_TRUE(common);
+  ASSERT_TRUE(stack.Do<BooleanCommand>(a, b, Operation::Union, std::move(common)));
+  ASSERT_EQ(model.Volumes().size(), 1u);
+  result.assign(model.Volumes()[0].faces.begin(), model.Volumes()[0].faces.end());
+  EXPECT_NEAR(SignedVolume(model, result), 1.0f, 1e-4f);
+
+  // Journal replay recomputes the result from the operand ids
+  std::vector<char> bytes;
+  SerializeCommand(BooleanCommand{a, b, Operation::Difference}, bytes);
+  BinaryReader in(std::string_view(bytes.data(), bytes.size()));
+  auto replayed = DeserializeCommand(in);
+  ASSERT_TRUE(replayed);
+  ASSERT_TRUE(stack.Undo());
+  std::visit(ExecuteVisitor{model}, *replayed);
+  ASSERT_EQ(model.Volumes().size(), 1u);
+  result.assign(model.Volumes()[0].faces.begin(), model.Volumes()[0].faces.end());
+  EXPECT_NEAR(SignedVolume(model, result), 7.0f, 1e-4f);
+}
+
+TEST_F(CsgTest, InvalidOperandsChangeNothing) {
+  Operands(Vec3{1, 1, 1});
+  EXPECT_FALSE(Csg::Combine(model, a, a, Operation::Union));
+  EXPECT_FALSE(Csg::Combine(model, a, 999, Operation::Union));
+
+  // An open grid has no inside
+  const MeshIds grid = model.AppendMesh(Generators::Grid(Vec3{1, 0, 1}, 2, 2));
+  const auto open = model.CreateVolume(grid.faces);
+  if (open) {
+    EXPECT_FALSE(Csg::Combine(model, a, *open, Operation::Union));
+  }
+
+  CommandStack stack(model);
+  const std::size_t faces = model.Faces().size();
+  stack.Do<BooleanCommand>(a, a, Operation::Union);
+  EXPECT_EQ(model.Faces().size(), faces);
+  EXPECT_TRUE(model.ContainsVolume(a));
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include "Geometry/Aabb.h"
+#include "Rendering/Camera.h"
+#include "Rendering/DirtyRegion.h"
+#include "Utilities/Vec3.h"
+
+#include "TestHelpers.h"
+
+using Geometry::Aabb;
+
+TEST(DirtyRegionTest, GrowsByProjectedBoxes) {
+  const Camera camera = SquareCamera();
+  DirtyRegion region;
+  region.Reset(200, 200);
+  EXPECT_TRUE(region.IsEmpty());
+
+  // A small box at the origin lands around the center
+  region.AddBox(Box(Vec3{0, 0, 0}, 0.1f), camera.GetViewProjectionMatrix());
+  ASSERT_FALSE(region.IsEmpty());
+  const ScreenRect first = region.Bounds();
+  EXPECT_LT(first.x, 100);
+  EXPECT_GT(first.x + first.width, 100);
+  EXPECT_LT(first.y, 100);
+  EXPECT_GT(first.y + first.height, 100);
+  EXPECT_LT(first.width, 40);
+  EXPECT_FALSE(region.IsFull());
+
+  // A second box to the upper right widens it to cover both
+  region.AddBox(Box(Vec3{1, 1, 0}, 0.1f), camera.GetViewProjectionMatrix());
+  const ScreenRect both = region.Bounds();
+  EXPECT_EQ(both.x, first.x);
+  EXPECT_EQ(both.y, first.y);
+  EXPECT_GT(both.x + both.width, first.x + first.width + 20);
+  EXPECT_GT(both.y + both.height, first.y + first.height + 20);
+  EXPECT_LE(both.x + both.width, 200);
+
+  // Boxes off screen or empty add nothing
+  region.AddBox(Box(Vec3{50, 0, 0}, 0.1f), camera.GetViewProjectionMatrix());
+  region.AddBox(Aabb{}, camera.GetViewProjectionMatrix());
+  EXPECT_EQ(region.Bounds().width, both.width);
+
+  region.Reset(200, 200);
+  EXPECT_TRUE(region.IsEmpty());
+}
+
+TEST(DirtyRegionTest, BoxesAroundTheEyeDirtyEverything) {
+  const Camera camera = SquareCamera();
+  DirtyRegion region;
+  region.Reset(320, 240);
+  region.AddBox(Box(Vec3{0, 0, 5}, 1.0f), camera.GetViewProjectionMatrix());
+  EXPECT_TRUE(region.IsFull());
+  EXPECT_EQ(region.Bounds().width, 320);
+  EXPECT_EQ(region.Bounds().height, 240);
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "Generators/Shapes.h"
+#include "Geometry/Aabb.h"
+#include "Geometry/Frustum.h"
+#include "Model/Model.h"
+#include "ModelView/ModelViewBuilder.h"
+#include "Rendering/Camera.h"
+#include "Utilities/Vec3.h"
+
+#include "TestHelpers.h"
+
+using Geometry::Aabb;
+using Geometry::Frustum;
+
+namespace {
+
+Frustum DefaultFrustum() {
+  return Frustum::FromViewProjection(SquareCamera().GetViewProjectionMatrix());
+}
+
+}  // namespace
+
+TEST(FrustumTest, KeepsBoxesInViewAndDropsTheRest) {
+  const Frustum frustum = DefaultFrustum();
+
+  EXPECT_TRUE(frustum.Intersects(Box(Vec3{}, 0.5f)));
+  EXPECT_TRUE(frustum.Intersects(Box(Vec3{0, 0, -500}, 1.0f)));
+  EXPECT_FALSE(frustum.Intersects(Box(Vec3{0, 0, 10}, 1.0f)));     // behind the eye
+  EXPECT_FALSE(frustum.Intersects(Box(Vec3{0, 0, -2000}, 1.0f)));  // past the far plane
+  EXPECT_FALSE(frustum.Intersects(Box(Vec3{10, 0, 0}, 1.0f)));     // off to the right
+  EXPECT_FALSE(frustum.Intersects(Box(Vec3{0, -10, 0}, 1.0f)));    // below
+
+  // Straddling the edge of the view still counts
+  EXPECT_TRUE(frustum.Intersects(Box(Vec3{3, 0, 0}, 1.5f)));
+  EXPECT_FALSE(frustum.Intersects(Aabb{}));
+}
+
+TEST(FrustumTest, BatchCullingMatchesSingleTests) {
+  const Frustum frustum = DefaultFrustum();
+
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+  std::uniform_real_distribution<float> size(0.01f, 3.0f);
+  std::vector<Aabb> boxes;
+  for (int i = 0; i < 20003; ++i) {
+    boxes.push_back(Box(Vec3{position(rng), position(rng), position(rng)}, size(rng)));
+  }
+  boxes[5] = Aabb{};
+
+  std::vector<uint8_t> visible(boxes.size(), 2);
+  frustum.Cull(boxes, visible);
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    ASSERT_EQ(visible[i], frustum.Intersects(boxes[i]) ? 1 : 0) << "box " << i;
+    kept += visible[i];
+  }
+  EXPECT_GT(kept, 0u);
+  EXPECT_LT(kept, boxes.size());
+}
+
+TEST(FrustumTest, FaceViewChunksBoundTheirVertices) {
+  Model model;
+  model.AppendMesh(Generators::UvSphere(Vec3{2, 2, 2}, 96, 48));
+  model.ResetDirtyFlags();
+  ModelViewBuilder builder(model);
+  FaceView view;
+  builder.BuildFaceView(view);
+  ModelViewBuilder::BuildChunks(view);
+
+  const std::size_t chunks =
+      (view.vertices.size() + FaceView::kChunkVertices - 1) / FaceView::kChunkVertices;
+  ASSERT_GT(chunks, 2u);
+  ASSERT_EQ(view.chunkBounds.size(), chunks);
+  for (std::size_t i = 0; i < view.vertices.size(); ++i) {
+    EXPECT_TRUE(view.chunkBounds[i / FaceView::kChunkVertices].Contains(view.vertices[i]));
+  }
+
+  // Pulling one vertex out refits the chunks of the faces around it
+  const VertexId pulled = model.VertexIndexToId(0);
+  model.SetVertexPosition(pulled, Vec3{0, 5, 0});
+  std::vector<ViewRange> ranges;
+  ASSERT_TRUE(builder.PatchFaceView(view, model.ReshapedFaces(), ranges));
+  ASSERT_FALSE(ranges.empty());
+  for (const ViewRange& range : ranges) {
+    for (std::size_t i = range.first; i < range.first + range.count; ++i) {
+      EXPECT_TRUE(view.chunkBounds[i / FaceView::kChunkVertices].Contains(view.vertices[i]));
+    }
+  }
+}
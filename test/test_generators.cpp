@@ -0,0 +1,272 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "App/Commands/CommandStack.h"
+#include "App/Commands/Commands.h"
+#include "Generators/Profiles.h"
+#include "Generators/Shapes.h"
+#include "Geometry/Geometry.h"
+#include "Model/Model.h"
+#include "Topology/Validation.h"
+#include "Utilities/Vec3.h"
+
+#include "TestHelpers.h"
+
+using Generators::Shape;
+
+namespace {
+
+// Unit square in the plane x = 0 (when offset is zero)
+std::vector<Vec3> Square(const Vec3& offset = Vec3{}) {
+  return {offset + Vec3{0, -0.5f, -0.5f}, offset + Vec3{0, 0.5f, -0.5f},
+          offset + Vec3{0, 0.5f, 0.5f}, offset + Vec3{0, -0.5f, 0.5f}};
+}
+
+// Inserts mesh into a fresh model, checks it is one valid, consistently wound closed
+// volume and returns the volume it encloses
+float ClosedVolume(const MeshData& mesh) {
+  Model model;
+  const MeshIds ids = model.AppendMesh(mesh);
+  EXPECT_EQ(ids.volumes.size(), 1u);
+  if (ids.volumes.size() != 1) return 0.0f;
+
+  const std::vector<Face> faces(model.Faces().begin(), model.Faces().end());
+  for (Topology::Defect defect : model.ValidateFaces(faces)) {
+    EXPECT_EQ(defect, Topology::Defect::None) << Topology::DefectName(defect);
+  }
+  const std::vector<Volume> volume{model.GetVolume(ids.volumes[0])};
+  EXPECT_EQ(model.ValidateVolumes(volume, true)[0], Topology::Defect::None);
+  return SignedVolume(model, ids.faces);
+}
+
+}  // namespace
+
+TEST(GeneratorsTest, ClosedShapesAreValidOutwardVolumes) {
+  for (const Shape shape : {Shape::Box, Shape::Cylinder, Shape::UvSphere, Shape::IcoSphere,
+                            Shape::Torus, Shape::Stairs}) {
+    SCOPED_TRACE(Generators::ShapeName(shape));
+
+    const MeshData mesh = Generators::Generate(Generators::DefaultParams(shape));
+    const float volumeSize = ClosedVolume(mesh);
+
+    // Euler characteristic: 2 for sphere-like shells, 0 for the torus
+    const auto euler = static_cast<int64_t>(mesh.positions.size()) -
+                       static_cast<int64_t>(mesh.edges.size()) +
+                       static_cast<int64_t>(mesh.FaceCount());
+    EXPECT_EQ(euler, shape == Shape::Torus ? 0 : 2);
+
+    // Inside the 2x2x2 bounds and enclosing positive volume
+    EXPECT_GT(volumeSize, 0.0f);
+    EXPECT_LE(volumeSize, 8.0f + 1e-4f);
+    for (const Vec3& p : mesh.positions) {
+      EXPECT_LE(std::abs(p.x), 1.0f + 1e-5f);
+      EXPECT_LE(std::abs(p.y), 1.0f + 1e-5f);
+      EXPECT_LE(std::abs(p.z), 1.0f + 1e-5f);
+    }
+
+    if (shape == Shape::Box) {
+      EXPECT_NEAR(volumeSize, 8.0f, 1e-4f);
+    } else if (shape == Shape::Stairs) {
+      // Eight steps of 0.25 x 0.25, 2 wide: 2 * 0.0625 * (1 + ... + 8)
+      EXPECT_NEAR(volumeSize, 4.5f, 1e-4f);
+    }
+  }
+}
+
+TEST(GeneratorsTest, ResolutionSetsElementCounts) {
+  const Vec3 size{2, 2, 2};
+
+  const MeshData box = Generators::Box(size, 3);
+  EXPECT_EQ(box.positions.size(), 56u);
+  EXPECT_EQ(box.edges.size(), 108u);
+  EXPECT_EQ(box.FaceCount(), 54u);
+
+  const MeshData cylinder = Generators::Cylinder(size, 16, 2);
+  EXPECT_EQ(cylinder.positions.size(), 48u);
+  EXPECT_EQ(cylinder.edges.size(), 80u);
+  EXPECT_EQ(cylinder.FaceCount(), 34u);
+
+  const MeshData uv = Generators::UvSphere(size, 16, 8);
+  EXPECT_EQ(uv.positions.size(), 114u);
+  EXPECT_EQ(uv.FaceCount(), 128u);
+
+  const MeshData ico = Generators::IcoSphere(size, 2);
+  EXPECT_EQ(ico.positions.size(), 162u);
+  EXPECT_EQ(ico.FaceCount(), 320u);
+  for (const Vec3& p : ico.positions) EXPECT_NEAR(p.Length(), 1.0f, 1e-5f);
+
+  const MeshData torus = Generators::Torus(size, 24, 8);
+  EXPECT_EQ(torus.positions.size(), 192u);
+  EXPECT_EQ(torus.edges.size(), 384u);
+  EXPECT_EQ(torus.FaceCount(), 192u);
+
+  // An open grid has no volume and every quad faces up
+  const MeshData grid = Generators::Grid(size, 4, 3);
+  EXPECT_EQ(grid.positions.size(), 20u);
+  EXPECT_EQ(grid.edges.size(), 31u);
+  EXPECT_EQ(grid.VolumeCount(), 0u);
+  Model model;
+  const MeshIds ids = model.AppendMesh(grid);
+  for (FaceId id : ids.faces) {
+    std::vector<Vec3> points;
+    for (VertexId v : model.FaceLoop(id)) points.push_back(model.GetVertex(v).position);
+    EXPECT_GT(Geometry::PolygonNormal(points).y, 0.0f);
+  }
+}
+
+TEST(GeneratorsTest, ResolutionIsClampedToMaximum) {
+  const Vec3 size{2, 2, 2};
+  constexpr uint32_t kHuge = 1u << 30;
+  const uint32_t n = Generators::kMaxResolution;
+
+  EXPECT_EQ(Generators::Cylinder(size, kHuge, 1).positions.size(), 2u * n);
+  EXPECT_EQ(Generators::Torus(size, kHuge, 3).positions.size(), 3u * n);
+  EXPECT_EQ(Generators::Grid(size, kHuge, 1).positions.size(), 2u * (n + 1));
+  EXPECT_EQ(Generators::Grid(size, 1, kHuge).positions.size(), 2u * (n + 1));
+  EXPECT_EQ(Generators::UvSphere(size, 3, kHuge).FaceCount(), 3u * n);
+  EXPECT_EQ(Generators::Stairs(size, kHuge).VolumeCount(), 1u);
+
+  // Rows would wrap to zero at UINT32_MAX without the clamp
+  const std::vector<Vec3> square = Square(Vec3{2, 0, 0});
+  EXPECT_EQ(Generators::Lathe(square, Vec3{}, Up, 1.0f, UINT32_MAX).positions.size(),
+            4u * (n + 1));
+  EXPECT_EQ(Generators::Loft(Square(), square, UINT32_MAX).positions.size(), 4u * (n + 1));
+}
+
+TEST(GeneratorsTest, GenerateShapeIsOneUndoStep) {
+  Model model;
+  CommandStack stack(model);
+
+  Generators::ShapeParams params = Generators::DefaultParams(Shape::UvSphere);
+  params.center = Vec3{5, 0, 0};
+  ASSERT_TRUE(stack.Do<GenerateShapeCommand>(params));
+  EXPECT_EQ(stack.UndoCount(), 1u);
+  EXPECT_EQ(model.Volumes().size(), 1u);
+
+  const std::size_t vertexCount = model.Vertices().size();
+  Vec3 centroid{};
+  for (const Vertex& v : model.Vertices()) centroid += v.position;
+  EXPECT_TRUE(IsEqual(centroid / static_cast<float>(vertexCount), params.center));
+
+  ASSERT_TRUE(stack.Undo());
+  EXPECT_TRUE(model.Vertices().empty());
+  EXPECT_TRUE(model.Edges().empty());
+  EXPECT_TRUE(model.Faces().empty());
+  EXPECT_TRUE(model.Volumes().empty());
+
+  ASSERT_TRUE(stack.Redo());
+  EXPECT_EQ(model.Vertices().size(), vertexCount);
+  EXPECT_EQ(model.Volumes().size(), 1u);
+}
+
+TEST(GeneratorsTest, RedoneShapeKeepsIdsForLaterCommands) {
+  Model model;
+  CommandStack stack(model);
+
+  ASSERT_TRUE(stack.Do<GenerateShapeCommand>(Generators::DefaultParams(Shape::Box)));
+  const FaceId top = 5;
+  ASSERT_FLOAT_EQ(model.FaceBounds(top).min.z, 1.0f);
+  ASSERT_TRUE(stack.Do<ExtrudeFacesCommand>(std::vector<FaceId>{top}, 1.0f));
+
+  std::vector<FaceId> ids;
+  std::vector<Vec3> minima;
+  for (uint32_t i = 0; i < model.Faces().size(); ++i) {
+    ids.push_back(model.FaceIndexToId(i));
+    minima.push_back(model.FaceBounds(ids.back()).min);
+  }
+
+  ASSERT_TRUE(stack.Undo());
+  ASSERT_TRUE(stack.Undo());
+  ASSERT_TRUE(stack.Redo());
+  ASSERT_TRUE(stack.Redo());
+
+  // The redone extrusion still lands on the +z face
+  EXPECT_FLOAT_EQ(model.FaceBounds(top).min.z, 2.0f);
+  ASSERT_EQ(model.Faces().size(), ids.size());
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    ASSERT_TRUE(model.ContainsFace(ids[i]));
+    EXPECT_TRUE(IsEqual(model.FaceBounds(ids[i]).min, minima[i])) << "face " << ids[i];
+  }
+}
+
+TEST(GeneratorsTest, LatheClosesFullTurnsAndCapsPartialOnes) {
+  // Unit square 1.5 from the y axis: a square section ring of volume 2 pi 1.5 for a
+  // smooth turn, slightly less for 32 flat segments
+  const std::vector<Vec3> square = Square(Vec3{1.5f, 0, 0});
+  std::vector<Vec3> upright;
+  for (const Vec3& p : square) upright.push_back(Vec3{1.5f + p.z, p.y, 0.0f});
+
+  const MeshData ring = Generators::Lathe(upright, Vec3{}, Up, 2.0f * 3.14159265f, 32);
+  EXPECT_EQ(ring.positions.size(), 128u);
+  EXPECT_EQ(ring.FaceCount(), 128u);
+  EXPECT_NEAR(ClosedVolume(ring), 9.42478f, 0.1f);
+
+  // A quarter turn the other way is capped at both ends
+  const MeshData quarter = Generators::Lathe(upright, Vec3{}, Up, -1.5707963f, 8);
+  EXPECT_EQ(quarter.FaceCount(), 8u * 4 + 2);
+  EXPECT_NEAR(ClosedVolume(quarter), 9.42478f / 4, 0.05f);
+}
+
+TEST(GeneratorsTest, LatheWeldsProfileVerticesOnTheAxis) {
+  // Unit square with one side on the y axis turns into a closed octagonal cylinder
+  const std::vector<Vec3> profile{{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+  const MeshData cylinder = Generators::Lathe(profile, Vec3{}, Up, 2.0f * 3.14159265f, 8);
+
+  EXPECT_EQ(cylinder.positions.size(), 2u + 2 * 8);
+  EXPECT_EQ(cylinder.edges.size(), 8u * 5);
+  EXPECT_EQ(cylinder.FaceCount(), 8u * 3);
+  // Regular octagon of circumradius 1 has area 2 sqrt(2)
+  EXPECT_NEAR(ClosedVolume(cylinder), 2.828427f, 1e-3f);
+}
+
+TEST(GeneratorsTest, SweepFollowsCornersWithoutTwisting) {
+  const std::vector<Vec3> path{{0, 0, 0}, {2, 0, 0}, {2, 2, 0}};
+  const MeshData elbow = Generators::Sweep(Square(), path);
+
+  ASSERT_EQ(elbow.positions.size(), 12u);
+  EXPECT_GT(ClosedVolume(elbow), 0.0f);
+
+  // The last ring sits square across the second leg, keeping its z extent
+  for (std::size_t i = 8; i < 12; ++i) {
+    EXPECT_NEAR(elbow.positions[i].y, 2.0f, 1e-5f);
+    EXPECT_NEAR(std::abs(elbow.positions[i].z), 0.5f, 1e-5f);
+  }
+}
+
+TEST(GeneratorsTest, LoftAlignsLoopOrderAndStart) {
+  // The target runs the other way round and starts at a different corner
+  const std::vector<Vec3> from = Square();
+  const std::vector<Vec3> square = Square(Vec3{2, 0, 0});
+  const std::vector<Vec3> to{square[2], square[1], square[0], square[3]};
+
+  const MeshData box = Generators::Loft(from, to, 2);
+  ASSERT_EQ(box.positions.size(), 12u);
+  EXPECT_NEAR(ClosedVolume(box), 2.0f, 1e-4f);
+
+  // Mismatched loops produce nothing
+  EXPECT_TRUE(Generators::Loft(from, std::vector<Vec3>(square.begin(), square.end() - 1)).Empty());
+}
+
+TEST(GeneratorsTest, ProfileCommandsUseFaceLoops) {
+  Model model;
+  CommandStack stack(model);
+  const MeshIds base = model.AppendMesh(Generators::Box(Vec3{1, 1, 1}));
+  const std::size_t faceCount = model.Faces().size();
+
+  ASSERT_TRUE(stack.Do<LatheCommand>(base.faces[0], Vec3{-0.5f, 0, 3}, Up, 3.14159265f, 12u));
+  EXPECT_EQ(model.Volumes().size(), 2u);
+  ASSERT_TRUE(stack.Do<LoftCommand>(base.faces[0], base.faces[1], 3u));
+  EXPECT_EQ(model.Volumes().size(), 3u);
+
+  ASSERT_TRUE(stack.Undo());
+  ASSERT_TRUE(stack.Undo());
+  EXPECT_EQ(model.Faces().size(), faceCount);
+  EXPECT_EQ(model.Volumes().size(), 1u);
+
+  // A missing face leaves the model alone
+  ASSERT_TRUE(stack.Do<SweepCommand>(FaceId{999}, std::vector<Vec3>{{0, 0, 0}, {0, 1, 0}}));
+  EXPECT_EQ(model.Faces().size(), faceCount);
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "App/Input.h"
+#include "App/InputHandler.h"
+#include "App/InputLatency.h"
+#include "Generators/Shapes.h"
+#include "Model/Model.h"
+#include "Rendering/PreviewOverlay.h"
+#include "Utilities/SpscQueue.h"
+
+namespace {
+
+InputEvent Key(KEYS key, bool down) {
+  InputEvent event;
+  event.type = down ? InputEvent::Type::KeyDown : InputEvent::Type::KeyUp;
+  event.key = key;
+  return event;
+}
+
+InputEvent Motion(float x, float y) {
+  InputEvent event;
+  event.type = InputEvent::Type::Motion;
+  event.x = x;
+  event.y = y;
+  return event;
+}
+
+}  // namespace
+
+TEST(InputEventsTest, QueueHandsOverEveryItemInOrder) {
+  SpscQueue<int, 8> queue;
+  int item = 0;
+  EXPECT_FALSE(queue.TryPop(item));
+  for (int i = 0; i < 7; ++i) EXPECT_TRUE(queue.TryPush(i));
+  EXPECT_FALSE(queue.TryPush(7));  // full at capacity - 1
+  for (int i = 0; i < 7; ++i) {
+    ASSERT_TRUE(queue.TryPop(item));
+    EXPECT_EQ(item, i);
+  }
+  EXPECT_TRUE(queue.IsEmpty());
+
+  // Across threads and many wraps of the ring
+  constexpr int kItems = 200000;
+  std::thread producer([&] {
+    for (int i = 0; i < kItems; ++i) {
+      while (!queue.TryPush(i)) std::this_thread::yield();
+    }
+  });
+  int expected = 0;
+  while (expected < kItems) {
+    if (!queue.TryPop(item)) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(item, expected);
+    ++expected;
+  }
+  producer.join();
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(InputEventsTest, FrameCoalescesEvents) {
+  Input input;
+  input.BeginFrame();
+  input.Apply(Motion(100, 100));  // places the cursor, no movement
+  input.Apply(Key(KEYS::SHIFT, true));
+  EXPECT_EQ(input.GetMouseDeltaX(), 0.0f);
+  EXPECT_TRUE(input.IsPressed(KEYS::SHIFT));
+
+  // Everything within one frame: movement and scrolling add up, a short click survives
+  input.BeginFrame();
+  EXPECT_FALSE(input.IsPressed(KEYS::SHIFT));
+  EXPECT_TRUE(input.IsDown(KEYS::SHIFT));
+  EXPECT_FALSE(input.FirstEventTime());
+  InputEvent scroll;
+  scroll.type = InputEvent::Type::Scroll;
+  scroll.y = 1.0f;
+  input.Apply(Motion(104, 97));
+  input.Apply(Key(KEYS::MOUSE_RIGHT, true));
+  input.Apply(Motion(110, 90));
+  input.Apply(Key(KEYS::MOUSE_RIGHT, false));
+  input.Apply(scroll);
+  input.Apply(scroll);
+  input.Apply(Key(KEYS::SHIFT, true));  // already down
+  EXPECT_EQ(input.GetMouseX(), 110.0f);
+  EXPECT_EQ(input.GetMouseDeltaX(), 10.0f);
+  EXPECT_EQ(input.GetMouseDeltaY(), -10.0f);
+  EXPECT_EQ(input.GetScrollDelta(), 2.0f);
+  EXPECT_TRUE(input.IsPressed(KEYS::MOUSE_RIGHT));
+  EXPECT_TRUE(input.IsReleased(KEYS::MOUSE_RIGHT));
+  EXPECT_FALSE(input.IsDown(KEYS::MOUSE_RIGHT));
+  EXPECT_FALSE(input.IsPressed(KEYS::SHIFT));
+  EXPECT_TRUE(input.FirstEventTime());
+
+  input.BeginFrame();
+  input.Apply(Key(KEYS::SHIFT, false));
+  EXPECT_TRUE(input.IsReleased(KEYS::SHIFT));
+  EXPECT_EQ(input.GetScrollDelta(), 0.0f);
+  EXPECT_EQ(input.GetMouseDeltaX(), 0.0f);
+}
+
+TEST(InputEventsTest, LatencyKeepsTheLastFrames) {
+  InputLatency latency;
+  EXPECT_EQ(latency.AverageMilliseconds(), 0.0f);
+  latency.Add(std::chrono::milliseconds(30));
+  for (std::size_t i = 0; i < InputLatency::kFrames; ++i) {
+    latency.Add(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(latency.Count(), InputLatency::kFrames);
+  EXPECT_FLOAT_EQ(latency.AverageMilliseconds(), 10.0f);  // the slow one dropped out
+  EXPECT_FLOAT_EQ(latency.MaxMilliseconds(), 10.0f);
+}
+
+TEST(InputEventsTest, ExtrudeDragCommitsTheWallsItPreviewed) {
+  Model model;
+  model.AppendMesh(Generators::Box(Vec3{2, 2, 2}));
+  CommandStack stack(model);
+  Camera camera;
+  PreviewOverlay overlay;
+  InputHandler handler(stack, camera, model, overlay);
+  InputEventQueue events;
+  Input input;
+
+  const FaceId face = model.FaceIndexToId(0);
+  input.SetSelectedFaceId(face + 1);
+  events.TryPush(Motion(100, 100));
+  events.TryPush(Key(KEYS::SHIFT, true));
+  events.TryPush(Key(KEYS::MOUSE_LEFT, true));
+  handler.HandleInput(events, input);
+
+  // Dragging up half a unit only changes the preview
+  events.TryPush(Motion(100, 50));
+  handler.HandleInput(events, input);
+  EXPECT_FALSE(overlay.IsEmpty());
+  EXPECT_EQ(stack.UndoCount(), 0u);
+  EXPECT_EQ(model.Faces().size(), 6u);
+
+  // Release commits the face moved out with a wall along each of its four edges
+  events.TryPush(Key(KEYS::MOUSE_LEFT, false));
+  handler.HandleInput(events, input);
+  EXPECT_TRUE(overlay.IsEmpty());
+  EXPECT_EQ(stack.UndoCount(), 1u);
+  EXPECT_EQ(model.Faces().size(), 10u);
+  ASSERT_EQ(model.Volumes().size(), 1u);
+  EXPECT_EQ(model.Volumes()[0].faces.size(), 10u);
+}
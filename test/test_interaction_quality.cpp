@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+
+#include "Rendering/InteractionQuality.h"
+
+TEST(InteractionQualityTest, StartsAtFullQuality) {
+  InteractionQuality quality;
+  EXPECT_TRUE(quality.IsFull());
+  EXPECT_EQ(quality.LodErrorScale(), 1.0f);
+  EXPECT_TRUE(quality.DrawWorldPositions());
+  EXPECT_TRUE(quality.DrawPoints());
+  EXPECT_FALSE(quality.Advance(false));
+}
+
+TEST(InteractionQualityTest, DropsWhileMovingAndRestoresStepByStep) {
+  InteractionQuality quality;
+  for (int frame = 0; frame < 5; ++frame) {
+    EXPECT_FALSE(quality.Advance(true));
+    EXPECT_TRUE(quality.IsMoving());
+    EXPECT_GT(quality.LodErrorScale(), 1.0f);
+    EXPECT_FALSE(quality.DrawWorldPositions());
+    EXPECT_FALSE(quality.DrawPoints());
+  }
+
+  // One redraw per step: full LODs, then world positions, then points
+  EXPECT_TRUE(quality.Advance(false));
+  EXPECT_EQ(quality.LodErrorScale(), 1.0f);
+  EXPECT_FALSE(quality.DrawWorldPositions());
+  EXPECT_TRUE(quality.Advance(false));
+  EXPECT_TRUE(quality.DrawWorldPositions());
+  EXPECT_FALSE(quality.DrawPoints());
+  EXPECT_TRUE(quality.Advance(false));
+  EXPECT_TRUE(quality.IsFull());
+  EXPECT_FALSE(quality.Advance(false));
+
+  // Moving again mid-restore starts over
+  quality.Advance(true);
+  quality.Advance(false);
+  EXPECT_FALSE(quality.Advance(true));
+  EXPECT_TRUE(quality.IsMoving());
+  EXPECT_FALSE(quality.DrawWorldPositions());
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <numbers>
+#include <vector>
+
+#include "Analysis/MassProperties.h"
+#include "Analysis/MassPropertiesCache.h"
+#include "Generators/Shapes.h"
+#include "Model/Model.h"
+#include "Utilities/Vec3.h"
+
+#include "TestHelpers.h"
+
+TEST(MassPropertiesTest, BoxMatchesClosedForm) {
+  // 2 x 3 x 4 box far from the origin, split into several faces per side
+  Model model;
+  const Vec3 center{1000, -500, 250};
+  const MeshIds ids = model.AppendMesh(Moved(Generators::Box(Vec3{2, 3, 4}, 3), center));
+
+  const Analysis::MassProperties box = Analysis::Compute(model, ids.faces);
+  EXPECT_NEAR(box.volume, 24.0, 1e-6);
+  EXPECT_NEAR(box.area, 2.0 * (6 + 8 + 12), 1e-6);
+  EXPECT_NEAR(box.centroid.x, center.x, 1e-3);
+  EXPECT_NEAR(box.centroid.y, center.y, 1e-3);
+  EXPECT_NEAR(box.centroid.z, center.z, 1e-3);
+
+  // m (b^2 + c^2) / 12 and so on; no products of inertia for an axis aligned box
+  EXPECT_NEAR(box.inertia[0], 24.0 * (9 + 16) / 12.0, 1e-5);
+  EXPECT_NEAR(box.inertia[1], 24.0 * (4 + 16) / 12.0, 1e-5);
+  EXPECT_NEAR(box.inertia[2], 24.0 * (4 + 9) / 12.0, 1e-5);
+  for (int i = 3; i < 6; ++i) EXPECT_NEAR(box.inertia[i], 0.0, 1e-5);
+}
+
+TEST(MassPropertiesTest, SphereApproachesClosedForm) {
+  Model model;
+  const MeshIds ids = model.AppendMesh(Generators::UvSphere(Vec3{2, 2, 2}, 256, 128));
+  const Analysis::MassProperties sphere = Analysis::Compute(model, ids.faces);
+
+  const double pi = std::numbers::pi;
+  const double volume = 4.0 / 3.0 * pi;
+  EXPECT_NEAR(sphere.volume, volume, 1e-3 * volume);
+  EXPECT_NEAR(sphere.area, 4.0 * pi, 1e-3 * 4.0 * pi);
+  for (int i = 0; i < 3; ++i) EXPECT_NEAR(sphere.inertia[i], 0.4 * volume, 2e-3 * volume);
+  EXPECT_NEAR(sphere.centroid.Length(), 0.0f, 1e-4f);
+}
+
+TEST(MassPropertiesTest, ProductsOfInertiaFollowOffsets) {
+  // Two unit cubes on a diagonal: the pair leans, so xy is non-zero
+  Model model;
+  std::vector<FaceId> faces = model.AppendMesh(Generators::Box(Vec3{1, 1, 1})).faces;
+  const MeshIds second = model.AppendMesh(Moved(Generators::Box(Vec3{1, 1, 1}), Vec3{1, 1, 0}));
+  faces.insert(faces.end(), second.faces.begin(), second.faces.end());
+
+  const Analysis::MassProperties pair = Analysis::Compute(model, faces);
+  EXPECT_NEAR(pair.volume, 2.0, 1e-9);
+  // Each cube sits half a unit from the centroid along x and y
+  EXPECT_NEAR(pair.inertia[3], -2.0 * 0.5 * 0.5, 1e-9);
+  EXPECT_NEAR(pair.inertia[2], 2.0 / 6.0 + 2.0 * 0.5, 1e-9);
+}
+
+TEST(MassPropertiesTest, VolumesInParallelMatchOneAtATime) {
+  Model model;
+  std::vector<VolumeId> volumes;
+  for (int i = 0; i < 12; ++i) {
+    const Vec3 offset{static_cast<float>(3 * i), 0, 0};
+    volumes.push_back(
+        model.AppendMesh(Moved(Generators::Torus(Vec3{2, 1, 2}, 16 + i, 8), offset)).volumes[0]);
+  }
+  volumes.push_back(12345);
+
+  const auto all = Analysis::ComputeVolumes(model, volumes);
+  ASSERT_EQ(all.size(), volumes.size());
+  for (std::size_t i = 0; i + 1 < volumes.size(); ++i) {
+    const auto one = Analysis::Compute(model, model.GetVolume(volumes[i]).faces);
+    EXPECT_EQ(all[i].volume, one.volume);
+    EXPECT_EQ(all[i].inertia, one.inertia);
+    EXPECT_GT(one.volume, 0.0);
+  }
+  EXPECT_EQ(all.back().volume, 0.0);
+}
+
+TEST(MassPropertiesTest, CacheDropsEditedVolumesOnly) {
+  Model model;
+  const MeshIds a = model.AppendMesh(Generators::Box(Vec3{1, 1, 1}));
+  const MeshIds b = model.AppendMesh(Moved(Generators::Box(Vec3{2, 2, 2}), Vec3{5, 0, 0}));
+  model.ResetDirtyFlags();
+
+  Analysis::MassPropertiesCache cache(model);
+  const VolumeId both[] = {a.volumes[0], b.volumes[0]};
+  cache.Prefetch(both);
+  EXPECT_EQ(cache.CachedCount(), 2u);
+  EXPECT_NEAR(cache.Get(b.volumes[0]).volume, 8.0, 1e-9);
+
+  // Moving a vertex of the first box only invalidates that box
+  const VertexId corner = a.vertices[0];
+  model.SetVertexPosition(corner, model.GetVertex(corner).position * 2.0f);
+  cache.Update();
+  model.ResetDirtyFlags();
+  EXPECT_EQ(cache.CachedCount(), 1u);
+  EXPECT_GT(cache.Get(a.volumes[0]).volume, 1.0);
+
+  // Unrelated geometry leaves both alone; removing a volume drops its entry
+  model.AppendMesh(Moved(Generators::Box(Vec3{1, 1, 1}), Vec3{-5, 0, 0}));
+  cache.Update();
+  model.ResetDirtyFlags();
+  EXPECT_EQ(cache.CachedCount(), 2u);
+
+  model.RemoveVolume(b.volumes[0]);
+  cache.Update();
+  EXPECT_EQ(cache.CachedCount(), 1u);
+  EXPECT_EQ(cache.Get(b.volumes[0]).volume, 0.0);
+}
+
+TEST(MassPropertiesTest, CacheSeesEditsBeforeUpdate) {
+  Model model;
+  const MeshIds cube = model.AppendMesh(Generators::Box(Vec3{1, 1, 1}));
+  model.ResetDirtyFlags();
+
+  Analysis::MassPropertiesCache cache(model);
+  EXPECT_NEAR(cache.Get(cube.volumes[0]).volume, 1.0, 1e-9);
+
+  // Scaling the cube by two, with no Update in between
+  std::vector<Vec3> positions;
+  for (VertexId id : cube.vertices) positions.push_back(model.GetVertex(id).position * 2.0f);
+  model.SetVertexPositions(cube.vertices, positions);
+  EXPECT_NEAR(cache.Get(cube.volumes[0]).volume, 8.0, 1e-6);
+
+  const VolumeId volumes[] = {cube.volumes[0]};
+  for (Vec3& p : positions) p = p * 0.5f;
+  model.SetVertexPositions(cube.vertices, positions);
+  cache.Prefetch(volumes);
+  EXPECT_EQ(cache.CachedCount(), 1u);
+  EXPECT_NEAR(cache.Get(cube.volumes[0]).volume, 1.0, 1e-6);
+}
+
+TEST(MassPropertiesTest, CacheDropsEntriesOnUntrackedMoves) {
+  Model model;
+  const MeshIds cube = model.AppendMesh(Generators::Box(Vec3{1, 1, 1}));
+  model.ResetDirtyFlags();
+
+  Analysis::MassPropertiesCache cache(model);
+  EXPECT_NEAR(cache.Get(cube.volumes[0]).volume, 1.0, 1e-9);
+
+  // Two face drags move every vertex of the cube, more than the model tracks per face
+  auto drag = [&](FaceId face, const Vec3& offset) {
+    const auto loop = model.FaceLoop(face);
+    const std::vector<VertexId> ids(loop.begin(), loop.end());
+    std::vector<Vec3> positions;
+    for (VertexId id : ids) positions.push_back(model.GetVertex(id).position + offset);
+    model.SetVertexPositions(ids, positions);
+  };
+  // The box emits its -x side first and the opposite +x side second
+  const FaceId left = cube.faces[0];
+  const FaceId right = cube.faces[1];
+  drag(left, model.FaceNormal(left) * 0.5f);
+  drag(right, model.FaceNormal(right) * 0.5f);
+  ASSERT_TRUE(model.HasUntrackedMoves());
+  cache.Update();
+  model.ResetDirtyFlags();
+  EXPECT_EQ(cache.CachedCount(), 0u);
+  EXPECT_NEAR(cache.Get(cube.volumes[0]).volume, 2.0, 1e-6);
+
+  // Legacy extrude keeps every face list and loop size
+  model.ExtrudeFace(right, 1.0f);
+  cache.Update();
+  model.ResetDirtyFlags();
+  EXPECT_EQ(cache.CachedCount(), 0u);
+  EXPECT_NEAR(cache.Get(cube.volumes[0]).volume, 3.0, 1e-6);
+}
+
+TEST(MassPropertiesTest, CacheDropsEntriesWhenARegionExtrudeMovesAClosedVolume) {
+  Model model;
+  const MeshIds cube = model.AppendMesh(Generators::Box(Vec3{1, 1, 1}));
+  model.ResetDirtyFlags();
+
+  Analysis::MassPropertiesCache cache(model);
+  EXPECT_NEAR(cache.Get(cube.volumes[0]).volume, 1.0, 1e-9);
+
+  // The whole cube has no boundary: no walls, same face lists, every corner pushed
+  // out along its averaged normal
+  const ExtrudeRecord record = model.ExtrudeFaces(cube.faces, 0.5f);
+  ASSERT_TRUE(record.createdFaces.empty());
+  cache.Update();
+  model.ResetDirtyFlags();
+  EXPECT_EQ(cache.CachedCount(), 0u);
+  const double side = 1.0 + 2.0 * 0.5 / std::numbers::sqrt3;
+  EXPECT_NEAR(cache.Get(cube.volumes[0]).volume, side * side * side, 1e-5);
+
+  model.RevertExtrude(record);
+  cache.Update();
+  model.ResetDirtyFlags();
+  EXPECT_EQ(cache.CachedCount(), 0u);
+  EXPECT_NEAR(cache.Get(cube.volumes[0]).volume, 1.0, 1e-6);
+}
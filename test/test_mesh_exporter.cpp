@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+
+#include "Export/MeshExporter.h"
+#include "Import/MeshImporter.h"
+#include "Model/Model.h"
+
+namespace {
+
+const char* kObjCube = R"(v 0 0 0
+v 1 0 0
+v 1 1 0
+v 0 1 0
+v 0 0 1
+v 1 0 1
+v 1 1 1
+v 0 1 1.5
+f 1 4 3 2
+f 5 6 7 8
+f 1 2 6 5
+f 2 3 7 6
+f 3 4 8 7
+f 4 1 5 8
+)";
+
+}  // namespace
+
+class MeshExporterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto result = Import::ImportBuffer(kObjCube);
+    ASSERT_TRUE(result.Ok()) << result.message;
+    model.AppendMesh(result.mesh);
+  }
+
+  void TearDown() override { std::filesystem::remove(path); }
+
+  std::string TempPath(const std::string& extension) {
+    const int seed = ::testing::UnitTest::GetInstance()->random_seed();
+    path = (std::filesystem::temp_directory_path() /
+            ("cad_export_test_" + std::to_string(seed) + extension))
+               .string();
+    return path;
+  }
+
+  Model model;
+  std::string path;
+};
+
+TEST_F(MeshExporterTest, Obj_RoundTripsThroughImporter) {
+  Export::Options options;
+  options.facesPerChunk = 2;  // force several chunks
+  auto exported = Export::ExportFile(model, TempPath(".obj"), options);
+
+  ASSERT_TRUE(exported.Ok()) << exported.message;
+  EXPECT_EQ(exported.triangleCount, 12u);
+
+  auto imported = Import::ImportFile(path);
+  ASSERT_TRUE(imported.Ok()) << imported.message;
+  ASSERT_EQ(imported.mesh.positions.size(), 8u);
+  EXPECT_EQ(imported.mesh.FaceCount(), 12u);
+  EXPECT_EQ(imported.mesh.VolumeCount(), 1u);
+  EXPECT_FLOAT_EQ(imported.mesh.positions[7].z, 1.5f);
+}
+
+TEST_F(MeshExporterTest, Stl_WritesBinaryWithPatchedCount) {
+  auto exported = Export::ExportFile(model, TempPath(".stl"));
+
+  ASSERT_TRUE(exported.Ok()) << exported.message;
+  EXPECT_EQ(std::filesystem::file_size(path), 84u + 12u * 50u);
+
+  auto imported = Import::ImportFile(path);
+  ASSERT_TRUE(imported.Ok()) << imported.message;
+  EXPECT_EQ(imported.mesh.positions.size(), 8u);
+  EXPECT_EQ(imported.mesh.FaceCount(), 12u);
+}
+
+TEST_F(MeshExporterTest, UnknownExtension_IsRejected) {
+  auto exported = Export::ExportFile(model, TempPath(".xyz"));
+  EXPECT_EQ(exported.status, Export::Status::UnsupportedFormat);
+}
+
+TEST_F(MeshExporterTest, Cancelled_StopsEarly) {
+  std::atomic<bool> cancel{true};
+  Export::Options options;
+  options.cancel = &cancel;
+
+  auto exported = Export::ExportFile(model, TempPath(".stl"), options);
+  EXPECT_EQ(exported.status, Export::Status::Cancelled);
+  EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST_F(MeshExporterTest, WriteFailure_IsReported) {
+  // Every write to /dev/full fails with no space left
+  if (!std::filesystem::exists("/dev/full")) GTEST_SKIP() << "needs /dev/full";
+
+  Export::Options options;
+  options.format = Export::Format::Obj;
+  auto exported = Export::ExportFile(model, "/dev/full", options);
+  EXPECT_EQ(exported.status, Export::Status::FileError);
+  EXPECT_TRUE(std::filesystem::exists("/dev/full"));
+}
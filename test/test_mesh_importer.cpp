@@ -0,0 +1,340 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "App/Commands/CommandStack.h"
+#include "Geometry/Aabb.h"
+#include "Import/MeshImporter.h"
+#include "Model/Model.h"
+#include "Topology/Tools.h"
+
+namespace {
+
+const char* kObjCube = R"(# unit cube
+v 0 0 0
+v 1 0 0
+v 1 1 0
+v 0 1 0
+v 0 0 1
+v 1 0 1
+v 1 1 1
+v 0 1 1
+f 1 4 3 2
+f 5 6 7 8
+f 1/1/1 2/2/1 6/3/1 5/4/1
+f 2 3 7 6
+f -5 -1 -2 -6
+f 4 1 5 8
+)";
+
+std::string BinaryStl(const float (*triangles)[9], uint32_t count) {
+  std::string data(80, '\0');
+  data.append(reinterpret_cast<const char*>(&count), 4);
+  for (uint32_t t = 0; t < count; ++t) {
+    const float normal[3] = {0, 0, 0};
+    data.append(reinterpret_cast<const char*>(normal), sizeof(normal));
+    data.append(reinterpret_cast<const char*>(triangles[t]), 9 * sizeof(float));
+    data.append(2, '\0');
+  }
+  return data;
+}
+
+// Closed tetrahedron as four triangles with unshared corners
+const float kTetrahedron[4][9] = {
+    {0, 0, 0, 0, 1, 0, 1, 0, 0},
+    {0, 0, 0, 1, 0, 0, 0, 0, 1},
+    {0, 0, 0, 0, 0, 1, 0, 1, 0},
+    {1, 0, 0, 0, 1, 0, 0, 0, 1},
+};
+
+}  // namespace
+
+TEST(MeshImporterTest, ObjCube_WeldsEdgesAndBuildsVolume) {
+  Import::Options options;
+  options.format = Import::Format::Obj;
+  auto result = Import::ImportBuffer(kObjCube, options);
+
+  ASSERT_TRUE(result.Ok()) << result.message;
+  EXPECT_EQ(result.mesh.positions.size(), 8u);
+  EXPECT_EQ(result.mesh.edges.size(), 12u);
+  EXPECT_EQ(result.mesh.FaceCount(), 6u);
+  EXPECT_EQ(result.mesh.VolumeCount(), 1u);
+}
+
+TEST(MeshImporterTest, ObjCube_AppendsValidTopologyToModel) {
+  auto result = Import::ImportBuffer(kObjCube);
+  ASSERT_TRUE(result.Ok()) << result.message;
+
+  Model model;
+  MeshIds ids = model.AppendMesh(result.mesh);
+
+  ASSERT_EQ(ids.faces.size(), 6u);
+  ASSERT_EQ(ids.volumes.size(), 1u);
+  for (FaceId face : ids.faces) {
+    EXPECT_EQ(Topology::ExtractVertices(model.GetFace(face), model.Edges()).size(), 4u);
+  }
+}
+
+TEST(MeshImporterTest, ObjMissingVertex_ReportsParseError) {
+  auto result = Import::ImportBuffer("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 9\n");
+  EXPECT_EQ(result.status, Import::Status::ParseError);
+}
+
+TEST(MeshImporterTest, BinaryStl_WeldsSharedCorners) {
+  const std::string data = BinaryStl(kTetrahedron, 4);
+  auto result = Import::ImportBuffer(data);
+
+  ASSERT_TRUE(result.Ok()) << result.message;
+  EXPECT_EQ(result.mesh.positions.size(), 4u);
+  EXPECT_EQ(result.mesh.edges.size(), 6u);
+  EXPECT_EQ(result.mesh.FaceCount(), 4u);
+  EXPECT_EQ(result.mesh.VolumeCount(), 1u);
+}
+
+TEST(MeshImporterTest, AsciiStl_WeldsWithinTolerance) {
+  const char* stl = R"(solid two
+facet normal 0 0 1
+ outer loop
+  vertex 0 0 0
+  vertex 1 0 0
+  vertex 0 1 0
+ endloop
+endfacet
+facet normal 0 0 1
+ outer loop
+  vertex 1.00001 0 0
+  vertex 1 1 0
+  vertex 0 1.00001 0
+ endloop
+endfacet
+endsolid two
+)";
+  Import::Options options;
+  options.weldTolerance = 0.001f;
+  auto result = Import::ImportBuffer(stl, options);
+
+  ASSERT_TRUE(result.Ok()) << result.message;
+  EXPECT_EQ(result.mesh.positions.size(), 4u);
+  EXPECT_EQ(result.mesh.edges.size(), 5u);
+  EXPECT_EQ(result.mesh.VolumeCount(), 0u);
+}
+
+TEST(MeshImporterTest, AsciiPly_ParsesQuadAndTriangle) {
+  const char* ply = R"(ply
+format ascii 1.0
+element vertex 5
+property float x
+property float y
+property float z
+property uchar red
+element face 2
+property list uchar int vertex_indices
+end_header
+0 0 0 255
+1 0 0 255
+1 1 0 255
+0 1 0 255
+2 0 0 255
+4 0 1 2 3
+3 1 4 2
+)";
+  auto result = Import::ImportBuffer(ply);
+
+  ASSERT_TRUE(result.Ok()) << result.message;
+  EXPECT_EQ(result.mesh.positions.size(), 5u);
+  EXPECT_EQ(result.mesh.FaceCount(), 2u);
+  EXPECT_EQ(result.mesh.FaceEdges(0).size(), 4u);
+  EXPECT_EQ(result.mesh.edges.size(), 6u);
+}
+
+TEST(MeshImporterTest, BinaryPly_ParsesBigEndian) {
+  std::string ply =
+      "ply\nformat binary_big_endian 1.0\nelement vertex 3\nproperty float x\n"
+      "property float y\nproperty float z\nelement face 1\n"
+      "property list uchar int vertex_indices\nend_header\n";
+  auto appendBigEndian = [&](const void* value, std::size_t size) {
+    const char* bytes = static_cast<const char*>(value);
+    for (std::size_t i = size; i-- > 0;) ply.push_back(bytes[i]);
+  };
+  const float positions[9] = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+  for (float f : positions) appendBigEndian(&f, sizeof(f));
+  ply.push_back(3);
+  for (int32_t i = 0; i < 3; ++i) appendBigEndian(&i, sizeof(i));
+
+  auto result = Import::ImportBuffer(ply);
+
+  ASSERT_TRUE(result.Ok()) << result.message;
+  ASSERT_EQ(result.mesh.positions.size(), 3u);
+  EXPECT_FLOAT_EQ(result.mesh.positions[1].x, 1.0f);
+  EXPECT_EQ(result.mesh.FaceCount(), 1u);
+}
+
+TEST(MeshImporterTest, BinaryPly_TruncatedListVertexReportsParseError) {
+  // Vertex records with a list are variable size; the last one claims more items than remain
+  std::string ply =
+      "ply\nformat binary_little_endian 1.0\nelement vertex 2\nproperty float x\n"
+      "property float y\nproperty float z\nproperty list uchar int tags\nend_header\n";
+  const float position[3] = {0, 0, 0};
+  ply.append(reinterpret_cast<const char*>(position), sizeof(position));
+  ply.push_back(0);
+  ply.append(reinterpret_cast<const char*>(position), sizeof(position));
+  ply.push_back(static_cast<char>(200));
+
+  auto result = Import::ImportBuffer(ply);
+  EXPECT_EQ(result.status, Import::Status::ParseError);
+}
+
+TEST(MeshImporterTest, BinaryPly_HugeElementCountReportsParseError) {
+  // stride * count wraps around to a small number if the product is not checked
+  const std::string ply =
+      "ply\nformat binary_little_endian 1.0\nelement vertex 1537228672809129302\n"
+      "property float x\nproperty float y\nproperty float z\nend_header\n";
+
+  auto result = Import::ImportBuffer(ply);
+  EXPECT_EQ(result.status, Import::Status::ParseError);
+}
+
+TEST(MeshImporterTest, BinaryPly_NegativeIndexReportsParseError) {
+  std::string ply =
+      "ply\nformat binary_little_endian 1.0\nelement vertex 3\nproperty float x\n"
+      "property float y\nproperty float z\nelement face 1\n"
+      "property list uchar int vertex_indices\nend_header\n";
+  const float positions[9] = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+  ply.append(reinterpret_cast<const char*>(positions), sizeof(positions));
+  ply.push_back(3);
+  const int32_t indices[3] = {0, 1, -1};
+  ply.append(reinterpret_cast<const char*>(indices), sizeof(indices));
+
+  auto result = Import::ImportBuffer(ply);
+  EXPECT_EQ(result.status, Import::Status::ParseError);
+}
+
+TEST(MeshImporterTest, AsciiPly_IndexAboveUint32ReportsParseError) {
+  // 2^32 + 2 would truncate to the valid index 2
+  const char* ply =
+      "ply\nformat ascii 1.0\nelement vertex 3\nproperty float x\nproperty float y\n"
+      "property float z\nelement face 1\nproperty list uchar int vertex_indices\n"
+      "end_header\n0 0 0\n1 0 0\n0 1 0\n3 0 1 4294967298\n";
+
+  auto result = Import::ImportBuffer(ply);
+  EXPECT_EQ(result.status, Import::Status::ParseError);
+}
+
+TEST(MeshImporterTest, ObjIndexOverflow_ReportsParseError) {
+  auto result =
+      Import::ImportBuffer("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 18446744073709551618\n");
+  EXPECT_EQ(result.status, Import::Status::ParseError);
+}
+
+TEST(MeshImporterTest, ObjNanCoordinate_ReportsParseError) {
+  auto result = Import::ImportBuffer("v nan 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+  EXPECT_EQ(result.status, Import::Status::ParseError);
+}
+
+TEST(MeshImporterTest, BinaryStlInfiniteCoordinate_ReportsParseError) {
+  float triangle[1][9] = {{0, 0, 0, 1, 0, 0, 0, 1, 0}};
+  triangle[0][4] = std::numeric_limits<float>::infinity();
+  auto result = Import::ImportBuffer(BinaryStl(triangle, 1));
+  EXPECT_EQ(result.status, Import::Status::ParseError);
+}
+
+TEST(MeshImporterTest, Weld_KeepsCoordinatesBeyondTheToleranceGridApart) {
+  // 1e30 / 1e-6 cells is far outside int64_t; the two far corners must not collapse
+  Import::Options options;
+  options.weldTolerance = 1e-6f;
+  auto result = Import::ImportBuffer("v 1e30 0 0\nv 2e30 0 0\nv 0 1 0\nf 1 2 3\n", options);
+
+  ASSERT_TRUE(result.Ok()) << result.message;
+  EXPECT_EQ(result.mesh.positions.size(), 3u);
+  ASSERT_EQ(result.mesh.FaceCount(), 1u);
+  EXPECT_EQ(result.mesh.FaceEdges(0).size(), 3u);
+}
+
+TEST(MeshImporterTest, Weld_DropsRepeatedCornersAnywhereInLoop) {
+  // The second and fourth corners weld together without being adjacent
+  const char* obj = "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 1 0 0\nv 0 1 0\nf 1 2 3 4 5\n";
+  auto result = Import::ImportBuffer(obj);
+
+  ASSERT_TRUE(result.Ok()) << result.message;
+  ASSERT_EQ(result.mesh.FaceCount(), 1u);
+  EXPECT_EQ(result.mesh.FaceEdges(0).size(), 4u);
+}
+
+TEST(MeshImporterTest, Cancelled_ReturnsCancelledStatus) {
+  std::atomic<bool> cancel{true};
+  Import::Options options;
+  options.cancel = &cancel;
+
+  auto result = Import::ImportBuffer(kObjCube, options);
+  EXPECT_EQ(result.status, Import::Status::Cancelled);
+}
+
+TEST(MeshImporterTest, Progress_IsMonotonicAndCompletes) {
+  float last = -1.0f;
+  bool monotonic = true;
+  Import::Options options;
+  options.progress = [&](float value) {
+    monotonic = monotonic && value >= last;
+    last = value;
+  };
+
+  ASSERT_TRUE(Import::ImportBuffer(kObjCube, options).Ok());
+  EXPECT_TRUE(monotonic);
+  EXPECT_FLOAT_EQ(last, 1.0f);
+}
+
+TEST(MeshImporterTest, AppendMeshCommand_UndoRemovesEverything) {
+  auto result = Import::ImportBuffer(kObjCube);
+  ASSERT_TRUE(result.Ok());
+
+  Model model;
+  CommandStack stack(model);
+  stack.Do<AppendMeshCommand>(std::move(result.mesh));
+  EXPECT_EQ(model.Faces().size(), 6u);
+
+  ASSERT_TRUE(stack.Undo());
+  EXPECT_TRUE(model.Vertices().empty());
+  EXPECT_TRUE(model.Edges().empty());
+  EXPECT_TRUE(model.Faces().empty());
+  EXPECT_TRUE(model.Volumes().empty());
+
+  ASSERT_TRUE(stack.Redo());
+  EXPECT_EQ(model.Volumes().size(), 1u);
+}
+
+TEST(MeshImporterTest, AppendMeshCommand_RedoKeepsIdsForLaterCommands) {
+  auto result = Import::ImportBuffer(kObjCube);
+  ASSERT_TRUE(result.Ok());
+
+  Model model;
+  CommandStack stack(model);
+  stack.Do<AppendMeshCommand>(std::move(result.mesh));
+  ASSERT_TRUE(IsEqual(model.FaceBounds(1).min, Vec3{0, 0, 1}));
+  stack.Do<ExtrudeFacesCommand>(std::vector<FaceId>{1}, 1.0f);
+
+  std::vector<FaceId> ids;
+  std::vector<Geometry::Aabb> bounds;
+  for (uint32_t i = 0; i < model.Faces().size(); ++i) {
+    ids.push_back(model.FaceIndexToId(i));
+    bounds.push_back(model.FaceBounds(ids.back()));
+  }
+  EXPECT_FLOAT_EQ(model.FaceBounds(1).min.z, 2.0f);
+
+  // The redone extrusion must find the same top face under the same id
+  ASSERT_TRUE(stack.Undo());
+  ASSERT_TRUE(stack.Undo());
+  ASSERT_TRUE(stack.Redo());
+  ASSERT_TRUE(stack.Redo());
+
+  ASSERT_EQ(model.Faces().size(), ids.size());
+  for (uint32_t i = 0; i < ids.size(); ++i) {
+    ASSERT_TRUE(model.ContainsFace(ids[i]));
+    EXPECT_TRUE(IsEqual(model.FaceBounds(ids[i]).min, bounds[i].min)) << "face " << ids[i];
+    EXPECT_TRUE(IsEqual(model.FaceBounds(ids[i]).max, bounds[i].max)) << "face " << ids[i];
+  }
+  EXPECT_FLOAT_EQ(model.FaceBounds(1).min.z, 2.0f);
+}
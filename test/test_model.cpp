@@ -1,8 +1,18 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "App/Commands/Commands.h"
+#include "Core/MeshData.h"
 #include "Model/Model.h"
+#include "Topology/Validation.h"
 #include "Utilities/Vec3.h"
 
+#include "TestHelpers.h"
+
 class ModelTest : public ::testing::Test {
  protected:
   Model model;
@@ -148,3 +158,218 @@ TEST_F(ModelTest, IterationReturnsCorrectCounts) {
   EXPECT_EQ(model.Faces().size(), 0u);
   EXPECT_EQ(model.Volumes().size(), 0u);
 }
+
+TEST_F(ModelTest, FaceCache_TracksLoopPlaneAndBounds) {
+  VertexId v0 = model.CreateVertex({0, 0, 2});
+  VertexId v1 = model.CreateVertex({1, 0, 2});
+  VertexId v2 = model.CreateVertex({1, 1, 2});
+  VertexId v3 = model.CreateVertex({0, 1, 2});
+
+  auto e0 = model.CreateEdge(v0, v1);
+  auto e1 = model.CreateEdge(v1, v2);
+  auto e2 = model.CreateEdge(v2, v3);
+  auto e3 = model.CreateEdge(v3, v0);
+  ASSERT_TRUE(e0 && e1 && e2 && e3);
+
+  std::array<EdgeId, 4> edges{*e0, *e1, *e2, *e3};
+  auto faceId = model.CreateFace(edges);
+  ASSERT_TRUE(faceId.has_value());
+
+  const auto loop = model.FaceLoop(*faceId);
+  ASSERT_EQ(loop.size(), 4u);
+  EXPECT_EQ(loop[0], v0);
+  EXPECT_EQ(loop[1], v1);
+  EXPECT_TRUE(IsEqual(model.FaceNormal(*faceId), Vec3{0, 0, 1}));
+  EXPECT_FLOAT_EQ(model.FacePlaneOffset(*faceId), 2.0f);
+  EXPECT_TRUE(IsEqual(model.FaceBounds(*faceId).max, Vec3{1, 1, 2}));
+  EXPECT_EQ(model.VertexFaces(v2).size(), 1u);
+
+  // Moving the whole face keeps the cached plane current
+  model.ExtrudeFace(*faceId, 3.0f);
+  EXPECT_FLOAT_EQ(model.FacePlaneOffset(*faceId), 5.0f);
+  EXPECT_TRUE(IsEqual(model.FaceBounds(*faceId).min, Vec3{0, 0, 5}));
+
+  model.SetVertexPosition(v2, {2, 2, 5});
+  EXPECT_TRUE(IsEqual(model.FaceBounds(*faceId).max, Vec3{2, 2, 5}));
+
+  // Breaking the loop invalidates the entry and its adjacency
+  ASSERT_TRUE(model.RemoveEdge(*e1));
+  EXPECT_TRUE(model.FaceLoop(*faceId).empty());
+  EXPECT_TRUE(model.VertexFaces(v2).empty());
+}
+
+TEST_F(ModelTest, FaceCache_RemoveFaceDetachesAdjacency) {
+  VertexId v0 = model.CreateVertex({0, 0, 0});
+  VertexId v1 = model.CreateVertex({1, 0, 0});
+  VertexId v2 = model.CreateVertex({0, 1, 0});
+
+  auto e0 = model.CreateEdge(v0, v1);
+  auto e1 = model.CreateEdge(v1, v2);
+  auto e2 = model.CreateEdge(v2, v0);
+  ASSERT_TRUE(e0 && e1 && e2);
+
+  std::array<EdgeId, 3> edges{*e0, *e1, *e2};
+  auto faceId = model.CreateFace(edges);
+  ASSERT_TRUE(faceId.has_value());
+
+  // Copies keep their own cache
+  Model copy(model);
+  ASSERT_TRUE(model.RemoveFace(*faceId));
+  EXPECT_TRUE(model.VertexFaces(v0).empty());
+  EXPECT_EQ(copy.VertexFaces(v0).size(), 1u);
+  EXPECT_EQ(copy.FaceLoop(*faceId).size(), 3u);
+}
+
+TEST_F(ModelTest, FaceCache_RemoveEdgeUndoRestoresLoop) {
+  VertexId v0 = model.CreateVertex({0, 0, 0});
+  VertexId v1 = model.CreateVertex({1, 0, 0});
+  VertexId v2 = model.CreateVertex({0, 1, 0});
+
+  auto e0 = model.CreateEdge(v0, v1);
+  auto e1 = model.CreateEdge(v1, v2);
+  auto e2 = model.CreateEdge(v2, v0);
+  ASSERT_TRUE(e0 && e1 && e2);
+
+  std::array<EdgeId, 3> edges{*e0, *e1, *e2};
+  auto faceId = model.CreateFace(edges);
+  ASSERT_TRUE(faceId.has_value());
+  model.ResetDirtyFlags();
+
+  RemoveEdgeCommand remove{*e1};
+  remove.Execute(model);
+  EXPECT_TRUE(model.FaceLoop(*faceId).empty());
+  EXPECT_TRUE(model.VertexFaces(v0).empty());
+  EXPECT_TRUE(model.IsFacesDirty());
+
+  model.ResetDirtyFlags();
+  remove.Undo(model);
+  ASSERT_TRUE(model.ContainsEdge(*e1));
+  EXPECT_EQ(model.FaceLoop(*faceId).size(), 3u);
+  EXPECT_EQ(model.VertexFaces(v0).size(), 1u);
+  EXPECT_EQ(model.VertexFaces(v2).size(), 1u);
+  EXPECT_TRUE(IsEqual(model.FaceNormal(*faceId), Vec3{0, 0, 1}));
+  EXPECT_TRUE(model.IsFacesDirty());
+}
+
+TEST_F(ModelTest, FaceCache_RemoveVertexDetachesFacesUntilUndo) {
+  VertexId v0 = model.CreateVertex({0, 0, 0});
+  VertexId v1 = model.CreateVertex({1, 0, 0});
+  VertexId v2 = model.CreateVertex({0, 1, 0});
+
+  auto e0 = model.CreateEdge(v0, v1);
+  auto e1 = model.CreateEdge(v1, v2);
+  auto e2 = model.CreateEdge(v2, v0);
+  ASSERT_TRUE(e0 && e1 && e2);
+
+  std::array<EdgeId, 3> edges{*e0, *e1, *e2};
+  auto faceId = model.CreateFace(edges);
+  ASSERT_TRUE(faceId.has_value());
+
+  RemoveVertexCommand remove{v2};
+  remove.Execute(model);
+  EXPECT_TRUE(model.FaceLoop(*faceId).empty());
+  EXPECT_TRUE(model.VertexFaces(v0).empty());
+  EXPECT_TRUE(model.VertexFaces(v2).empty());
+
+  remove.Undo(model);
+  ASSERT_TRUE(model.ContainsVertex(v2));
+  EXPECT_EQ(model.FaceLoop(*faceId).size(), 3u);
+  EXPECT_EQ(model.VertexFaces(v2).size(), 1u);
+  EXPECT_TRUE(IsEqual(model.FaceBounds(*faceId).max, Vec3{1, 1, 0}));
+}
+
+TEST_F(ModelTest, ExtrudeFaces_StitchesWallsAndLeavesNeighboursInPlace) {
+  MeshIds ids = model.AppendMesh(Grid(2, 1));
+  const uint32_t vertexCount = model.Vertices().size();
+  const uint32_t edgeCount = model.Edges().size();
+
+  const std::array<FaceId, 1> region{ids.faces[0]};
+  ExtrudeRecord record = model.ExtrudeFaces(region, 2.0f);
+
+  // Every corner of the extruded quad is on the boundary, so all four are copied
+  EXPECT_EQ(record.createdVertices.size(), 4u);
+  EXPECT_EQ(record.createdFaces.size(), 4u);
+  EXPECT_EQ(model.Vertices().size(), vertexCount + 4);
+  EXPECT_EQ(model.Edges().size(), edgeCount + 8);
+
+  EXPECT_FLOAT_EQ(model.FacePlaneOffset(ids.faces[0]), 2.0f);
+  EXPECT_FLOAT_EQ(model.FacePlaneOffset(ids.faces[1]), 0.0f);
+  EXPECT_TRUE(IsEqual(model.FaceBounds(ids.faces[1]).max, Vec3{2, 1, 0}));
+
+  // Walls face away from the region
+  for (FaceId wall : record.createdFaces) {
+    ASSERT_EQ(model.FaceLoop(wall).size(), 4u);
+    const Vec3 center = (model.FaceBounds(wall).min + model.FaceBounds(wall).max) * 0.5f;
+    EXPECT_GT(model.FaceNormal(wall).Dot(center - Vec3{0.5f, 0.5f, 1.0f}), 0.0f);
+  }
+
+  model.RevertExtrude(record);
+  EXPECT_EQ(model.Vertices().size(), vertexCount);
+  EXPECT_EQ(model.Edges().size(), edgeCount);
+  EXPECT_EQ(model.Faces().size(), 2u);
+  EXPECT_FLOAT_EQ(model.FacePlaneOffset(ids.faces[0]), 0.0f);
+  EXPECT_EQ(model.VertexFaces(ids.vertices[1]).size(), 2u);
+}
+
+TEST_F(ModelTest, ExtrudeFacesCommand_RedoCreatesTheSameIds) {
+  MeshIds ids = model.AppendMesh(Grid(2, 2));
+  ExtrudeFacesCommand command{{ids.faces[0], ids.faces[1]}, 1.0f};
+
+  command.Execute(model);
+  ASSERT_TRUE(command.record);
+  const ExtrudeRecord first = *command.record;
+
+  command.Undo(model);
+  command.Execute(model);
+  ASSERT_TRUE(command.record);
+  EXPECT_EQ(command.record->createdVertices, first.createdVertices);
+  EXPECT_EQ(command.record->createdEdges, first.createdEdges);
+  EXPECT_EQ(command.record->createdFaces, first.createdFaces);
+}
+
+TEST_F(ModelTest, ExtrudeFaces_MovesInteriorVerticesAndKeepsVolumesClosed) {
+  // A 2x2 region shares its centre vertex with nothing else, so it moves in place
+  MeshIds grid = model.AppendMesh(Grid(2, 2));
+  ExtrudeRecord record = model.ExtrudeFaces(grid.faces, 1.0f);
+  EXPECT_EQ(record.createdVertices.size(), 8u);
+  ASSERT_EQ(record.movedVertices.size(), 1u);
+  EXPECT_TRUE(IsEqual(model.GetVertex(grid.vertices[4]).position, Vec3{1, 1, 1}));
+  EXPECT_EQ(record.createdFaces.size(), 8u);
+
+  MeshIds cube = model.AppendMesh(Cube());
+  const std::array<FaceId, 1> top{cube.faces[5]};
+  record = model.ExtrudeFaces(top, 0.5f);
+
+  const Volume& volume = model.GetVolume(cube.volumes[0]);
+  EXPECT_EQ(volume.faces.size(), 10u);
+  const std::array<Volume, 1> candidates{volume};
+  EXPECT_EQ(model.ValidateVolumes(candidates, true)[0], Topology::Defect::None);
+  EXPECT_FLOAT_EQ(model.FacePlaneOffset(cube.faces[5]), 1.5f);
+
+  model.RevertExtrude(record);
+  EXPECT_EQ(model.GetVolume(cube.volumes[0]).faces.size(), 6u);
+  EXPECT_FLOAT_EQ(model.FacePlaneOffset(cube.faces[5]), 1.0f);
+}
+
+TEST_F(ModelTest, MovedVertices_StaySortedAndUniqueAcrossBatches) {
+  const MeshIds ids = model.AppendMesh(Grid(3, 3));
+  model.ResetDirtyFlags();
+
+  const std::array<VertexId, 2> first{ids.vertices[5], ids.vertices[1]};
+  const std::array<Vec3, 2> up{Vec3{1, 1, 1}, Vec3{1, 0, 1}};
+  model.SetVertexPositions(first, up);
+  model.SetVertexPosition(ids.vertices[1], Vec3{1, 0, 2});
+  const std::array<VertexId, 2> second{ids.vertices[3], ids.vertices[0]};
+  model.SetVertexPositions(second, up);
+
+  // Readers of a shared snapshot only read, so the lists are already normalized
+  const std::shared_ptr<const Model> snapshot = model.Snapshot();
+  const auto moved = snapshot->MovedVertices();
+  EXPECT_EQ(std::vector<VertexId>(moved.begin(), moved.end()),
+            (std::vector<VertexId>{ids.vertices[0], ids.vertices[1], ids.vertices[3],
+                                   ids.vertices[5]}));
+  const auto faces = snapshot->ReshapedFaces();
+  EXPECT_TRUE(std::is_sorted(faces.begin(), faces.end()));
+  EXPECT_EQ(std::adjacent_find(faces.begin(), faces.end()), faces.end());
+  EXPECT_EQ(faces.size(), 5u);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Generators/Shapes.h"
+#include "Geometry/Aabb.h"
+#include "Model/Model.h"
+#include "ModelView/ModelViewBuilder.h"
+#include "Occlusion/DepthBuffer.h"
+#include "Occlusion/OcclusionCuller.h"
+#include "Rendering/Camera.h"
+#include "Utilities/Vec3.h"
+
+#include "TestHelpers.h"
+
+using Geometry::Aabb;
+
+TEST(OcclusionTest, WallHidesWhatIsBehindIt) {
+  const Camera camera = SquareCamera();
+  Occlusion::DepthBuffer depth;
+  depth.Resize(130, 130);  // not a whole number of SSE lanes
+  depth.Clear(camera.GetViewProjectionMatrix());
+
+  // 4 x 4 wall through the origin, facing the camera
+  const std::vector<Vec3> wall = {Vec3{-2, -2, 0}, Vec3{2, -2, 0}, Vec3{2, 2, 0},
+                                  Vec3{-2, -2, 0}, Vec3{2, 2, 0},  Vec3{-2, 2, 0}};
+  depth.Rasterize(wall);
+  EXPECT_NEAR(depth.InverseDepthAt(65, 65), 1.0f / 5.0f, 1e-4f);
+  EXPECT_EQ(depth.InverseDepthAt(0, 0), 0.0f);
+
+  EXPECT_TRUE(depth.IsOccluded(Box(Vec3{0, 0, -3}, 0.5f)));
+  EXPECT_TRUE(depth.IsOccluded(Box(Vec3{1, -1, -0.5f}, 0.25f)));
+  EXPECT_FALSE(depth.IsOccluded(Box(Vec3{0, 0, 2}, 0.5f)));      // in front
+  EXPECT_FALSE(depth.IsOccluded(Box(Vec3{0, 0, 0}, 0.5f)));      // pierces the wall
+  EXPECT_FALSE(depth.IsOccluded(Box(Vec3{2.2f, 0, -1}, 0.5f)));  // peeks past the edge
+  EXPECT_FALSE(depth.IsOccluded(Box(Vec3{0, 0, 8}, 0.5f)));      // behind the eye
+  EXPECT_FALSE(depth.IsOccluded(Aabb{}));
+
+  // The wall's own bounds touch it and so stay visible
+  Aabb wallBounds;
+  for (const Vec3& p : wall) wallBounds.Expand(p);
+  EXPECT_FALSE(depth.IsOccluded(wallBounds));
+}
+
+TEST(OcclusionTest, CullerPicksLargeSimpleVolumes) {
+  // A wall in front of a row of small boxes, and a detailed sphere off to the side
+  Model model;
+  model.AppendMesh(Generators::Box(Vec3{3, 3, 0.2f}));
+  std::vector<Aabb> parts;
+  for (int i = 0; i < 5; ++i) {
+    const Vec3 center{0.5f * static_cast<float>(i) - 1.0f, 0, -3};
+    model.AppendMesh(Moved(Generators::Box(Vec3{0.3f, 0.3f, 0.3f}), center));
+    parts.push_back(Box(center, 0.15f));
+  }
+  model.AppendMesh(Moved(Generators::UvSphere(Vec3{2, 2, 2}, 64, 32), Vec3{6, 0, -10}));
+  parts.push_back(Box(Vec3{6, 0, -10}, 1.0f));
+
+  ModelViewBuilder builder(model);
+  FaceView view;
+  builder.BuildFaceView(view);
+
+  Occlusion::OcclusionCuller culler;
+  culler.SetCandidates(model, view);
+
+  const Camera camera = SquareCamera();
+  std::vector<uint8_t> visible(parts.size(), 1);
+  visible[0] = 0;  // already outside the frustum, say
+  culler.Cull(view, camera.GetViewProjectionMatrix(), camera.GetPosition(), 1.0f, parts,
+              visible);
+
+  const Occlusion::Stats& stats = culler.GetStats();
+  EXPECT_EQ(stats.tested, parts.size() - 1);
+  // Every box is an occluder, but the sphere has too many triangles to be one
+  EXPECT_EQ(stats.occluders, 6u);
+  EXPECT_EQ(stats.occluderTriangles, 6 * 12u);
+  EXPECT_EQ(stats.occluded, 4u);
+  EXPECT_EQ(visible, (std::vector<uint8_t>{0, 0, 0, 0, 0, 1}));
+}
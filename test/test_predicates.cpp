@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <random>
+
+#include "Geometry/Geometry.h"
+#include "Geometry/Predicates.h"
+
+namespace {
+
+int Sign(double value) { return (value > 0.0) - (value < 0.0); }
+
+// Exact reference for integer coordinates (|coordinate| < 2^24, so floats hold them exactly)
+int Orient3dReference(const std::array<int64_t, 3>& a, const std::array<int64_t, 3>& b,
+                      const std::array<int64_t, 3>& c, const std::array<int64_t, 3>& d) {
+  const __int128 ux = b[0] - a[0], uy = b[1] - a[1], uz = b[2] - a[2];
+  const __int128 vx = c[0] - a[0], vy = c[1] - a[1], vz = c[2] - a[2];
+  const __int128 wx = d[0] - a[0], wy = d[1] - a[1], wz = d[2] - a[2];
+  const __int128 det =
+      (uy * vz - uz * vy) * wx + (uz * vx - ux * vz) * wy + (ux * vy - uy * vx) * wz;
+  return (det > 0) - (det < 0);
+}
+
+Vec3 ToVec3(const std::array<int64_t, 3>& p) {
+  return Vec3{static_cast<float>(p[0]), static_cast<float>(p[1]), static_cast<float>(p[2])};
+}
+
+}  // namespace
+
+TEST(PredicatesTest, Orient2dSigns) {
+  EXPECT_GT(Geometry::Orient2d(0, 0, 1, 0, 0, 1), 0.0);
+  EXPECT_LT(Geometry::Orient2d(0, 0, 0, 1, 1, 0), 0.0);
+  EXPECT_EQ(Geometry::Orient2d(0.5f, 0.5f, 12, 12, 24, 24), 0.0);
+
+  // One ulp off the line still has a definite side
+  const float nudged = std::nextafter(24.0f, 25.0f);
+  EXPECT_LT(Geometry::Orient2d(0.5f, 0.5f, 12, 12, nudged, 24), 0.0);
+}
+
+TEST(PredicatesTest, Orient3dMatchesExactReferenceNearDegenerate) {
+  // Points on a large plane, nudged off it by at most one unit: products overflow the
+  // double mantissa, so only the exact fallback gets every sign right
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int64_t> coordinate(-(1 << 20), 1 << 20);
+  std::uniform_int_distribution<int64_t> step(-7, 7);
+  std::uniform_int_distribution<int64_t> nudge(-1, 1);
+
+  int signsSeen[3] = {0, 0, 0};
+  for (int i = 0; i < 2000; ++i) {
+    const std::array<int64_t, 3> a{coordinate(rng), coordinate(rng), coordinate(rng)};
+    std::array<int64_t, 3> b{};
+    std::array<int64_t, 3> c{};
+    for (int k = 0; k < 3; ++k) {
+      b[k] = a[k] + coordinate(rng) / 8;
+      c[k] = a[k] + coordinate(rng) / 8;
+    }
+
+    const int64_t s = step(rng);
+    const int64_t t = step(rng);
+    std::array<int64_t, 3> d{};
+    for (int k = 0; k < 3; ++k) d[k] = a[k] + s * (b[k] - a[k]) + t * (c[k] - a[k]);
+    d[2] += nudge(rng);
+    if (std::abs(d[0]) >= (1 << 24) || std::abs(d[1]) >= (1 << 24) ||
+        std::abs(d[2]) >= (1 << 24)) {
+      continue;
+    }
+
+    const int expected = Orient3dReference(a, b, c, d);
+    ASSERT_EQ(Sign(Geometry::Orient3d(ToVec3(a), ToVec3(b), ToVec3(c), ToVec3(d))), expected)
+        << "case " << i;
+    ++signsSeen[expected + 1];
+  }
+
+  EXPECT_GT(signsSeen[0], 0);
+  EXPECT_GT(signsSeen[1], 0);
+  EXPECT_GT(signsSeen[2], 0);
+}
+
+TEST(PredicatesTest, Orient3dSumCancelsExactly) {
+  // Swapping two points negates the orientation, so the sum is exactly zero even where
+  // each term is far larger than its rounding error
+  const Vec3 a{1e7f, 3.0f, -2.5f};
+  const Vec3 b{-4.0f, 1e-3f, 7.0f};
+  const Vec3 c{0.1f, 9e6f, 0.3f};
+  const Vec3 d{5.0f, -6.0f, 1e5f};
+  EXPECT_EQ(Geometry::Orient3dSum(a, b, c, d, a, c, b, d), 0.0);
+
+  // One ulp of d decides the sign of the near-cancelling sum
+  const Vec3 nudged{5.0f, -6.0f, std::nextafter(1e5f, 2e5f)};
+  const double sign =
+      Geometry::Orient3d(a, b, c, nudged) > Geometry::Orient3d(a, b, c, d) ? 1.0 : -1.0;
+  EXPECT_GT(Geometry::Orient3dSum(a, b, c, nudged, a, c, b, d) * sign, 0.0);
+}
+
+TEST(PredicatesTest, PlanarityIsScaleInvariant) {
+  for (float scale : {1e-4f, 1.0f, 1e4f}) {
+    // Tilted square, one corner lifted by 1% of its size
+    std::array<Vec3, 4> square{Vec3{0, 0, 0}, Vec3{1, 0, 1}, Vec3{1, 1, 1}, Vec3{0, 1, 0}};
+    for (Vec3& p : square) p = p * scale;
+    EXPECT_TRUE(Geometry::AreCoplanar(square)) << scale;
+
+    square[2] = square[2] + Vec3{0, 0, 0.01f * scale};
+    EXPECT_FALSE(Geometry::AreCoplanar(square)) << scale;
+
+    // A sliver triangle only 1% as tall as it is wide is still a real face
+    const std::array<Vec3, 3> sliver{Vec3{0, 0, 0}, Vec3{scale, 0, 0},
+                                     Vec3{0.5f * scale, 0.01f * scale, 0}};
+    EXPECT_FALSE(Geometry::AreColinear(sliver)) << scale;
+  }
+
+  // Far from the origin, float rounding of a rotated plane is tolerated
+  const Vec3 offset{1e4f, -2e4f, 3e4f};
+  const Vec3 u = Vec3{0.6f, 0.8f, 0.0f} * 3.0f;
+  const Vec3 v = Vec3{-0.48f, 0.36f, 0.8f} * 3.0f;
+  const std::array<Vec3, 5> rotated{offset, offset + u, offset + u + v, offset + v,
+                                    offset + u * 0.5f + v * 1.3f};
+  EXPECT_TRUE(Geometry::AreCoplanar(rotated));
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Generators/Shapes.h"
+#include "Model/Model.h"
+#include "Rendering/PreviewOverlay.h"
+#include "Utilities/Vec3.h"
+
+TEST(PreviewOverlayTest, ExtrusionLeavesTheModelAlone) {
+  Model model;
+  model.AppendMesh(Generators::Box(Vec3{2, 2, 2}));
+  model.ResetDirtyFlags();
+  std::vector<Vec3> before;
+  for (const Vertex& v : model.Vertices()) before.push_back(v.position);
+
+  const FaceId face = model.FaceIndexToId(0);
+  PreviewOverlay overlay;
+  overlay.AddExtrusion(model, face, 0.5f);
+  EXPECT_TRUE(overlay.IsDirty());
+
+  // Cap and four sides of two triangles each, a marker per corner, an edge per side
+  constexpr std::size_t kCorners = 4;
+  EXPECT_EQ(overlay.TriangleVertexCount(),
+            3 * (2 + 2 * kCorners + PreviewOverlay::kSphereTriangles * kCorners));
+  EXPECT_EQ(overlay.EdgeCount(), kCorners);
+
+  // The outline sits where the command would move the face
+  const auto edges = overlay.EdgeInstances();
+  const Vec3 start{edges[0], edges[1], edges[2]};
+  const Vec3 offset = model.FaceNormal(face) * 0.5f;
+  const Vec3 corner = model.GetVertex(model.FaceLoop(face)[0]).position + offset;
+  EXPECT_NEAR((start - corner).Length(), 0.0f, 1e-5f);
+
+  // Nothing in the model changed or needs redrawing
+  EXPECT_FALSE(model.ShouldRender());
+  for (std::size_t i = 0; i < before.size(); ++i) {
+    EXPECT_EQ(model.Vertices()[i].position.x, before[i].x);
+    EXPECT_EQ(model.Vertices()[i].position.y, before[i].y);
+    EXPECT_EQ(model.Vertices()[i].position.z, before[i].z);
+  }
+}
+
+TEST(PreviewOverlayTest, ClearingAnEmptyOverlayChangesNothing) {
+  PreviewOverlay overlay;
+  overlay.Clear();
+  EXPECT_FALSE(overlay.IsDirty());
+
+  overlay.AddEdge(Vec3{0, 0, 0}, Vec3{1, 0, 0}, {1, 0, 0, 1});
+  overlay.AddSphere(Vec3{1, 0, 0}, 0.1f, {1, 0, 0, 1});
+  overlay.ClearDirty();
+  overlay.Clear();
+  EXPECT_TRUE(overlay.IsDirty());
+  EXPECT_TRUE(overlay.IsEmpty());
+}
+
+TEST(PreviewOverlayTest, ConcavePolygonsStayInsideTheirOutline) {
+  // L shape of area 3, concave at (1, 1); a fan from the first corner would cover the
+  // notch and overlap itself
+  const std::vector<Vec3> loop{{2, 1, 0}, {1, 1, 0}, {1, 2, 0}, {0, 2, 0}, {0, 0, 0}, {2, 0, 0}};
+  PreviewOverlay overlay;
+  overlay.AddPolygon(loop, {1, 1, 1, 1});
+  ASSERT_EQ(overlay.TriangleVertexCount(), 3u * (loop.size() - 2));
+
+  const auto vertices = overlay.TriangleVertices();
+  auto at = [&](std::size_t i) {
+    const float* v = &vertices[i * PreviewOverlay::kVertexFloats];
+    return Vec3{v[0], v[1], v[2]};
+  };
+  float area = 0.0f;
+  for (std::size_t i = 0; i < overlay.TriangleVertexCount(); i += 3) {
+    const float z = (at(i + 1) - at(i)).Cross(at(i + 2) - at(i)).z;
+    EXPECT_GT(z, 0.0f);  // every triangle keeps the loop's winding
+    area += 0.5f * z;
+  }
+  EXPECT_NEAR(area, 3.0f, 1e-5f);
+}
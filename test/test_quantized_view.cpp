@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "Generators/Shapes.h"
+#include "Model/Model.h"
+#include "ModelView/ModelViewBuilder.h"
+#include "Sculpt/Brush.h"
+#include "Sculpt/Stroke.h"
+#include "Utilities/Vec3.h"
+
+namespace {
+
+// What the vertex shader computes for vertex i
+Vec3 Decode(const QuantizedFaceView& view, std::size_t i) {
+  const float* box = view.chunkBoxes.data() + i / FaceView::kChunkVertices * 8;
+  const uint16_t* q = view.positions.data() + 3 * i;
+  const float steps = QuantizedFaceView::kSteps;
+  return Vec3{box[0] + q[0] / steps * box[4], box[1] + q[1] / steps * box[5],
+              box[2] + q[2] / steps * box[6]};
+}
+
+float MaxDecodeError(const FaceView& faces, const QuantizedFaceView& view) {
+  float error = 0.0f;
+  for (std::size_t i = 0; i < faces.vertices.size(); ++i) {
+    error = std::max(error, (Decode(view, i) - faces.vertices[i]).Length());
+  }
+  return error;
+}
+
+}  // namespace
+
+TEST(QuantizedViewTest, DecodesWithinTheErrorBound) {
+  Model model;
+  model.AppendMesh(Generators::UvSphere(Vec3{40, 40, 40}, 96, 48));
+  ModelViewBuilder builder(model);
+  FaceView faces;
+  builder.BuildFaceView(faces);
+  ModelViewBuilder::BuildChunks(faces);
+  ASSERT_GT(faces.chunkBounds.size(), 1u);
+
+  QuantizedFaceView quantized;
+  ModelViewBuilder::BuildQuantized(faces, quantized);
+  ASSERT_EQ(quantized.positions.size(), 3 * faces.vertices.size());
+  EXPECT_EQ(quantized.chunkBoxes.size(), 8 * faces.chunkBounds.size());
+  EXPECT_GT(quantized.maxError, 0.0f);
+  // Half a step of a chunk no wider than the 40 unit sphere
+  const float sphereError = Vec3{40, 40, 40}.Length() * 0.5f / QuantizedFaceView::kSteps;
+  EXPECT_LE(quantized.maxError, sphereError);
+  EXPECT_LE(MaxDecodeError(faces, quantized), quantized.maxError * 1.001f);
+
+  // Few faces: IDs fit 16 bits, and the view takes half the bytes of full floats
+  EXPECT_FALSE(quantized.WideIds());
+  EXPECT_EQ(quantized.ids16.size(), faces.primitiveIds.size());
+  EXPECT_EQ(quantized.Bytes() * 2, faces.vertices.size() * (sizeof(Vec3) + sizeof(float)));
+}
+
+TEST(QuantizedViewTest, WideIdsAndFlatChunks) {
+  // One flat triangle whose ID needs 32 bits
+  FaceView faces;
+  faces.vertices = {Vec3{1, 2, 3}, Vec3{5, 2, 3}, Vec3{1, 2, 7}};
+  faces.primitiveIds = {70000, 70000, 70000};
+  ModelViewBuilder::BuildChunks(faces);
+
+  QuantizedFaceView quantized;
+  ModelViewBuilder::BuildQuantized(faces, quantized);
+  ASSERT_TRUE(quantized.WideIds());
+  EXPECT_TRUE(quantized.ids16.empty());
+  EXPECT_EQ(quantized.ids32, faces.primitiveIds);
+  // Corners sit on the box, so they decode exactly, and the flat axis decodes to its min
+  EXPECT_EQ(MaxDecodeError(faces, quantized), 0.0f);
+}
+
+TEST(QuantizedViewTest, PatchedViewMatchesRebuild) {
+  Model model;
+  model.AppendMesh(Generators::Grid(Vec3{4, 0, 4}, 64, 64));
+  model.ResetDirtyFlags();
+  ModelViewBuilder builder(model);
+  FaceView faces;
+  builder.BuildFaceView(faces);
+  ModelViewBuilder::BuildChunks(faces);
+  QuantizedFaceView patched;
+  ModelViewBuilder::BuildQuantized(faces, patched);
+
+  Sculpt::Stroke stroke(model, {Sculpt::Brush::Grab, 0.6f, 1.0f});
+  stroke.Dab(Vec3{1, 0, -1}, Vec3{0.1f, 0.3f, 0});
+  std::vector<ViewRange> changed;
+  ASSERT_TRUE(builder.PatchFaceView(faces, model.ReshapedFaces(), changed));
+  std::vector<ViewRange> ranges;
+  ModelViewBuilder::PatchQuantized(faces, changed, patched, ranges);
+  ASSERT_FALSE(ranges.empty());
+  std::size_t touched = 0;
+  for (const ViewRange& range : ranges) {
+    EXPECT_EQ(range.first % FaceView::kChunkVertices, 0u);  // whole chunks
+    touched += range.count;
+  }
+  EXPECT_LT(touched, faces.vertices.size());
+
+  QuantizedFaceView rebuilt;
+  ModelViewBuilder::BuildQuantized(faces, rebuilt);
+  EXPECT_EQ(patched.positions, rebuilt.positions);
+  EXPECT_EQ(patched.chunkBoxes, rebuilt.chunkBoxes);
+  EXPECT_EQ(patched.maxError, rebuilt.maxError);
+}
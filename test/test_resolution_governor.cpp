@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+
+#include "Rendering/ResolutionGovernor.h"
+
+TEST(ResolutionGovernorTest, DropsAtOnceWhenOverBudget) {
+  ResolutionGovernor governor(16.0f);
+  EXPECT_EQ(governor.Scale(), 1.0f);
+  EXPECT_FALSE(governor.AddFrame(10.0f));  // already at full scale
+  EXPECT_FALSE(governor.AddFrame(18.0f));  // within the tolerance
+
+  // 2.5x over: area must shrink by as much, rounded down to a step
+  EXPECT_TRUE(governor.AddFrame(40.0f));
+  EXPECT_EQ(governor.Scale(), 0.625f);
+
+  // Slow frames right after a change are still drawn at the old scale
+  for (uint32_t i = 0; i < ResolutionGovernor::kSettleFrames; ++i) {
+    EXPECT_FALSE(governor.AddFrame(30.0f));
+  }
+  EXPECT_TRUE(governor.AddFrame(30.0f));
+  EXPECT_EQ(governor.Scale(), ResolutionGovernor::kMinScale);
+  for (int i = 0; i < 10; ++i) EXPECT_FALSE(governor.AddFrame(100.0f));
+  EXPECT_EQ(governor.Scale(), ResolutionGovernor::kMinScale);
+}
+
+TEST(ResolutionGovernorTest, RaisesSlowlyWhileFramesFit) {
+  ResolutionGovernor governor(16.0f);
+  governor.AddFrame(64.0f);
+  EXPECT_EQ(governor.Scale(), 0.5f);
+
+  for (uint32_t i = 1; i < ResolutionGovernor::kRaiseAfterFrames; ++i) {
+    EXPECT_FALSE(governor.AddFrame(12.0f));
+  }
+  // A frame near the budget restarts the count
+  EXPECT_FALSE(governor.AddFrame(18.0f));
+  for (uint32_t i = 1; i < ResolutionGovernor::kRaiseAfterFrames; ++i) {
+    EXPECT_FALSE(governor.AddFrame(12.0f));
+  }
+  EXPECT_TRUE(governor.AddFrame(12.0f));
+  EXPECT_EQ(governor.Scale(), 0.5f + ResolutionGovernor::kStep);
+
+  governor.Reset();
+  EXPECT_EQ(governor.Scale(), 1.0f);
+}
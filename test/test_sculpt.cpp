@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+#include <vector>
+
+#include "App/Commands/CommandSerialization.h"
+#include "App/Commands/CommandStack.h"
+#include "App/Commands/Commands.h"
+#include "Generators/Shapes.h"
+#include "Model/Model.h"
+#include "ModelView/ModelViewBuilder.h"
+#include "Sculpt/Brush.h"
+#include "Sculpt/Stroke.h"
+#include "Utilities/BinaryStream.h"
+#include "Utilities/Vec3.h"
+
+using Sculpt::Brush;
+
+namespace {
+
+// Exact comparison: undo and redo must restore positions bit for bit
+bool Same(const std::vector<Vec3>& a, const std::vector<Vec3>& b) {
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const Vec3& p, const Vec3& q) {
+    return p.x == q.x && p.y == q.y && p.z == q.z;
+  });
+}
+
+class SculptTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // 4 x 4 plane at y = 0 with vertices 0.125 apart
+    model.AppendMesh(Generators::Grid(Vec3{4, 0, 4}, 32, 32));
+    model.ResetDirtyFlags();
+  }
+
+  std::vector<Vec3> Positions() const {
+    std::vector<Vec3> positions;
+    for (const Vertex& v : model.Vertices()) positions.push_back(v.position);
+    return positions;
+  }
+
+  float Height(const Vec3& near) const {
+    float best = INFINITY;
+    float height = 0.0f;
+    for (const Vertex& v : model.Vertices()) {
+      const float dx = v.position.x - near.x;
+      const float dz = v.position.z - near.z;
+      if (dx * dx + dz * dz < best) {
+        best = dx * dx + dz * dz;
+        height = v.position.y;
+      }
+    }
+    return height;
+  }
+
+  Model model;
+};
+
+}  // namespace
+
+TEST(SculptFalloffTest, FadesFromStrengthToZeroAtTheRim) {
+  // Seven points so both the four wide and the leftover path run
+  const std::vector<float> xs{0.0f, 0.25f, 0.5f, 0.75f, 1.0f, 1.5f, -0.5f};
+  const std::vector<float> zeros(xs.size(), 0.0f);
+  std::vector<float> weights(xs.size(), -1.0f);
+  Sculpt::ComputeFalloff(xs.data(), zeros.data(), zeros.data(), xs.size(), Vec3{}, 1.0f, 0.8f,
+                         weights.data());
+
+  EXPECT_FLOAT_EQ(weights[0], 0.8f);
+  EXPECT_FLOAT_EQ(weights[2], 0.8f * 0.5f);
+  EXPECT_FLOAT_EQ(weights[4], 0.0f);
+  EXPECT_FLOAT_EQ(weights[5], 0.0f);
+  EXPECT_FLOAT_EQ(weights[6], weights[2]);
+  EXPECT_GT(weights[1], weights[2]);
+  EXPECT_GT(weights[3], 0.0f);
+  EXPECT_LT(weights[3], weights[2]);
+}
+
+TEST_F(SculptTest, InflateMovesOnlyVerticesUnderTheBrush) {
+  Sculpt::Stroke stroke(model, {Brush::Inflate, 0.5f, 1.0f});
+  const std::size_t moved = stroke.Dab(Vec3{0, 0, 0});
+  ASSERT_GT(moved, 0u);
+
+  // Pushed up along the plane normal, most at the centre
+  EXPECT_NEAR(Height(Vec3{0, 0, 0}), 0.05f, 1e-5f);
+  EXPECT_GT(Height(Vec3{0.25f, 0, 0}), 0.0f);
+  EXPECT_EQ(Height(Vec3{0.5f, 0, 0}), 0.0f);
+  EXPECT_EQ(Height(Vec3{1, 0, 1}), 0.0f);
+
+  // Only the moved vertices and the faces around them are published
+  EXPECT_TRUE(model.OnlyVerticesMoved());
+  ASSERT_EQ(model.MovedVertices().size(), moved);
+  for (VertexId id : model.MovedVertices()) {
+    const Vec3& p = model.GetVertex(id).position;
+    EXPECT_LT(p.x * p.x + p.z * p.z, 0.25f);
+  }
+  EXPECT_LT(model.ReshapedFaces().size(), model.Faces().size() / 8);
+  EXPECT_EQ(stroke.TouchedCount(), moved);
+}
+
+TEST_F(SculptTest, GrabFollowsTheDragAndFlattenSmoothLevelIt) {
+  Sculpt::Stroke grab(model, {Brush::Grab, 0.75f, 1.0f});
+  grab.Dab(Vec3{0, 0, 0}, Vec3{0, 0.5f, 0});
+  EXPECT_NEAR(Height(Vec3{0, 0, 0}), 0.5f, 1e-5f);
+  const float bump = Height(Vec3{0.25f, 0, 0});
+  EXPECT_GT(bump, 0.0f);
+
+  Sculpt::Stroke smooth(model, {Brush::Smooth, 0.75f, 1.0f});
+  smooth.Dab(Vec3{0, 0, 0});
+  EXPECT_LT(Height(Vec3{0, 0, 0}), 0.5f);
+
+  // Flattening pulls the remaining peak down towards the average plane
+  Sculpt::Stroke flatten(model, {Brush::Flatten, 2.0f, 1.0f});
+  const float before = Height(Vec3{0, 0, 0});
+  flatten.Dab(Vec3{0, 0, 0});
+  EXPECT_LT(Height(Vec3{0, 0, 0}), before);
+  for (const Vertex& v : model.Vertices()) EXPECT_TRUE(std::isfinite(v.position.y));
+}
+
+TEST_F(SculptTest, StrokeIsOneCompressedUndoStep) {
+  CommandStack stack(model);
+  const std::vector<Vec3> original = Positions();
+
+  Sculpt::Stroke stroke(model, {Brush::Inflate, 0.5f, 0.5f});
+  for (int i = 0; i < 8; ++i) stroke.Dab(Vec3{-0.5f + 0.125f * static_cast<float>(i), 0, 0});
+  const std::vector<Vec3> sculpted = Positions();
+
+  Sculpt::StrokeDelta delta = stroke.Finish();
+  ASSERT_EQ(delta.vertexCount, stroke.TouchedCount());
+  // Well under an id plus two positions per vertex
+  EXPECT_LT(delta.bytes.size(), std::size_t{delta.vertexCount} * 12);
+
+  // Recording the painted stroke leaves the model as it is
+  ASSERT_TRUE(stack.Do<SculptStrokeCommand>(delta, true));
+  EXPECT_EQ(stack.UndoCount(), 1u);
+  EXPECT_TRUE(Same(Positions(), sculpted));
+
+  ASSERT_TRUE(stack.Undo());
+  EXPECT_TRUE(Same(Positions(), original));
+  ASSERT_TRUE(stack.Redo());
+  EXPECT_TRUE(Same(Positions(), sculpted));
+
+  // Journal replay applies the delta to the unsculpted state
+  std::vector<char> bytes;
+  SerializeCommand(SculptStrokeCommand{delta}, bytes);
+  BinaryReader in(std::string_view(bytes.data(), bytes.size()));
+  auto replayed = DeserializeCommand(in);
+  ASSERT_TRUE(replayed);
+  ASSERT_TRUE(stack.Undo());
+  std::visit(ExecuteVisitor{model}, *replayed);
+  EXPECT_TRUE(Same(Positions(), sculpted));
+}
+
+TEST_F(SculptTest, MalformedDeltaLeavesModelAlone) {
+  const std::vector<Vec3> original = Positions();
+
+  Sculpt::StrokeDelta missing =
+      Sculpt::EncodeStrokeDelta(std::vector<VertexId>{3, 100000}, std::vector<Vec3>(2, Vec3{}),
+                                std::vector<Vec3>(2, Vec3{1, 1, 1}));
+  EXPECT_FALSE(Sculpt::ApplyStrokeDelta(model, missing));
+
+  Sculpt::StrokeDelta truncated =
+      Sculpt::EncodeStrokeDelta(std::vector<VertexId>{3}, std::vector<Vec3>{Vec3{}},
+                                std::vector<Vec3>{Vec3{1, 1, 1}});
+  truncated.bytes.pop_back();
+  EXPECT_FALSE(Sculpt::ApplyStrokeDelta(model, truncated));
+
+  EXPECT_TRUE(Same(Positions(), original));
+}
+
+TEST_F(SculptTest, PatchedFaceViewMatchesRebuild) {
+  ModelViewBuilder builder(model);
+  FaceView patched;
+  builder.BuildFaceView(patched);
+
+  Sculpt::Stroke stroke(model, {Brush::Grab, 0.6f, 1.0f});
+  stroke.Dab(Vec3{1, 0, -1}, Vec3{0.1f, 0.3f, 0});
+  ASSERT_TRUE(model.OnlyVerticesMoved());
+
+  std::vector<ViewRange> ranges;
+  ASSERT_TRUE(builder.PatchFaceView(patched, model.ReshapedFaces(), ranges));
+  ASSERT_FALSE(ranges.empty());
+  for (std::size_t i = 1; i < ranges.size(); ++i) {
+    EXPECT_GT(ranges[i].first, ranges[i - 1].first + ranges[i - 1].count);
+  }
+
+  ModelViewBuilder fresh(model);
+  FaceView rebuilt;
+  fresh.BuildFaceView(rebuilt);
+  ASSERT_EQ(patched.vertices.size(), rebuilt.vertices.size());
+  std::size_t touched = 0;
+  for (const ViewRange& range : ranges) touched += range.count;
+  EXPECT_LT(touched, rebuilt.vertices.size() / 4);
+
+  // Same triangles, though the patched view may keep a face's old diagonal order
+  auto sorted = [](std::vector<Vec3> v) {
+    std::sort(v.begin(), v.end(), [](const Vec3& a, const Vec3& b) {
+      return a.x != b.x ? a.x < b.x : a.y != b.y ? a.y < b.y : a.z < b.z;
+    });
+    return v;
+  };
+  EXPECT_TRUE(Same(sorted(patched.vertices), sorted(rebuilt.vertices)));
+}
+
+TEST_F(SculptTest, PatchedLineViewMatchesRebuild) {
+  ModelViewBuilder builder(model);
+  LineView patched;
+  builder.BuildLineView(patched);
+  ASSERT_EQ(patched.endpoints.size(), patched.vertexIndices.size());
+
+  Sculpt::Stroke stroke(model, {Brush::Grab, 0.6f, 1.0f});
+  stroke.Dab(Vec3{1, 0, -1}, Vec3{0.1f, 0.3f, 0});
+  ASSERT_TRUE(model.OnlyVerticesMoved());
+
+  std::vector<ViewRange> ranges;
+  ASSERT_TRUE(builder.PatchLineView(patched, model.MovedVertices(), ranges));
+  ASSERT_FALSE(ranges.empty());
+  for (std::size_t i = 1; i < ranges.size(); ++i) {
+    EXPECT_GT(ranges[i].first, ranges[i - 1].first + ranges[i - 1].count);
+  }
+  std::size_t touched = 0;
+  for (const ViewRange& range : ranges) touched += range.count;
+
+  ModelViewBuilder fresh(model);
+  LineView rebuilt;
+  fresh.BuildLineView(rebuilt);
+  EXPECT_LT(touched, rebuilt.endpoints.size() / 4);
+  EXPECT_TRUE(Same(patched.endpoints, rebuilt.endpoints));
+}
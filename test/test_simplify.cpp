@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "App/Commands/CommandSerialization.h"
+#include "App/Commands/CommandStack.h"
+#include "App/Commands/Commands.h"
+#include "Generators/Shapes.h"
+#include "Model/Model.h"
+#include "ModelView/LodCache.h"
+#include "ModelView/ModelViewBuilder.h"
+#include "Simplify/Decimate.h"
+#include "Topology/Validation.h"
+#include "Utilities/BinaryStream.h"
+#include "Utilities/Vec3.h"
+
+#include "TestHelpers.h"
+
+namespace {
+
+std::size_t TriangleCount(const Model& model, std::span<const FaceId> faces) {
+  std::size_t count = 0;
+  for (FaceId id : faces) count += model.FaceLoop(id).size() - 2;
+  return count;
+}
+
+class SimplifyTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const MeshIds ids = model.AppendMesh(Generators::UvSphere(Vec3{2, 2, 2}, 64, 32));
+    sphere = ids.volumes.front();
+    faces = ids.faces;
+    model.ResetDirtyFlags();
+  }
+
+  Model model;
+  VolumeId sphere = 0;
+  std::vector<FaceId> faces;
+};
+
+}  // namespace
+
+TEST_F(SimplifyTest, ReachesTargetAndStaysClosed) {
+  const std::size_t original = TriangleCount(model, faces);
+  const Simplify::Result result = Simplify::Decimate(model, faces, {original / 8});
+  EXPECT_LE(result.mesh.FaceCount(), original / 8);
+  EXPECT_GT(result.mesh.FaceCount(), original / 10);
+  ASSERT_EQ(result.faceOrigins.size(), result.mesh.FaceCount());
+  for (FaceId origin : result.faceOrigins) EXPECT_TRUE(model.ContainsFace(origin));
+
+  Model simplified;
+  const MeshIds ids = simplified.AppendMesh(result.mesh);
+  ASSERT_EQ(ids.volumes.size(), 1u);
+  const Volume& volume = simplified.GetVolume(ids.volumes[0]);
+  EXPECT_EQ(simplified.ValidateVolumes(std::span<const Volume>(&volume, 1), true).front(),
+            Topology::Defect::None);
+
+  // Still the same sphere to within a few percent
+  const float before = SignedVolume(model, faces);
+  EXPECT_NEAR(SignedVolume(simplified, ids.faces), before, 0.03f * before);
+  EXPECT_GT(result.error, 0.0f);
+  EXPECT_LT(result.error, 0.1f);
+}
+
+TEST_F(SimplifyTest, ErrorBoundStopsCollapsing) {
+  const std::size_t original = TriangleCount(model, faces);
+  const Simplify::Result tight = Simplify::Decimate(model, faces, {0, 0.002f});
+  const Simplify::Result loose = Simplify::Decimate(model, faces, {0, 0.02f});
+  EXPECT_LE(tight.error, 0.002f);
+  EXPECT_LE(loose.error, 0.02f);
+  EXPECT_LT(tight.mesh.FaceCount(), original);
+  EXPECT_LT(loose.mesh.FaceCount(), tight.mesh.FaceCount());
+}
+
+TEST(SimplifyFlatTest, CoplanarTrianglesMergeWithoutError) {
+  // A flat grid loses its inside vertices for free while the border stays put
+  Model model;
+  const MeshIds ids = model.AppendMesh(Generators::Grid(Vec3{4, 0, 4}, 16, 16));
+  const Simplify::Result result = Simplify::Decimate(model, ids.faces, {0, 1e-5f});
+  EXPECT_LT(result.mesh.FaceCount(), 16u * 16u * 2u / 4u);
+  EXPECT_EQ(result.error, 0.0f);
+  EXPECT_EQ(result.mesh.VolumeCount(), 0u);
+
+  float area = 0.0f;
+  for (std::size_t f = 0; f < result.mesh.FaceCount(); ++f) {
+    const auto edges = result.mesh.FaceEdges(f);
+    ASSERT_EQ(edges.size(), 3u);
+    // Corners in loop order: each edge shares an endpoint with the next one
+    Vec3 corners[3];
+    for (int k = 0; k < 3; ++k) {
+      const Edge& edge = result.mesh.edges[edges[k]];
+      const Edge& next = result.mesh.edges[edges[(k + 1) % 3]];
+      corners[k] = result.mesh.positions[edge.b == next.a || edge.b == next.b ? edge.a : edge.b];
+    }
+    area += (corners[1] - corners[0]).Cross(corners[2] - corners[0]).Length() * 0.5f;
+  }
+  EXPECT_NEAR(area, 16.0f, 1e-3f);
+}
+
+TEST_F(SimplifyTest, LodChainGetsCoarser) {
+  const Simplify::LodChain chain = Simplify::BuildLodChain(model, faces, 4, 0.25f, 64);
+  ASSERT_GE(chain.levels.size(), 2u);
+  std::size_t previous = TriangleCount(model, faces);
+  float error = 0.0f;
+  for (const Simplify::Lod& lod : chain.levels) {
+    EXPECT_LT(lod.triangleCount, previous);
+    EXPECT_GE(lod.error, error);
+    ASSERT_EQ(lod.view.vertices.size(), lod.triangleCount * 3);
+    ASSERT_EQ(lod.view.primitiveIds.size(), lod.view.vertices.size());
+    for (FaceId id : lod.view.primitiveIds) ASSERT_TRUE(model.ContainsFace(id - 1));
+    previous = lod.triangleCount;
+    error = lod.error;
+  }
+  EXPECT_TRUE(chain.bounds.Contains(Vec3{0.9f, 0.9f, 0.9f}));
+}
+
+TEST_F(SimplifyTest, LodCacheFollowsScreenSize) {
+  LodCache lods(model, 1000);
+  const Vec3 far{0, 0, 400};
+  const Vec3 near{0, 0, 3};
+
+  // Builds start once the volume has settled and finish on a worker
+  bool changed = false;
+  for (int frame = 0; frame < 2000 && lods.SelectedLevel(sphere) == 0; ++frame) {
+    changed = lods.Update(far, 45.0f, 1000) || changed;
+    if (lods.PendingCount() > 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_TRUE(changed);
+  EXPECT_GT(lods.SelectedLevel(sphere), 0u);
+
+  // Coarse levels replace the sphere's faces in the view; ids still pick sphere faces
+  ModelViewBuilder builder(model);
+  FaceView view;
+  builder.BuildFaceView(view);
+  const std::size_t full = view.vertices.size();
+  lods.Apply(view);
+  EXPECT_LT(view.vertices.size(), full);
+  EXPECT_EQ(view.primitiveIds.size(), view.vertices.size());
+  EXPECT_EQ(view.faceVertexCount[faces[0]], 0u);
+
+  // Close up, full detail again
+  EXPECT_TRUE(lods.Update(near, 45.0f, 1000));
+  EXPECT_EQ(lods.SelectedLevel(sphere), 0u);
+  EXPECT_FALSE(lods.Update(near, 45.0f, 1000));
+
+  // Far away but edited: the stale chain is dropped
+  lods.Update(far, 45.0f, 1000);
+  ASSERT_GT(lods.SelectedLevel(sphere), 0u);
+  const VertexId moved = model.FaceLoop(faces[0])[0];
+  model.SetVertexPosition(moved, model.GetVertex(moved).position * 1.1f);
+  EXPECT_TRUE(lods.Update(far, 45.0f, 1000));
+  EXPECT_EQ(lods.SelectedLevel(sphere), 0u);
+}
+
+TEST_F(SimplifyTest, LodCacheDropsChainsOnUntrackedVertexChanges) {
+  LodCache lods(model, 1000);
+  const Vec3 far{0, 0, 400};
+  auto settle = [&] {
+    for (int frame = 0; frame < 2000 && lods.SelectedLevel(sphere) == 0; ++frame) {
+      lods.Update(far, 45.0f, 1000);
+      if (lods.PendingCount() > 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return lods.SelectedLevel(sphere);
+  };
+
+  // Moving most vertices at once is recorded as a whole-set change, not per face
+  ASSERT_GT(settle(), 0u);
+  std::vector<VertexId> ids;
+  std::vector<Vec3> positions;
+  for (uint32_t i = 0; i < model.Vertices().size(); ++i) {
+    ids.push_back(model.VertexIndexToId(i));
+    positions.push_back(model.Vertices()[i].position * 1.5f);
+  }
+  model.SetVertexPositions(ids, positions);
+  ASSERT_TRUE(model.ReshapedFaces().empty());
+  EXPECT_TRUE(lods.Update(far, 45.0f, 1000));
+  EXPECT_EQ(lods.SelectedLevel(sphere), 0u);
+
+  // Legacy extrude moves a face without touching any face list or loop size
+  model.ResetDirtyFlags();
+  ASSERT_GT(settle(), 0u);
+  model.ExtrudeFace(faces[0], 0.5f);
+  EXPECT_TRUE(lods.Update(far, 45.0f, 1000));
+  EXPECT_EQ(lods.SelectedLevel(sphere), 0u);
+}
+
+TEST_F(SimplifyTest, CommandReplacesVolumeAsOneUndoStep) {
+  const std::size_t vertices = model.Vertices().size();
+  const std::size_t original = TriangleCount(model, faces);
+
+  CommandStack stack(model);
+  ASSERT_TRUE(stack.Do<DecimateCommand>(sphere, Simplify::Options{original / 4}));
+  ASSERT_EQ(model.Volumes().size(), 1u);
+  EXPECT_FALSE(model.ContainsVolume(sphere));
+  std::vector<FaceId> result(model.Volumes()[0].faces);
+  EXPECT_LE(result.size(), original / 4);
+
+  ASSERT_TRUE(stack.Undo());
+  ASSERT_TRUE(model.ContainsVolume(sphere));
+  EXPECT_EQ(model.Vertices().size(), vertices);
+  EXPECT_EQ(model.GetVolume(sphere).faces, faces);
+
+  // Redo appends the kept result instead of decimating again
+  ASSERT_TRUE(stack.Redo());
+  EXPECT_EQ(model.Volumes()[0].faces, result);
+  ASSERT_TRUE(stack.Undo());
+
+  // A result decimated ahead, as Application::SimplifyVolume does on a worker, is used
+  // as given
+  MeshData precomputed = Simplify::Decimate(model, faces, {original / 8}).mesh;
+  const std::size_t precomputedFaces = precomputed.FaceCount();
+  ASSERT_TRUE(stack.Do<DecimateCommand>(sphere, Simplify::Options{original / 4},
+                                        std::move(precomputed)));
+  ASSERT_EQ(model.Volumes().size(), 1u);
+  EXPECT_EQ(model.Volumes()[0].faces.size(), precomputedFaces);
+  ASSERT_TRUE(stack.Undo());
+
+  // Journal replay decimates again from the parameters
+  std::vector<char> bytes;
+  SerializeCommand(DecimateCommand{sphere, {original / 2, 0.5f}}, bytes);
+  BinaryReader in(std::string_view(bytes.data(), bytes.size()));
+  auto replayed = DeserializeCommand(in);
+  ASSERT_TRUE(replayed);
+  std::visit(ExecuteVisitor{model}, *replayed);
+  ASSERT_EQ(model.Volumes().size(), 1u);
+  EXPECT_LE(model.Volumes()[0].faces.size(), original / 2);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "Core/MeshData.h"
+#include "Model/Model.h"
+#include "Subdivision/CatmullClark.h"
+#include "Topology/Validation.h"
+#include "Utilities/Vec3.h"
+
+#include "TestHelpers.h"
+
+class SubdivisionTest : public ::testing::Test {
+ protected:
+  Model model;
+};
+
+TEST_F(SubdivisionTest, ClosedCageStaysAClosedVolume) {
+  const MeshIds cube = model.AppendMesh(Cube());
+  const auto result = Subdivision::CatmullClark(model, cube.faces, 1);
+
+  // V + E + F refined vertices, each corner becomes a quad
+  EXPECT_EQ(result.mesh.positions.size(), 26u);
+  EXPECT_EQ(result.mesh.edges.size(), 48u);
+  ASSERT_EQ(result.mesh.FaceCount(), 24u);
+  ASSERT_EQ(result.mesh.VolumeCount(), 1u);
+  ASSERT_EQ(result.faceOrigins.size(), 24u);
+  EXPECT_EQ(result.faceOrigins[0], cube.faces[0]);
+
+  // Valence 3 corner: (F + 2R) / 3 = (1/3 + 2/6) / 3 along each axis
+  EXPECT_TRUE(IsEqual(result.mesh.positions[0], Vec3{2.0f / 9, 2.0f / 9, 2.0f / 9}));
+
+  Model refined;
+  const MeshIds ids = refined.AppendMesh(result.mesh);
+  const std::array<Volume, 1> volume{refined.GetVolume(ids.volumes[0])};
+  EXPECT_EQ(refined.ValidateVolumes(volume, true)[0], Topology::Defect::None);
+}
+
+TEST_F(SubdivisionTest, OpenBorderFollowsBoundaryRules) {
+  const MeshIds grid = model.AppendMesh(Grid(2, 2));
+
+  // Border vertices take (6P + a + b) / 8 from their border neighbours, border edge
+  // points are midpoints
+  const auto once = Subdivision::CatmullClark(model, grid.faces, 1);
+  EXPECT_TRUE(IsEqual(once.mesh.positions[0], Vec3{0.125f, 0.125f, 0}));
+  EXPECT_TRUE(IsEqual(once.mesh.positions[9], Vec3{0.5f, 0, 0}));
+
+  const auto twice = Subdivision::CatmullClark(model, grid.faces, 2);
+  EXPECT_EQ(twice.mesh.FaceCount(), 64u);
+  EXPECT_EQ(twice.mesh.VolumeCount(), 0u);
+  for (const Vec3& p : twice.mesh.positions) EXPECT_FLOAT_EQ(p.z, 0.0f);
+}
+
+TEST_F(SubdivisionTest, PreviewLeavesModelUntouched) {
+  const MeshIds cube = model.AppendMesh(Cube());
+  model.ResetDirtyFlags();
+
+  FaceView view;
+  Subdivision::BuildPreview(model, cube.faces, 2, view);
+
+  // 6 faces * 16 quads * 2 triangles
+  EXPECT_EQ(view.vertices.size(), 6u * 16 * 2 * 3);
+  ASSERT_EQ(view.primitiveIds.size(), view.vertices.size());
+  for (FaceId id : view.primitiveIds) {
+    EXPECT_NE(std::find(cube.faces.begin(), cube.faces.end(), id - 1), cube.faces.end());
+  }
+  EXPECT_EQ(view.colorIndices.size(), 6u);
+  EXPECT_FALSE(model.ShouldRender());
+  EXPECT_EQ(model.Vertices().size(), 8u);
+}
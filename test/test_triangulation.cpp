@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+#include "Geometry/Geometry.h"
+#include "Geometry/Triangulation.h"
+#include "Model/Model.h"
+#include "ModelView/TriangulationCache.h"
+
+namespace {
+
+// Checks n - 2 triangles, all wound with the normal, whose areas add up to the polygon's
+void ExpectValidTriangulation(std::span<const Vec3> points, const std::vector<uint32_t>& corners) {
+  const Vec3 normal = Geometry::PolygonNormal(points);
+  ASSERT_EQ(corners.size(), (points.size() - 2) * 3);
+
+  float area = 0.0f;
+  for (std::size_t i = 0; i < corners.size(); i += 3) {
+    const Vec3& a = points[corners[i]];
+    const Vec3& b = points[corners[i + 1]];
+    const Vec3& c = points[corners[i + 2]];
+    const float twiceArea = (b - a).Cross(c - a).Dot(normal);
+    EXPECT_GT(twiceArea, 0.0f) << "triangle " << i / 3;
+    area += twiceArea * 0.5f;
+  }
+
+  // Shoelace area through the Newell normal
+  Vec3 sum{};
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    sum += points[i].Cross(points[(i + 1) % points.size()]);
+  }
+  EXPECT_NEAR(area, 0.5f * sum.Dot(normal), 1e-4f);
+}
+
+std::vector<uint32_t> Triangulate(std::span<const Vec3> points) {
+  std::vector<uint32_t> corners;
+  Geometry::TriangulatePolygon(points, Geometry::PolygonNormal(points), corners);
+  return corners;
+}
+
+}  // namespace
+
+TEST(TriangulationTest, ConcaveQuadSplitsAtReflexCorner) {
+  // Long dart: corner 2 is reflex and the shorter diagonal 1-3 lies outside the polygon
+  const std::array<Vec3, 4> points{Vec3{0, 0, 0}, Vec3{10, -0.5f, 0}, Vec3{9, 0, 0},
+                                   Vec3{10, 0.5f, 0}};
+  const auto corners = Triangulate(points);
+  ExpectValidTriangulation(points, corners);
+}
+
+TEST(TriangulationTest, ConcavePolygonsAreEarClipped) {
+  // L shape in a tilted plane
+  std::vector<Vec3> points{{0, 0, 0}, {2, 0, 0}, {2, 1, 0}, {1, 1, 0}, {1, 2, 0}, {0, 2, 0}};
+  for (Vec3& p : points) p = Vec3{p.x, p.y * 0.6f, p.y * 0.8f};
+  ExpectValidTriangulation(points, Triangulate(points));
+
+  // Comb with several reflex corners, wound clockwise
+  std::vector<Vec3> comb{{0, 0, 0}, {0, 3, 0}, {1, 1, 0}, {2, 3, 0},
+                         {3, 1, 0}, {4, 3, 0}, {4, 0, 0}};
+  ExpectValidTriangulation(comb, Triangulate(comb));
+}
+
+TEST(TriangulationTest, ConvexPolygonUsesAllCorners) {
+  std::vector<Vec3> hexagon;
+  for (int i = 0; i < 6; ++i) {
+    const float angle = static_cast<float>(i) * 3.14159265f / 3.0f;
+    hexagon.push_back(Vec3{std::cos(angle), 0.0f, -std::sin(angle)});
+  }
+  EXPECT_TRUE(Geometry::IsConvexPolygon(hexagon, Geometry::PolygonNormal(hexagon)));
+  ExpectValidTriangulation(hexagon, Triangulate(hexagon));
+}
+
+TEST(TriangulationTest, CacheRetriangulatesOnlyChangedFaces) {
+  Model model;
+  const VertexId v0 = model.CreateVertex({0, 0, 0});
+  const VertexId v1 = model.CreateVertex({1, 0, 0});
+  const VertexId v2 = model.CreateVertex({0, 1, 0});
+  const VertexId v3 = model.CreateVertex({5, 0, 0});
+  const VertexId v4 = model.CreateVertex({6, 0, 0});
+  const VertexId v5 = model.CreateVertex({5, 1, 0});
+
+  auto makeTriangle = [&](VertexId a, VertexId b, VertexId c) {
+    const std::array<EdgeId, 3> edges{*model.CreateEdge(a, b), *model.CreateEdge(b, c),
+                                      *model.CreateEdge(c, a)};
+    return *model.CreateFace(edges);
+  };
+  const FaceId f0 = makeTriangle(v0, v1, v2);
+  const FaceId f1 = makeTriangle(v3, v4, v5);
+
+  TriangulationCache cache;
+  EXPECT_EQ(cache.Get(model, f0).size(), 3u);
+  EXPECT_EQ(cache.Get(model, f1).size(), 3u);
+  EXPECT_EQ(cache.RebuildCount(), 2u);
+
+  cache.Get(model, f0);
+  cache.Get(model, f1);
+  EXPECT_EQ(cache.RebuildCount(), 2u);
+
+  model.SetVertexPosition(v4, {7, 0, 0});
+  cache.Get(model, f0);
+  cache.Get(model, f1);
+  EXPECT_EQ(cache.RebuildCount(), 3u);
+}
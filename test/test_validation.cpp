@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+#include "Model/Model.h"
+#include "Topology/Validation.h"
+#include "Utilities/SparseSet.h"
+
+using Topology::Defect;
+
+class ValidationTest : public ::testing::Test {
+ protected:
+  // Tetrahedron 0..3 with edges e01, e02, e03, e12, e13, e23
+  void SetUp() override {
+    const std::array<Edge, 6> tetra{Edge{0, 1}, Edge{0, 2}, Edge{0, 3},
+                                    Edge{1, 2}, Edge{1, 3}, Edge{2, 3}};
+    for (const Edge& e : tetra) edges.Insert(e);
+  }
+
+  FaceId AddFace(std::vector<EdgeId> loop) { return faces.Insert(Face{std::move(loop)}); }
+
+  SparseSet<Edge> edges;
+  SparseSet<Face> faces;
+};
+
+TEST_F(ValidationTest, CheckFace_ReportsReasons) {
+  std::vector<VertexId> loop;
+
+  EXPECT_EQ(Topology::CheckFace(Face{{0, 3, 1}}, edges, loop), Defect::None);
+  EXPECT_EQ(loop.size(), 3u);
+
+  EXPECT_EQ(Topology::CheckFace(Face{{0, 3}}, edges, loop), Defect::TooFewElements);
+  EXPECT_EQ(Topology::CheckFace(Face{{0, 3, 42}}, edges, loop), Defect::MissingElement);
+  EXPECT_TRUE(loop.empty());
+
+  // e01, e12, e13: vertex 1 has degree 3
+  EXPECT_EQ(Topology::CheckFace(Face{{0, 3, 4}}, edges, loop), Defect::BadVertexDegree);
+}
+
+TEST_F(ValidationTest, CheckFace_RejectsTwoSeparateLoops) {
+  // Two disjoint triangles: every vertex has degree 2 but the edges do not chain
+  const EdgeId base = static_cast<EdgeId>(edges.DenseCount());
+  for (const Edge& e : {Edge{10, 11}, Edge{11, 12}, Edge{12, 10}, Edge{20, 21}, Edge{21, 22},
+                        Edge{22, 20}}) {
+    edges.Insert(e);
+  }
+
+  std::vector<VertexId> loop;
+  const Face face{{base, base + 1, base + 2, base + 3, base + 4, base + 5}};
+  EXPECT_EQ(Topology::CheckFace(face, edges, loop), Defect::BrokenLoop);
+}
+
+TEST_F(ValidationTest, CheckVolume_Orientation) {
+  // Outward wound: every shared edge is crossed in opposite directions
+  const FaceId f012 = AddFace({0, 3, 1});  // 0->1->2->0
+  const FaceId f031 = AddFace({2, 4, 0});  // 0->3->1->0
+  const FaceId f023 = AddFace({1, 5, 2});  // 0->2->3->0
+  const FaceId f132 = AddFace({4, 5, 3});  // 1->3->2->1
+
+  const Volume wound{{f012, f031, f023, f132}};
+  EXPECT_EQ(Topology::CheckVolume(wound, faces, edges, true), Defect::None);
+
+  // Same shell with one face reversed: orientable, but not as wound
+  const FaceId f021 = AddFace({1, 3, 0});  // 0->2->1->0
+  const Volume flipped{{f021, f031, f023, f132}};
+  EXPECT_EQ(Topology::CheckVolume(flipped, faces, edges), Defect::None);
+  EXPECT_EQ(Topology::CheckVolume(flipped, faces, edges, true), Defect::InconsistentWinding);
+}
+
+TEST_F(ValidationTest, CheckVolume_ReportsReasons) {
+  const FaceId f0 = AddFace({0, 3, 1});
+  const FaceId f1 = AddFace({2, 4, 0});
+  const FaceId f2 = AddFace({1, 5, 2});
+  const FaceId f3 = AddFace({4, 5, 3});
+
+  EXPECT_EQ(Topology::CheckVolume(Volume{{f0, f1, f2}}, faces, edges), Defect::TooFewElements);
+  EXPECT_EQ(Topology::CheckVolume(Volume{{f0, f1, f2, f2}}, faces, edges),
+            Defect::DuplicateElement);
+  EXPECT_EQ(Topology::CheckVolume(Volume{{f0, f1, f2, 99}}, faces, edges),
+            Defect::MissingElement);
+
+  // A fifth face on e01 makes that edge non-manifold
+  const FaceId extra = AddFace({0, 4, 2});  // 0->1->3->0
+  EXPECT_EQ(Topology::CheckVolume(Volume{{f0, f1, f2, f3, extra}}, faces, edges),
+            Defect::NonManifoldEdge);
+}
+
+TEST_F(ValidationTest, ModelBatchMatchesSingleChecks) {
+  Model model;
+  VertexId v0 = model.CreateVertex({0, 0, 0});
+  VertexId v1 = model.CreateVertex({1, 0, 0});
+  VertexId v2 = model.CreateVertex({0, 1, 0});
+  VertexId v3 = model.CreateVertex({0, 1, 1});
+
+  auto e01 = model.CreateEdge(v0, v1);
+  auto e12 = model.CreateEdge(v1, v2);
+  auto e20 = model.CreateEdge(v2, v0);
+  auto e23 = model.CreateEdge(v2, v3);
+  auto e30 = model.CreateEdge(v3, v0);
+  ASSERT_TRUE(e01 && e12 && e20 && e23 && e30);
+
+  std::vector<Face> candidates(1000);
+  for (std::size_t i = 0; i < candidates.size(); ++i) {
+    switch (i % 3) {
+      case 0: candidates[i].edges = {*e01, *e12, *e20}; break;
+      case 1: candidates[i].edges = {*e01, *e12, *e23, *e30}; break;
+      default: candidates[i].edges = {*e01, *e12}; break;
+    }
+  }
+
+  const auto verdicts = model.ValidateFaces(candidates);
+  ASSERT_EQ(verdicts.size(), candidates.size());
+  for (std::size_t i = 0; i < verdicts.size(); ++i) {
+    const Defect expected = i % 3 == 0   ? Defect::None
+                            : i % 3 == 1 ? Defect::NotPlanar
+                                         : Defect::TooFewElements;
+    ASSERT_EQ(verdicts[i], expected) << i;
+  }
+}